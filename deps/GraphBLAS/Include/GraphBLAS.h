@@ -6520,6 +6520,14 @@ GrB_Info GxB_MatrixTupleIter_iterate_range
     GrB_Index endRowIdx         // row index to finish with
 ) ;
 
+// Skip the remaining entries of the current row whose column index is below
+// colIdx, galloping over the row's sorted column indices
+GrB_Info GxB_MatrixTupleIter_seek_col
+(
+    GxB_MatrixTupleIter *iter,  // iterator to use
+    GrB_Index colIdx            // smallest column index to stop at
+) ;
+
 
 // Advance iterator to the next none zero value
 GrB_Info GxB_MatrixTupleIter_next
@@ -108,6 +108,45 @@ GrB_Info GxB_MatrixTupleIter_iterate_range
 	return (GrB_SUCCESS) ;
 }
 
+// Skip entries of the current row with a column index below colIdx
+GrB_Info GxB_MatrixTupleIter_seek_col
+(
+	GxB_MatrixTupleIter *iter,  // iterator to use
+	GrB_Index colIdx            // smallest column index to stop at
+) {
+	GB_WHERE("GxB_MatrixTupleIter_seek_col (iter, colIdx)") ;
+	GB_RETURN_IF_NULL(iter) ;
+
+	// Seek is confined to the current row.
+	const int64_t *Ai = iter->A->i ;
+	GrB_Index lo = iter->nnz_idx ;
+	GrB_Index hi = iter->nvals ;
+	if(iter->row_idx < iter->nrows && iter->A->p[iter->row_idx + 1] < hi) {
+		hi = iter->A->p[iter->row_idx + 1] ;
+	}
+	if(lo >= hi || Ai[lo] >= colIdx) return (GrB_SUCCESS) ;
+
+	// Gallop while Ai[lo] < colIdx, doubling the step.
+	GrB_Index step = 1 ;
+	while(lo + step < hi && Ai[lo + step] < colIdx) {
+		lo += step ;
+		step *= 2 ;
+	}
+	if(lo + step < hi) hi = lo + step ;
+
+	// Binary search (lo, hi] for the first column index not below colIdx.
+	lo++ ;
+	while(lo < hi) {
+		GrB_Index mid = lo + (hi - lo) / 2 ;
+		if(Ai[mid] < colIdx) lo = mid + 1 ;
+		else hi = mid ;
+	}
+
+	iter->p += lo - iter->nnz_idx ;
+	iter->nnz_idx = lo ;
+	return (GrB_SUCCESS) ;
+}
+
 
 // Advance iterator
 GrB_Info GxB_MatrixTupleIter_next
@@ -10,6 +10,7 @@
 #include "./bfs.h"
 #include "./dfs.h"
 #include "./all_paths.h"
+#include "./shortest_path.h"
 #include "./detect_cycle.h"
 #include "./longest_path.h"
 
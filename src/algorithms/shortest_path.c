@@ -0,0 +1,275 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "shortest_path.h"
+#include "RG.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+static inline GRAPH_EDGE_DIR _ReverseDirection(GRAPH_EDGE_DIR dir) {
+	if(dir == GRAPH_EDGE_DIR_OUTGOING) return GRAPH_EDGE_DIR_INCOMING;
+	if(dir == GRAPH_EDGE_DIR_INCOMING) return GRAPH_EDGE_DIR_OUTGOING;
+	return dir;
+}
+
+static inline GrB_Matrix _RelationMatrix(Graph *g, int relation) {
+	if(relation == GRAPH_NO_RELATION) return Graph_GetAdjacencyMatrix(g);
+	return Graph_GetRelationMatrix(g, relation);
+}
+
+// Returns true if node 'id' was discovered at 'level' by the search which produced 'levels'.
+static inline bool _DiscoveredAt(GrB_Vector levels, NodeID id, uint64_t level) {
+	uint64_t l;
+	if(GrB_Vector_extractElement_UINT64(&l, levels, id) != GrB_SUCCESS) return false;
+	return l == level;
+}
+
+// Expand frontier by a single hop in the given direction,
+// returns the set of reached nodes which are not yet visited.
+static GrB_Vector _Expand(ShortestPathCtx *ctx, GrB_Vector frontier, GrB_Vector visited,
+						  GRAPH_EDGE_DIR dir, GrB_Index n) {
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Vector next;
+	info = GrB_Vector_new(&next, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	for(int i = 0; i < ctx->relationCount; i++) {
+		GrB_Matrix M = _RelationMatrix(ctx->g, ctx->relationIDs[i]);
+		// next<!visited> |= frontier * M
+		if(dir != GRAPH_EDGE_DIR_INCOMING) {
+			info = GrB_vxm(next, visited, GrB_LOR, GxB_ANY_PAIR_BOOL, frontier, M, GrB_DESC_SC);
+			ASSERT(info == GrB_SUCCESS);
+		}
+		// next<!visited> |= M * frontier
+		if(dir != GRAPH_EDGE_DIR_OUTGOING) {
+			info = GrB_mxv(next, visited, GrB_LOR, GxB_ANY_PAIR_BOOL, M, frontier, GrB_DESC_SC);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	}
+
+	return next;
+}
+
+// Bidirectional BFS, sets ctx->length to the length of the shortest path
+// between src and dest, ctx->found is false if dest is unreachable within maxLen hops.
+static void _ShortestPathCtx_ComputeLength(ShortestPathCtx *ctx, NodeID src, NodeID dest,
+										   unsigned int maxLen) {
+	GrB_Info info;
+	UNUSED(info);
+	// Vectors must agree with the dimensions of the traversed matrices.
+	GrB_Index n = Graph_RequiredMatrixDim(ctx->g);
+	if(ctx->relationCount > 0) {
+		GrB_Matrix_nrows(&n, _RelationMatrix(ctx->g, ctx->relationIDs[0]));
+	}
+
+	GrB_Vector src_frontier;
+	GrB_Vector dest_frontier;
+	info = GrB_Vector_new(&ctx->src_levels, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&ctx->dest_levels, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&src_frontier, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&dest_frontier, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// Source and destination are discovered at level 0, stored as 1.
+	GrB_Vector_setElement_UINT64(ctx->src_levels, 1, src);
+	GrB_Vector_setElement_UINT64(ctx->dest_levels, 1, dest);
+	GrB_Vector_setElement_BOOL(src_frontier, true, src);
+	GrB_Vector_setElement_BOOL(dest_frontier, true, dest);
+
+	GrB_Vector intersection;
+	info = GrB_Vector_new(&intersection, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	while(ctx->src_depth + ctx->dest_depth < maxLen) {
+		// Expand the smaller of the two frontiers.
+		GrB_Index src_frontier_size;
+		GrB_Index dest_frontier_size;
+		GrB_Vector_nvals(&src_frontier_size, src_frontier);
+		GrB_Vector_nvals(&dest_frontier_size, dest_frontier);
+		bool forward = (src_frontier_size <= dest_frontier_size);
+
+		GrB_Vector *frontier = forward ? &src_frontier : &dest_frontier;
+		GrB_Vector levels = forward ? ctx->src_levels : ctx->dest_levels;
+		GrB_Vector other_levels = forward ? ctx->dest_levels : ctx->src_levels;
+		uint *depth = forward ? &ctx->src_depth : &ctx->dest_depth;
+		GRAPH_EDGE_DIR dir = forward ? ctx->dir : _ReverseDirection(ctx->dir);
+
+		GrB_Vector next = _Expand(ctx, *frontier, levels, dir, n);
+		GrB_Vector_free(frontier);
+		*frontier = next;
+
+		GrB_Index next_size;
+		GrB_Vector_nvals(&next_size, next);
+		// Frontier exhausted, dest is unreachable.
+		if(next_size == 0) break;
+
+		(*depth)++;
+		// levels<next> = depth + 1
+		info = GrB_Vector_assign_UINT64(levels, next, NULL, *depth + 1, GrB_ALL, n, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+
+		// Did we reach a node discovered by the other search?
+		info = GrB_eWiseMult_Vector_BinaryOp(intersection, NULL, NULL, GrB_SECOND_UINT64, next,
+											 other_levels, GrB_DESC_R);
+		ASSERT(info == GrB_SUCCESS);
+		GrB_Index intersection_size;
+		GrB_Vector_nvals(&intersection_size, intersection);
+		if(intersection_size > 0) {
+			uint64_t other_level;
+			info = GrB_Vector_reduce_UINT64(&other_level, NULL, GxB_MIN_UINT64_MONOID, intersection,
+											NULL);
+			ASSERT(info == GrB_SUCCESS);
+			ctx->length = *depth + other_level - 1;
+			ctx->found = true;
+			break;
+		}
+	}
+
+	GrB_Vector_free(&intersection);
+	GrB_Vector_free(&src_frontier);
+	GrB_Vector_free(&dest_frontier);
+}
+
+// Make sure context levels array have atleast 'level' entries,
+// Append given 'node' to given 'level' array.
+static void _ShortestPathCtx_AddConnectionToLevel(ShortestPathCtx *ctx, uint level, Node *node,
+												  Edge *edge) {
+	while(array_len(ctx->levels) <= level) {
+		ctx->levels = array_append(ctx->levels, array_new(LevelConnection, 1));
+	}
+	LevelConnection connection;
+	connection.node = *node;
+	if(edge) connection.edge = *edge;
+	ctx->levels[level] = array_append(ctx->levels[level], connection);
+}
+
+// Check to see if context levels array has entries at position 'level'.
+static bool _ShortestPathCtx_LevelNotEmpty(const ShortestPathCtx *ctx, uint level) {
+	return (level < array_len(ctx->levels) && array_len(ctx->levels[level]) > 0);
+}
+
+// Returns true if node 'id' may appear at position 'depth' of a shortest path.
+static bool _ShortestPathCtx_OnShortestPath(const ShortestPathCtx *ctx, NodeID id, uint depth) {
+	// Positions covered by the source search must match the source level.
+	if(depth <= ctx->src_depth && !_DiscoveredAt(ctx->src_levels, id, depth + 1)) return false;
+	// Positions covered by the destination search must match the destination level.
+	uint remaining = ctx->length - depth;
+	if(remaining <= ctx->dest_depth && !_DiscoveredAt(ctx->dest_levels, id, remaining + 1)) {
+		return false;
+	}
+	return true;
+}
+
+// Add neighbors of frontier which reside on a shortest path to level 'depth'.
+static void _addNeighbors(ShortestPathCtx *ctx, LevelConnection *frontier, uint depth,
+						  GRAPH_EDGE_DIR dir) {
+	for(int i = 0; i < ctx->relationCount; i++) {
+		Graph_GetNodeEdges(ctx->g, &frontier->node, dir, ctx->relationIDs[i], &ctx->neighbors);
+	}
+
+	uint32_t neighborsCount = array_len(ctx->neighbors);
+	for(uint32_t i = 0; i < neighborsCount; i++) {
+		Edge *e = ctx->neighbors + i;
+		NodeID id = (dir == GRAPH_EDGE_DIR_OUTGOING) ? Edge_GetDestNodeID(e) : Edge_GetSrcNodeID(e);
+		if(!_ShortestPathCtx_OnShortestPath(ctx, id, depth)) continue;
+
+		Node neighbor = GE_NEW_NODE();
+		Graph_GetNode(ctx->g, id, &neighbor);
+		_ShortestPathCtx_AddConnectionToLevel(ctx, depth, &neighbor, e);
+	}
+	array_clear(ctx->neighbors);
+}
+
+ShortestPathCtx *ShortestPathCtx_New(Node *src, Node *dest, Graph *g, int *relationIDs,
+									 int relationCount, GRAPH_EDGE_DIR dir, unsigned int minLen,
+									 unsigned int maxLen, bool single) {
+	ASSERT(src != NULL);
+	ASSERT(dest != NULL);
+	ASSERT(minLen <= 1);
+
+	ShortestPathCtx *ctx = rm_malloc(sizeof(ShortestPathCtx));
+	ctx->g = g;
+	ctx->dir = dir;
+	ctx->relationIDs = relationIDs;
+	ctx->relationCount = relationCount;
+	ctx->src_levels = NULL;
+	ctx->dest_levels = NULL;
+	ctx->src_depth = 0;
+	ctx->dest_depth = 0;
+	ctx->length = 0;
+	ctx->found = false;
+	ctx->single = single;
+	ctx->depleted = false;
+	ctx->levels = array_new(LevelConnection *, 1);
+	ctx->path = Path_New(1);
+	ctx->neighbors = array_new(Edge, 32);
+
+	if(ENTITY_GET_ID(src) == ENTITY_GET_ID(dest)) {
+		// A node reaches itself by an empty path, which is only valid when minLen is 0.
+		ctx->found = (minLen == 0);
+	} else {
+		_ShortestPathCtx_ComputeLength(ctx, ENTITY_GET_ID(src), ENTITY_GET_ID(dest), maxLen);
+	}
+
+	if(ctx->found) _ShortestPathCtx_AddConnectionToLevel(ctx, 0, src, NULL);
+	else ctx->depleted = true;
+
+	return ctx;
+}
+
+Path *ShortestPathCtx_NextPath(ShortestPathCtx *ctx) {
+	if(!ctx || ctx->depleted) return NULL;
+
+	// As long as path is not empty OR there are neighbors to traverse.
+	while(Path_NodeCount(ctx->path) || _ShortestPathCtx_LevelNotEmpty(ctx, 0)) {
+		uint depth = Path_NodeCount(ctx->path);
+
+		// Can we advance?
+		if(_ShortestPathCtx_LevelNotEmpty(ctx, depth)) {
+			LevelConnection frontierConnection = array_pop(ctx->levels[depth]);
+			Path_AppendNode(ctx->path, frontierConnection.node);
+			// For depth > 0 for each frontier node, there is a leading edge.
+			if(depth > 0) Path_AppendEdge(ctx->path, frontierConnection.edge);
+
+			// Frontier is the destination node.
+			if(depth == ctx->length) {
+				if(ctx->single) ctx->depleted = true;
+				return ctx->path;
+			}
+
+			depth++;
+			GRAPH_EDGE_DIR dir = ctx->dir;
+			if(dir == GRAPH_EDGE_DIR_BOTH) {
+				_addNeighbors(ctx, &frontierConnection, depth, GRAPH_EDGE_DIR_INCOMING);
+				dir = GRAPH_EDGE_DIR_OUTGOING;
+			}
+			_addNeighbors(ctx, &frontierConnection, depth, dir);
+		} else {
+			// No way to advance, backtrack.
+			Path_PopNode(ctx->path);
+			if(Path_EdgeCount(ctx->path)) Path_PopEdge(ctx->path);
+		}
+	}
+
+	ctx->depleted = true;
+	return NULL;
+}
+
+void ShortestPathCtx_Free(ShortestPathCtx *ctx) {
+	if(!ctx) return;
+	uint32_t levelsCount = array_len(ctx->levels);
+	for(uint32_t i = 0; i < levelsCount; i++) array_free(ctx->levels[i]);
+	array_free(ctx->levels);
+	if(ctx->src_levels) GrB_Vector_free(&ctx->src_levels);
+	if(ctx->dest_levels) GrB_Vector_free(&ctx->dest_levels);
+	Path_Free(ctx->path);
+	array_free(ctx->neighbors);
+	rm_free(ctx);
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+/*
+ * Finds the shortest path(s) between a source and a destination node.
+ * The length of the shortest path is computed by a bidirectional BFS,
+ * expanding either the source or the destination frontier, whichever is smaller,
+ * one level at a time until the two searches meet.
+ * Each search records the level at which it discovered every node,
+ * paths are then enumerated one at a time by a DFS which only follows
+ * nodes whose recorded levels place them on a shortest path.
+ * */
+
+#ifndef _SHORTEST_PATH_H_
+#define _SHORTEST_PATH_H_
+
+#include "./all_paths.h"
+#include "../datatypes/path/path.h"
+#include "../graph/graph.h"
+#include "../graph/entities/node.h"
+
+typedef struct {
+	LevelConnection **levels;   // Nodes reached at depth i, and edges leading to them.
+	Path *path;                 // Current path.
+	Graph *g;                   // Graph to traverse.
+	Edge *neighbors;            // Reusable buffer of edges along the current path.
+	int *relationIDs;           // edge type(s) to traverse.
+	int relationCount;          // length of relationIDs.
+	GRAPH_EDGE_DIR dir;         // traverse direction.
+	GrB_Vector src_levels;      // Depth + 1 of each node reached from the source.
+	GrB_Vector dest_levels;     // Depth + 1 of each node reached from the destination.
+	uint src_depth;             // Number of levels expanded from the source.
+	uint dest_depth;            // Number of levels expanded from the destination.
+	uint length;                // Length of the shortest path.
+	bool found;                 // True if a path between source and destination exists.
+	bool single;                // Produce only the first shortest path.
+	bool depleted;              // No additional paths to produce.
+} ShortestPathCtx;
+
+// Create a new shortest path context object,
+// computes the length of the shortest path between src and dest.
+ShortestPathCtx *ShortestPathCtx_New(
+	Node *src,           // Source node.
+	Node *dest,          // Destination node.
+	Graph *g,            // Graph to traverse.
+	int *relationIDs,    // Edge type(s) on which we'll traverse.
+	int relationCount,   // Length of relationIDs.
+	GRAPH_EDGE_DIR dir,  // Traversal direction.
+	unsigned int minLen, // Path must contain at least minLen edges, either 0 or 1.
+	unsigned int maxLen, // Path must not contain more than maxLen edges.
+	bool single          // Produce a single path rather than all shortest paths.
+);
+
+// Produces the next shortest path from src to dest,
+// returns NULL once all paths have been produced.
+Path *ShortestPathCtx_NextPath(ShortestPathCtx *ctx);
+
+// Free context object.
+void ShortestPathCtx_Free(ShortestPathCtx *ctx);
+
+#endif
@@ -45,6 +45,7 @@ struct AlgebraicExpression {
 		struct {
 			AL_EXP_OP op;                   // Operation: `*`,`+`,`transpose`
 			AlgebraicExpression **children; // Child nodes.
+			GrB_Matrix scratch;             // Intermediate matrix reused across evaluations.
 		} operation;
 	};
 };
@@ -217,6 +218,14 @@ void AlgebraicExpression_Eval
 	GrB_Matrix res                  // Result output.
 );
 
+// Evaluate expression tree, computing only the entries present in mask.
+void AlgebraicExpression_EvalMasked
+(
+	const AlgebraicExpression *exp, // Root node.
+	GrB_Matrix mask,                // Entries to compute.
+	GrB_Matrix res                  // Result output.
+);
+
 //------------------------------------------------------------------------------
 // AlgebraicExpression debugging utilities.
 //------------------------------------------------------------------------------
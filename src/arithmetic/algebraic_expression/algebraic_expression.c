@@ -70,6 +70,7 @@ AlgebraicExpression *AlgebraicExpression_NewOperation
 	node->type = AL_OPERATION;
 	node->operation.op = op;
 	node->operation.children = array_new(AlgebraicExpression *, 0);
+	node->operation.scratch = GrB_NULL;
 	return node;
 }
 
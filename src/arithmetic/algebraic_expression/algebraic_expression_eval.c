@@ -5,15 +5,268 @@
 */
 
 #include "utils.h"
+#include "../../config.h"
 #include "../../query_ctx.h"
+#include "../../util/arr.h"
 #include "../algebraic_expression.h"
+#include "../../graph/graphcontext.h"
 
 // Forward declarations
-GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix res);
+GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix mask,
+									 GrB_Matrix res);
+
+/* Returns the scratch matrix of the given operation, shaped nrows x ncols.
+ * The matrix is kept by the operation so consecutive evaluations,
+ * e.g. one per batch of records, don't reallocate it. */
+static GrB_Matrix _Scratch
+(
+	const AlgebraicExpression *exp,
+	GrB_Index nrows,
+	GrB_Index ncols
+) {
+	GrB_Info info;
+	UNUSED(info);
+	// The scratch matrix is a cache, exp is otherwise unmodified.
+	AlgebraicExpression *op = (AlgebraicExpression *)exp;
+	GrB_Matrix scratch = op->operation.scratch;
+
+	if(scratch == GrB_NULL) {
+		info = GrB_Matrix_new(&scratch, GrB_BOOL, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+		op->operation.scratch = scratch;
+		return scratch;
+	}
+
+	GrB_Index scratch_nrows;
+	GrB_Index scratch_ncols;
+	GrB_Matrix_nrows(&scratch_nrows, scratch);
+	GrB_Matrix_ncols(&scratch_ncols, scratch);
+	if(scratch_nrows != nrows || scratch_ncols != ncols) {
+		info = GxB_Matrix_resize(scratch, nrows, ncols);
+		ASSERT(info == GrB_SUCCESS);
+	}
+	return scratch;
+}
+
+// Average number of entries per row.
+static inline uint64_t _AvgRowDegree(GrB_Matrix m) {
+	GrB_Index nrows;
+	GrB_Index nvals;
+	GrB_Matrix_nrows(&nrows, m);
+	GrB_Matrix_nvals(&nvals, m);
+	return (nrows == 0) ? 0 : nvals / nrows;
+}
+
+/* Estimated cost of C = A * B computed by scattering the rows of B
+ * for every entry of A (push, saxpy). 'Bt' is B's transpose, which
+ * has the same number of entries. */
+static inline uint64_t _PushCost(GrB_Matrix A, GrB_Matrix Bt) {
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, A);
+	return nvals * (_AvgRowDegree(Bt) + 1);
+}
+
+/* Estimated cost of computing the 'mask_nvals' entries of C<M> = A * B
+ * by intersecting rows of A with rows of B's transpose 'Bt' (pull, dot). */
+static inline uint64_t _PullCost(uint64_t mask_nvals, GrB_Matrix A, GrB_Matrix Bt) {
+	return mask_nvals * (_AvgRowDegree(A) + _AvgRowDegree(Bt) + 1);
+}
+
+/* Returns the transpose of the operand's matrix if the graph maintains it,
+ * GrB_NULL otherwise. */
+static GrB_Matrix _TransposedCounterpart(const AlgebraicExpression *operand) {
+	ASSERT(operand->type == AL_OPERAND);
+	GrB_Matrix m = operand->operand.matrix;
+	if(m == IDENTITY_MATRIX) return GrB_NULL;
+	if(operand->operand.diagonal) return m;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+
+	if(operand->operand.label == NULL) {
+		if(m == Graph_GetAdjacencyMatrix(g)) return Graph_GetTransposedAdjacencyMatrix(g);
+		if(m == Graph_GetTransposedAdjacencyMatrix(g)) return Graph_GetAdjacencyMatrix(g);
+		return GrB_NULL;
+	}
+
+	bool maintain_transpose;
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
+	if(!maintain_transpose) return GrB_NULL;
+
+	Schema *s = GraphContext_GetSchema(gc, operand->operand.label, SCHEMA_EDGE);
+	if(s == NULL) return GrB_NULL;
+	GrB_Matrix R = Graph_GetRelationMatrix(g, s->id);
+	GrB_Matrix TR = Graph_GetTransposedRelationMatrix(g, s->id);
+	if(m == R) return TR;
+	if(m == TR) return R;
+	return GrB_NULL;
+}
+
+/* Returns the matrix of a multiplication operand,
+ * setting 'transposed' if the operand is a transpose operation. */
+static GrB_Matrix _MulOperand(AlgebraicExpression **operand, bool *transposed) {
+	AlgebraicExpression *exp = *operand;
+	*transposed = false;
+	if(exp->type == AL_OPERATION) {
+		ASSERT(exp->operation.op == AL_EXP_TRANSPOSE);
+		ASSERT(AlgebraicExpression_ChildCount(exp) == 1);
+		*transposed = true;
+		exp = CHILD_AT(exp, 0);
+		*operand = exp;
+	}
+	return exp->operand.matrix;
+}
+
+static inline bool _IsDiagonalOperand(const AlgebraicExpression *exp) {
+	return exp->type == AL_OPERAND && exp->operand.diagonal;
+}
+
+/* Returns the position of the first multiplication operand from which
+ * all products share the expression's destination as their column domain,
+ * only these products can be restricted by a mask over the destination. */
+static uint _DestinationOperandIdx(const AlgebraicExpression *exp) {
+	uint child_count = AlgebraicExpression_ChildCount(exp);
+	for(uint i = child_count - 1; i > 0; i--) {
+		if(!_IsDiagonalOperand(CHILD_AT(exp, i))) return i;
+	}
+	return 1;
+}
+
+/* Computes C<M> = A * B, where B's matrix is 'b', transposed if 'transpose_b' is set.
+ * When a mask is given, the product is computed by pulling each masked entry
+ * from B's transpose if that is cheaper than pushing every entry of A through B. */
+static void _Multiply
+(
+	GrB_Matrix C,
+	GrB_Matrix M,
+	GrB_Matrix A,
+	bool transpose_a,
+	const AlgebraicExpression *b,
+	bool transpose_b,
+	GrB_Descriptor desc
+) {
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Matrix B = b->operand.matrix;
+
+	GrB_Descriptor_set(desc, GrB_INP0, transpose_a ? GrB_TRAN : GxB_DEFAULT);
+	GrB_Descriptor_set(desc, GrB_INP1, transpose_b ? GrB_TRAN : GxB_DEFAULT);
+	GrB_Descriptor_set(desc, GrB_OUTP, M ? GrB_REPLACE : GxB_DEFAULT);
+	GrB_Descriptor_set(desc, GxB_AxB_METHOD, GxB_DEFAULT);
+
+	if(B == IDENTITY_MATRIX) {
+		// The identity matrix does not need to be transposed.
+		GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
+		// B is the identity matrix, Perform A * I.
+		info = GrB_Matrix_apply(C, M, GrB_NULL, GrB_IDENTITY_BOOL, A, desc);
+		ASSERT(info == GrB_SUCCESS);
+		return;
+	}
+
+	if(M != GrB_NULL && !_IsDiagonalOperand(b)) {
+		// Rows of B's transpose, B itself if B is transposed.
+		GrB_Matrix pull = transpose_b ? B : _TransposedCounterpart(b);
+		// Rows of B, B's counterpart if B is transposed.
+		GrB_Matrix push = transpose_b ? _TransposedCounterpart(b) : B;
+		if(pull != GrB_NULL) {
+			GrB_Index mask_nvals;
+			GrB_Matrix_nvals(&mask_nvals, M);
+			if(push == GrB_NULL || _PullCost(mask_nvals, A, pull) < _PushCost(A, pull)) {
+				// C<M> = A * pull'
+				GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+				GrB_Descriptor_set(desc, GxB_AxB_METHOD, GxB_AxB_DOT);
+				B = pull;
+			} else {
+				GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
+				GrB_Descriptor_set(desc, GxB_AxB_METHOD, GxB_AxB_SAXPY);
+				B = push;
+			}
+		}
+	}
+
+	info = GrB_mxm(C, M, GrB_NULL, GxB_ANY_PAIR_BOOL, A, B, desc);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+/* Builds a mask shaped as 'res' over the nonempty rows of A and the entries of
+ * the diagonal label matrix L, into the scratch matrix of 'exp'.
+ * Returns GrB_NULL if restricting A * B to the mask isn't expected to pay off. */
+static GrB_Matrix _LabelMask
+(
+	const AlgebraicExpression *exp,
+	GrB_Matrix res,
+	GrB_Matrix A,
+	const AlgebraicExpression *b,
+	bool transpose_b,
+	GrB_Matrix L
+) {
+	GrB_Matrix pull = transpose_b ? b->operand.matrix : _TransposedCounterpart(b);
+	if(pull == GrB_NULL) return GrB_NULL;
+
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Index a_nvals;
+	GrB_Index l_nvals;
+	GrB_Matrix_nrows(&nrows, res);
+	GrB_Matrix_ncols(&ncols, res);
+	GrB_Matrix_nvals(&a_nvals, A);
+	GrB_Matrix_nvals(&l_nvals, L);
+
+	// Estimate the mask's size by the number of rows A might occupy.
+	uint64_t active_rows = (a_nvals < nrows) ? a_nvals : nrows;
+	if(_PullCost(active_rows * l_nvals, A, pull) >= _PushCost(A, pull)) return GrB_NULL;
+
+	// Collect the labeled nodes within the result's dimensions.
+	GrB_Index *labeled = rm_malloc(sizeof(GrB_Index) * (l_nvals + 1));
+	GrB_Matrix_extractTuples_BOOL(labeled, GrB_NULL, GrB_NULL, &l_nvals, L);
+	while(l_nvals > 0 && labeled[l_nvals - 1] >= ncols) l_nvals--;
+
+	// Collect A's nonempty rows, iterated in ascending order.
+	GrB_Index *rows = array_new(GrB_Index, active_rows);
+	GxB_MatrixTupleIter *iter;
+	GxB_MatrixTupleIter_new(&iter, A);
+	GrB_Index row;
+	bool depleted = false;
+	while(true) {
+		GxB_MatrixTupleIter_next(iter, &row, NULL, &depleted);
+		if(depleted) break;
+		uint row_count = array_len(rows);
+		if(row_count == 0 || rows[row_count - 1] != row) rows = array_append(rows, row);
+	}
+	GxB_MatrixTupleIter_free(iter);
+
+	uint row_count = array_len(rows);
+	GrB_Index n = row_count * l_nvals;
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * (n + 1));
+	GrB_Index *J = rm_malloc(sizeof(GrB_Index) * (n + 1));
+	bool *X = rm_malloc(sizeof(bool) * (n + 1));
+	for(uint i = 0; i < row_count; i++) {
+		for(GrB_Index j = 0; j < l_nvals; j++) {
+			GrB_Index idx = i * l_nvals + j;
+			I[idx] = rows[i];
+			J[idx] = labeled[j];
+			X[idx] = true;
+		}
+	}
+
+	GrB_Matrix mask = _Scratch(exp, nrows, ncols);
+	GrB_Matrix_clear(mask);
+	GrB_Info info = GrB_Matrix_build_BOOL(mask, I, J, X, n, GrB_LOR);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	rm_free(I);
+	rm_free(J);
+	rm_free(X);
+	rm_free(labeled);
+	array_free(rows);
+	return mask;
+}
 
 static GrB_Matrix _Eval_Transpose
 (
 	const AlgebraicExpression *exp,
+	GrB_Matrix mask,
 	GrB_Matrix res
 ) {
 	// This function is currently unused.
@@ -21,12 +274,13 @@ static GrB_Matrix _Eval_Transpose
 
 	AlgebraicExpression *child = FIRST_CHILD(exp);
 	ASSERT(child->type == AL_OPERAND);
-	GrB_Info info = GrB_transpose(res, GrB_NULL, GrB_NULL, child->operand.matrix, GrB_NULL);
+	GrB_Descriptor desc = (mask) ? GrB_DESC_R : GrB_NULL;
+	GrB_Info info = GrB_transpose(res, mask, GrB_NULL, child->operand.matrix, desc);
 	ASSERT(info == GrB_SUCCESS);
 	return res;
 }
 
-static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix res) {
+static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix mask, GrB_Matrix res) {
 	ASSERT(exp && AlgebraicExpression_ChildCount(exp) > 1);
 
 	GrB_Info info;
@@ -37,7 +291,9 @@ static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix res) {
 	GrB_Matrix a = GrB_NULL;        // Left operand.
 	GrB_Matrix b = GrB_NULL;        // Right operand.
 	GrB_Matrix inter = GrB_NULL;    // Intermediate matrix.
-	GrB_Descriptor desc = GrB_NULL; // Descriptor used for transposing operands (currently unused).
+	GrB_Descriptor desc = GrB_NULL; // Descriptor used for transposing operands and replacing masked results.
+	GrB_Descriptor_new(&desc);
+	if(mask) GrB_Descriptor_set(desc, GrB_OUTP, GrB_REPLACE);
 
 	// Get left and right operands.
 	AlgebraicExpression *left = CHILD_AT(exp, 0);
@@ -51,49 +307,46 @@ static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix res) {
 		if(left->operation.op == AL_EXP_TRANSPOSE) {
 			ASSERT(AlgebraicExpression_ChildCount(left) == 1);
 			a = left->operation.children[0]->operand.matrix;
-			if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
 			GrB_Descriptor_set(desc, GrB_INP0, GrB_TRAN);
 		} else {
-			a = _AlgebraicExpression_Eval(left, res);
+			a = _AlgebraicExpression_Eval(left, mask, res);
 			res_in_use = true;
 		}
 	}
 
 	/* If right operand is a matrix, simply get it.
-	 * Otherwise evaluate right hand side using `res` if free or create an additional matrix to store RHS value. */
+	 * Otherwise evaluate right hand side using `res` if free or an additional matrix to store RHS value. */
 	if(right->type == AL_OPERAND) {
 		b = right->operand.matrix;
 	} else {
 		if(right->operation.op == AL_EXP_TRANSPOSE) {
 			ASSERT(AlgebraicExpression_ChildCount(right) == 1);
 			b = right->operation.children[0]->operand.matrix;
-			if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
 			GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
 		} else if(res_in_use) {
-			// `res` is in use, create an additional matrix.
+			// `res` is in use, use an additional matrix.
 			GrB_Matrix_nrows(&nrows, a);
 			GrB_Matrix_ncols(&ncols, a);
-			info = GrB_Matrix_new(&inter, GrB_BOOL, nrows, ncols);
-			ASSERT(info == GrB_SUCCESS);
-			b = _AlgebraicExpression_Eval(right, inter);
+			inter = _Scratch(exp, nrows, ncols);
+			b = _AlgebraicExpression_Eval(right, mask, inter);
 		} else {
 			// `res` is not used just yet, use it for RHS evaluation.
-			b = _AlgebraicExpression_Eval(right, res);
+			b = _AlgebraicExpression_Eval(right, mask, res);
 		}
 	}
 
 	// Perform addition.
-	info = GrB_eWiseAdd_Matrix_Semiring(res, GrB_NULL, GrB_NULL, GxB_ANY_PAIR_BOOL, a, b, desc);
+	info = GrB_eWiseAdd_Matrix_Semiring(res, mask, GrB_NULL, GxB_ANY_PAIR_BOOL, a, b, desc);
 	ASSERT(info == GrB_SUCCESS);
 
-	// Reset descriptor if non-null.
-	if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP0, GxB_DEFAULT);
+	// Reset descriptor.
+	GrB_Descriptor_set(desc, GrB_INP0, GxB_DEFAULT);
 
 	uint child_count = AlgebraicExpression_ChildCount(exp);
 	// Expression has more than 2 operands, e.g. A+B+C...
 	for(uint i = 2; i < child_count; i++) {
-		// Reset descriptor if non-null.
-		if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
+		// Reset descriptor.
+		GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
 		right = CHILD_AT(exp, i);
 
 		if(right->type == AL_OPERAND) {
@@ -102,7 +355,6 @@ static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix res) {
 			if(right->operation.op == AL_EXP_TRANSPOSE) {
 				ASSERT(AlgebraicExpression_ChildCount(right) == 1);
 				b = right->operation.children[0]->operand.matrix;
-				if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
 				GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
 			} else {
 				// 'right' represents either + or * operation.
@@ -110,104 +362,73 @@ static GrB_Matrix _Eval_Add(const AlgebraicExpression *exp, GrB_Matrix res) {
 					// Can't use `res`, use an intermidate matrix.
 					GrB_Matrix_nrows(&nrows, res);
 					GrB_Matrix_ncols(&ncols, res);
-					info = GrB_Matrix_new(&inter, GrB_BOOL, nrows, ncols);
-					ASSERT(info == GrB_SUCCESS);
+					inter = _Scratch(exp, nrows, ncols);
 				}
-				b = _AlgebraicExpression_Eval(right, inter);
+				b = _AlgebraicExpression_Eval(right, mask, inter);
 			}
 		}
 
 		// Perform addition.
-		info = GrB_eWiseAdd_Matrix_Semiring(res, GrB_NULL, GrB_NULL, GxB_ANY_PAIR_BOOL, res, b, GrB_NULL);
+		info = GrB_eWiseAdd_Matrix_Semiring(res, mask, GrB_NULL, GxB_ANY_PAIR_BOOL, res, b, desc);
 		ASSERT(info == GrB_SUCCESS);
 	}
 
-	if(inter != GrB_NULL) GrB_Matrix_free(&inter);
-	if(desc != GrB_NULL) GrB_free(&desc);
+	GrB_free(&desc);
 	return res;
 }
 
-static GrB_Matrix _Eval_Mul(const AlgebraicExpression *exp, GrB_Matrix res) {
+static GrB_Matrix _Eval_Mul(const AlgebraicExpression *exp, GrB_Matrix mask, GrB_Matrix res) {
 	ASSERT(exp &&
 		   AlgebraicExpression_ChildCount(exp) > 1 &&
 		   AlgebraicExpression_OperationCount(exp, AL_EXP_MUL) == 1);
 
-	GrB_Info info;
-	UNUSED(info);
-	GrB_Matrix A;
-	GrB_Matrix B;
 	GrB_Index nvals;
-	GrB_Descriptor desc = GrB_NULL;
-	AlgebraicExpression *left = CHILD_AT(exp, 0);
-	AlgebraicExpression *right = CHILD_AT(exp, 1);
-
-	if(left->type == AL_OPERATION) {
-		ASSERT(left->operation.op == AL_EXP_TRANSPOSE);
-		ASSERT(AlgebraicExpression_ChildCount(left) == 1);
-		if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
-		GrB_Descriptor_set(desc, GrB_INP0, GrB_TRAN);
-		left = CHILD_AT(left, 0);
-	}
-	A = left->operand.matrix;
-
-	if(right->type == AL_OPERATION) {
-		ASSERT(right->operation.op == AL_EXP_TRANSPOSE);
-		ASSERT(AlgebraicExpression_ChildCount(right) == 1);
-		if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
-		GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
-		right = CHILD_AT(right, 0);
-	}
-	B = right->operand.matrix;
-
-	if(B == IDENTITY_MATRIX) {
-		// Reset descriptor, as the identity matrix does not need to be transposed.
-		if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
-		// B is the identity matrix, Perform A * I.
-		info = GrB_Matrix_apply(res, GrB_NULL, GrB_NULL, GrB_IDENTITY_BOOL, A, desc);
-		ASSERT(info == GrB_SUCCESS);
-	} else {
-		// Perform multiplication.
-		info = GrB_mxm(res, GrB_NULL, GrB_NULL, GxB_ANY_PAIR_BOOL, A, B, desc);
-		ASSERT(info == GrB_SUCCESS);
-	}
-
-	GrB_Matrix_nvals(&nvals, res);
-
-	// Reset descriptor if non-null.
-	if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP0, GxB_DEFAULT);
+	bool transpose_a;
+	bool transpose_b;
+	GrB_Descriptor desc;
+	GrB_Descriptor_new(&desc);
 
 	uint child_count = AlgebraicExpression_ChildCount(exp);
-	for(uint i = 2; i < child_count; i++) {
-		// Reset descriptor if non-null.
-		if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
+	uint dest_idx = _DestinationOperandIdx(exp);
 
-		right = CHILD_AT(exp, i);
-		if(right->type == AL_OPERATION) {
-			ASSERT(right->operation.op == AL_EXP_TRANSPOSE);
-			ASSERT(AlgebraicExpression_ChildCount(right) == 1);
-			if(desc == GrB_NULL) GrB_Descriptor_new(&desc);
-			GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
-			right = CHILD_AT(right, 0);
-		}
-		B = right->operand.matrix;
-
-		if(B != IDENTITY_MATRIX) {
-			// Reset descriptor, as the identity matrix does not need to be transposed.
-			if(desc != GrB_NULL) GrB_Descriptor_set(desc, GrB_INP1, GxB_DEFAULT);
-			// Perform multiplication.
-			info = GrB_mxm(res, GrB_NULL, GrB_NULL, GxB_ANY_PAIR_BOOL, res, B, desc);
-			ASSERT(info == GrB_SUCCESS);
+	AlgebraicExpression *left = CHILD_AT(exp, 0);
+	GrB_Matrix A = _MulOperand(&left, &transpose_a);
+
+	for(uint i = 1; i < child_count; i++) {
+		AlgebraicExpression *right = CHILD_AT(exp, i);
+		GrB_Matrix B = _MulOperand(&right, &transpose_b);
+		// Multiplying an intermediate result by the identity matrix has no effect.
+		if(i > 1 && B == IDENTITY_MATRIX && (mask == GrB_NULL || i < dest_idx)) continue;
+
+		GrB_Matrix M = (i >= dest_idx) ? mask : GrB_NULL;
+
+		/* Traversal ends at a labeled node, e.g. A * B * L,
+		 * compute only the entries of A * B in L's columns. */
+		if(M == GrB_NULL && i == dest_idx && i == child_count - 2 && !transpose_a) {
+			AlgebraicExpression *label = CHILD_AT(exp, i + 1);
+			if(_IsDiagonalOperand(label) && label->operand.matrix != IDENTITY_MATRIX &&
+			   B != IDENTITY_MATRIX && !right->operand.diagonal) {
+				M = _LabelMask(exp, res, A, right, transpose_b, label->operand.matrix);
+				// The mask accounts for the label, skip it.
+				if(M != GrB_NULL) child_count--;
+			}
 		}
+
+		_Multiply(res, M, A, transpose_a, right, transpose_b, desc);
+		A = res;
+		transpose_a = false;
+
 		GrB_Matrix_nvals(&nvals, res);
 		if(nvals == 0) break;
 	}
 
-	if(desc != GrB_NULL) GrB_free(&desc);
+	GrB_free(&desc);
 
 	return res;
 }
 
-GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix res) {
+GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix mask,
+									 GrB_Matrix res) {
 	ASSERT(exp);
 
 	// Perform operation.
@@ -215,15 +436,15 @@ GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix
 	case AL_OPERATION:
 		switch(exp->operation.op) {
 		case AL_EXP_MUL:
-			res = _Eval_Mul(exp, res);
+			res = _Eval_Mul(exp, mask, res);
 			break;
 
 		case AL_EXP_ADD:
-			res = _Eval_Add(exp, res);
+			res = _Eval_Add(exp, mask, res);
 			break;
 
 		case AL_EXP_TRANSPOSE:
-			res = _Eval_Transpose(exp, res);
+			res = _Eval_Transpose(exp, mask, res);
 			break;
 
 		default:
@@ -242,6 +463,12 @@ GrB_Matrix _AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix
 
 void AlgebraicExpression_Eval(const AlgebraicExpression *exp, GrB_Matrix res) {
 	ASSERT(exp && exp->type == AL_OPERATION);
-	_AlgebraicExpression_Eval(exp, res);
+	_AlgebraicExpression_Eval(exp, GrB_NULL, res);
+}
+
+void AlgebraicExpression_EvalMasked(const AlgebraicExpression *exp, GrB_Matrix mask,
+									GrB_Matrix res) {
+	ASSERT(exp && exp->type == AL_OPERATION);
+	_AlgebraicExpression_Eval(exp, mask, res);
 }
 
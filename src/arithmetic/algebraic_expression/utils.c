@@ -157,6 +157,7 @@ void _AlgebraicExpression_FreeOperation
 		array_free(node->operation.children);
 		node->operation.children = NULL;
 	}
+	if(node->operation.scratch != GrB_NULL) GrB_Matrix_free(&node->operation.scratch);
 }
 
 void _AlgebraicExpression_FreeOperand
@@ -538,18 +538,24 @@ cypher_parse_result_t *parse_query(const char *query) {
 }
 
 
-cypher_parse_result_t *parse_params(const char *query, const char **query_body) {
+cypher_parse_result_t *parse_query_body(const char *query, const char **query_body) {
 	cypher_parse_result_t *result = cypher_parse(query, NULL, NULL, CYPHER_PARSE_ONLY_PARAMETERS);
 	if(!result) return NULL;
 	if(AST_Validate_QueryParams(result) != AST_VALID) {
 		parse_result_free(result);
 		return NULL;
 	}
-	_AST_Extract_Params(result);
 	if(query_body) *query_body = _AST_ExtractQueryString(result);
 	return result;
 }
 
+cypher_parse_result_t *parse_params(const char *query, const char **query_body) {
+	cypher_parse_result_t *result = parse_query_body(query, query_body);
+	if(!result) return NULL;
+	_AST_Extract_Params(result);
+	return result;
+}
+
 void parse_result_free(cypher_parse_result_t *parse_result) {
 	if(parse_result) cypher_parse_result_free(parse_result);
 }
@@ -128,6 +128,10 @@ cypher_parse_result_t *parse_query(const char *query);
 // Parse a query parameter values only. The remaining query string is set in the result body.
 cypher_parse_result_t *parse_params(const char *query, const char **query_body);
 
+// Parse a query parameters header only, without extracting parameter values.
+// The remaining query string is set in the result body.
+cypher_parse_result_t *parse_query_body(const char *query, const char **query_body);
+
 // Free the immutable AST generated by the parser.
 void parse_result_free(cypher_parse_result_t *parse_result);
 
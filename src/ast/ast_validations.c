@@ -308,6 +308,7 @@ static AST_Validation _Validate_Path_Locations(const cypher_astnode_t *root) {
 			   root_type != CYPHER_AST_MERGE &&
 			   root_type != CYPHER_AST_WITH &&
 			   root_type != CYPHER_AST_NAMED_PATH &&
+			   root_type != CYPHER_AST_SHORTEST_PATH &&
 			   root_type != CYPHER_AST_UNARY_OPERATOR &&
 			   root_type != CYPHER_AST_BINARY_OPERATOR) {
 				ErrorCtx_SetError("Encountered path traversal in unsupported location '%s'",
@@ -320,6 +321,68 @@ static AST_Validation _Validate_Path_Locations(const cypher_astnode_t *root) {
 	return AST_VALID;
 }
 
+// Validate a shortestPath or allShortestPaths pattern.
+static AST_Validation _Validate_ShortestPath(const cypher_astnode_t *shortest_path) {
+	const cypher_astnode_t *path = cypher_ast_shortest_path_get_path(shortest_path);
+	if(cypher_ast_pattern_path_nelements(path) != 3) {
+		ErrorCtx_SetError("shortestPath requires a pattern containing a single relationship");
+		return AST_INVALID;
+	}
+
+	const cypher_astnode_t *edge = cypher_ast_pattern_path_get_element(path, 1);
+	const cypher_astnode_t *range = cypher_ast_rel_pattern_get_varlength(edge);
+	if(range == NULL) {
+		ErrorCtx_SetError("shortestPath requires a variable-length relationship");
+		return AST_INVALID;
+	}
+
+	const cypher_astnode_t *range_start = cypher_ast_range_get_start(range);
+	if(range_start && AST_ParseIntegerNode(range_start) > 1) {
+		ErrorCtx_SetError("shortestPath does not support a minimal length greater than 1");
+		return AST_INVALID;
+	}
+
+	return AST_VALID;
+}
+
+/* shortestPath and allShortestPaths are only supported as
+ * top-level paths of a MATCH pattern, optionally named. */
+static AST_Validation _Validate_ShortestPaths(const cypher_astnode_t *root) {
+	AST_Validation res = AST_VALID;
+	const cypher_astnode_t **shortest_paths = AST_GetTypedNodes(root, CYPHER_AST_SHORTEST_PATH);
+	uint shortest_path_count = array_len(shortest_paths);
+	array_free(shortest_paths);
+	if(shortest_path_count == 0) return AST_VALID;
+
+	uint match_shortest_path_count = 0;
+	const cypher_astnode_t **match_clauses = AST_GetTypedNodes(root, CYPHER_AST_MATCH);
+	uint match_count = array_len(match_clauses);
+	for(uint i = 0; i < match_count; i++) {
+		const cypher_astnode_t *pattern = cypher_ast_match_get_pattern(match_clauses[i]);
+		uint path_count = cypher_ast_pattern_npaths(pattern);
+		for(uint j = 0; j < path_count; j++) {
+			const cypher_astnode_t *path = cypher_ast_pattern_get_path(pattern, j);
+			if(cypher_astnode_type(path) == CYPHER_AST_NAMED_PATH) {
+				path = cypher_ast_named_path_get_path(path);
+			}
+			if(cypher_astnode_type(path) != CYPHER_AST_SHORTEST_PATH) continue;
+
+			match_shortest_path_count++;
+			res = _Validate_ShortestPath(path);
+			if(res != AST_VALID) goto cleanup;
+		}
+	}
+
+	if(match_shortest_path_count != shortest_path_count) {
+		ErrorCtx_SetError("shortestPath is only supported within MATCH patterns");
+		res = AST_INVALID;
+	}
+
+cleanup:
+	array_free(match_clauses);
+	return res;
+}
+
 static inline bool _AliasIsReturned(rax *projections, const char *identifier) {
 	return raxFind(projections, (unsigned char *)identifier, strlen(identifier)) != raxNotFound;
 }
@@ -1739,6 +1802,7 @@ AST_Validation AST_Validate_Query(const cypher_parse_result_t *result) {
 
 	// Check for path traversals in unsupported locations.
 	if(_Validate_Path_Locations(mock_ast.root) != AST_VALID) return AST_INVALID;
+	if(_Validate_ShortestPaths(mock_ast.root) != AST_VALID) return AST_INVALID;
 
 	// Check for invalid queries not captured by libcypher-parser
 	AST_Validation res;
@@ -124,7 +124,7 @@ static void _buildTypesWhitelist(void) {
 		CYPHER_AST_PROC_NAME,
 		CYPHER_AST_PATTERN,
 		CYPHER_AST_NAMED_PATH,
-		// CYPHER_AST_SHORTEST_PATH,
+		CYPHER_AST_SHORTEST_PATH,
 		CYPHER_AST_PATTERN_PATH,
 		CYPHER_AST_NODE_PATTERN,
 		CYPHER_AST_REL_PATTERN,
@@ -7,6 +7,7 @@
 #include "bulk_insert.h"
 #include "RG.h"
 #include "../schema/schema.h"
+#include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../datatypes/array.h"
 #include <errno.h>
@@ -115,19 +116,28 @@ int _BulkInsert_ProcessNodeFile(RedisModuleCtx *ctx, GraphContext *gc, const cha
 	unsigned int prop_count;
 	Attribute_ID *prop_indicies = _BulkInsert_ReadHeader(gc, SCHEMA_NODE, data, &data_idx, &label_id,
 														 &prop_count);
+	Schema *s = (label_id == GRAPH_NO_LABEL) ? NULL :
+				GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
+	// Buffer holding a single node's properties.
+	SIValue *values = rm_malloc(sizeof(SIValue) * prop_count);
 
 	while(data_idx < data_len) {
 		Node n;
 		Graph_CreateNode(gc->g, label_id, &n);
+		if(prop_count == 0) continue;
+
 		for(unsigned int i = 0; i < prop_count; i++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// Cypher does not support NULL as a property value.
-			// If we encounter one here, simply skip it.
-			if(SI_TYPE(value) == T_NULL) continue;
-			GraphEntity_AddProperty((GraphEntity *)&n, prop_indicies[i], value);
+			values[i] = _BulkInsert_ReadProperty(data, &data_idx);
 		}
+		// Cypher does not support NULL as a property value,
+		// these are skipped.
+		GraphEntity_AddProperties((GraphEntity *)&n, prop_indicies, values, prop_count);
+		for(unsigned int i = 0; i < prop_count; i++) SIValue_Free(values[i]);
+		// Keep the label's columns, if any, up to date.
+		if(s && ColumnStore_ColumnCount(s->columns) > 0) ColumnStore_UpdateNode(s->columns, &n);
 	}
 
+	rm_free(values);
 	free(prop_indicies);
 	return BULK_OK;
 }
@@ -143,6 +153,10 @@ int _BulkInsert_ProcessRelationFile(RedisModuleCtx *ctx, GraphContext *gc, const
 														 &prop_count);
 	NodeID src;
 	NodeID dest;
+	// Buffer holding a single edge's properties.
+	SIValue *values = rm_malloc(sizeof(SIValue) * prop_count);
+	// Edges are connected once the entire file is processed.
+	Edge *edges = array_new(Edge, 1024);
 
 	while(data_idx < data_len) {
 		Edge e;
@@ -153,20 +167,26 @@ int _BulkInsert_ProcessRelationFile(RedisModuleCtx *ctx, GraphContext *gc, const
 		dest = *(NodeID *)&data[data_idx];
 		data_idx += sizeof(NodeID);
 
-		Graph_ConnectNodes(gc->g, src, dest, reltype_id, &e);
+		Graph_CreateEdge(gc->g, src, dest, reltype_id, &e);
+		edges = array_append(edges, e);
 
 		if(prop_count == 0) continue;
 
 		// Process and add relation properties
 		for(unsigned int i = 0; i < prop_count; i ++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// Cypher does not support NULL as a property value.
-			// If we encounter one here, simply skip it.
-			if(SI_TYPE(value) == T_NULL) continue;
-			GraphEntity_AddProperty((GraphEntity *)&e, prop_indicies[i], value);
+			values[i] = _BulkInsert_ReadProperty(data, &data_idx);
 		}
+		// Cypher does not support NULL as a property value,
+		// these are skipped.
+		GraphEntity_AddProperties((GraphEntity *)&e, prop_indicies, values, prop_count);
+		for(unsigned int i = 0; i < prop_count; i++) SIValue_Free(values[i]);
 	}
 
+	// Build the relation and adjacency matrices updates at once.
+	Graph_ConnectEdges(gc->g, edges, array_len(edges));
+
+	array_free(edges);
+	rm_free(values);
 	free(prop_indicies);
 	return BULK_OK;
 }
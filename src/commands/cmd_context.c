@@ -27,7 +27,8 @@ CommandCtx *CommandCtx_New
 	GraphContext *graph_ctx,
 	bool replicated_command,
 	bool compact,
-	long long timeout
+	long long timeout,
+	uint64_t cursor_count
 ) {
 	CommandCtx *context = rm_malloc(sizeof(CommandCtx));
 	context->bc = bc;
@@ -35,6 +36,7 @@ CommandCtx *CommandCtx_New
 	context->query = NULL;
 	context->compact = compact;
 	context->timeout = timeout;
+	context->cursor_count = cursor_count;
 	context->command_name = NULL;
 	context->graph_ctx = graph_ctx;
 	context->replicated_command = replicated_command;
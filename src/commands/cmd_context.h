@@ -20,6 +20,7 @@ typedef struct {
 	bool replicated_command;        // Whether this instance was spawned by a replication command.
 	bool compact;                   // Whether this query was issued with the compact flag.
 	long long timeout;              // The query timeout, if specified.
+	uint64_t cursor_count;          // Records per reply when reading through a cursor, 0 if disabled.
 } CommandCtx;
 
 // Create a new command context.
@@ -32,7 +33,8 @@ CommandCtx *CommandCtx_New
 	GraphContext *graph_ctx,        // Graph context.
 	bool replicated_command,        // Whether this instance was spawned by a replication command.
 	bool compact,                   // Whether this query was issued with the compact flag.
-	long long timeout               // The query timeout, if specified.
+	long long timeout,              // The query timeout, if specified.
+	uint64_t cursor_count           // Records per reply when reading through a cursor, 0 if disabled.
 );
 
 // Tracks given 'ctx' such that in case of a crash we will be able to report
@@ -0,0 +1,97 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "cmd_cursor.h"
+#include "../RG.h"
+#include "../errors.h"
+#include "cmd_context.h"
+#include "query_cursor.h"
+#include "../query_ctx.h"
+#include "../graph/graph.h"
+#include "../slow_log/slow_log.h"
+#include "../execution_plan/execution_plan.h"
+
+/* GRAPH.CURSOR <GRAPH_KEY> <CURSOR_ID>
+ * Replies with the next records of a query issued with the cursor flag. */
+void Graph_Cursor(void *args) {
+	bool pending            = false;
+	QueryCursor *cursor     = NULL;
+	ResultSet *result_set   = NULL;
+	CommandCtx *command_ctx = (CommandCtx *)args;
+	RedisModuleCtx *ctx     = CommandCtx_GetRedisCtx(command_ctx);
+	GraphContext *gc        = CommandCtx_GetGraphContext(command_ctx);
+
+	CommandCtx_TrackCtx(command_ctx);
+
+	// The cursor ID takes the place of the query argument.
+	char *end;
+	const char *id_str = CommandCtx_GetQuery(command_ctx);
+	uint64_t id = strtoull(id_str, &end, 10);
+	if(*id_str != '\0' && *end == '\0') cursor = QueryCursor_Take(id);
+
+	if(cursor == NULL) {
+		RedisModule_ReplyWithError(ctx, "Unknown cursor");
+		goto cleanup;
+	}
+
+	if(cursor->gc != gc) {
+		// Cursor belongs to a different graph, keep it for its owner.
+		QueryCursor_Store(cursor);
+		RedisModule_ReplyWithError(ctx, "Unknown cursor");
+		goto cleanup;
+	}
+
+	// A cursor reading a snapshot is unaffected by graph modifications.
+	bool snapshot = (cursor->query_ctx->snapshot != NULL);
+	if(!snapshot) Graph_AcquireReadLock(gc->g);
+
+	// Records held by the stopped execution may refer to modified entities.
+	if(!snapshot && Graph_GetEpoch(gc->g) != cursor->epoch) {
+		Graph_ReleaseLock(gc->g);
+		QueryCursor_Free(cursor);
+		RedisModule_ReplyWithError(ctx, "Cursor invalidated by a graph modification");
+		goto cleanup;
+	}
+
+	QueryCursor_Attach(cursor, command_ctx);
+	QueryCtx_BeginTimer(); // Start query timing.
+
+	if(!snapshot) Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
+	result_set = NewResultSet(ctx, cursor->format);
+	ResultSet_SetCapacity(result_set, cursor->count);
+	QueryCtx_SetResultSet(result_set);
+
+	ExecutionPlan *plan = cursor->exec_ctx->plan;
+	ExecutionPlan_Resume(plan);
+
+	// Emit error if query timed out.
+	if(ExecutionPlan_Drained(plan)) ErrorCtx_SetError("Query timed out");
+
+	// Result-set filled up again, additional records might be pending.
+	pending = (ResultSet_Capacity(result_set) == 0 && !ErrorCtx_EncounteredError());
+	if(pending) ResultSet_SetCursor(result_set, cursor->id);
+
+	ResultSet_Reply(result_set);    // Send result-set back to client.
+	if(!snapshot) Graph_ReleaseLock(gc->g);
+
+	// Log cursor read to slowlog.
+	SlowLog *slowlog = GraphContext_GetSlowLog(gc);
+	SlowLog_Add(slowlog, command_ctx->command_name, cursor->query,
+				QueryCtx_GetExecutionTime(), NULL);
+
+	ResultSet_Free(result_set);
+	if(pending) {
+		QueryCursor_Detach(cursor);
+		QueryCursor_Store(cursor);
+	} else {
+		QueryCursor_Free(cursor);
+	}
+
+cleanup:
+	GraphContext_Release(gc);
+	CommandCtx_Free(command_ctx);
+	ErrorCtx_Clear();
+}
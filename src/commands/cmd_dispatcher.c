@@ -7,6 +7,7 @@
 #include "../RG.h"
 #include "commands.h"
 #include "cmd_context.h"
+#include "execution_ctx.h"
 #include "../RG.h"
 
 #define GRAPH_VERSION_MISSING -1
@@ -16,14 +17,16 @@ typedef void(*Command_Handler)(void *args);
 
 // Read configuration flags, returning REDIS_MODULE_ERR if flag parsing failed.
 static int _read_flags(RedisModuleString **argv, int argc, bool *compact,
-		long long *timeout, uint *graph_version, char **errmsg) {
+		long long *timeout, uint64_t *cursor_count, uint *graph_version, char **errmsg) {
 
 	ASSERT(compact);
 	ASSERT(timeout);
+	ASSERT(cursor_count);
 
 	// set defaults
-	*timeout = 0;      // no timeout
-	*compact = false;  // verbose
+	*timeout = 0;       // no timeout
+	*compact = false;   // verbose
+	*cursor_count = 0;  // reply with the entire result-set
 	*graph_version = GRAPH_VERSION_MISSING;
 
 	// GRAPH.QUERY <GRAPH_KEY> <QUERY>
@@ -71,6 +74,26 @@ static int _read_flags(RedisModuleString **argv, int argc, bool *compact,
 				asprintf(errmsg, "Failed to parse query timeout value");
 				return REDISMODULE_ERR;
 			}
+
+			continue;
+		}
+
+		// number of records to reply with, remaining records are read through a cursor
+		if(!strcasecmp(arg, "cursor")) {
+			long long count = 0;
+			int err = REDISMODULE_ERR;
+			if(i < argc - 1) {
+				i++; // Set the current argument to the cursor count value.
+				err = RedisModule_StringToLongLong(argv[i], &count);
+			}
+
+			// Emit error on missing, non-positive, or non-numeric count values.
+			if(err != REDISMODULE_OK || count <= 0) {
+				asprintf(errmsg, "Failed to parse cursor count value");
+				return REDISMODULE_ERR;
+			}
+
+			*cursor_count = count;
 		}
 	}
 	return REDISMODULE_OK;
@@ -98,7 +121,10 @@ static inline bool _validate_command_arity(GRAPH_Commands cmd, int arity) {
 	case CMD_EXPLAIN:
 	case CMD_PROFILE:
 		// Expect a command, graph name, a query, and optional config flags.
-		return arity >= 3 && arity <= 8;
+		return arity >= 3 && arity <= 10;
+	case CMD_CURSOR:
+		// Expect a command, graph name and a cursor ID.
+		return arity == 3;
 	case CMD_SLOWLOG:
 		// Expect just a command and graph name.
 		return arity == 2;
@@ -120,12 +146,26 @@ static Command_Handler get_command_handler(GRAPH_Commands cmd) {
 		return Graph_Profile;
 	case CMD_SLOWLOG:
 		return Graph_Slowlog;
+	case CMD_CURSOR:
+		return Graph_Cursor;
 	default:
 		ASSERT(false);
 	}
 	return NULL;
 }
 
+// Determine query execution priority,
+// cheap queries are executed ahead of queued costly queries.
+static thpool_priority _query_priority(GRAPH_Commands cmd, GraphContext *gc,
+		RedisModuleString *query) {
+	if(cmd != CMD_QUERY && cmd != CMD_RO_QUERY) return THPOOL_PRIORITY_NORMAL;
+
+	// Cost class is known once the query was executed.
+	const char *query_str = RedisModule_StringPtrLen(query, NULL);
+	QueryCost cost = ExecutionCtx_GetCachedCost(gc, query_str);
+	return (cost == QUERY_COST_LOW) ? THPOOL_PRIORITY_HIGH : THPOOL_PRIORITY_NORMAL;
+}
+
 // Convert from string representation to an enum.
 static GRAPH_Commands determine_command(const char *cmd_name) {
 	if(strcasecmp(cmd_name, "graph.QUERY") == 0) return CMD_QUERY;
@@ -133,6 +173,7 @@ static GRAPH_Commands determine_command(const char *cmd_name) {
 	if(strcasecmp(cmd_name, "graph.EXPLAIN") == 0) return CMD_EXPLAIN;
 	if(strcasecmp(cmd_name, "graph.PROFILE") == 0) return CMD_PROFILE;
 	if(strcasecmp(cmd_name, "graph.SLOWLOG") == 0) return CMD_SLOWLOG;
+	if(strcasecmp(cmd_name, "graph.CURSOR") == 0) return CMD_CURSOR;
 
 	ASSERT(false);
 	return CMD_UNKNOWN;
@@ -143,6 +184,7 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	bool compact;
 	uint version;
 	long long timeout;
+	uint64_t cursor_count;
 	CommandCtx *context = NULL;
 
 	RedisModuleString *graph_name = argv[1];
@@ -151,7 +193,7 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	GRAPH_Commands cmd = determine_command(command_name);
 
 	// Parse additional query arguments.
-	int res = _read_flags(argv, argc, &compact, &timeout, &version, &errmsg);
+	int res = _read_flags(argv, argc, &compact, &timeout, &cursor_count, &version, &errmsg);
 
 	if(res == REDISMODULE_ERR) {
 		// Emit error and exit if argument parsing failed.
@@ -185,13 +227,16 @@ int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 											REDISMODULE_CTX_FLAGS_LOADING));
 	if(execute_on_main_thread) {
 		// Run query on Redis main thread.
-		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, is_replicated, compact, timeout);
+		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, is_replicated, compact, timeout,
+								 cursor_count);
 		handler(context);
 	} else {
 		// Run query on a dedicated thread.
 		RedisModuleBlockedClient *bc = RedisModule_BlockClient(ctx, NULL, NULL, NULL, 0);
-		context = CommandCtx_New(NULL, bc, argv[0], query, gc, is_replicated, compact, timeout);
-		thpool_add_work(_thpool, handler, context);
+		thpool_priority priority = _query_priority(cmd, gc, query);
+		context = CommandCtx_New(NULL, bc, argv[0], query, gc, is_replicated, compact, timeout,
+								 cursor_count);
+		thpool_add_work_priority(_thpool, handler, context, priority);
 	}
 
 	return REDISMODULE_OK;
@@ -0,0 +1,53 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "cmd_effect.h"
+#include "../query_ctx.h"
+#include "../effects/effects.h"
+#include "../graph/graphcontext.h"
+
+/* Apply the effects of a write query replicated by the primary,
+ * see EFFECTS_REPLICATION.
+ * GRAPH.EFFECT <graph> <effects> */
+int MGraph_Effect(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+	if(argc != 3) return RedisModule_WrongArity(ctx);
+
+	// Effects are only accepted from the primary or while loading the AOF.
+	int flags = RedisModule_GetContextFlags(ctx);
+	if(!(flags & (REDISMODULE_CTX_FLAGS_REPLICATED | REDISMODULE_CTX_FLAGS_LOADING))) {
+		RedisModule_ReplyWithError(ctx, "GRAPH.EFFECT is only accepted from a primary");
+		return REDISMODULE_OK;
+	}
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[1], false, true); // Increase ref count.
+	// If the GraphContext is null, key access failed and an error has been emitted.
+	if(!gc) goto cleanup;
+	QueryCtx_SetGraphCtx(gc);
+
+	size_t len;
+	const char *effects = RedisModule_StringPtrLen(argv[2], &len);
+
+	Graph_AcquireWriteLock(gc->g);
+	bool applied = Effects_Apply(gc, effects, len);
+	Graph_ReleaseLock(gc->g);
+
+	if(applied) {
+		RedisModule_ReplyWithSimpleString(ctx, "OK");
+		// Propagate effects to sub-replicas and the AOF.
+		RedisModule_ReplicateVerbatim(ctx);
+	} else {
+		// Rejected effects left the graph untouched, they aren't propagated.
+		RedisModule_Log(ctx, "warning", "Failed to apply replicated effects to graph %s",
+						gc->graph_name);
+		RedisModule_ReplyWithError(ctx, "Failed to apply effects");
+	}
+	GraphContext_Release(gc); // Decrease graph ref count.
+
+cleanup:
+	QueryCtx_Free(); // Reset the QueryCtx and free its allocations.
+	return REDISMODULE_OK;
+}
+
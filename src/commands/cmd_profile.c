@@ -82,6 +82,9 @@ void Graph_Profile(void *args) {
 	QueryCtx_ForceUnlockCommit();
 	ExecutionPlan_Print(plan, ctx);
 
+	// Flush pending matrix changes introduced by this query.
+	if(!readonly) Graph_SynchronizeWrites(gc->g);
+
 cleanup:
 	// Release the read-write lock
 	if(lockAcquired) {
@@ -16,7 +16,9 @@
 #include "../util/rmalloc.h"
 #include "../util/cache/cache.h"
 #include "../execution_plan/execution_plan.h"
+#include "../execution_plan/ops/op_node_by_label_scan.h"
 #include "execution_ctx.h"
+#include "query_cursor.h"
 
 static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST *ast,
 							 ExecutionType exec_type) {
@@ -48,6 +50,66 @@ static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST *ast,
 	}
 }
 
+/* Returns true if plan reads the graph exclusively through the graph's API,
+ * which resolves reads to the query's snapshot. Structures maintained next to
+ * the graph track the live graph only, plans reading them hold the read lock.
+ * Op types which aren't listed, including ones yet to be introduced, hold the read lock. */
+static bool _snapshot_plan(const OpBase *op) {
+	switch(op->type) {
+	// Exact-match and range indices track the live graph.
+	case OPType_INDEX_SCAN:
+	// Procedures may query fulltext indices.
+	case OPType_PROC_CALL:
+		return false;
+	// Label columns track the live graph.
+	case OPType_NODE_BY_LABEL_SCAN:
+		if(((const NodeByLabelScan *)op)->filters) return false;
+		break;
+	/* Scans and traversals read matrices and entities through the graph's API,
+	 * node degrees are maintained per snapshot and schemas are replaced rather
+	 * than modified while snapshot readers may use them. */
+	case OPType_ALL_NODE_SCAN:
+	case OPType_NODE_BY_ID_SEEK:
+	case OPType_NODE_BY_LABEL_AND_ID_SCAN:
+	case OPType_EXPAND_INTO:
+	case OPType_CONDITIONAL_TRAVERSE:
+	case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+	case OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO:
+	case OPType_SHORTEST_PATH:
+	case OPType_INTERSECT:
+	// Workers attach the query's snapshot along with its context.
+	case OPType_PARALLEL_AGGREGATE:
+	// Expressions evaluated over records read the graph through its API.
+	case OPType_RESULTS:
+	case OPType_PROJECT:
+	case OPType_AGGREGATE:
+	case OPType_SORT:
+	case OPType_SKIP:
+	case OPType_LIMIT:
+	case OPType_DISTINCT:
+	case OPType_FILTER:
+	case OPType_UNWIND:
+	case OPType_ARGUMENT:
+	case OPType_CARTESIAN_PRODUCT:
+	case OPType_VALUE_HASH_JOIN:
+	case OPType_APPLY:
+	case OPType_JOIN:
+	case OPType_SEMI_APPLY:
+	case OPType_ANTI_SEMI_APPLY:
+	case OPType_OR_APPLY_MULTIPLEXER:
+	case OPType_AND_APPLY_MULTIPLEXER:
+	case OPType_OPTIONAL:
+		break;
+	default:
+		return false;
+	}
+
+	for(int i = 0; i < op->childCount; i++) {
+		if(!_snapshot_plan(op->children[i])) return false;
+	}
+	return true;
+}
+
 inline static bool _readonly_cmd_mode(CommandCtx *ctx) {
 	return strcasecmp(CommandCtx_GetCommandName(ctx), "graph.RO_QUERY") == 0;
 }
@@ -76,7 +138,9 @@ void Query_SetTimeOut(uint timeout, ExecutionPlan *plan) {
 void Graph_Query(void *args) {
   bool readonly           = true;
 	bool lockAcquired       = false;
+	bool snapshot           = false;
 	ResultSet *result_set   = NULL;
+	QueryCursor *cursor     = NULL;
 	CommandCtx *command_ctx = (CommandCtx *)args;
 	RedisModuleCtx *ctx     = CommandCtx_GetRedisCtx(command_ctx);
 	GraphContext *gc        = CommandCtx_GetGraphContext(command_ctx);
@@ -124,12 +188,23 @@ void Graph_Query(void *args) {
 		Query_SetTimeOut(command_ctx->timeout, plan);
 	}
 
+	// A cursor retains the query between reads, without holding the graph lock.
+	if(command_ctx->cursor_count != 0 && !readonly) {
+		ErrorCtx_SetError("Cursors may only be specified on read-only queries");
+		ErrorCtx_EmitException();
+		goto cleanup;
+	}
+
 	bool compact = command_ctx->compact;
 	ResultSetFormatterType resultset_format = (compact) ? FORMATTER_COMPACT : FORMATTER_VERBOSE;
 
-	// Acquire the appropriate lock.
+	// Acquire the appropriate lock, reads may run against a snapshot instead.
 	if(readonly) {
-		Graph_AcquireReadLock(gc->g);
+		if(exec_type == EXECUTION_TYPE_QUERY && Graph_SnapshotReads(gc->g) &&
+		   _snapshot_plan(plan->root)) {
+			snapshot = QueryCtx_PinSnapshot();
+		}
+		if(!snapshot) Graph_AcquireReadLock(gc->g);
 	} else {
 		Graph_WriterEnter(gc->g);  // Single writer.
 		/* If this is a writer query we need to re-open the graph key with write flag
@@ -144,21 +219,35 @@ void Graph_Query(void *args) {
 	lockAcquired = true;
 
 	// Set policy after lock acquisition, avoid resetting policies between readers and writers.
-	Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
+	if(!snapshot) Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
 	result_set = NewResultSet(ctx, resultset_format);
 	// Indicate a cached execution.
 	if(cached) ResultSet_CachedExecution(result_set);
+	// Limit the number of records replied with, following records are read through a cursor.
+	if(command_ctx->cursor_count != 0) ResultSet_SetCapacity(result_set, command_ctx->cursor_count);
 
 	QueryCtx_SetResultSet(result_set);
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
 		ExecutionPlan_PreparePlan(plan);
+		/* Classify the prepared plan once, such that following executions
+		 * of the cached query can be prioritized. */
+		if(ExecutionCtx_GetCachedCost(gc, command_ctx->query) == QUERY_COST_UNKNOWN) {
+			ExecutionCtx_SetCachedCost(exec_ctx, gc, command_ctx->query);
+		}
 		result_set = ExecutionPlan_Execute(plan);
 
 		// Emit error if query timed out.
 		if(ExecutionPlan_Drained(plan)) ErrorCtx_SetError("Query timed out");
 
-		ExecutionPlan_Free(plan);
-		exec_ctx->plan = NULL;
+		if(command_ctx->cursor_count != 0 && ResultSet_Capacity(result_set) == 0 &&
+		   !ErrorCtx_EncounteredError()) {
+			// Execution stopped once the result-set filled up, retain the plan for the cursor.
+			cursor = QueryCursor_New(exec_ctx, command_ctx->cursor_count, resultset_format);
+			ResultSet_SetCursor(result_set, cursor->id);
+		} else {
+			ExecutionPlan_Free(plan);
+			exec_ctx->plan = NULL;
+		}
 	} else if(exec_type == EXECUTION_TYPE_INDEX_CREATE ||
 			  exec_type == EXECUTION_TYPE_INDEX_DROP) {
 		_index_operation(ctx, gc, ast, exec_type);
@@ -168,14 +257,25 @@ void Graph_Query(void *args) {
 	QueryCtx_ForceUnlockCommit();
 	ResultSet_Reply(result_set);    // Send result-set back to client.
 
+	/* Flush pending matrix changes introduced by this query
+	 * while we're still the graph's single writer,
+	 * sparing following readers from synchronizing matrices. */
+	if(!readonly) Graph_SynchronizeWrites(gc->g);
+
 	// Clean up.
 cleanup:
 	// Release the read-write lock
 	if(lockAcquired) {
 		// TODO In the case of a failing writing query, we may hold both locks:
 		// "CREATE (a {num: 1}) MERGE ({v: a.num})"
-		if(readonly) Graph_ReleaseLock(gc->g);
-		else Graph_WriterLeave(gc->g);
+		// A cursor keeps its snapshot pinned until it is freed.
+		if(snapshot) {
+			if(!cursor) QueryCtx_UnpinSnapshot();
+		} else if(readonly) {
+			Graph_ReleaseLock(gc->g);
+		} else {
+			Graph_WriterLeave(gc->g);
+		}
 	}
 
 	// Log query to slowlog.
@@ -183,10 +283,16 @@ cleanup:
 	SlowLog_Add(slowlog, command_ctx->command_name, command_ctx->query,
 				QueryCtx_GetExecutionTime(), NULL);
 
-	ExecutionCtx_Free(exec_ctx);
 	ResultSet_Free(result_set);
+	if(cursor) {
+		// The cursor takes ownership over the execution and query contexts.
+		QueryCursor_Detach(cursor);
+		QueryCursor_Store(cursor);
+	} else {
+		ExecutionCtx_Free(exec_ctx);
+	}
 	GraphContext_Release(gc);
 	CommandCtx_Free(command_ctx);
-	QueryCtx_Free(); // Reset the QueryCtx and free its allocations.
+	if(!cursor) QueryCtx_Free(); // Reset the QueryCtx and free its allocations.
 	ErrorCtx_Clear();
 }
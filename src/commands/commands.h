@@ -8,9 +8,11 @@
 
 #include "cmd_query.h"
 #include "cmd_delete.h"
+#include "cmd_effect.h"
 #include "cmd_config.h"
 #include "cmd_explain.h"
 #include "cmd_profile.h"
+#include "cmd_cursor.h"
 #include "cmd_slowlog.h"
 #include "cmd_dispatcher.h"
 #include "cmd_bulk_insert.h"
@@ -28,6 +30,7 @@ typedef enum {
 	CMD_EXPLAIN        = 5,
 	CMD_PROFILE        = 6,
 	CMD_BULK_INSERT    = 7,
-	CMD_SLOWLOG        = 8
+	CMD_SLOWLOG        = 8,
+	CMD_CURSOR         = 9
 } GRAPH_Commands;
 
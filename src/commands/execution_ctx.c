@@ -8,6 +8,25 @@
 #include "RG.h"
 #include "../query_ctx.h"
 #include "../execution_plan/execution_plan_clone.h"
+#include "../execution_plan/execution_plan_build/execution_plan_modify.h"
+#include "xxhash.h"
+
+// Data sources which only produce the entities they look up.
+#define CHEAP_TAP_COUNT 3
+static const OPType CHEAP_TAPS[] = {OPType_INDEX_SCAN, OPType_NODE_BY_ID_SEEK,
+									OPType_NODE_BY_LABEL_AND_ID_SCAN
+								   };
+
+// Operations which may expand a few entities into a large portion of the graph.
+#define COSTLY_OP_COUNT 2
+static const OPType COSTLY_OPS[] = {OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
+									OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO
+								   };
+
+/* Query cost table entries hold the query hash in their upper bits
+ * and its cost class in the lower bits, 0 marks an empty entry. */
+#define QUERY_COST_BITS 2
+#define QUERY_COST_MASK ((1ULL << QUERY_COST_BITS) - 1)
 
 static ExecutionType _GetExecutionTypeFromAST(AST *ast) {
 	const cypher_astnode_type_t root_type = cypher_astnode_type(ast->root);
@@ -110,6 +129,69 @@ ExecutionCtx *ExecutionCtx_FromQuery(const char *query) {
 	}
 }
 
+// A plan is cheap if its data originates solely from index scans and ID seeks.
+static QueryCost _ExecutionCtx_ClassifyPlan(const ExecutionPlan *plan) {
+	if(ExecutionPlan_LocateOpMatchingType(plan->root, COSTLY_OPS, COSTLY_OP_COUNT)) {
+		return QUERY_COST_HIGH;
+	}
+
+	QueryCost cost = QUERY_COST_LOW;
+	OpBase **taps = ExecutionPlan_LocateTaps(plan);
+	uint tap_count = array_len(taps);
+	for(uint i = 0; i < tap_count && cost == QUERY_COST_LOW; i++) {
+		cost = QUERY_COST_HIGH;
+		for(uint j = 0; j < CHEAP_TAP_COUNT; j++) {
+			if(taps[i]->type == CHEAP_TAPS[j]) {
+				cost = QUERY_COST_LOW;
+				break;
+			}
+		}
+	}
+	array_free(taps);
+	return cost;
+}
+
+static inline uint64_t *_ExecutionCtx_CostEntry(const GraphContext *gc, uint64_t hash) {
+	return gc->query_costs + (hash % QUERY_COST_TABLE_SIZE);
+}
+
+/* Hashes the query stripped of its parameters header, the string execution plans
+ * are cached by, such that executions with different parameters share a cost.
+ * Returns false if the parameters header is invalid. */
+static bool _ExecutionCtx_QueryHash(const char *query, uint64_t *hash) {
+	const char *query_body;
+	cypher_parse_result_t *params_parse_result = parse_query_body(query, &query_body);
+	if(params_parse_result == NULL) return false;
+
+	*hash = XXH64(query_body, strlen(query_body), 0);
+	parse_result_free(params_parse_result);
+	return true;
+}
+
+QueryCost ExecutionCtx_GetCachedCost(const GraphContext *gc, const char *query) {
+	ASSERT(gc != NULL);
+	ASSERT(query != NULL);
+
+	uint64_t hash;
+	if(!_ExecutionCtx_QueryHash(query, &hash)) return QUERY_COST_UNKNOWN;
+	// Entries are written concurrently by query executing threads.
+	uint64_t entry = __atomic_load_n(_ExecutionCtx_CostEntry(gc, hash), __ATOMIC_RELAXED);
+	// Entry might belong to a different query sharing its position.
+	if((entry & ~QUERY_COST_MASK) != (hash & ~QUERY_COST_MASK)) return QUERY_COST_UNKNOWN;
+	return entry & QUERY_COST_MASK;
+}
+
+void ExecutionCtx_SetCachedCost(const ExecutionCtx *ctx, GraphContext *gc, const char *query) {
+	ASSERT(ctx != NULL);
+	ASSERT(ctx->plan != NULL);
+	ASSERT(query != NULL);
+
+	uint64_t hash;
+	if(!_ExecutionCtx_QueryHash(query, &hash)) return;
+	uint64_t entry = (hash & ~QUERY_COST_MASK) | _ExecutionCtx_ClassifyPlan(ctx->plan);
+	__atomic_store_n(_ExecutionCtx_CostEntry(gc, hash), entry, __ATOMIC_RELAXED);
+}
+
 void ExecutionCtx_Free(ExecutionCtx *ctx) {
 	if(ctx == NULL) return;
 	if(ctx->plan != NULL) ExecutionPlan_Free(ctx->plan);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "../ast/ast.h"
+#include "../graph/graphcontext.h"
 #include "../execution_plan/execution_plan.h"
 
 /**
@@ -19,6 +20,18 @@ typedef enum {
 	EXECUTION_TYPE_INDEX_DROP       // Drop index execution.
 } ExecutionType;
 
+// Number of query cost classes recorded per graph.
+#define QUERY_COST_TABLE_SIZE 4096
+
+/**
+ * @brief  Cost class of a query, used to prioritize its execution.
+ */
+typedef enum {
+	QUERY_COST_UNKNOWN,             // Query plan has not been classified yet.
+	QUERY_COST_LOW,                 // Query data originates from index scans and ID seeks.
+	QUERY_COST_HIGH,                // Query data originates from any other source.
+} QueryCost;
+
 /**
  * @brief  A struct for saving execution objects in cache.
  */
@@ -43,6 +56,25 @@ ExecutionCtx *ExecutionCtx_FromQuery(const char *query);
  */
 ExecutionCtx *ExecutionCtx_Clone(ExecutionCtx *ctx);
 
+/**
+ * @brief  Returns the recorded cost class of a query.
+ * @note   Costs are keyed by a hash of the query stripped of its parameters header,
+ *         only the header is parsed.
+ * @param  *gc: Graph context the query is issued against.
+ * @param  *query: String representing the query, including its parameters.
+ * @retval Cost class of the query, QUERY_COST_UNKNOWN if it wasn't classified.
+ */
+QueryCost ExecutionCtx_GetCachedCost(const GraphContext *gc, const char *query);
+
+/**
+ * @brief  Classifies the prepared execution plan of ctx, recording its cost class
+ *         under the hash of query, shared by all of its parameter values.
+ * @param  *ctx: A pointer to ExecutionCTX struct with a prepared execution plan
+ * @param  *gc: Graph context the query is issued against.
+ * @param  *query: String representing the query, including its parameters.
+ */
+void ExecutionCtx_SetCachedCost(const ExecutionCtx *ctx, GraphContext *gc, const char *query);
+
 /**
  * @brief  Free an ExecutionCTX struct and its inner fields.
  * @param  *ctx: ExecutionCTX struct
@@ -0,0 +1,124 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "query_cursor.h"
+#include "RG.h"
+#include "rax.h"
+#include "../util/cron.h"
+#include "../util/rmalloc.h"
+#include "../util/simple_timer.h"
+
+static rax *_cursors = NULL;    // Registered cursors, keyed by cursor ID.
+static uint64_t _last_id = 0;   // Last assigned cursor ID.
+static pthread_mutex_t _cursors_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Frees cursor id if it was not read for CURSOR_IDLE_TIMEOUT milliseconds.
+static void _QueryCursor_Expire(void *pdata) {
+	uint64_t id = (uint64_t)pdata;
+	QueryCursor *cursor = NULL;
+
+	pthread_mutex_lock(&_cursors_lock);
+	{
+		QueryCursor *c = raxFind(_cursors, (unsigned char *)&id, sizeof(id));
+		// Cursor may have been read since this task was scheduled.
+		if(c != raxNotFound && simple_toc(c->last_access) * 1000 >= CURSOR_IDLE_TIMEOUT) {
+			raxRemove(_cursors, (unsigned char *)&id, sizeof(id), NULL);
+			cursor = c;
+		}
+	}
+	pthread_mutex_unlock(&_cursors_lock);
+
+	if(cursor) QueryCursor_Free(cursor);
+}
+
+QueryCursor *QueryCursor_New(ExecutionCtx *exec_ctx, uint64_t count,
+							 ResultSetFormatterType format) {
+	ASSERT(exec_ctx != NULL);
+	ASSERT(count > 0);
+
+	QueryCursor *cursor = rm_malloc(sizeof(QueryCursor));
+	cursor->id = __atomic_add_fetch(&_last_id, 1, __ATOMIC_RELAXED);
+	cursor->count = count;
+	cursor->format = format;
+	cursor->exec_ctx = exec_ctx;
+	cursor->query_ctx = QueryCtx_GetQueryCtx();
+	cursor->gc = QueryCtx_GetGraphCtx();
+	GraphContext_Retain(cursor->gc);
+
+	// Any modification to the graph from this point on invalidates the cursor.
+	cursor->epoch = Graph_GetEpoch(cursor->gc->g);
+
+	// The query string is owned by the command which issued the query, copy it.
+	cursor->query = rm_strdup(cursor->query_ctx->query_data.query);
+	cursor->query_ctx->query_data.query = cursor->query;
+
+	return cursor;
+}
+
+void QueryCursor_Attach(QueryCursor *cursor, CommandCtx *command_ctx) {
+	ASSERT(cursor != NULL);
+	QueryCtx_SetTLS(cursor->query_ctx);
+	QueryCtx_SetGlobalExecutionCtx(command_ctx);
+	// Keep reporting the original query rather than the cursor command arguments.
+	cursor->query_ctx->query_data.query = cursor->query;
+}
+
+void QueryCursor_Detach(QueryCursor *cursor) {
+	ASSERT(cursor != NULL);
+	ASSERT(QueryCtx_GetQueryCtx() == cursor->query_ctx);
+
+	// The Redis context is freed once the replying command completes.
+	cursor->query_ctx->global_exec_ctx.bc = NULL;
+	cursor->query_ctx->global_exec_ctx.redis_ctx = NULL;
+	cursor->query_ctx->global_exec_ctx.command_name = NULL;
+	QueryCtx_SetResultSet(NULL);
+	QueryCtx_RemoveFromTLS();
+}
+
+void QueryCursor_Store(QueryCursor *cursor) {
+	ASSERT(cursor != NULL);
+
+	simple_tic(cursor->last_access);
+	pthread_mutex_lock(&_cursors_lock);
+	{
+		if(_cursors == NULL) _cursors = raxNew();
+		raxInsert(_cursors, (unsigned char *)&cursor->id, sizeof(cursor->id), cursor, NULL);
+	}
+	pthread_mutex_unlock(&_cursors_lock);
+
+	Cron_AddTask(CURSOR_IDLE_TIMEOUT, _QueryCursor_Expire, (void *)cursor->id);
+}
+
+QueryCursor *QueryCursor_Take(uint64_t id) {
+	QueryCursor *cursor = NULL;
+
+	pthread_mutex_lock(&_cursors_lock);
+	{
+		if(_cursors != NULL) {
+			void *c = raxFind(_cursors, (unsigned char *)&id, sizeof(id));
+			if(c != raxNotFound) {
+				raxRemove(_cursors, (unsigned char *)&id, sizeof(id), NULL);
+				cursor = c;
+			}
+		}
+	}
+	pthread_mutex_unlock(&_cursors_lock);
+
+	return cursor;
+}
+
+void QueryCursor_Free(QueryCursor *cursor) {
+	ASSERT(cursor != NULL);
+
+	// Operations may consult the query context while being freed.
+	QueryCtx_SetTLS(cursor->query_ctx);
+	ExecutionCtx_Free(cursor->exec_ctx);
+	QueryCtx_Free();
+
+	GraphContext_Release(cursor->gc);
+	rm_free(cursor->query);
+	rm_free(cursor);
+}
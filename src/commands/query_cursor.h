@@ -0,0 +1,71 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "cmd_context.h"
+#include "execution_ctx.h"
+#include "../query_ctx.h"
+#include "../resultset/formatters/resultset_formatters.h"
+
+// Number of milliseconds an unread cursor is retained.
+#define CURSOR_IDLE_TIMEOUT 300000
+
+/* A cursor holds a read-only query whose execution stopped
+ * once its result-set was full, reading from the cursor resumes
+ * execution as long as the graph was not modified in the meantime. */
+typedef struct {
+	uint64_t id;                    // Cursor ID.
+	uint64_t count;                 // Maximum number of records replied per read.
+	uint64_t epoch;                 // Graph epoch at which execution stopped.
+	char *query;                    // Query string.
+	GraphContext *gc;               // Graph context the query is issued against.
+	QueryCtx *query_ctx;            // Query context of the stopped execution.
+	ExecutionCtx *exec_ctx;         // AST and execution plan of the stopped execution.
+	ResultSetFormatterType format;  // Result-set format.
+	double last_access[2];          // Time at which the cursor was last detached.
+} QueryCursor;
+
+// Create a cursor for the query executing on the calling thread,
+// must be called while holding the graph's read lock.
+QueryCursor *QueryCursor_New
+(
+	ExecutionCtx *exec_ctx,         // Execution context, owned by the cursor.
+	uint64_t count,                 // Maximum number of records replied per read.
+	ResultSetFormatterType format   // Result-set format.
+);
+
+// Attach the cursor's query context to the calling thread,
+// replacing its Redis context with the one of command_ctx.
+void QueryCursor_Attach
+(
+	QueryCursor *cursor,
+	CommandCtx *command_ctx
+);
+
+// Detach the cursor's query context from the calling thread.
+void QueryCursor_Detach
+(
+	QueryCursor *cursor
+);
+
+// Register a detached cursor, making it available for reading.
+void QueryCursor_Store
+(
+	QueryCursor *cursor
+);
+
+// Unregister cursor id, returns NULL if there is no such cursor.
+QueryCursor *QueryCursor_Take
+(
+	uint64_t id
+);
+
+// Free a detached cursor along with its query.
+void QueryCursor_Free
+(
+	QueryCursor *cursor
+);
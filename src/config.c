@@ -23,6 +23,10 @@
 #define OMP_THREAD_COUNT "OMP_THREAD_COUNT" // Config param, max number of OpenMP threads
 #define VKEY_MAX_ENTITY_COUNT "VKEY_MAX_ENTITY_COUNT" // Config param, max number of entities in each virtual key
 #define MAINTAIN_TRANSPOSED_MATRICES "MAINTAIN_TRANSPOSED_MATRICES" // Whether the module should maintain transposed relationship matrices
+#define PARALLEL_THREAD_COUNT "PARALLEL_THREAD_COUNT" // Config param, number of threads used by parallel scans
+#define EFFECTS_REPLICATION "EFFECTS_REPLICATION" // Whether write queries are replicated by their effects
+#define COLUMNAR_STORE "COLUMNAR_STORE" // Whether label scans filter attributes over property columns
+#define SNAPSHOT_READS "SNAPSHOT_READS" // Whether read queries run against pinned snapshots
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -100,6 +104,54 @@ uint Config_OMP_thread_count_get(void) {
 	return config.omp_thread_count;
 }
 
+//------------------------------------------------------------------------------
+// parallel scan thread count
+//------------------------------------------------------------------------------
+
+void Config_parallel_thread_count_set(uint nthreads) {
+	config.parallel_thread_count = nthreads;
+}
+
+uint Config_parallel_thread_count_get(void) {
+	return config.parallel_thread_count;
+}
+
+//------------------------------------------------------------------------------
+// effects replication
+//------------------------------------------------------------------------------
+
+void Config_effects_replication_set(bool replicate_effects) {
+	config.effects_replication = replicate_effects;
+}
+
+bool Config_effects_replication_get(void) {
+	return config.effects_replication;
+}
+
+//------------------------------------------------------------------------------
+// columnar store
+//------------------------------------------------------------------------------
+
+void Config_columnar_store_set(bool columnar_store) {
+	config.columnar_store = columnar_store;
+}
+
+bool Config_columnar_store_get(void) {
+	return config.columnar_store;
+}
+
+//------------------------------------------------------------------------------
+// snapshot reads
+//------------------------------------------------------------------------------
+
+void Config_snapshot_reads_set(bool snapshot_reads) {
+	config.snapshot_reads = snapshot_reads;
+}
+
+bool Config_snapshot_reads_get(void) {
+	return config.snapshot_reads;
+}
+
 //------------------------------------------------------------------------------
 // virtual key entity count
 //------------------------------------------------------------------------------
@@ -178,6 +230,14 @@ bool Config_Contains_field(const char *field_str, Config_Option_Field *field) {
 		f = Config_CACHE_SIZE;
 	} else if(!(strcasecmp(field_str, RESULTSET_SIZE))) {
 		f = Config_RESULTSET_MAX_SIZE;
+	} else if(!(strcasecmp(field_str, PARALLEL_THREAD_COUNT))) {
+		f = Config_PARALLEL_THREAD_COUNT;
+	} else if(!(strcasecmp(field_str, EFFECTS_REPLICATION))) {
+		f = Config_EFFECTS_REPLICATION;
+	} else if(!(strcasecmp(field_str, COLUMNAR_STORE))) {
+		f = Config_COLUMNAR_STORE;
+	} else if(!(strcasecmp(field_str, SNAPSHOT_READS))) {
+		f = Config_SNAPSHOT_READS;
 	} else {
 		return false;
 	}
@@ -218,6 +278,22 @@ const char *Config_Field_name(Config_Option_Field field) {
 			name = ASYNC_DELETE;
 			break;
 
+		case Config_PARALLEL_THREAD_COUNT:
+			name = PARALLEL_THREAD_COUNT;
+			break;
+
+		case Config_EFFECTS_REPLICATION:
+			name = EFFECTS_REPLICATION;
+			break;
+
+		case Config_COLUMNAR_STORE:
+			name = COLUMNAR_STORE;
+			break;
+
+		case Config_SNAPSHOT_READS:
+			name = SNAPSHOT_READS;
+			break;
+
         //----------------------------------------------------------------------
         // invalid option
         //----------------------------------------------------------------------
@@ -265,6 +341,18 @@ void _Config_SetToDefaults(RedisModuleCtx *ctx) {
 
 	// No limit on result-set size
 	config.resultset_size = RESULTSET_SIZE_UNLIMITED;
+
+	// Parallel scans are disabled by default.
+	config.parallel_thread_count = 0;
+
+	// Write queries are replicated verbatim by default.
+	config.effects_replication = false;
+
+	// Label scans read node property sets by default.
+	config.columnar_store = false;
+
+	// Read queries hold the graph's read lock by default.
+	config.snapshot_reads = false;
 }
 
 int Config_Init(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
@@ -405,6 +493,59 @@ bool Config_Option_set(Config_Option_Field field, RedisModuleString *val) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// parallel scan thread count
+		//----------------------------------------------------------------------
+
+		case Config_PARALLEL_THREAD_COUNT:
+			{
+				long long parallel_nthreads;
+				if(!_Config_ParseInteger(val, &parallel_nthreads) ||
+				   parallel_nthreads < 0) return false;
+
+				Config_parallel_thread_count_set(parallel_nthreads);
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// effects replication
+		//----------------------------------------------------------------------
+
+		case Config_EFFECTS_REPLICATION:
+			{
+				bool replicate_effects;
+				if(!_Config_ParseYesNo(val, &replicate_effects)) return false;
+
+				Config_effects_replication_set(replicate_effects);
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// columnar store
+		//----------------------------------------------------------------------
+
+		case Config_COLUMNAR_STORE:
+			{
+				bool columnar_store;
+				if(!_Config_ParseYesNo(val, &columnar_store)) return false;
+
+				Config_columnar_store_set(columnar_store);
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// snapshot reads
+		//----------------------------------------------------------------------
+
+		case Config_SNAPSHOT_READS:
+			{
+				bool snapshot_reads;
+				if(!_Config_ParseYesNo(val, &snapshot_reads)) return false;
+
+				Config_snapshot_reads_set(snapshot_reads);
+			}
+			break;
+
 	    //----------------------------------------------------------------------
 	    // invalid option
 	    //----------------------------------------------------------------------
@@ -531,6 +672,66 @@ bool Config_Option_get(Config_Option_Field field, ...) {
 			}
 			break;
 
+		//----------------------------------------------------------------------
+		// parallel scan thread count
+		//----------------------------------------------------------------------
+
+		case Config_PARALLEL_THREAD_COUNT:
+			{
+				va_start(ap, field);
+				uint *parallel_nthreads = va_arg(ap, uint*);
+				va_end(ap);
+
+				ASSERT(parallel_nthreads != NULL);
+				(*parallel_nthreads) = Config_parallel_thread_count_get();
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// effects replication
+		//----------------------------------------------------------------------
+
+		case Config_EFFECTS_REPLICATION:
+			{
+				va_start(ap, field);
+				bool *replicate_effects = va_arg(ap, bool*);
+				va_end(ap);
+
+				ASSERT(replicate_effects != NULL);
+				(*replicate_effects) = Config_effects_replication_get();
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// columnar store
+		//----------------------------------------------------------------------
+
+		case Config_COLUMNAR_STORE:
+			{
+				va_start(ap, field);
+				bool *columnar_store = va_arg(ap, bool*);
+				va_end(ap);
+
+				ASSERT(columnar_store != NULL);
+				(*columnar_store) = Config_columnar_store_get();
+			}
+			break;
+
+		//----------------------------------------------------------------------
+		// snapshot reads
+		//----------------------------------------------------------------------
+
+		case Config_SNAPSHOT_READS:
+			{
+				va_start(ap, field);
+				bool *snapshot_reads = va_arg(ap, bool*);
+				va_end(ap);
+
+				ASSERT(snapshot_reads != NULL);
+				(*snapshot_reads) = Config_snapshot_reads_get();
+			}
+			break;
+
         //----------------------------------------------------------------------
         // invalid option
         //----------------------------------------------------------------------
@@ -20,7 +20,11 @@ typedef enum {
 	Config_RESULTSET_MAX_SIZE       = 4,  // max number of records in result-set
 	Config_MAINTAIN_TRANSPOSE       = 5,  // maintain transpose matrices
 	Config_VKEY_MAX_ENTITY_COUNT    = 6,  // max number of elements in vkey
-	Config_END_MARKER               = 7
+	Config_PARALLEL_THREAD_COUNT    = 7,  // number of threads for parallel scans
+	Config_EFFECTS_REPLICATION      = 8,  // replicate write queries by their effects
+	Config_COLUMNAR_STORE           = 9,  // filter label scans over property columns
+	Config_SNAPSHOT_READS           = 10, // run read queries against pinned snapshots
+	Config_END_MARKER               = 11
 } Config_Option_Field;
 
 // configuration object
@@ -32,11 +36,16 @@ typedef struct {
 	uint64_t resultset_size;           // resultset maximum size, (-1) unlimited
 	uint64_t vkey_entity_count;        // The limit of number of entities encoded at once for each RDB key.
 	bool maintain_transposed_matrices; // If true, maintain a transposed version of each relationship matrix.
+	uint parallel_thread_count;        // Thread count for intra-query parallel scans, 0 disables.
+	bool effects_replication;          // If true, replicate write queries as a log of their changes.
+	bool columnar_store;               // If true, label scans filter attributes over property columns.
+	bool snapshot_reads;               // If true, read queries run against pinned snapshots of the graph.
 } RG_Config;
 
 // Run-time configurable fields
-#define RUNTIME_CONFIG_COUNT 1
-static const Config_Option_Field RUNTIME_CONFIGS[] = { Config_RESULTSET_MAX_SIZE };
+#define RUNTIME_CONFIG_COUNT 2
+static const Config_Option_Field RUNTIME_CONFIGS[] = { Config_RESULTSET_MAX_SIZE,
+													   Config_EFFECTS_REPLICATION };
 
 // Set module-level configurations to defaults or to user arguments where provided.
 // returns REDISMODULE_OK on success, emits an error and returns REDISMODULE_ERR on failure.
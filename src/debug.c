@@ -10,10 +10,13 @@
 #include <sys/types.h>
 #include "RG.h"
 #include "util/thpool/thpool.h"
+#include "util/arr.h"
 #include "commands/cmd_context.h"
+#include "graph/graphcontext.h"
 
 extern threadpool _thpool;
 extern CommandCtx **command_ctxs;
+extern GraphContext **graphs_in_keyspace;
 
 static struct sigaction old_act;
 
@@ -37,7 +40,26 @@ static void logCommands(void) {
 	}
 }
 
+// Reports execution plan cache usage, summed across graphs.
+static void _InfoPlanCache(RedisModuleInfoCtx *ctx) {
+	CacheStats total = {0};
+	uint graph_count = array_len(graphs_in_keyspace);
+	for(uint i = 0; i < graph_count; i++) {
+		CacheStats stats = Cache_GetStats(GraphContext_GetCache(graphs_in_keyspace[i]));
+		total.hits      += stats.hits;
+		total.misses    += stats.misses;
+		total.evictions += stats.evictions;
+	}
+
+	RedisModule_InfoAddSection(ctx, "plan_cache");
+	RedisModule_InfoAddFieldULongLong(ctx, "hits", total.hits);
+	RedisModule_InfoAddFieldULongLong(ctx, "misses", total.misses);
+	RedisModule_InfoAddFieldULongLong(ctx, "evictions", total.evictions);
+}
+
 void InfoFunc(RedisModuleInfoCtx *ctx, int for_crash_report) {
+	_InfoPlanCache(ctx);
+
 	// make sure information is requested for crash report
 	if(!for_crash_report) return;
 
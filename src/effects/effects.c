@@ -0,0 +1,549 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "effects.h"
+#include "../RG.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/array.h"
+#include "../schema/schema.h"
+#include "../../deps/rax/rax.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Encoding
+//------------------------------------------------------------------------------
+
+static void _WriteBytes(EffectsBuffer *buff, const void *data, size_t n) {
+	if(buff->len + n > buff->cap) {
+		buff->cap *= 2;
+		if(buff->cap < buff->len + n) buff->cap = buff->len + n;
+		buff->buffer = rm_realloc(buff->buffer, buff->cap);
+	}
+	memcpy(buff->buffer + buff->len, data, n);
+	buff->len += n;
+}
+
+static inline void _WriteUnsigned(EffectsBuffer *buff, uint64_t v) {
+	_WriteBytes(buff, &v, sizeof(v));
+}
+
+static inline void _WriteType(EffectsBuffer *buff, uint8_t t) {
+	_WriteBytes(buff, &t, sizeof(t));
+}
+
+static void _WriteString(EffectsBuffer *buff, const char *s) {
+	uint64_t len = (s) ? strlen(s) : 0;
+	_WriteUnsigned(buff, len);
+	if(len > 0) _WriteBytes(buff, s, len);
+}
+
+static void _WriteValue(EffectsBuffer *buff, SIValue v) {
+	/* Format:
+	 * SIType
+	 * Value */
+	_WriteUnsigned(buff, v.type);
+	switch(v.type) {
+	case T_BOOL:
+	case T_INT64:
+		_WriteBytes(buff, &v.longval, sizeof(v.longval));
+		return;
+	case T_DOUBLE:
+		_WriteBytes(buff, &v.doubleval, sizeof(v.doubleval));
+		return;
+	case T_STRING:
+		_WriteString(buff, v.stringval);
+		return;
+	case T_ARRAY: {
+		uint len = SIArray_Length(v);
+		_WriteUnsigned(buff, len);
+		for(uint i = 0; i < len; i++) _WriteValue(buff, SIArray_Get(v, i));
+		return;
+	}
+	case T_NULL:
+		return; // No data beyond the type needs to be encoded for a NULL value.
+	default:
+		// Value can't be encoded, the query must be replicated verbatim.
+		buff->unsupported = true;
+	}
+}
+
+static void _WriteProperties(EffectsBuffer *buff, GraphContext *gc, const Entity *e) {
+	/* Format:
+	 * #properties N
+	 * (name, value) X N */
+	_WriteUnsigned(buff, e->prop_count);
+	for(int i = 0; i < e->prop_count; i++) {
+		EntityProperty *prop = e->properties + i;
+		_WriteString(buff, GraphContext_GetAttributeString(gc, prop->id));
+		_WriteValue(buff, prop->value);
+	}
+}
+
+static const char *_SchemaName(GraphContext *gc, int id, SchemaType t) {
+	if(id == GRAPH_NO_LABEL) return NULL;
+	return Schema_GetName(GraphContext_GetSchemaByID(gc, id, t));
+}
+
+EffectsBuffer *EffectsBuffer_New(void) {
+	EffectsBuffer *buff = rm_calloc(1, sizeof(EffectsBuffer));
+	buff->cap = 256;
+	buff->buffer = rm_malloc(buff->cap);
+	_WriteType(buff, EFFECTS_VERSION);
+	return buff;
+}
+
+void EffectsBuffer_AddCreateNodeEffect(EffectsBuffer *buff, GraphContext *gc, const Node *n) {
+	/* Format:
+	 * node ID
+	 * label, empty for unlabeled nodes
+	 * node properties */
+	ASSERT(buff && gc && n);
+	_WriteType(buff, EFFECT_CREATE_NODE);
+	_WriteUnsigned(buff, ENTITY_GET_ID(n));
+	_WriteString(buff, _SchemaName(gc, n->labelID, SCHEMA_NODE));
+	_WriteProperties(buff, gc, n->entity);
+	buff->effect_count++;
+}
+
+void EffectsBuffer_AddCreateEdgeEffect(EffectsBuffer *buff, GraphContext *gc, const Edge *e) {
+	/* Format:
+	 * edge ID
+	 * source node ID
+	 * destination node ID
+	 * relationship type
+	 * edge properties */
+	ASSERT(buff && gc && e);
+	_WriteType(buff, EFFECT_CREATE_EDGE);
+	_WriteUnsigned(buff, ENTITY_GET_ID(e));
+	_WriteUnsigned(buff, Edge_GetSrcNodeID(e));
+	_WriteUnsigned(buff, Edge_GetDestNodeID(e));
+	_WriteString(buff, _SchemaName(gc, Edge_GetRelationID(e), SCHEMA_EDGE));
+	_WriteProperties(buff, gc, e->entity);
+	buff->effect_count++;
+}
+
+void EffectsBuffer_AddSetPropertyEffect(EffectsBuffer *buff, GraphContext *gc,
+										const GraphEntity *ge, GraphEntityType t, Attribute_ID attr_id, SIValue value) {
+	/* Format:
+	 * entity type
+	 * entity ID
+	 * attribute name
+	 * value */
+	ASSERT(buff && gc && ge);
+	_WriteType(buff, EFFECT_SET_PROPERTY);
+	_WriteType(buff, t);
+	_WriteUnsigned(buff, ENTITY_GET_ID(ge));
+	_WriteString(buff, GraphContext_GetAttributeString(gc, attr_id));
+	_WriteValue(buff, value);
+	buff->effect_count++;
+}
+
+void EffectsBuffer_AddDeleteEffect(EffectsBuffer *buff, GraphContext *gc, const Node *nodes,
+								   uint node_count, const Edge *edges, uint edge_count) {
+	/* Format:
+	 * #nodes N
+	 * node ID X N
+	 * #edges M
+	 * (edge ID, source node ID, destination node ID, relationship type) X M
+	 * Entities are logged in the order they're deleted,
+	 * such that replicas free entity IDs in the same order. */
+	ASSERT(buff && gc);
+	_WriteType(buff, EFFECT_DELETE);
+	_WriteUnsigned(buff, node_count);
+	for(uint i = 0; i < node_count; i++) _WriteUnsigned(buff, ENTITY_GET_ID(nodes + i));
+	_WriteUnsigned(buff, edge_count);
+	for(uint i = 0; i < edge_count; i++) {
+		const Edge *e = edges + i;
+		_WriteUnsigned(buff, ENTITY_GET_ID(e));
+		_WriteUnsigned(buff, Edge_GetSrcNodeID(e));
+		_WriteUnsigned(buff, Edge_GetDestNodeID(e));
+		_WriteString(buff, _SchemaName(gc, Edge_GetRelationID(e), SCHEMA_EDGE));
+	}
+	buff->effect_count++;
+}
+
+bool EffectsBuffer_Replicable(const EffectsBuffer *buff) {
+	return (buff->effect_count > 0 && !buff->unsupported);
+}
+
+void EffectsBuffer_Free(EffectsBuffer *buff) {
+	if(buff == NULL) return;
+	rm_free(buff->buffer);
+	rm_free(buff);
+}
+
+//------------------------------------------------------------------------------
+// Decoding
+//------------------------------------------------------------------------------
+
+typedef struct {
+	const char *pos;    // Current read position.
+	const char *end;    // End of serialized effects.
+	bool error;         // Set once the effects were found to be malformed.
+} EffectsReader;
+
+static void _ReadBytes(EffectsReader *r, void *dest, size_t n) {
+	if(r->error || (size_t)(r->end - r->pos) < n) {
+		r->error = true;
+		memset(dest, 0, n);
+		return;
+	}
+	memcpy(dest, r->pos, n);
+	r->pos += n;
+}
+
+static inline uint64_t _ReadUnsigned(EffectsReader *r) {
+	uint64_t v;
+	_ReadBytes(r, &v, sizeof(v));
+	return v;
+}
+
+static inline uint8_t _ReadType(EffectsReader *r) {
+	uint8_t t;
+	_ReadBytes(r, &t, sizeof(t));
+	return t;
+}
+
+// Returns a heap allocated copy of the next string, NULL if it is empty.
+static char *_ReadString(EffectsReader *r) {
+	uint64_t len = _ReadUnsigned(r);
+	if(len == 0 || r->error) return NULL;
+	if((uint64_t)(r->end - r->pos) < len) {
+		r->error = true;
+		return NULL;
+	}
+	char *s = rm_malloc(len + 1);
+	_ReadBytes(r, s, len);
+	s[len] = '\0';
+	return s;
+}
+
+static SIValue _ReadValue(EffectsReader *r) {
+	SIType t = _ReadUnsigned(r);
+	switch(t) {
+	case T_BOOL:
+	case T_INT64: {
+		int64_t v;
+		_ReadBytes(r, &v, sizeof(v));
+		return (t == T_BOOL) ? SI_BoolVal(v) : SI_LongVal(v);
+	}
+	case T_DOUBLE: {
+		double v;
+		_ReadBytes(r, &v, sizeof(v));
+		return SI_DoubleVal(v);
+	}
+	case T_STRING: {
+		char *s = _ReadString(r);
+		// Transfer ownership of the heap-allocated string to the newly-created SIValue.
+		return (s) ? SI_TransferStringVal(s) : SI_ConstStringVal("");
+	}
+	case T_ARRAY: {
+		uint64_t len = _ReadUnsigned(r);
+		SIValue list = SI_Array(0);
+		for(uint64_t i = 0; i < len && !r->error; i++) {
+			SIValue elem = _ReadValue(r);
+			SIArray_Append(&list, elem);
+			SIValue_Free(elem);
+		}
+		return list;
+	}
+	case T_NULL:
+		return SI_NullVal();
+	default:
+		r->error = true;
+		return SI_NullVal();
+	}
+}
+
+/* Liveness of entities referenced by the effects, tracked while validating,
+ * entities which are not tracked are looked up in the graph. */
+typedef struct {
+	rax *nodes;  // Node ID to liveness.
+	rax *edges;  // Edge ID to liveness.
+} EffectsValidation;
+
+#define ENTITY_LIVE ((void *)1)
+#define ENTITY_DELETED ((void *)2)
+
+// Returns true if id is past every position ever allocated by entities.
+static inline bool _Unused(const DataBlock *entities, EntityID id) {
+	return (id >= entities->itemCount + array_len(entities->deletedIdx));
+}
+
+static bool _NodeLive(const EffectsValidation *v, const Graph *g, NodeID id) {
+	void *state = raxFind(v->nodes, (unsigned char *)&id, sizeof(id));
+	if(state != raxNotFound) return (state == ENTITY_LIVE);
+	if(_Unused(g->nodes, id)) return false;
+	Node n;
+	return Graph_GetNode(g, id, &n);
+}
+
+static bool _EdgeLive(const EffectsValidation *v, const Graph *g, EdgeID id) {
+	void *state = raxFind(v->edges, (unsigned char *)&id, sizeof(id));
+	if(state != raxNotFound) return (state == ENTITY_LIVE);
+	if(_Unused(g->edges, id)) return false;
+	Edge e;
+	return Graph_GetEdge(g, id, &e);
+}
+
+static inline void _SetLiveness(rax *entities, EntityID id, void *state) {
+	raxInsert(entities, (unsigned char *)&id, sizeof(id), state, NULL);
+}
+
+/* Reads a schema name, the schema is created if missing
+ * unless effects are only validated, in which case NULL is returned. */
+static Schema *_ReadSchema(EffectsReader *r, GraphContext *gc, SchemaType t, bool *named,
+						   const EffectsValidation *v) {
+	char *name = _ReadString(r);
+	*named = (name != NULL);
+	if(name == NULL || v) {
+		rm_free(name);
+		return NULL;
+	}
+	Schema *s = GraphContext_GetSchema(gc, name, t);
+	if(s == NULL) s = GraphContext_AddSchema(gc, name, t);
+	rm_free(name);
+	return s;
+}
+
+static void _ReadProperties(EffectsReader *r, GraphContext *gc, GraphEntity *ge,
+							const EffectsValidation *v) {
+	uint64_t prop_count = _ReadUnsigned(r);
+	for(uint64_t i = 0; i < prop_count && !r->error; i++) {
+		char *attr = _ReadString(r);
+		SIValue val = _ReadValue(r);
+		if(attr == NULL) r->error = true;
+		else if(!v && !r->error) GraphEntity_AddProperty(ge, GraphContext_FindOrAddAttribute(gc, attr), val);
+		SIValue_Free(val);
+		rm_free(attr);
+	}
+}
+
+static void _ApplyCreateNode(EffectsReader *r, GraphContext *gc, EffectsValidation *v) {
+	NodeID id = _ReadUnsigned(r);
+	bool labeled;
+	Schema *s = _ReadSchema(r, gc, SCHEMA_NODE, &labeled, v);
+	if(r->error) return;
+
+	if(v) {
+		// Created node must not collide with a live node.
+		if(_NodeLive(v, gc->g, id)) r->error = true;
+		_SetLiveness(v->nodes, id, ENTITY_LIVE);
+		_ReadProperties(r, gc, NULL, v);
+		return;
+	}
+
+	/* Nodes are created at their logged ID, the primary's free list order
+	 * isn't reproduced by replicas, e.g. for edges deleted along with their endpoints. */
+	Node n = GE_NEW_NODE();
+	if(s) n.labelID = s->id;
+	Graph_CreateNodeAt(gc->g, id, n.labelID, &n);
+
+	_ReadProperties(r, gc, (GraphEntity *)&n, v);
+	if(s && Schema_HasIndices(s)) Schema_AddNodeToIndices(s, &n);
+}
+
+static void _ApplyCreateEdge(EffectsReader *r, GraphContext *gc, EffectsValidation *v) {
+	EdgeID id = _ReadUnsigned(r);
+	NodeID src = _ReadUnsigned(r);
+	NodeID dest = _ReadUnsigned(r);
+	bool typed;
+	Schema *s = _ReadSchema(r, gc, SCHEMA_EDGE, &typed, v);
+	if(r->error || !typed) {
+		r->error = true;
+		return;
+	}
+
+	if(v) {
+		// Endpoints must be live, created edge must not collide with a live edge.
+		if(!_NodeLive(v, gc->g, src) || !_NodeLive(v, gc->g, dest) ||
+		   _EdgeLive(v, gc->g, id)) {
+			r->error = true;
+		}
+		_SetLiveness(v->edges, id, ENTITY_LIVE);
+		_ReadProperties(r, gc, NULL, v);
+		return;
+	}
+
+	// Edges are created at their logged ID, same as nodes.
+	Edge e;
+	if(!Graph_ConnectNodesAt(gc->g, id, src, dest, s->id, &e)) {
+		r->error = true;
+		return;
+	}
+
+	_ReadProperties(r, gc, (GraphEntity *)&e, v);
+}
+
+static void _ApplySetProperty(EffectsReader *r, GraphContext *gc, EffectsValidation *v) {
+	GraphEntityType t = _ReadType(r);
+	EntityID id = _ReadUnsigned(r);
+	char *attr = _ReadString(r);
+	SIValue val = _ReadValue(r);
+	if(r->error || attr == NULL) {
+		r->error = true;
+		goto cleanup;
+	}
+
+	if(v) {
+		bool live = (t == GETYPE_NODE) ? _NodeLive(v, gc->g, id) :
+					(t == GETYPE_EDGE) ? _EdgeLive(v, gc->g, id) : false;
+		if(!live) r->error = true;
+		goto cleanup;
+	}
+
+	Node n = GE_NEW_NODE();
+	Edge e;
+	GraphEntity *ge;
+	if(t == GETYPE_NODE && Graph_GetNode(gc->g, id, &n)) {
+		ge = (GraphEntity *)&n;
+	} else if(t == GETYPE_EDGE && Graph_GetEdge(gc->g, id, &e)) {
+		ge = (GraphEntity *)&e;
+	} else {
+		r->error = true;
+		goto cleanup;
+	}
+
+	Attribute_ID attr_id = GraphContext_FindOrAddAttribute(gc, attr);
+	Graph_PrepareEntityWrite(gc->g, t, id);
+	if(GraphEntity_GetProperty(ge, attr_id) == PROPERTY_NOTFOUND) {
+		// Setting a missing attribute to NULL is a no-op.
+		if(SIValue_IsNull(val)) goto cleanup;
+		GraphEntity_AddProperty(ge, attr_id, val);
+	} else {
+		// Setting an attribute to NULL removes it.
+		GraphEntity_SetProperty(ge, attr_id, val);
+	}
+
+	// Reindex node if the updated attribute is indexed.
+	if(t == GETYPE_NODE) {
+		int label_id = Graph_GetNodeLabel(gc->g, id);
+		if(label_id != GRAPH_NO_LABEL) {
+			Schema *s = GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
+			if(GraphContext_GetIndex(gc, Schema_GetName(s), &attr_id, IDX_ANY) ||
+			   Schema_HasColumn(s, attr_id)) {
+				n.labelID = label_id;
+				Schema_AddNodeToIndices(s, &n);
+			}
+		}
+	}
+
+cleanup:
+	SIValue_Free(val);
+	rm_free(attr);
+}
+
+static void _ApplyDelete(EffectsReader *r, GraphContext *gc, EffectsValidation *v) {
+	Graph *g = gc->g;
+	uint64_t node_count = _ReadUnsigned(r);
+	Node *nodes = array_new(Node, 0);
+	for(uint64_t i = 0; i < node_count && !r->error; i++) {
+		Node n = GE_NEW_NODE();
+		NodeID id = _ReadUnsigned(r);
+		if(v) {
+			if(!_NodeLive(v, g, id)) r->error = true;
+			ENTITY_GET_ID(&n) = id;
+		} else if(!Graph_GetNode(g, id, &n)) {
+			r->error = true;
+		}
+		nodes = array_append(nodes, n);
+	}
+
+	uint64_t edge_count = _ReadUnsigned(r);
+	Edge *edges = array_new(Edge, 0);
+	for(uint64_t i = 0; i < edge_count && !r->error; i++) {
+		Edge e = {0};
+		EdgeID id = _ReadUnsigned(r);
+		e.srcNodeID = _ReadUnsigned(r);
+		e.destNodeID = _ReadUnsigned(r);
+		bool typed;
+		Schema *s = _ReadSchema(r, gc, SCHEMA_EDGE, &typed, v);
+		if(r->error || !typed) {
+			r->error = true;
+			break;
+		}
+		if(v) {
+			if(!_EdgeLive(v, g, id)) r->error = true;
+			ENTITY_GET_ID(&e) = id;
+		} else if(!Graph_GetEdge(g, id, &e)) {
+			r->error = true;
+			break;
+		} else {
+			e.relationID = s->id;
+		}
+		edges = array_append(edges, e);
+	}
+
+	if(r->error) goto cleanup;
+
+	if(v) {
+		// Entities are deleted once all of them were found live.
+		for(uint i = 0; i < node_count; i++) _SetLiveness(v->nodes, ENTITY_GET_ID(nodes + i), ENTITY_DELETED);
+		for(uint i = 0; i < edge_count; i++) _SetLiveness(v->edges, ENTITY_GET_ID(edges + i), ENTITY_DELETED);
+		goto cleanup;
+	}
+
+	if(GraphContext_HasIndices(gc)) {
+		for(uint i = 0; i < node_count; i++) GraphContext_DeleteNodeFromIndices(gc, nodes + i);
+	}
+	uint nodes_deleted;
+	uint edges_deleted;
+	Graph_BulkDelete(g, nodes, node_count, edges, edge_count, &nodes_deleted, &edges_deleted);
+
+cleanup:
+	array_free(nodes);
+	array_free(edges);
+}
+
+/* Reads the effects, validating them if v is set, applying them otherwise.
+ * Returns false if the effects are malformed. */
+static bool _ProcessEffects(GraphContext *gc, const char *effects, size_t len,
+							EffectsValidation *v) {
+	EffectsReader r = { .pos = effects, .end = effects + len, .error = false };
+	if(_ReadType(&r) != EFFECTS_VERSION) return false;
+
+	while(r.pos < r.end && !r.error) {
+		EffectType t = _ReadType(&r);
+		switch(t) {
+		case EFFECT_CREATE_NODE:
+			_ApplyCreateNode(&r, gc, v);
+			break;
+		case EFFECT_CREATE_EDGE:
+			_ApplyCreateEdge(&r, gc, v);
+			break;
+		case EFFECT_SET_PROPERTY:
+			_ApplySetProperty(&r, gc, v);
+			break;
+		case EFFECT_DELETE:
+			_ApplyDelete(&r, gc, v);
+			break;
+		default:
+			r.error = true;
+		}
+	}
+
+	return !r.error;
+}
+
+bool Effects_Apply(GraphContext *gc, const char *effects, size_t len) {
+	ASSERT(gc && effects);
+
+	/* Validate the entire log before modifying the graph,
+	 * such that a truncated or mismatched log is rejected as a whole. */
+	EffectsValidation v = { .nodes = raxNew(), .edges = raxNew() };
+	bool valid = _ProcessEffects(gc, effects, len, &v);
+	raxFree(v.nodes);
+	raxFree(v.edges);
+	if(!valid) return false;
+
+	// Node creation may introduce new matrix dimensions.
+	Graph_SetMatrixPolicy(gc->g, RESIZE_TO_CAPACITY);
+	bool applied = _ProcessEffects(gc, effects, len, NULL);
+	Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
+
+	return applied;
+}
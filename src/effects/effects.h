@@ -0,0 +1,69 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../value.h"
+#include "../graph/graphcontext.h"
+#include "../graph/entities/node.h"
+#include "../graph/entities/edge.h"
+
+/* Effects are a compact binary log of the changes a write query introduced to a graph.
+ * When effects replication is enabled the log is replicated in place of the query,
+ * sparing replicas from re-evaluating the query.
+ *
+ * Format:
+ * version
+ * (effect type, effect data) X N
+ *
+ * Labels, relationship types and attributes are referred to by name,
+ * as their internal IDs may differ between primary and replicas.
+ * Entity IDs are the same, as replicas create entities at the IDs logged by the primary. */
+
+#define EFFECTS_VERSION 1
+
+typedef enum {
+	EFFECT_CREATE_NODE = 1,  // Node creation, including its label and properties.
+	EFFECT_CREATE_EDGE = 2,  // Edge creation, including its endpoints and properties.
+	EFFECT_SET_PROPERTY = 3, // Property update, a NULL value removes the property.
+	EFFECT_DELETE = 4,       // Bulk deletion of nodes and edges.
+} EffectType;
+
+typedef struct {
+	char *buffer;        // Serialized effects.
+	size_t len;          // Number of bytes written.
+	size_t cap;          // Buffer capacity.
+	uint effect_count;   // Number of effects written.
+	bool unsupported;    // Set when an effect could not be encoded, e.g. a temporal value.
+} EffectsBuffer;
+
+/* Create a new, empty effects buffer. */
+EffectsBuffer *EffectsBuffer_New(void);
+
+/* Log the creation of node 'n', must be called after its properties have been set. */
+void EffectsBuffer_AddCreateNodeEffect(EffectsBuffer *buff, GraphContext *gc, const Node *n);
+
+/* Log the creation of edge 'e', must be called after its properties have been set. */
+void EffectsBuffer_AddCreateEdgeEffect(EffectsBuffer *buff, GraphContext *gc, const Edge *e);
+
+/* Log setting attribute 'attr_id' of entity 'ge' to 'value'. */
+void EffectsBuffer_AddSetPropertyEffect(EffectsBuffer *buff, GraphContext *gc,
+										const GraphEntity *ge, GraphEntityType t, Attribute_ID attr_id, SIValue value);
+
+/* Log a bulk deletion, must be called before the entities are handed to Graph_BulkDelete. */
+void EffectsBuffer_AddDeleteEffect(EffectsBuffer *buff, GraphContext *gc, const Node *nodes,
+								   uint node_count, const Edge *edges, uint edge_count);
+
+/* Returns true if the buffer holds a complete log of the changes made. */
+bool EffectsBuffer_Replicable(const EffectsBuffer *buff);
+
+/* Free effects buffer. */
+void EffectsBuffer_Free(EffectsBuffer *buff);
+
+/* Apply serialized effects to a write-locked graph.
+ * Returns false if the effects are malformed or do not fit the graph. */
+bool Effects_Apply(GraphContext *gc, const char *effects, size_t len);
+
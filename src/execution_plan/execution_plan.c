@@ -374,6 +374,16 @@ void ExecutionPlan_Init(ExecutionPlan *plan) {
 	_ExecutionPlanInit(plan->root);
 }
 
+static void _ExecutionPlan_Run(ExecutionPlan *plan) {
+	uint count;
+	Record batch[RECORD_BATCH_SIZE];
+	// Execute the root operation and free the processed Records until the data stream is depleted.
+	do {
+		count = OpBase_ConsumeBatch(plan->root, batch, RECORD_BATCH_SIZE);
+		for(uint i = 0; i < count; i++) ExecutionPlan_ReturnRecord(batch[i]->owner, batch[i]);
+	} while(count == RECORD_BATCH_SIZE);
+}
+
 ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 	ASSERT(plan->prepared)
 	/* Set an exception-handling breakpoint to capture run-time errors.
@@ -385,10 +395,20 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 	if(encountered_error) return QueryCtx_GetResultSet();
 
 	ExecutionPlan_Init(plan);
+	_ExecutionPlan_Run(plan);
+
+	return QueryCtx_GetResultSet();
+}
+
+ResultSet *ExecutionPlan_Resume(ExecutionPlan *plan) {
+	ASSERT(plan->prepared)
+	int encountered_error = SET_EXCEPTION_HANDLER();
+
+	// Encountered a run-time error - return immediately.
+	if(encountered_error) return QueryCtx_GetResultSet();
 
-	Record r = NULL;
-	// Execute the root operation and free the processed Record until the data stream is depleted.
-	while((r = OpBase_Consume(plan->root)) != NULL) ExecutionPlan_ReturnRecord(r->owner, r);
+	// Operations are already initialized, pick up where the previous execution stopped.
+	_ExecutionPlan_Run(plan);
 
 	return QueryCtx_GetResultSet();
 }
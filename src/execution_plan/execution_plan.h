@@ -65,6 +65,10 @@ void ExecutionPlan_Init(ExecutionPlan *plan);
 /* Executes plan */
 ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan);
 
+/* Continues executing a plan whose previous execution
+ * stopped once its result-set was full */
+ResultSet *ExecutionPlan_Resume(ExecutionPlan *plan);
+
 /* Checks if execution plan been drained */
 bool ExecutionPlan_Drained(ExecutionPlan *plan);
 
@@ -13,7 +13,26 @@ static void _ExecutionPlan_ProcessQueryGraph(ExecutionPlan *plan, QueryGraph *qg
 
 	// Build the full FilterTree for this AST so that we can order traversals properly.
 	FT_FilterNode *ft = AST_BuildFilterTree(ast);
-	QueryGraph **connectedComponents = QueryGraph_ConnectedComponents(qg);
+
+	/* Shortest path edges are resolved once both of their endpoints are bound,
+	 * exclude them when breaking the pattern into traversal chains. */
+	QueryGraph *traversed_qg = qg;
+	const QGEdge **shortest_edges = array_new(const QGEdge *, 0);
+	uint qg_edge_count = QueryGraph_EdgeCount(qg);
+	for(uint i = 0; i < qg_edge_count; i++) {
+		if(qg->edges[i]->shortest_path) shortest_edges = array_append(shortest_edges, qg->edges[i]);
+	}
+	uint shortest_edge_count = array_len(shortest_edges);
+	if(shortest_edge_count > 0) {
+		traversed_qg = QueryGraph_Clone(qg);
+		for(uint i = 0; i < shortest_edge_count; i++) {
+			QGEdge *e = QueryGraph_GetEdgeByAlias(traversed_qg, shortest_edges[i]->alias);
+			QGEdge_Free(QueryGraph_RemoveEdge(traversed_qg, e));
+		}
+	}
+
+	QueryGraph **connectedComponents = QueryGraph_ConnectedComponents(traversed_qg);
+	if(traversed_qg != qg) QueryGraph_Free(traversed_qg);
 	uint connectedComponentsCount = array_len(connectedComponents);
 	plan->connected_components = connectedComponents;
 	// If we have already constructed any ops, the plan's record map contains all variables bound at this time.
@@ -98,6 +117,15 @@ static void _ExecutionPlan_ProcessQueryGraph(ExecutionPlan *plan, QueryGraph *qg
 			ExecutionPlan_UpdateRoot(plan, root);
 		}
 	}
+
+	// Connect endpoints of shortest paths.
+	for(uint i = 0; i < shortest_edge_count; i++) {
+		QGEdge *e = QueryGraph_GetEdgeByAlias(plan->query_graph, shortest_edges[i]->alias);
+		OpBase *shortest_path = NewShortestPathOp(plan, gc->g, e);
+		ExecutionPlan_UpdateRoot(plan, shortest_path);
+	}
+
+	array_free(shortest_edges);
 	FilterTree_Free(ft);
 }
 
@@ -54,8 +54,8 @@ static OpBase *_CloneOpTree(OpBase *template_parent, OpBase *template_current,
 	return clone_current;
 }
 
-static ExecutionPlan *_ExecutionPlan_Clone(const ExecutionPlan *template) {
-	OpBase *clone_root = _CloneOpTree(NULL, template->root, NULL);
+static ExecutionPlan *_ExecutionPlan_CloneOpTree(OpBase *root) {
+	OpBase *clone_root = _CloneOpTree(NULL, root, NULL);
 	// The "master" execution plan is the one constructed with the root op.
 	ExecutionPlan *clone = (ExecutionPlan *)clone_root->plan;
 	// The root op is currently NULL; set it now.
@@ -73,7 +73,17 @@ ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *template) {
 	AST *master_ast = QueryCtx_GetAST();
 	// Verify that the execution plan template is not prepared yet.
 	ASSERT(template->prepared == false && "Execution plan cloning should be only on templates");
-	ExecutionPlan *clone = _ExecutionPlan_Clone(template);
+	ExecutionPlan *clone = _ExecutionPlan_CloneOpTree(template->root);
+	// Restore the original AST pointer.
+	QueryCtx_SetAST(master_ast);
+	return clone;
+}
+
+ExecutionPlan *ExecutionPlan_CloneOpTree(const OpBase *op) {
+	ASSERT(op != NULL);
+	// Store the original AST pointer.
+	AST *master_ast = QueryCtx_GetAST();
+	ExecutionPlan *clone = _ExecutionPlan_CloneOpTree((OpBase *)op);
 	// Restore the original AST pointer.
 	QueryCtx_SetAST(master_ast);
 	return clone;
@@ -11,3 +11,7 @@
 /* Clones an execution plan */
 ExecutionPlan *ExecutionPlan_Clone(const ExecutionPlan *plan);
 
+
+/* Clones the tree of operations rooted at op into a standalone ExecutionPlan,
+ * op and its descendants must not have been executed yet. */
+ExecutionPlan *ExecutionPlan_CloneOpTree(const OpBase *op);
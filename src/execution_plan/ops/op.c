@@ -34,6 +34,7 @@ void OpBase_Init(OpBase *op, OPType type, const char *name, fpInit init, fpConsu
 	// Function pointers.
 	op->init = init;
 	op->consume = consume;
+	op->consumeBatch = NULL;
 	op->reset = reset;
 	op->toString = toString;
 	op->clone = clone;
@@ -45,6 +46,25 @@ inline Record OpBase_Consume(OpBase *op) {
 	return op->consume(op);
 }
 
+uint OpBase_ConsumeBatch(OpBase *op, Record *batch, uint cap) {
+	ASSERT(cap > 0);
+	/* Profiled operations are consumed record by record
+	 * such that their statistics remain accurate. */
+	if(op->consumeBatch && !op->stats) return op->consumeBatch(op, batch, cap);
+
+	uint count = 0;
+	while(count < cap) {
+		Record r = OpBase_Consume(op);
+		if(!r) break;
+		/* Scalars may refer to data owned by op, which might be
+		 * released by the next call to consume. */
+		Record_PersistScalars(r);
+		batch[count++] = r;
+	}
+
+	return count;
+}
+
 int OpBase_Modifies(OpBase *op, const char *alias) {
 	if(!op->modifies) op->modifies = array_new(const char *, 1);
 	op->modifies = array_append(op->modifies, alias);
@@ -140,6 +160,11 @@ void OpBase_UpdateConsume(OpBase *op, fpConsume consume) {
 	else op->consume = consume;
 }
 
+void OpBase_SetConsumeBatch(OpBase *op, fpConsumeBatch consumeBatch) {
+	ASSERT(op != NULL);
+	op->consumeBatch = consumeBatch;
+}
+
 inline Record OpBase_CreateRecord(const OpBase *op) {
 	return ExecutionPlan_BorrowRecord((struct ExecutionPlan *)op->plan);
 }
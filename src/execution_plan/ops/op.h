@@ -51,6 +51,9 @@ typedef enum {
 	OPType_OR_APPLY_MULTIPLEXER,
 	OPType_AND_APPLY_MULTIPLEXER,
 	OPType_OPTIONAL,
+	OPType_PARALLEL_AGGREGATE,
+	OPType_SHORTEST_PATH,
+	OPType_INTERSECT,
 } OPType;
 
 typedef enum {
@@ -78,12 +81,16 @@ static const OPType FILTER_RECURSE_BLACKLIST[] = {OPType_APPLY, OPType_MERGE};
 #define EAGER_OP_COUNT 5
 static const OPType EAGER_OPERATIONS[] = {OPType_AGGREGATE, OPType_CREATE, OPType_UPDATE, OPType_DELETE, OPType_MERGE};
 
+// Maximum number of records passed between operations at once.
+#define RECORD_BATCH_SIZE 256
+
 struct OpBase;
 struct ExecutionPlan;
 
 typedef void (*fpFree)(struct OpBase *);
 typedef OpResult(*fpInit)(struct OpBase *);
 typedef Record(*fpConsume)(struct OpBase *);
+typedef uint(*fpConsumeBatch)(struct OpBase *, Record *, uint);
 typedef OpResult(*fpReset)(struct OpBase *);
 typedef int (*fpToString)(const struct OpBase *, char *, uint);
 typedef struct OpBase *(*fpClone)(const struct ExecutionPlan *, const struct OpBase *);
@@ -101,6 +108,7 @@ struct OpBase {
 	fpReset reset;              // Reset operation state.
 	fpClone clone;              // Operation clone.
 	fpConsume consume;          // Produce next record.
+	fpConsumeBatch consumeBatch; // Produce a batch of records, NULL if unsupported.
 	fpConsume profile;          // Profiled version of consume.
 	fpToString toString;        // Operation string representation.
 	const char *name;           // Operation name.
@@ -123,6 +131,12 @@ void OpBase_Free(OpBase *op);       // Free op.
 Record OpBase_Consume(OpBase *op);  // Consume op.
 Record OpBase_Profile(OpBase *op);  // Profile op.
 
+/* Consume up to cap records from op into batch, returns the number of records
+ * produced. A batch smaller than cap indicates op is depleted.
+ * Scalars of batched records are access-safe, as records outlive subsequent calls to consume.
+ * Operations which do not implement batch consumption are consumed record by record. */
+uint OpBase_ConsumeBatch(OpBase *op, Record *batch, uint cap);
+
 int OpBase_ToString(const OpBase *op, char *buff, uint buff_len);
 
 OpBase *OpBase_Clone(const struct ExecutionPlan *plan, const OpBase *op);
@@ -148,6 +162,9 @@ bool OpBase_IsWriter(OpBase *op);
 // Update operation consume function.
 void OpBase_UpdateConsume(OpBase *op, fpConsume consume);
 
+// Set operation batch consume function.
+void OpBase_SetConsumeBatch(OpBase *op, fpConsumeBatch consumeBatch);
+
 // Creates a new record that will be populated during execution.
 Record OpBase_CreateRecord(const OpBase *op);
 
@@ -12,6 +12,9 @@
 #include "../../util/rmalloc.h"
 #include "../../grouping/group.h"
 
+// Number of groups to accommodate before resizing the group cache.
+#define GROUP_COUNT_HINT 64
+
 /* Forward declarations. */
 static Record AggregateConsume(OpBase *opBase);
 static OpResult AggregateReset(OpBase *opBase);
@@ -84,54 +87,33 @@ static void _ComputeGroupKey(OpAggregate *op, Record r) {
 	}
 }
 
-static void _ComputeGroupKeyStr(OpAggregate *op, char **key) {
-	if(op->key_count == 0) {
-		*key = rm_strdup("SINGLE_GROUP");
-		return;
-	}
-
-	// Determine required size for group key string representation.
-	size_t key_len = SIValue_StringJoinLen(op->group_keys, op->key_count, ",");
-	*key = rm_malloc(sizeof(char) * key_len);
-	size_t bytesWritten = 0;
-	SIValue_StringJoin(op->group_keys, op->key_count, ",", key, &key_len, &bytesWritten);
-}
-
 /* Retrieves group under which given record belongs to,
  * creates group if one doesn't exists. */
 static Group *_GetGroup(OpAggregate *op, Record r) {
-	char *group_key_str;
 	// Construct group key.
 	_ComputeGroupKey(op, r);
 
-	// First group created.
-	if(!op->group) {
-		op->group = _CreateGroup(op, r);
-		Group_KeyStr(op->group, &group_key_str);
-		CacheGroupAdd(op->groups, group_key_str, op->group);
-		goto cleanup;
-	}
-
 	// Evaluate non-aggregated fields, see if they match
 	// the last accessed group.
-	bool reuseLastAccessedGroup = true;
-	for(uint i = 0; reuseLastAccessedGroup && i < op->key_count; i++) {
-		reuseLastAccessedGroup = (SIValue_Compare(op->group->keys[i], op->group_keys[i], NULL) == 0);
-	}
+	if(op->group) {
+		bool reuseLastAccessedGroup = true;
+		for(uint i = 0; reuseLastAccessedGroup && i < op->key_count; i++) {
+			reuseLastAccessedGroup = (SIValue_Compare(op->group->keys[i], op->group_keys[i], NULL) == 0);
+		}
 
-	// See if we can reuse last accessed group.
-	if(reuseLastAccessedGroup) return op->group;
+		// See if we can reuse last accessed group.
+		if(reuseLastAccessedGroup) return op->group;
+	}
 
-	// Can't reuse last accessed group, lookup group by identifier key.
-	_ComputeGroupKeyStr(op, &group_key_str);
-	op->group = CacheGroupGet(op->groups, group_key_str);
+	// Can't reuse last accessed group, lookup group by key.
+	XXH64_hash_t hash = CacheGroup_KeyHash(op->group_keys, op->key_count);
+	op->group = CacheGroupGet(op->groups, hash, op->group_keys, op->key_count);
 	if(!op->group) {
 		// Group does not exists, create it.
 		op->group = _CreateGroup(op, r);
-		CacheGroupAdd(op->groups, group_key_str, op->group);
+		CacheGroupAdd(op->groups, hash, op->group);
 	}
-cleanup:
-	rm_free(group_key_str);
+
 	return op->group;
 }
 
@@ -152,9 +134,8 @@ static void _aggregateRecord(OpAggregate *op, Record r) {
 
 /* Returns a record populated with group data. */
 static Record _handoff(OpAggregate *op) {
-	char *key;
 	Group *group;
-	if(!CacheGroupIterNext(op->group_iter, &key, &group)) return NULL;
+	if(!CacheGroupIterNext(op->group_iter, &group)) return NULL;
 
 	Record r = OpBase_CreateRecord((OpBase *)op);
 
@@ -185,7 +166,6 @@ OpBase *NewAggregateOp(const ExecutionPlan *plan, AR_ExpNode **exps, bool should
 	op->group = NULL;
 	op->group_iter = NULL;
 	op->group_keys = NULL;
-	op->groups = CacheGroupNew();
 	op->should_cache_records = should_cache_records;
 
 	// Migrate each expression to the keys array or the aggregations array as appropriate.
@@ -195,6 +175,9 @@ OpBase *NewAggregateOp(const ExecutionPlan *plan, AR_ExpNode **exps, bool should
 	// Allocate memory for group keys if we have any non-aggregate expressions.
 	if(op->key_count) op->group_keys = rm_malloc(op->key_count * sizeof(SIValue));
 
+	// Key-less aggregations form a single group.
+	op->groups = CacheGroupNew((op->key_count) ? GROUP_COUNT_HINT : 1);
+
 	OpBase_Init((OpBase *)op, OPType_AGGREGATE, "Aggregate", NULL, AggregateConsume,
 				AggregateReset, NULL, AggregateClone, AggregateFree, false, plan);
 
@@ -227,7 +210,12 @@ static Record AggregateConsume(OpBase *opBase) {
 		_aggregateRecord(op, r);
 	} else {
 		OpBase *child = op->op.children[0];
-		while((r = OpBase_Consume(child))) _aggregateRecord(op, r);
+		Record batch[RECORD_BATCH_SIZE];
+		uint count;
+		do {
+			count = OpBase_ConsumeBatch(child, batch, RECORD_BATCH_SIZE);
+			for(uint i = 0; i < count; i++) _aggregateRecord(op, batch[i]);
+		} while(count == RECORD_BATCH_SIZE);
 	}
 
 	op->group_iter = CacheGroupIter(op->groups);
@@ -237,8 +225,11 @@ static Record AggregateConsume(OpBase *opBase) {
 static OpResult AggregateReset(OpBase *opBase) {
 	OpAggregate *op = (OpAggregate *)opBase;
 
+	/* The number of groups formed by the previous execution
+	 * estimates the number of groups formed by the next. */
+	uint64_t group_count = CacheGroupCount(op->groups);
 	FreeGroupCache(op->groups);
-	op->groups = CacheGroupNew();
+	op->groups = CacheGroupNew(group_count);
 
 	if(op->group_iter) {
 		CacheGroupIterator_Free(op->group_iter);
@@ -24,6 +24,7 @@ OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias) {
 	AllNodeScan *op = rm_malloc(sizeof(AllNodeScan));
 	op->iter = NULL;
 	op->alias = alias;
+	op->id_range = NULL;
 	op->child_record = NULL;
 
 	// Set our Op operations
@@ -34,10 +35,32 @@ OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias) {
 	return (OpBase *)op;
 }
 
+static DataBlockIterator *_ScanNodes(const AllNodeScan *op) {
+	Graph *g = QueryCtx_GetGraph();
+	if(op->id_range == NULL) return Graph_ScanNodes(g);
+
+	NodeID minId = op->id_range->include_min ? op->id_range->min : op->id_range->min + 1;
+	NodeID maxId = op->id_range->max;
+	if(op->id_range->include_max && maxId < UINT64_MAX) maxId++;
+	if(minId > maxId) minId = maxId;
+	return Graph_ScanNodeRange(g, minId, maxId);
+}
+
+void AllNodeScanOp_SetIDRange(AllNodeScan *op, UnsignedRange *id_range) {
+	if(op->id_range) UnsignedRange_Free(op->id_range);
+	op->id_range = UnsignedRange_Clone(id_range);
+
+	// Rebuild an existing iterator to cover the new range.
+	if(op->iter) {
+		DataBlockIterator_Free(op->iter);
+		op->iter = _ScanNodes(op);
+	}
+}
+
 static OpResult AllNodeScanInit(OpBase *opBase) {
 	AllNodeScan *op = (AllNodeScan *)opBase;
 	if(opBase->childCount > 0) OpBase_UpdateConsume(opBase, AllNodeScanConsumeFromChild);
-	else op->iter = Graph_ScanNodes(QueryCtx_GetGraph());
+	else op->iter = _ScanNodes(op);
 	return OP_OK;
 }
 
@@ -48,7 +71,7 @@ static Record AllNodeScanConsumeFromChild(OpBase *opBase) {
 		op->child_record = OpBase_Consume(op->op.children[0]);
 		if(op->child_record == NULL) return NULL;
 		else {
-			if(!op->iter) op->iter = Graph_ScanNodes(QueryCtx_GetGraph());
+			if(!op->iter) op->iter = _ScanNodes(op);
 			else DataBlockIterator_Reset(op->iter);
 		}
 	}
@@ -111,5 +134,10 @@ static void AllNodeScanFree(OpBase *ctx) {
 		OpBase_DeleteRecord(op->child_record);
 		op->child_record = NULL;
 	}
+
+	if(op->id_range) {
+		UnsignedRange_Free(op->id_range);
+		op->id_range = NULL;
+	}
 }
 
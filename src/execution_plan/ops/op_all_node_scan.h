@@ -11,6 +11,7 @@
 #include "../../graph/graph.h"
 #include "../../graph/query_graph.h"
 #include "../../graph/entities/node.h"
+#include "../../util/range/unsigned_range.h"
 #include "../../util/datablock/datablock_iterator.h"
 
 /* AllNodesScan
@@ -20,8 +21,12 @@ typedef struct {
 	const char *alias;          /* Alias of the node being scanned by this op. */
 	uint nodeRecIdx;
 	DataBlockIterator *iter;
+	UnsignedRange *id_range;    /* ID range to iterate over, NULL scans all nodes. */
 	Record child_record;        /* The Record this op acts on if it is not a tap. */
 } AllNodeScan;
 
 OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias);
 
+/* Restrict the scan to nodes whose ID is within id_range. */
+void AllNodeScanOp_SetIDRange(AllNodeScan *op, UnsignedRange *id_range);
+
@@ -18,6 +18,11 @@ OpBase *NewCartesianProductOp(const ExecutionPlan *plan) {
 	CartesianProduct *op = rm_malloc(sizeof(CartesianProduct));
 	op->init = true;
 	op->r = NULL;
+	op->depleted = false;
+	op->block = array_new(Record, 1);
+	op->block_idx = 0;
+	op->filling = false;
+	op->first_depleted = false;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_CARTESIAN_PRODUCT, "Cartesian Product", CartesianProductInit,
@@ -26,42 +31,64 @@ OpBase *NewCartesianProductOp(const ExecutionPlan *plan) {
 	return (OpBase *)op;
 }
 
+static void _ClearBlock(CartesianProduct *op) {
+	uint count = array_len(op->block);
+	for(uint i = 0; i < count; i++) OpBase_DeleteRecord(op->block[i]);
+	array_clear(op->block);
+	op->block_idx = 0;
+}
+
 static void _ResetStreams(CartesianProduct *cp, int streamIdx) {
-	// Reset each child stream, Reset propagates upwards.
-	for(int i = 0; i < streamIdx; i++) OpBase_PropagateReset(cp->op.children[i]);
+	// Reset each child stream [1, streamIdx), Reset propagates upwards.
+	for(int i = 1; i < streamIdx; i++) OpBase_PropagateReset(cp->op.children[i]);
 }
 
-static int _PullFromStreams(CartesianProduct *op) {
+// Pull a record from stream, returns false if stream is depleted.
+static bool _PullFromStream(CartesianProduct *op, int streamIdx) {
+	OpBase *child = op->op.children[streamIdx];
+	Record childRecord = OpBase_Consume(child);
+	if(!childRecord) return false;
+
+	Record_TransferEntries(&op->r, childRecord);
+	OpBase_DeleteRecord(childRecord);
+	return true;
+}
+
+// Pull the first combination of streams [1, childCount).
+static bool _FirstCombination(CartesianProduct *op) {
 	for(int i = 1; i < op->op.childCount; i++) {
-		OpBase *child = op->op.children[i];
-		Record childRecord = OpBase_Consume(child);
+		if(!_PullFromStream(op, i)) return false;
+	}
+	return true;
+}
 
-		if(childRecord) {
-			Record_TransferEntries(&op->r, childRecord);
-			OpBase_DeleteRecord(childRecord);
+// Advance to the next combination of streams [1, childCount).
+static bool _NextCombination(CartesianProduct *op) {
+	for(int i = 1; i < op->op.childCount; i++) {
+		if(_PullFromStream(op, i)) {
 			/* Managed to get new data
-			 * Reset streams [0-i] */
+			 * Reset streams [1-i] and pull from them. */
 			_ResetStreams(op, i);
-
-			// Pull from resetted streams.
-			for(int j = 0; j < i; j++) {
-				child = op->op.children[j];
-				childRecord = OpBase_Consume(child);
-				if(childRecord) {
-					Record_TransferEntries(&op->r, childRecord);
-					OpBase_DeleteRecord(childRecord);
-				} else {
-					return 0;
-				}
+			for(int j = 1; j < i; j++) {
+				if(!_PullFromStream(op, j)) return false;
 			}
 			// Ready to continue.
-			return 1;
+			return true;
 		}
 	}
 
 	/* If we're here, then we didn't manged to get new data.
 	 * Last stream depleted. */
-	return 0;
+	return false;
+}
+
+// Combine the current combination with block record at idx.
+static Record _Emit(CartesianProduct *op, uint idx) {
+	Record_ShareEntries(op->r, op->block[idx]);
+	Record r = OpBase_CloneRecord(op->r);
+	// Emitted records may outlive the block they were combined with.
+	Record_PersistScalars(r);
+	return r;
 }
 
 static OpResult CartesianProductInit(OpBase *opBase) {
@@ -72,43 +99,61 @@ static OpResult CartesianProductInit(OpBase *opBase) {
 
 static Record CartesianProductConsume(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
-	OpBase *child;
-	Record childRecord;
+	OpBase *first = op->op.children[0];
+
+	if(op->depleted) return NULL;
 
 	if(op->init) {
 		op->init = false;
+		if(!_FirstCombination(op)) goto depleted;
+		op->filling = true;
+	}
+
+	while(true) {
+		// Combine the next block record with the current combination.
+		if(op->block_idx < array_len(op->block)) return _Emit(op, op->block_idx++);
+
+		// Extend block while it is combined with the first combination.
+		if(op->filling) {
+			if(array_len(op->block) < CARTESIAN_PRODUCT_BLOCK_SIZE) {
+				Record childRecord = OpBase_Consume(first);
+				if(childRecord) {
+					op->block = array_append(op->block, childRecord);
+					return _Emit(op, op->block_idx++);
+				}
+				op->first_depleted = true;
+			}
+			op->filling = false;
+			if(array_len(op->block) == 0) goto depleted;
+		}
 
-		for(int i = 0; i < op->op.childCount; i++) {
-			child = op->op.children[i];
-			childRecord = OpBase_Consume(child);
-			if(!childRecord) return NULL;
-			Record_TransferEntries(&op->r, childRecord);
-			OpBase_DeleteRecord(childRecord);
+		// Block is exhausted, combine it with the next combination.
+		if(_NextCombination(op)) {
+			op->block_idx = 0;
+			continue;
 		}
-		return OpBase_CloneRecord(op->r);
-	}
 
-	// Pull from first stream.
-	child = op->op.children[0];
-	childRecord = OpBase_Consume(child);
-
-	if(childRecord) {
-		// Managed to get data from first stream.
-		Record_TransferEntries(&op->r, childRecord);
-		OpBase_DeleteRecord(childRecord);
-	} else {
-		// Failed to get data from first stream,
-		// try pulling other streams for data.
-		if(!_PullFromStreams(op)) return NULL;
+		// Combinations are exhausted, start over with the next block.
+		if(op->first_depleted) goto depleted;
+		_ClearBlock(op);
+		_ResetStreams(op, op->op.childCount);
+		if(!_FirstCombination(op)) goto depleted;
+		op->filling = true;
 	}
 
-	// Pass down a clone of record.
-	return OpBase_CloneRecord(op->r);
+depleted:
+	op->depleted = true;
+	_ClearBlock(op);
+	return NULL;
 }
 
 static OpResult CartesianProductReset(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
 	op->init = true;
+	op->depleted = false;
+	op->filling = false;
+	op->first_depleted = false;
+	_ClearBlock(op);
 	return OP_OK;
 }
 
@@ -119,9 +164,14 @@ static OpBase *CartesianProductClone(const ExecutionPlan *plan, const OpBase *op
 
 static void CartesianProductFree(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
+	if(op->block) {
+		_ClearBlock(op);
+		array_free(op->block);
+		op->block = NULL;
+	}
+
 	if(op->r) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
 }
-
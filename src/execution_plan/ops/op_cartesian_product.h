@@ -9,11 +9,23 @@
 #include "op.h"
 #include "../execution_plan.h"
 
-/* Cartesian product AKA Join. */
+// Maximum number of records of the first stream held in memory at once.
+#define CARTESIAN_PRODUCT_BLOCK_SIZE 16384
+
+/* Cartesian product AKA Join.
+ * Block nested loop: records of the first stream are held in bounded blocks,
+ * each block is combined with every combination of the remaining streams,
+ * which are therefore scanned once per block rather than once per record.
+ * A block is filled lazily while it is combined with the first combination. */
 typedef struct {
 	OpBase op;
 	Record r;
 	bool init;
+	bool depleted;           // All combinations have been produced.
+	Record *block;           // Current block of first stream records.
+	uint block_idx;          // Position of the next block record to combine.
+	bool filling;            // Block is being filled from the first stream.
+	bool first_depleted;     // First stream is depleted.
 } CartesianProduct;
 
 OpBase *NewCartesianProductOp(const ExecutionPlan *plan);
@@ -6,6 +6,7 @@
 
 #include "op_cond_var_len_traverse.h"
 #include "shared/print_functions.h"
+#include "shared/traverse_functions.h"
 #include "../../util/arr.h"
 #include "../../ast/ast.h"
 #include "../../arithmetic/arithmetic_expression.h"
@@ -13,6 +14,9 @@
 #include "../../algorithms/all_paths.h"
 #include "../../query_ctx.h"
 
+// number of records traversed together when pruning
+#define PRUNE_BATCH_SIZE 64
+
 /* Forward declarations. */
 static Record CondVarLenTraverseConsume(OpBase *opBase);
 static OpResult CondVarLenTraverseReset(OpBase *opBase);
@@ -25,29 +29,8 @@ static void _setupTraversedRelations(CondVarLenTraverse *op) {
 	op->minHops = e->minHops;
 	op->maxHops = e->maxHops;
 
-	uint reltype_count = array_len(e->reltypeIDs);
-	if(reltype_count == 0) {
-		op->edgeRelationCount = 1;
-		op->edgeRelationTypes = array_new(int, 1);
-		op->edgeRelationTypes = array_append(op->edgeRelationTypes, GRAPH_NO_RELATION);
-	} else {
-		GraphContext *gc = QueryCtx_GetGraphCtx();
-		op->edgeRelationCount = 0;
-		op->edgeRelationTypes = array_new(int, reltype_count);
-
-		for(int i = 0; i < reltype_count; i++) {
-			int rel_id = e->reltypeIDs[i];
-			if(rel_id != GRAPH_UNKNOWN_RELATION) {
-				op->edgeRelationTypes = array_append(op->edgeRelationTypes, rel_id);
-			} else {
-				const char *rel_type = e->reltypes[i];
-				Schema *s = GraphContext_GetSchema(gc, rel_type, SCHEMA_EDGE);
-				if(s) op->edgeRelationTypes = array_append(op->edgeRelationTypes, s->id);
-			}
-		}
-
-		op->edgeRelationCount = array_len(op->edgeRelationTypes);
-	}
+	op->edgeRelationTypes = Traverse_RelationTypes(e);
+	op->edgeRelationCount = array_len(op->edgeRelationTypes);
 }
 
 // Set the traversal direction to match the traversed edge and AlgebraicExpression form.
@@ -75,7 +58,149 @@ void CondVarLenTraverseOp_ExpandInto(CondVarLenTraverse *op) {
 	array_clear(op->op.modifies);
 	op->expandInto = true;
 	op->op.type = OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO;
-	op->op.name = "Conditional Variable Length Traverse (Expand Into)";
+	op->op.name = op->prune ? "Conditional Variable Length Traverse (Expand Into, Pruned)" :
+				  "Conditional Variable Length Traverse (Expand Into)";
+}
+
+void CondVarLenTraverseOp_Prune(CondVarLenTraverse *op) {
+	ASSERT(op->edgesIdx == -1);
+	op->prune = true;
+	if(op->records == NULL) op->records = rm_malloc(PRUNE_BATCH_SIZE * sizeof(Record));
+	op->op.name = op->expandInto ? "Conditional Variable Length Traverse (Expand Into, Pruned)" :
+				  "Conditional Variable Length Traverse (Pruned)";
+}
+
+static inline GrB_Matrix _relationMatrix(Graph *g, int relation) {
+	if(relation == GRAPH_NO_RELATION) return Graph_GetAdjacencyMatrix(g);
+	return Graph_GetRelationMatrix(g, relation);
+}
+
+/* Computes the nodes reachable from each record in the batch
+ * within op->maxHops hops, one level at a time:
+ * N<!V> = F * M, V += N, F = N
+ * The visited mask guarantees each node is expanded at most once per record. */
+static void _prunedTraverse(CondVarLenTraverse *op) {
+	GrB_Info info;
+	UNUSED(info);
+
+	// Matrices must agree with the dimensions of the traversed relation matrices.
+	GrB_Index n = Graph_RequiredMatrixDim(op->g);
+	if(op->edgeRelationCount > 0) {
+		GrB_Matrix_nrows(&n, _relationMatrix(op->g, op->edgeRelationTypes[0]));
+	}
+
+	if(op->F == GrB_NULL) {
+		GrB_Matrix_new(&op->F, GrB_BOOL, PRUNE_BATCH_SIZE, n);
+		GrB_Matrix_new(&op->V, GrB_BOOL, PRUNE_BATCH_SIZE, n);
+		GrB_Matrix_new(&op->N, GrB_BOOL, PRUNE_BATCH_SIZE, n);
+	} else {
+		GrB_Index ncols;
+		GrB_Matrix_ncols(&ncols, op->F);
+		if(ncols != n) {
+			GxB_Matrix_resize(op->F, PRUNE_BATCH_SIZE, n);
+			GxB_Matrix_resize(op->V, PRUNE_BATCH_SIZE, n);
+			GxB_Matrix_resize(op->N, PRUNE_BATCH_SIZE, n);
+		}
+		GrB_Matrix_clear(op->F);
+		GrB_Matrix_clear(op->V);
+	}
+
+	// F[i, srcId] = true.
+	for(uint i = 0; i < op->record_count; i++) {
+		Node *src = Record_GetNode(op->records[i], op->srcNodeIdx);
+		GrB_Matrix_setElement_BOOL(op->F, true, i, ENTITY_GET_ID(src));
+	}
+
+	/* A source node reaches itself by a path of length 0,
+	 * otherwise it is reported only if it is reached again. */
+	if(op->minHops == 0) {
+		info = GrB_Matrix_apply(op->V, GrB_NULL, GrB_NULL, GrB_IDENTITY_BOOL, op->F, GrB_NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	for(uint depth = 0; depth < op->maxHops; depth++) {
+		GrB_Matrix_clear(op->N);
+		for(int i = 0; i < op->edgeRelationCount; i++) {
+			GrB_Matrix M = _relationMatrix(op->g, op->edgeRelationTypes[i]);
+			if(op->traverseDir != GRAPH_EDGE_DIR_INCOMING) {
+				info = GrB_mxm(op->N, op->V, GrB_LOR, GxB_ANY_PAIR_BOOL, op->F, M, GrB_DESC_SC);
+				ASSERT(info == GrB_SUCCESS);
+			}
+			if(op->traverseDir != GRAPH_EDGE_DIR_OUTGOING) {
+				info = GrB_mxm(op->N, op->V, GrB_LOR, GxB_ANY_PAIR_BOOL, op->F, M, GrB_DESC_SCT1);
+				ASSERT(info == GrB_SUCCESS);
+			}
+		}
+
+		GrB_Index reached;
+		GrB_Matrix_nvals(&reached, op->N);
+		if(reached == 0) break;
+
+		// V += N
+		info = GrB_eWiseAdd_Matrix_BinaryOp(op->V, GrB_NULL, GrB_NULL, GrB_LOR, op->V, op->N, GrB_NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// Newly reached nodes form the next frontier.
+		GrB_Matrix tmp = op->F;
+		op->F = op->N;
+		op->N = tmp;
+	}
+
+	if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, op->V);
+	else GxB_MatrixTupleIter_reuse(op->iter, op->V);
+}
+
+static Record _prunedConsume(CondVarLenTraverse *op) {
+	OpBase *child = op->op.children[0];
+	GrB_Index row;
+	GrB_Index col;
+	bool depleted = true;
+
+	while(true) {
+		if(op->iter) GxB_MatrixTupleIter_next(op->iter, &row, &col, &depleted);
+
+		if(!depleted) {
+			Record r = op->records[row];
+			if(op->expandInto) {
+				// Emit the record only if its destination was reached.
+				Node *destNode = Record_GetNode(r, op->destNodeIdx);
+				if(destNode == NULL || ENTITY_GET_ID(destNode) != col) continue;
+			} else {
+				Node destNode = GE_NEW_NODE();
+				Graph_GetNode(op->g, col, &destNode);
+				Record_AddNode(r, op->destNodeIdx, destNode);
+			}
+			return OpBase_CloneRecord(r);
+		}
+
+		// Run out of tuples, free old records and try to get new data.
+		for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
+		op->record_count = 0;
+
+		uint received = OpBase_ConsumeBatch(child, op->records, PRUNE_BATCH_SIZE);
+		if(received == 0) return NULL;
+
+		for(uint i = 0; i < received; i++) {
+			Record childRecord = op->records[i];
+			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
+				/* The child Record may not contain the source node in scenarios like
+				 * a failed OPTIONAL MATCH. In this case, delete the Record. */
+				OpBase_DeleteRecord(childRecord);
+				continue;
+			}
+			Record_PersistScalars(childRecord);
+			op->records[op->record_count++] = childRecord;
+		}
+		if(op->record_count == 0) continue;
+
+		// Create edge relation type array on first traversal.
+		if(!op->edgeRelationTypes) {
+			_setupTraversedRelations(op);
+			if(op->edgeRelationCount == 0 && op->minHops > 0) return NULL;
+		}
+
+		_prunedTraverse(op);
+	}
 }
 
 OpBase *NewCondVarLenTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpression *ae) {
@@ -89,6 +214,13 @@ OpBase *NewCondVarLenTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicEx
 	op->expandInto = false;
 	op->allPathsCtx = NULL;
 	op->edgeRelationTypes = NULL;
+	op->prune = false;
+	op->F = GrB_NULL;
+	op->V = GrB_NULL;
+	op->N = GrB_NULL;
+	op->iter = NULL;
+	op->records = NULL;
+	op->record_count = 0;
 
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
 				"Conditional Variable Length Traverse", NULL, CondVarLenTraverseConsume, CondVarLenTraverseReset,
@@ -113,6 +245,8 @@ static Record CondVarLenTraverseConsume(OpBase *opBase) {
 	bool reused_record = true;
 	Path *p = NULL;
 
+	if(op->prune) return _prunedConsume(op);
+
 	while(!(p = AllPathsCtx_NextPath(op->allPathsCtx))) {
 		reused_record = false;
 		Record childRecord = OpBase_Consume(child);
@@ -171,14 +305,24 @@ static OpResult CondVarLenTraverseReset(OpBase *ctx) {
 	}
 	AllPathsCtx_Free(op->allPathsCtx);
 	op->allPathsCtx = NULL;
+
+	for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
+	op->record_count = 0;
+	if(op->iter) {
+		GxB_MatrixTupleIter_free(op->iter);
+		op->iter = NULL;
+	}
 	return OP_OK;
 }
 
 static OpBase *CondVarLenTraverseClone(const ExecutionPlan *plan, const OpBase *opBase) {
-	ASSERT(opBase->type == OPType_CONDITIONAL_VAR_LEN_TRAVERSE);
+	ASSERT(opBase->type == OPType_CONDITIONAL_VAR_LEN_TRAVERSE ||
+		   opBase->type == OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO);
 	CondVarLenTraverse *op = (CondVarLenTraverse *) opBase;
 	OpBase *op_clone = NewCondVarLenTraverseOp(plan, QueryCtx_GetGraph(),
 											   AlgebraicExpression_Clone(op->ae));
+	if(op->prune) CondVarLenTraverseOp_Prune((CondVarLenTraverse *)op_clone);
+	if(op->expandInto) CondVarLenTraverseOp_ExpandInto((CondVarLenTraverse *)op_clone);
 	return op_clone;
 }
 
@@ -204,5 +348,31 @@ static void CondVarLenTraverseFree(OpBase *ctx) {
 		AllPathsCtx_Free(op->allPathsCtx);
 		op->allPathsCtx = NULL;
 	}
+
+	if(op->iter) {
+		GxB_MatrixTupleIter_free(op->iter);
+		op->iter = NULL;
+	}
+
+	if(op->F != GrB_NULL) {
+		GrB_Matrix_free(&op->F);
+		op->F = GrB_NULL;
+	}
+
+	if(op->V != GrB_NULL) {
+		GrB_Matrix_free(&op->V);
+		op->V = GrB_NULL;
+	}
+
+	if(op->N != GrB_NULL) {
+		GrB_Matrix_free(&op->N);
+		op->N = GrB_NULL;
+	}
+
+	if(op->records) {
+		for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
+		rm_free(op->records);
+		op->records = NULL;
+	}
 }
 
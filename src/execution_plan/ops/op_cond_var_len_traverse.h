@@ -28,6 +28,13 @@ typedef struct {
 	int *edgeRelationTypes;         /* Relation(s) we're traversing. */
 	AllPathsCtx *allPathsCtx;
 	GRAPH_EDGE_DIR traverseDir;     /* Traverse direction. */
+	bool prune;                     /* Emit each reachable destination once per source. */
+	GrB_Matrix F;                   /* Frontier, row i holds the frontier of the i-th record. */
+	GrB_Matrix V;                   /* Visited, row i holds nodes reached from the i-th record. */
+	GrB_Matrix N;                   /* Next frontier. */
+	GxB_MatrixTupleIter *iter;      /* Iterator over V. */
+	Record *records;                /* Batch of records being traversed. */
+	uint record_count;              /* Number of records in batch. */
 } CondVarLenTraverse;
 
 OpBase *NewCondVarLenTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpression *ae);
@@ -36,3 +43,10 @@ OpBase *NewCondVarLenTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicEx
  * to Expand Into Conditional Variable Length Traverse */
 void CondVarLenTraverseOp_ExpandInto(CondVarLenTraverse *op);
 
+/* Transform operation to produce every reachable destination only once
+ * per source record, rather than once per path.
+ * Reachability is computed level by level over a batch of source records,
+ * never revisiting a node. Only valid when paths are not projected and
+ * minimal path length is either 0 or 1, or 0 for bidirectional traversals. */
+void CondVarLenTraverseOp_Prune(CondVarLenTraverse *op);
+
@@ -9,18 +9,61 @@
 #include "shared/print_functions.h"
 #include "../../query_ctx.h"
 
-// default number of records to accumulate before traversing
+// initial number of records to accumulate before traversing
 #define BATCH_SIZE 16
+// upper bound on the number of records accumulated before traversing
+#define MAX_BATCH_SIZE 4096
 
 /* Forward declarations. */
 static OpResult CondTraverseInit(OpBase *opBase);
 static Record CondTraverseConsume(OpBase *opBase);
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult CondTraverseReset(OpBase *opBase);
 static OpBase *CondTraverseClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void CondTraverseFree(OpBase *opBase);
 
 static int CondTraverseToString(const OpBase *ctx, char *buf, uint buf_len) {
-	return TraversalToString(ctx, buf, buf_len, ((const OpCondTraverse *)ctx)->ae);
+	const OpCondTraverse *op = (const OpCondTraverse *)ctx;
+	int offset = TraversalToString(ctx, buf, buf_len, op->ae);
+	if(ctx->stats && op->row_scans > 0) {
+		offset += snprintf(buf + offset, buf_len - offset, " | Row scans: %u", op->row_scans);
+	}
+	return offset;
+}
+
+// (re)allocate batch buffers to hold op->batch_size records
+static void _allocate_batch(OpCondTraverse *op, uint prev_size) {
+	uint n = op->batch_size;
+	op->records = rm_realloc(op->records, n * sizeof(Record));
+	op->F_rows = rm_realloc(op->F_rows, n * sizeof(GrB_Index));
+	op->F_cols = rm_realloc(op->F_cols, n * sizeof(GrB_Index));
+	op->F_vals = rm_realloc(op->F_vals, n * sizeof(bool));
+
+	// row i of F always holds the i-th record's source node
+	for(uint i = prev_size; i < n; i++) {
+		op->records[i] = NULL;
+		op->F_rows[i] = i;
+		op->F_vals[i] = true;
+	}
+}
+
+/* Double the batch size, bounded by record_cap.
+ * Called once a batch was filled entirely, as long as the child keeps
+ * producing records larger batches amortize per-traversal overhead. */
+static void _grow_batch(OpCondTraverse *op) {
+	uint prev_size = op->batch_size;
+	op->batch_size = MIN(op->batch_size * 2, op->record_cap);
+	if(op->batch_size == prev_size) return;
+
+	_allocate_batch(op, prev_size);
+
+	if(op->F != GrB_NULL) {
+		// F is referenced by the algebraic expression, resize in place.
+		GrB_Index ncols;
+		GrB_Matrix_ncols(&ncols, op->F);
+		GxB_Matrix_resize(op->F, op->batch_size, ncols);
+		GxB_Matrix_resize(op->M, op->batch_size, ncols);
+	}
 }
 
 static void _populate_filter_matrix(OpCondTraverse *op) {
@@ -29,9 +72,34 @@ static void _populate_filter_matrix(OpCondTraverse *op) {
 		/* Update filter matrix F, set row i at position srcId
 		 * F[i, srcId] = true. */
 		Node *n = Record_GetNode(r, op->srcNodeIdx);
-		NodeID srcId = ENTITY_GET_ID(n);
-		GrB_Matrix_setElement_BOOL(op->F, true, i, srcId);
+		op->F_cols[i] = ENTITY_GET_ID(n);
 	}
+
+	// Rows are sorted and unique, build F in a single call.
+	GrB_Info info = GrB_Matrix_build_BOOL(op->F, op->F_rows, op->F_cols,
+										  op->F_vals, op->record_count, GrB_FIRST_BOOL);
+	UNUSED(info);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+/* Returns the operand B if the expression is of the form F * B,
+ * in which case F * B for a single record is simply row srcId of B.
+ * Returns GrB_NULL otherwise. */
+static GrB_Matrix _single_operand(const AlgebraicExpression *ae, GrB_Matrix F) {
+	if(ae->type != AL_OPERATION || ae->operation.op != AL_EXP_MUL) return GrB_NULL;
+	if(AlgebraicExpression_ChildCount(ae) != 2) return GrB_NULL;
+
+	const AlgebraicExpression *left = ae->operation.children[0];
+	const AlgebraicExpression *right = ae->operation.children[1];
+	if(left->type != AL_OPERAND || left->operand.matrix != F) return GrB_NULL;
+	if(right->type != AL_OPERAND || right->operand.matrix == IDENTITY_MATRIX) return GrB_NULL;
+
+	return right->operand.matrix;
+}
+
+static inline void _set_iterator(OpCondTraverse *op, GrB_Matrix m) {
+	if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, m);
+	else GxB_MatrixTupleIter_reuse(op->iter, m);
 }
 
 /* Evaluate algebraic expression:
@@ -45,14 +113,26 @@ void _traverse(OpCondTraverse *op) {
 	if(op->F == GrB_NULL) {
 		// Create both filter and result matrices.
 		size_t required_dim = Graph_RequiredMatrixDim(op->graph);
-		GrB_Matrix_new(&op->M, GrB_BOOL, op->record_cap, required_dim);
-		GrB_Matrix_new(&op->F, GrB_BOOL, op->record_cap, required_dim);
+		GrB_Matrix_new(&op->M, GrB_BOOL, op->batch_size, required_dim);
+		GrB_Matrix_new(&op->F, GrB_BOOL, op->batch_size, required_dim);
 
 		// Prepend the filter matrix to algebraic expression as the leftmost operand.
 		AlgebraicExpression_MultiplyToTheLeft(&op->ae, op->F);
 
 		// Optimize the expression tree.
 		AlgebraicExpression_Optimize(&op->ae);
+
+		op->row_operand = _single_operand(op->ae, op->F);
+	}
+
+	// A single record against a single operand, scan the source row directly.
+	op->row_scan = (op->record_count == 1 && op->row_operand != GrB_NULL);
+	if(op->row_scan) {
+		op->row_scans++;
+		Node *n = Record_GetNode(op->records[0], op->srcNodeIdx);
+		_set_iterator(op, op->row_operand);
+		GxB_MatrixTupleIter_iterate_row(op->iter, ENTITY_GET_ID(n));
+		return;
 	}
 
 	// Populate filter matrix.
@@ -61,8 +141,7 @@ void _traverse(OpCondTraverse *op) {
 	// Evaluate expression.
 	AlgebraicExpression_Eval(op->ae, op->M);
 
-	if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, op->M);
-	else GxB_MatrixTupleIter_reuse(op->iter, op->M);
+	_set_iterator(op, op->M);
 
 	// Clear filter matrix.
 	GrB_Matrix_clear(op->F);
@@ -76,17 +155,25 @@ OpBase *NewCondTraverseOp(const ExecutionPlan *plan, Graph *g, AlgebraicExpressi
 	op->iter = NULL;
 	op->F = GrB_NULL;
 	op->M = GrB_NULL;
+	op->row_operand = GrB_NULL;
+	op->F_rows = NULL;
+	op->F_cols = NULL;
+	op->F_vals = NULL;
+	op->row_scan = false;
+	op->row_scans = 0;
 	op->records = NULL;
 	op->record_count = 0;
 	op->edge_ctx = NULL;
 	op->dest_label = NULL;
-	op->record_cap = BATCH_SIZE;
+	op->record_cap = MAX_BATCH_SIZE;
+	op->batch_size = BATCH_SIZE;
 	op->dest_label_id = GRAPH_NO_LABEL;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_CONDITIONAL_TRAVERSE, "Conditional Traverse", CondTraverseInit,
 				CondTraverseConsume, CondTraverseReset, CondTraverseToString, CondTraverseClone, CondTraverseFree,
 				false, plan);
+	OpBase_SetConsumeBatch((OpBase *)op, CondTraverseConsumeBatch);
 
 	bool aware = OpBase_Aware((OpBase *)op, AlgebraicExpression_Source(ae), &op->srcNodeIdx);
 	UNUSED(aware);
@@ -115,65 +202,67 @@ static OpResult CondTraverseInit(OpBase *opBase) {
 	OpCondTraverse *op = (OpCondTraverse *)opBase;
 	// Create 'records' with this Init function as 'record_cap'
 	// might be set during optimization time (applyLimit)
-	// If cap greater than BATCH_SIZE is specified,
-	// use BATCH_SIZE as the value.
-	if(op->record_cap > BATCH_SIZE) op->record_cap = BATCH_SIZE;
-	op->records = rm_calloc(op->record_cap, sizeof(Record));
+	// If cap greater than MAX_BATCH_SIZE is specified,
+	// use MAX_BATCH_SIZE as the value.
+	// Batches start small and grow while the child keeps filling them.
+	if(op->record_cap > MAX_BATCH_SIZE) op->record_cap = MAX_BATCH_SIZE;
+	op->batch_size = MIN(BATCH_SIZE, op->record_cap);
+	_allocate_batch(op, 0);
 	return OP_OK;
 }
 
-/* Each call to CondTraverseConsume emits a Record containing the
- * traversal's endpoints and, if required, an edge.
- * Returns NULL once all traversals have been performed. */
-static Record CondTraverseConsume(OpBase *opBase) {
-	OpCondTraverse *op = (OpCondTraverse *)opBase;
+/* Moves to the next tuple of M, traversing from the child's following records
+ * once M is depleted. Returns false once the child is depleted. */
+static bool _nextTuple(OpCondTraverse *op, NodeID *src_id, NodeID *dest_id) {
 	OpBase *child = op->op.children[0];
-
-	/* If we're required to update an edge and have one queued, we can return early.
-	 * Otherwise, try to get a new pair of source and destination nodes. */
-	if(op->edge_ctx && Traverse_SetEdge(op->edge_ctx, op->r)) return OpBase_CloneRecord(op->r);
-
 	bool depleted = true;
-	NodeID src_id = INVALID_ENTITY_ID;
-	NodeID dest_id = INVALID_ENTITY_ID;
 
 	while(true) {
-		if(op->iter) GxB_MatrixTupleIter_next(op->iter, &src_id, &dest_id, &depleted);
+		if(op->iter) GxB_MatrixTupleIter_next(op->iter, src_id, dest_id, &depleted);
 
 		// Managed to get a tuple, break.
-		if(!depleted) break;
+		if(!depleted) return true;
 
 		/* Run out of tuples, try to get new data.
 		 * Free old records. */
 		op->r = NULL;
 		for(uint i = 0; i < op->record_count; i++) OpBase_DeleteRecord(op->records[i]);
 
+		// Previous batch was filled, child is likely to keep producing.
+		if(op->record_count == op->batch_size) _grow_batch(op);
+
 		// Ask child operations for data.
-		for(op->record_count = 0; op->record_count < op->record_cap; op->record_count++) {
-			Record childRecord = OpBase_Consume(child);
-			// If the Record is NULL, the child has been depleted.
-			if(!childRecord) break;
+		op->record_count = 0;
+		uint received = OpBase_ConsumeBatch(child, op->records, op->batch_size);
+		for(uint i = 0; i < received; i++) {
+			Record childRecord = op->records[i];
 			if(!Record_GetNode(childRecord, op->srcNodeIdx)) {
 				/* The child Record may not contain the source node in scenarios like
-				 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+				 * a failed OPTIONAL MATCH. In this case, delete the Record. */
 				OpBase_DeleteRecord(childRecord);
-				op->record_count--;
 				continue;
 			}
 
 			// Store received record.
 			Record_PersistScalars(childRecord);
-			op->records[op->record_count] = childRecord;
+			op->records[op->record_count++] = childRecord;
 		}
 
 		// No data.
-		if(op->record_count == 0) return NULL;
+		if(received == 0) return false;
+		// None of the received records contain a source node.
+		if(op->record_count == 0) continue;
 
 		_traverse(op);
 	}
+}
 
-	/* Get node from current column. */
-	op->r = op->records[src_id];
+// Sets op->r to the source record of tuple (src_id, dest_id), populated with its destination
+// and, if required, with the first edge connecting the pair.
+static void _setTraversal(OpCondTraverse *op, NodeID src_id, NodeID dest_id) {
+	/* Get node from current column.
+	 * When scanning a single row, src_id is the source node ID. */
+	op->r = op->records[op->row_scan ? 0 : src_id];
 	/* Populate the destination node and add it to the Record.
 	 * Note that if the node's label is unknown, this will correctly
 	 * create an unlabeled node. */
@@ -188,10 +277,49 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		// We're guaranteed to have at least one edge.
 		Traverse_SetEdge(op->edge_ctx, op->r);
 	}
+}
+
+/* Each call to CondTraverseConsume emits a Record containing the
+ * traversal's endpoints and, if required, an edge.
+ * Returns NULL once all traversals have been performed. */
+static Record CondTraverseConsume(OpBase *opBase) {
+	OpCondTraverse *op = (OpCondTraverse *)opBase;
+
+	/* If we're required to update an edge and have one queued, we can return early.
+	 * Otherwise, try to get a new pair of source and destination nodes. */
+	if(op->edge_ctx && Traverse_SetEdge(op->edge_ctx, op->r)) return OpBase_CloneRecord(op->r);
+
+	NodeID src_id = INVALID_ENTITY_ID;
+	NodeID dest_id = INVALID_ENTITY_ID;
+	if(!_nextTuple(op, &src_id, &dest_id)) return NULL;
 
+	_setTraversal(op, src_id, dest_id);
 	return OpBase_CloneRecord(op->r);
 }
 
+// Fills batch straight off M's tuple iterator, until batch is full
+// or all traversals have been performed.
+static uint CondTraverseConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpCondTraverse *op = (OpCondTraverse *)opBase;
+	NodeID src_id = INVALID_ENTITY_ID;
+	NodeID dest_id = INVALID_ENTITY_ID;
+
+	uint count = 0;
+	while(count < cap) {
+		// Edges queued for the current pair of endpoints precede the next tuple.
+		if(!op->edge_ctx || !Traverse_SetEdge(op->edge_ctx, op->r)) {
+			if(!_nextTuple(op, &src_id, &dest_id)) break;
+			_setTraversal(op, src_id, dest_id);
+		}
+
+		Record r = OpBase_CloneRecord(op->r);
+		// Emitted records share scalars with source records, which may be released.
+		Record_PersistScalars(r);
+		batch[count++] = r;
+	}
+	return count;
+}
+
 static OpResult CondTraverseReset(OpBase *ctx) {
 	OpCondTraverse *op = (OpCondTraverse *)ctx;
 
@@ -250,5 +378,20 @@ static void CondTraverseFree(OpBase *ctx) {
 		rm_free(op->records);
 		op->records = NULL;
 	}
+
+	if(op->F_rows) {
+		rm_free(op->F_rows);
+		op->F_rows = NULL;
+	}
+
+	if(op->F_cols) {
+		rm_free(op->F_cols);
+		op->F_cols = NULL;
+	}
+
+	if(op->F_vals) {
+		rm_free(op->F_vals);
+		op->F_vals = NULL;
+	}
 }
 
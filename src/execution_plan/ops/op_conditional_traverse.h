@@ -19,6 +19,10 @@ typedef struct {
 	AlgebraicExpression *ae;
 	GrB_Matrix F;               // Filter matrix.
 	GrB_Matrix M;               // Algebraic expression result.
+	GrB_Matrix row_operand;     // Single operand scanned directly for a batch of one.
+	GrB_Index *F_rows;          // Row indices used to build F.
+	GrB_Index *F_cols;          // Column indices used to build F.
+	bool *F_vals;               // Values used to build F.
 	NodeID dest_label_id;       // ID of destination node label if known.
 	const char *dest_label;     // Label of destination node if known.
 	EdgeTraverseCtx *edge_ctx;  // Edge collection data if the edge needs to be set.
@@ -27,6 +31,9 @@ typedef struct {
 	int destNodeIdx;            // Destination node index into record.
 	uint record_count;          // Number of held records.
 	uint record_cap;            // Max number of records to process.
+	uint batch_size;            // Current number of records to accumulate.
+	bool row_scan;              // Iterator scans a single row of row_operand.
+	uint row_scans;             // Number of batches resolved by a row scan, reported when profiling.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
 } OpCondTraverse;
@@ -36,6 +36,12 @@ void _DeleteEntities(OpDelete *op) {
 		}
 	}
 
+	EffectsBuffer *effects = QueryCtx_GetEffectsBuffer();
+	if(effects) {
+		EffectsBuffer_AddDeleteEffect(effects, op->gc, op->deleted_nodes, node_count,
+									  op->deleted_edges, edge_count);
+	}
+
 	Graph_BulkDelete(g, op->deleted_nodes, node_count, op->deleted_edges,
 					 edge_count, &node_deleted, &relationships_deleted);
 
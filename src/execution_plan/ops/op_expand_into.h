@@ -19,6 +19,7 @@ typedef struct {
 	AlgebraicExpression *ae;
 	GrB_Matrix F;               // Filter matrix.
 	GrB_Matrix M;               // Algebraic expression result.
+	GrB_Matrix D;               // Destination mask, the entries of M to compute.
 	EdgeTraverseCtx *edge_ctx;  // Edge collection data if the edge needs to be set.
 	int srcNodeIdx;             // Source node index into record.
 	int destNodeIdx;            // Destination node index into record.
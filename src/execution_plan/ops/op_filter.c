@@ -8,21 +8,32 @@
 #include "RG.h"
 
 /* Forward declarations. */
+static OpResult FilterInit(OpBase *opBase);
 static Record FilterConsume(OpBase *opBase);
+static uint FilterConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void FilterFree(OpBase *opBase);
 
 OpBase *NewFilterOp(const ExecutionPlan *plan, FT_FilterNode *filterTree) {
 	OpFilter *op = rm_malloc(sizeof(OpFilter));
 	op->filterTree = filterTree;
+	op->compiled = NULL;
 
 	// Set our Op operations
-	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", NULL, FilterConsume,
+	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", FilterInit, FilterConsume,
 				NULL, NULL, FilterClone, FilterFree, false, plan);
+	OpBase_SetConsumeBatch((OpBase *)op, FilterConsumeBatch);
 
 	return (OpBase *)op;
 }
 
+static OpResult FilterInit(OpBase *opBase) {
+	OpFilter *filter = (OpFilter *)opBase;
+	// Optimizations no longer modify the filter tree, compile it.
+	filter->compiled = CompiledFilterTree_New(filter->filterTree, opBase->plan->query_graph);
+	return OP_OK;
+}
+
 /* FilterConsume next operation
  * returns OP_OK when graph passes filter tree. */
 static Record FilterConsume(OpBase *opBase) {
@@ -35,13 +46,39 @@ static Record FilterConsume(OpBase *opBase) {
 		if(!r) break;
 
 		/* Pass graph through filter tree */
-		if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) break;
+		if(CompiledFilterTree_applyFilters(filter->compiled, r) == FILTER_PASS) break;
 		else OpBase_DeleteRecord(r);
 	}
 
 	return r;
 }
 
+/* Fills batch with records passing the filter tree,
+ * records are filtered in place as they're received from the child. */
+static uint FilterConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	OpFilter *filter = (OpFilter *)opBase;
+	OpBase *child = filter->op.children[0];
+
+	uint count = 0;
+	while(count < cap) {
+		Record *received_batch = batch + count;
+		uint requested = cap - count;
+		uint received = OpBase_ConsumeBatch(child, received_batch, requested);
+
+		// Compact passing records to the front of the batch.
+		for(uint i = 0; i < received; i++) {
+			Record r = received_batch[i];
+			if(CompiledFilterTree_applyFilters(filter->compiled, r) == FILTER_PASS) batch[count++] = r;
+			else OpBase_DeleteRecord(r);
+		}
+
+		// Child is depleted.
+		if(received < requested) break;
+	}
+
+	return count;
+}
+
 static inline OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_FILTER);
 	OpFilter *op = (OpFilter *)opBase;
@@ -51,6 +88,11 @@ static inline OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBas
 /* Frees OpFilter*/
 static void FilterFree(OpBase *ctx) {
 	OpFilter *filter = (OpFilter *)ctx;
+	if(filter->compiled) {
+		CompiledFilterTree_Free(filter->compiled);
+		filter->compiled = NULL;
+	}
+
 	if(filter->filterTree) {
 		FilterTree_Free(filter->filterTree);
 		filter->filterTree = NULL;
@@ -9,12 +9,14 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../filter_tree/compiled_filter_tree.h"
 
 /* Filter
  * filters graph according to where cluase */
 typedef struct {
 	OpBase op;
 	FT_FilterNode *filterTree;
+	CompiledFilterTree *compiled;  // Execution form of filterTree, built once the plan is final.
 } OpFilter;
 
 /* Creates a new Filter operation */
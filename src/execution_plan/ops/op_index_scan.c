@@ -26,6 +26,9 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n, RSInd
 	op->n = n;
 	op->idx = idx;
 	op->iter = NULL;
+	op->range_idx = NULL;
+	op->range_query = NULL;
+	op->range_iter_init = false;
 	op->child_record = NULL;
 	op->rs_query_node = rs_query_node;
 
@@ -37,6 +40,14 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n, RSInd
 	return (OpBase *)op;
 }
 
+OpBase *NewRangeIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
+							RangeIndex *idx, RangeIndexQuery *query) {
+	IndexScan *op = (IndexScan *)NewIndexScanOp(plan, g, n, NULL, NULL);
+	op->range_idx = idx;
+	op->range_query = query;
+	return (OpBase *)op;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	if(opBase->childCount > 0) OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
 	return OP_OK;
@@ -51,69 +62,90 @@ static inline void _UpdateRecord(IndexScan *op, Record r, EntityID node_id) {
 	Record_AddNode(r, op->nodeRecIdx, n);
 }
 
-static Record IndexScanConsumeFromChild(OpBase *opBase) {
-	IndexScan *op = (IndexScan *)opBase;
+static void _InitIterator(IndexScan *op) {
+	if(op->range_idx) {
+		if(op->range_iter_init) return;
+		RangeIndexIterator_Init(&op->range_iter, op->range_idx, op->range_query);
+		op->range_iter_init = true;
+		return;
+	}
 
 	if(op->iter == NULL) {
-		/* On the first execution of IndexScanConsumeFromChild, use the RediSearch query node
-		 * to populate an index iterator. This causes the index to acquire a read lock. */
+		/* On the first execution, use the RediSearch query node to populate
+		 * an index iterator. This causes the index to acquire a read lock. */
 		op->iter = RediSearch_GetResultsIterator(op->rs_query_node, op->idx);
 		// The query node is now part of the iterator, explicitly NULL-set it to prevent a double free.
 		op->rs_query_node = NULL;
 	}
+}
+
+static void _ResetIterator(IndexScan *op) {
+	if(op->range_idx) {
+		if(op->range_iter_init) RangeIndexIterator_Reset(&op->range_iter);
+	} else if(op->iter) {
+		RediSearch_ResultsIteratorReset(op->iter);
+	}
+}
+
+// Sets node_id to the next matching node, returns false once the scan is depleted.
+static bool _NextNodeID(IndexScan *op, EntityID *node_id) {
+	if(op->range_idx) return RangeIndexIterator_Next(&op->range_iter, node_id);
+
+	const EntityID *id = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL);
+	if(!id) return false;
+	*node_id = *id;
+	return true;
+}
+
+static Record IndexScanConsumeFromChild(OpBase *opBase) {
+	IndexScan *op = (IndexScan *)opBase;
+	_InitIterator(op);
 
 	if(op->child_record == NULL) {
 		op->child_record = OpBase_Consume(op->op.children[0]);
 		if(op->child_record == NULL) return NULL;
-		else RediSearch_ResultsIteratorReset(op->iter);
+		else _ResetIterator(op);
 	}
 
-	const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL);
-	if(!nodeId) { // Index scan depleted.
+	EntityID nodeId;
+	if(!_NextNodeID(op, &nodeId)) { // Index scan depleted.
 		OpBase_DeleteRecord(op->child_record); // Free old record.
 		// Pull a new record from child.
 		op->child_record = OpBase_Consume(op->op.children[0]);
 		if(op->child_record == NULL) return NULL; // Child depleted.
 
 		// Reset iterator and evaluate again.
-		RediSearch_ResultsIteratorReset(op->iter);
-		nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL);
-		if(!nodeId) return NULL; // Empty iterator, return immediately.
+		_ResetIterator(op);
+		if(!_NextNodeID(op, &nodeId)) return NULL; // Empty iterator, return immediately.
 	}
 
 	// Clone the held Record, as it will be freed upstream.
 	Record r = OpBase_CloneRecord(op->child_record);
 
 	// Populate the Record with the actual node.
-	_UpdateRecord(op, r, *nodeId);
+	_UpdateRecord(op, r, nodeId);
 
 	return r;
 }
 
 static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	if(op->iter == NULL) {
-		/* On the first execution of IndexScanConsume, use the RediSearch query node
-		 * to populate an index iterator. This causes the index to acquire a read lock. */
-		op->iter = RediSearch_GetResultsIterator(op->rs_query_node, op->idx);
-		// The query node is now part of the iterator, explicitly NULL-set it to prevent a double free.
-		op->rs_query_node = NULL;
-	}
+	_InitIterator(op);
 
-	const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL);
-	if(!nodeId) return NULL;
+	EntityID nodeId;
+	if(!_NextNodeID(op, &nodeId)) return NULL;
 
 	Record r = OpBase_CreateRecord((OpBase *)op);
 
 	// Populate the Record with the actual node.
-	_UpdateRecord(op, r, *nodeId);
+	_UpdateRecord(op, r, nodeId);
 
 	return r;
 }
 
 static OpResult IndexScanReset(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	RediSearch_ResultsIteratorReset(op->iter);
+	_ResetIterator(op);
 	return OP_OK;
 }
 
@@ -133,6 +165,16 @@ static void IndexScanFree(OpBase *opBase) {
 		op->rs_query_node = NULL;
 	}
 
+	if(op->range_iter_init) {
+		RangeIndexIterator_Free(&op->range_iter);
+		op->range_iter_init = false;
+	}
+
+	if(op->range_query) {
+		RangeIndexQuery_Free(op->range_query);
+		op->range_query = NULL;
+	}
+
 	if(op->child_record) {
 		OpBase_DeleteRecord(op->child_record);
 		op->child_record = NULL;
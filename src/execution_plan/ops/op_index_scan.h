@@ -21,6 +21,10 @@ typedef struct {
 	uint nodeRecIdx;            /* Index of the node being scanned in the Record. */
 	RSQNode *rs_query_node;     /* RediSearch query node used to construct iterator. */
 	RSResultsIterator *iter;    /* RediSearch iterator over an index with the appropriate filters. */
+	RangeIndex *range_idx;      /* Range index, NULL when scanning a RediSearch index. */
+	RangeIndexQuery *range_query;   /* Range index scan bounds. */
+	RangeIndexIterator range_iter;  /* Range index iterator. */
+	bool range_iter_init;       /* Range index iterator has been initialized. */
 	Record child_record;        /* The Record this op acts on if it is not a tap. */
 } IndexScan;
 
@@ -28,3 +32,7 @@ typedef struct {
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n, RSIndex *idx,
 					   RSQNode *rs_query_node);
 
+/* Creates a new IndexScan operation over a range index, the op takes ownership of query. */
+OpBase *NewRangeIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx n,
+							RangeIndex *idx, RangeIndexQuery *query);
+
@@ -0,0 +1,342 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_intersect.h"
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../../util/strcmp.h"
+#include "../../query_ctx.h"
+#include "../../graph/graphcontext.h"
+
+/* Forward declarations. */
+static Record IntersectConsume(OpBase *opBase);
+static OpResult IntersectReset(OpBase *opBase);
+static OpBase *IntersectClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void IntersectFree(OpBase *opBase);
+
+static int IntersectToString(const OpBase *ctx, char *buf, uint buf_len) {
+	const OpIntersect *op = (const OpIntersect *)ctx;
+	const QueryGraph *qg = ctx->plan->query_graph;
+	uint constraint_count = array_len(op->constraints);
+
+	int offset = snprintf(buf, buf_len, "%s | ", ctx->name);
+	for(uint i = 0; i < constraint_count; i++) {
+		QGEdge *e = QueryGraph_GetEdgeByAlias(qg, op->constraints[i].edge);
+		if(i > 0) offset += snprintf(buf + offset, buf_len - offset, ", ");
+		offset += QGNode_ToString(e->src, buf + offset, buf_len - offset);
+		offset += snprintf(buf + offset, buf_len - offset, "-");
+		offset += QGEdge_ToString(e, buf + offset, buf_len - offset);
+		offset += snprintf(buf + offset, buf_len - offset, e->bidirectional ? "-" : "->");
+		offset += QGNode_ToString(e->dest, buf + offset, buf_len - offset);
+	}
+	return offset;
+}
+
+// Returns the ID of the given label,
+// GRAPH_UNKNOWN_LABEL if the label doesn't exists.
+static int _resolveLabel(const char *label, int label_id) {
+	if(!label) return GRAPH_NO_LABEL;
+	if(label_id != GRAPH_UNKNOWN_LABEL) return label_id;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	return (s) ? s->id : GRAPH_UNKNOWN_LABEL;
+}
+
+// Resolve label and relationship type IDs, which might not have existed
+// at the time the operation was constructed.
+static void _resolveSchema(OpIntersect *op) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	const QueryGraph *qg = op->op.plan->query_graph;
+	uint constraint_count = array_len(op->constraints);
+
+	op->labelID = _resolveLabel(op->label, op->labelID);
+
+	for(uint i = 0; i < constraint_count; i++) {
+		IntersectConstraint *c = op->constraints + i;
+		QGEdge *e = QueryGraph_GetEdgeByAlias(qg, c->edge);
+		QGNode *other = QueryGraph_GetNodeByAlias(qg, c->other);
+		c->otherLabelID = _resolveLabel(other->label, other->labelID);
+
+		uint reltype_count = array_len(e->reltypeIDs);
+		if(reltype_count == 0) {
+			c->relationIDs = array_append(c->relationIDs, GRAPH_NO_RELATION);
+		}
+
+		for(uint j = 0; j < reltype_count; j++) {
+			int rel_id = e->reltypeIDs[j];
+			if(rel_id == GRAPH_UNKNOWN_RELATION) {
+				Schema *s = GraphContext_GetSchema(gc, e->reltypes[j], SCHEMA_EDGE);
+				if(!s) continue;
+				rel_id = s->id;
+			}
+			c->relationIDs = array_append(c->relationIDs, rel_id);
+		}
+
+		// A row per relation and direction.
+		uint relation_count = array_len(c->relationIDs);
+		for(uint j = 0; j < relation_count; j++) {
+			IntersectRow row = {.relationID = c->relationIDs[j], .iter = NULL};
+			if(c->outgoing) {
+				row.transposed = false;
+				c->rows = array_append(c->rows, row);
+			}
+			if(c->incoming) {
+				row.transposed = true;
+				c->rows = array_append(c->rows, row);
+			}
+		}
+	}
+
+	op->schema_resolved = true;
+}
+
+// Returns true if node is labeled 'label_id'.
+static bool _hasLabel(const OpIntersect *op, NodeID id, int label_id) {
+	if(label_id == GRAPH_NO_LABEL) return true;
+	if(label_id == GRAPH_UNKNOWN_LABEL) return false;
+	bool x;
+	GrB_Matrix L = Graph_GetLabelMatrix(op->g, label_id);
+	return GrB_Matrix_extractElement_BOOL(&x, L, id, id) == GrB_SUCCESS;
+}
+
+// Moves row to its next entry.
+static inline void _rowNext(IntersectRow *row) {
+	GxB_MatrixTupleIter_next(row->iter, NULL, &row->current, &row->depleted);
+}
+
+// Moves row to its first entry not smaller than 'v',
+// galloping over the row's sorted column indices rather than stepping through them.
+static inline void _rowSeek(IntersectRow *row, NodeID v) {
+	if(row->depleted || row->current >= v) return;
+	GxB_MatrixTupleIter_seek_col(row->iter, v);
+	_rowNext(row);
+}
+
+// Positions row at the first neighbor of node 'id'.
+static void _rowStart(OpIntersect *op, IntersectRow *row, NodeID id) {
+	GrB_Matrix M = (row->transposed) ?
+				   Graph_GetTransposedRelationMatrix(op->g, row->relationID) :
+				   Graph_GetRelationMatrix(op->g, row->relationID);
+
+	if(row->iter == NULL) GxB_MatrixTupleIter_new(&row->iter, M);
+	else GxB_MatrixTupleIter_reuse(row->iter, M);
+	GxB_MatrixTupleIter_iterate_range(row->iter, id, id);
+	_rowNext(row);
+}
+
+// Sets the constraint's current neighbor to the smallest among its rows.
+static void _constraintUpdate(IntersectConstraint *c) {
+	c->depleted = true;
+	uint row_count = array_len(c->rows);
+	for(uint i = 0; i < row_count; i++) {
+		IntersectRow *row = c->rows + i;
+		if(row->depleted) continue;
+		if(c->depleted || row->current < c->current) c->current = row->current;
+		c->depleted = false;
+	}
+}
+
+// Advances the constraint's rows to their first neighbor not smaller than 'v',
+// returns false if the constraint is depleted.
+static bool _constraintSeek(IntersectConstraint *c, NodeID v) {
+	if(c->depleted) return false;
+	if(c->current >= v) return true;
+
+	uint row_count = array_len(c->rows);
+	for(uint i = 0; i < row_count; i++) _rowSeek(c->rows + i, v);
+	_constraintUpdate(c);
+	return !c->depleted;
+}
+
+// Positions the rows of every constraint at the bound nodes of the current record,
+// returns false if there are no candidates.
+static bool _startConstraints(OpIntersect *op) {
+	op->next_min = 0;
+	uint constraint_count = array_len(op->constraints);
+	for(uint i = 0; i < constraint_count; i++) {
+		IntersectConstraint *c = op->constraints + i;
+		Node *other = Record_GetNode(op->r, c->otherIdx);
+		/* The Record may not contain the bound node in scenarios like
+		 * a failed OPTIONAL MATCH. */
+		if(!other) return false;
+		NodeID id = ENTITY_GET_ID(other);
+		if(!_hasLabel(op, id, c->otherLabelID)) return false;
+
+		uint row_count = array_len(c->rows);
+		for(uint j = 0; j < row_count; j++) _rowStart(op, c->rows + j, id);
+		_constraintUpdate(c);
+		if(c->depleted) return false;
+	}
+	return true;
+}
+
+// Retrieves the next node which is a neighbor under every constraint,
+// returns false once the rows of a constraint are depleted.
+static bool _nextCandidate(OpIntersect *op, NodeID *id) {
+	uint constraint_count = array_len(op->constraints);
+	NodeID target = op->next_min;
+	while(true) {
+		// Seek every constraint to target, raising target
+		// whenever a constraint passes it, until all agree.
+		bool aligned = true;
+		for(uint i = 0; i < constraint_count; i++) {
+			IntersectConstraint *c = op->constraints + i;
+			if(!_constraintSeek(c, target)) return false;
+			if(c->current != target) {
+				target = c->current;
+				aligned = false;
+			}
+		}
+		if(!aligned) continue;
+
+		op->next_min = target + 1;
+		if(_hasLabel(op, target, op->labelID)) {
+			*id = target;
+			return true;
+		}
+		target = op->next_min;
+	}
+}
+
+static void _addConstraint(OpIntersect *op, const QueryGraph *qg, const char *edge) {
+	QGEdge *e = QueryGraph_GetEdgeByAlias(qg, edge);
+	ASSERT(e != NULL);
+
+	IntersectConstraint c;
+	c.edge = e->alias;
+	c.otherLabelID = GRAPH_NO_LABEL;
+	c.relationIDs = array_new(int, 1);
+	c.rows = array_new(IntersectRow, 1);
+	c.current = 0;
+	c.depleted = true;
+
+	if(!RG_STRCMP(e->dest->alias, op->alias)) {
+		// (other)-[e]->(alias), scan other's outgoing edges.
+		c.other = e->src->alias;
+		c.outgoing = true;
+		c.incoming = e->bidirectional;
+	} else {
+		// (alias)-[e]->(other), scan other's incoming edges.
+		ASSERT(!RG_STRCMP(e->src->alias, op->alias));
+		c.other = e->dest->alias;
+		c.outgoing = e->bidirectional;
+		c.incoming = true;
+	}
+	ASSERT(RG_STRCMP(c.other, op->alias));
+
+	bool aware = OpBase_Aware((OpBase *)op, c.other, &c.otherIdx);
+	ASSERT(aware);
+	UNUSED(aware);
+
+	op->constraints = array_append(op->constraints, c);
+}
+
+OpBase *NewIntersectOp(const ExecutionPlan *plan, Graph *g, const char *alias, const char **edges) {
+	ASSERT(g != NULL);
+	ASSERT(alias != NULL);
+	ASSERT(array_len(edges) > 1);
+
+	OpIntersect *op = rm_malloc(sizeof(OpIntersect));
+	op->g = g;
+	op->r = NULL;
+	op->alias = alias;
+	op->next_min = 0;
+	op->schema_resolved = false;
+	op->constraints = array_new(IntersectConstraint, array_len(edges));
+
+	QGNode *n = QueryGraph_GetNodeByAlias(plan->query_graph, alias);
+	op->label = n->label;
+	op->labelID = n->labelID;
+
+	OpBase_Init((OpBase *)op, OPType_INTERSECT, "Intersect", NULL, IntersectConsume,
+				IntersectReset, IntersectToString, IntersectClone, IntersectFree, false, plan);
+
+	op->nodeIdx = OpBase_Modifies((OpBase *)op, alias);
+	uint edge_count = array_len(edges);
+	for(uint i = 0; i < edge_count; i++) _addConstraint(op, plan->query_graph, edges[i]);
+
+	return (OpBase *)op;
+}
+
+void IntersectOp_AddEdge(OpIntersect *op, const char *edge) {
+	ASSERT(op != NULL);
+	ASSERT(!op->schema_resolved);
+	_addConstraint(op, op->op.plan->query_graph, edge);
+}
+
+static Record IntersectConsume(OpBase *opBase) {
+	OpIntersect *op = (OpIntersect *)opBase;
+	OpBase *child = op->op.children[0];
+
+	if(!op->schema_resolved) _resolveSchema(op);
+
+	// Emit pending candidates of the current record.
+	NodeID id;
+	while(!op->r || !_nextCandidate(op, &id)) {
+		if(op->r) OpBase_DeleteRecord(op->r);
+		op->r = OpBase_Consume(child);
+		if(!op->r) return NULL;
+
+		if(!_startConstraints(op)) {
+			// No candidates for this record.
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+		}
+	}
+
+	Node n = GE_NEW_LABELED_NODE(op->label, op->labelID);
+	Graph_GetNode(op->g, id, &n);
+	Record_AddNode(op->r, op->nodeIdx, n);
+
+	return OpBase_CloneRecord(op->r);
+}
+
+static OpResult IntersectReset(OpBase *ctx) {
+	OpIntersect *op = (OpIntersect *)ctx;
+	if(op->r) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+	op->next_min = 0;
+	return OP_OK;
+}
+
+static OpBase *IntersectClone(const ExecutionPlan *plan, const OpBase *opBase) {
+	ASSERT(opBase->type == OPType_INTERSECT);
+	const OpIntersect *op = (const OpIntersect *)opBase;
+	uint constraint_count = array_len(op->constraints);
+	const char **edges = array_new(const char *, constraint_count);
+	for(uint i = 0; i < constraint_count; i++) {
+		edges = array_append(edges, op->constraints[i].edge);
+	}
+
+	OpBase *clone = NewIntersectOp(plan, QueryCtx_GetGraph(), op->alias, edges);
+	array_free(edges);
+	return clone;
+}
+
+static void IntersectFree(OpBase *ctx) {
+	OpIntersect *op = (OpIntersect *)ctx;
+	if(op->r) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	if(op->constraints) {
+		uint constraint_count = array_len(op->constraints);
+		for(uint i = 0; i < constraint_count; i++) {
+			IntersectConstraint *c = op->constraints + i;
+			uint row_count = array_len(c->rows);
+			for(uint j = 0; j < row_count; j++) {
+				if(c->rows[j].iter) GxB_MatrixTupleIter_free(c->rows[j].iter);
+			}
+			array_free(c->rows);
+			array_free(c->relationIDs);
+		}
+		array_free(op->constraints);
+		op->constraints = NULL;
+	}
+}
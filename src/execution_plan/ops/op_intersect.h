@@ -0,0 +1,63 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Cursor over a single adjacency row of a bound node. */
+typedef struct {
+	int relationID;             // Relationship type of the row's matrix.
+	bool transposed;            // Row is of the transposed relation matrix, incoming edges.
+	GxB_MatrixTupleIter *iter;  // Iterator over the row.
+	NodeID current;             // Column the iterator is positioned at.
+	bool depleted;              // Row has no additional entries.
+} IntersectRow;
+
+/* Single relationship connecting the resolved node to a bound node. */
+typedef struct {
+	const char *edge;           // Alias of the connecting edge.
+	const char *other;          // Alias of the bound node.
+	int otherIdx;               // Bound node index into record.
+	int otherLabelID;           // Label ID of the bound node.
+	bool outgoing;              // Resolved node is reached by the bound node's outgoing edges.
+	bool incoming;              // Resolved node is reached by the bound node's incoming edges.
+	int *relationIDs;           // Relationship type(s) of the edge.
+	IntersectRow *rows;         // Adjacency rows of the bound node, one per relation and direction.
+	NodeID current;             // Smallest neighbor not yet passed by the rows.
+	bool depleted;              // All rows are depleted.
+} IntersectConstraint;
+
+/* OP Intersect
+ * Resolves a node connected to multiple bound nodes,
+ * such as the node closing a cycle, by intersecting
+ * the sorted adjacency rows of the bound nodes (Generic Join),
+ * rather than traversing from one bound node and
+ * discarding nodes not connected to the others.
+ * Rows are merged in place, each row's iterator seeks
+ * the largest neighbor seen so far by galloping search. */
+typedef struct {
+	OpBase op;
+	Graph *g;
+	Record r;                           // Currently selected record.
+	const char *alias;                  // Alias of the resolved node.
+	int nodeIdx;                        // Resolved node index into record.
+	const char *label;                  // Label of the resolved node.
+	int labelID;                        // Label ID of the resolved node.
+	IntersectConstraint *constraints;   // Relationships connecting the resolved node to bound nodes.
+	bool schema_resolved;               // Label and relationship type IDs were resolved.
+	NodeID next_min;                    // Smallest ID the next resolved node may have.
+} OpIntersect;
+
+/* Creates a new Intersect operation resolving 'alias',
+ * connected via 'edges' to bound nodes. */
+OpBase *NewIntersectOp(const ExecutionPlan *plan, Graph *g, const char *alias, const char **edges);
+
+/* Constrain the resolved node by an additional edge to a bound node. */
+void IntersectOp_AddEdge(OpIntersect *op, const char *edge);
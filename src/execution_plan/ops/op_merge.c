@@ -8,8 +8,11 @@
 #include "../../RG.h"
 #include "../../errors.h"
 #include "op_merge_create.h"
+#include "op_node_by_label_scan.h"
 #include "../../query_ctx.h"
+#include "../../util/arr.h"
 #include "../../schema/schema.h"
+#include "../../util/rax_extensions.h"
 #include "../../arithmetic/arithmetic_expression.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
@@ -34,7 +37,8 @@ static void _UpdateIndices(GraphContext *gc, Node *n) {
 }
 
 // Update the appropriate property on a graph entity.
-static int _UpdateProperty(Record r, GraphEntity *ge, EntityUpdateEvalCtx *update_ctx) {
+static int _UpdateProperty(Record r, GraphEntity *ge, GraphEntityType t,
+						   EntityUpdateEvalCtx *update_ctx) {
 	int res = 1;
 	SIValue new_value = AR_EXP_Evaluate(update_ctx->exp, r);
 
@@ -46,6 +50,9 @@ static int _UpdateProperty(Record r, GraphEntity *ge, EntityUpdateEvalCtx *updat
 		goto cleanup;
 	}
 
+	// Snapshots keep reading the entity's current properties.
+	Graph_PrepareEntityWrite(QueryCtx_GetGraph(), t, ENTITY_GET_ID(ge));
+
 	// Try to get current property value.
 	SIValue *old_value = GraphEntity_GetProperty(ge, update_ctx->attribute_id);
 
@@ -62,6 +69,12 @@ static int _UpdateProperty(Record r, GraphEntity *ge, EntityUpdateEvalCtx *updat
 		GraphEntity_SetProperty(ge, update_ctx->attribute_id, new_value);
 	}
 
+	EffectsBuffer *effects = QueryCtx_GetEffectsBuffer();
+	if(effects) {
+		EffectsBuffer_AddSetPropertyEffect(effects, QueryCtx_GetGraphCtx(), ge, t,
+										   update_ctx->attribute_id, new_value);
+	}
+
 cleanup:
 	SIValue_Free(new_value);
 	return res;
@@ -92,7 +105,8 @@ static void _UpdateProperties(ResultSetStatistics *stats, EntityUpdateEvalCtx *u
 
 			GraphEntity *ge = Record_GetGraphEntity(r, update_ctx->record_idx);
 
-			int res = _UpdateProperty(r, ge, update_ctx); // Update the entity.
+			GraphEntityType ge_type = (t == REC_TYPE_NODE) ? GETYPE_NODE : GETYPE_EDGE;
+			int res = _UpdateProperty(r, ge, ge_type, update_ctx); // Update the entity.
 			if(res == 0) {
 				failed_updates++;
 				continue;
@@ -152,6 +166,33 @@ static OpBase *_LocateOp(OpBase *root, OPType type) {
 	return NULL;
 }
 
+/* Returns the node to merge if all bound records can be matched by a single label scan,
+ * which is the case when the Match stream merely filters a label scan by the node's
+ * properties, e.g. UNWIND $rows AS r MERGE (n:User {id: r.id})
+ * Otherwise, e.g. when an index resolves the node, returns NULL. */
+static NodeCreateCtx *_BatchMatchNode(const OpMerge *op) {
+	OpBase *match_op = op->match_stream;
+	while(match_op->type == OPType_FILTER && match_op->childCount == 1) {
+		match_op = match_op->children[0];
+	}
+	if(match_op->type != OPType_NODE_BY_LABEL_SCAN || match_op->childCount != 1) return NULL;
+	if(match_op->children[0]->type != OPType_ARGUMENT) return NULL;
+
+	OpMergeCreate *merge_create = (OpMergeCreate *)_LocateOp(op->create_stream,
+															  OPType_MERGE_CREATE);
+	PendingCreations *pending = &merge_create->pending;
+	if(array_len(pending->nodes_to_create) != 1) return NULL;
+	if(pending->edges_to_create && array_len(pending->edges_to_create) > 0) return NULL;
+
+	NodeCreateCtx *n = pending->nodes_to_create;
+	const NodeByLabelScan *scan = (const NodeByLabelScan *)match_op;
+	if(n->properties == NULL || n->properties->property_count == 0) return NULL;
+	if(n->label == NULL || strcmp(n->label, scan->n.label) != 0) return NULL;
+	if(n->node_idx != scan->nodeRecIdx) return NULL;
+
+	return n;
+}
+
 static OpResult MergeInit(OpBase *opBase) {
 	/* Merge has 2 children if it is the first clause, and 3 otherwise.
 	 * - If there are 3 children, the first should resolve the Merge pattern's bound variables.
@@ -227,6 +268,7 @@ static OpResult MergeInit(OpBase *opBase) {
 																 OPType_ARGUMENT);
 	// Set up an array to store records produced by the bound variable stream.
 	op->input_records = array_new(Record, 1);
+	op->batch_node = _BatchMatchNode(op);
 
 	return OP_OK;
 }
@@ -237,25 +279,137 @@ static Record _handoff(OpMerge *op) {
 	return r;
 }
 
-static Record MergeConsume(OpBase *opBase) {
-	OpMerge *op = (OpMerge *)opBase;
+// Transfer the LHS record to the Create stream to build once we finish reading.
+static void _CreatePattern(OpMerge *op, Record lhs_record) {
+	/* We don't need to clone the record, as it won't be accessed again outside that stream,
+	 * but we must make sure its elements are access-safe, as the input stream will be freed
+	 * before entities are created. */
+	if(lhs_record) {
+		Record_PersistScalars(lhs_record);
+		Argument_AddRecord(op->create_argument_tap, lhs_record);
+	}
+	Record r = _pullFromStream(op->create_stream);
+	UNUSED(r);
+	ASSERT(r == NULL); // Don't expect returned records
+}
 
-	// Return mode, all data was consumed.
-	if(op->output_records) return _handoff(op);
+// Returns true if the node's properties equal the given values.
+static bool _PropertiesMatch(const Node *n, const PropertyMap *map, const SIValue *values) {
+	for(int i = 0; i < map->property_count; i++) {
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, map->keys[i]);
+		if(v == PROPERTY_NOTFOUND) return false;
+		int disjointOrNull = 0;
+		if(SIValue_Compare(*v, values[i], &disjointOrNull) != 0 || disjointOrNull) return false;
+	}
+	return true;
+}
 
-	// Consume mode.
-	op->output_records = array_new(Record, 32);
-	// If we have a bound variable stream, pull from it and store records until depleted.
-	if(op->bound_variable_stream) {
-		Record input_record;
-		while((input_record = _pullFromStream(op->bound_variable_stream))) {
-			op->input_records = array_append(op->input_records, input_record);
+/* Resolve the merged node for all input records at once:
+ * input records are hashed by the node's property values,
+ * and each node carrying the merged label is looked up in the table,
+ * replacing a scan of the label per input record.
+ * Returns true if any record has been passed on to the Create stream. */
+static bool _BatchMatch(OpMerge *op, uint *match_count) {
+	NodeCreateCtx *n = op->batch_node;
+	const PropertyMap *map = n->properties;
+	int key_count = map->property_count;
+	uint input_count = array_len(op->input_records);
+	int value_count = input_count * key_count;
+	SIValue *keys = rm_malloc(sizeof(SIValue) * value_count);
+	bool *matched = rm_calloc(input_count, sizeof(bool));
+	rax *buckets = raxNew();
+	XXH64_state_t state;
+
+	// Hash input records by the values of the node's properties.
+	for(uint i = 0; i < input_count; i++) {
+		bool has_null = false;
+		SIValue *values = keys + (i * key_count);
+		XXH64_reset(&state, 0);
+		for(int j = 0; j < key_count; j++) {
+			values[j] = AR_EXP_Evaluate(map->values[j], op->input_records[i]);
+			if(SIValue_IsNull(values[j])) has_null = true;
+			SIValue_HashUpdate(values[j], &state);
+		}
+		// Null properties never match.
+		if(has_null) continue;
+
+		XXH64_hash_t hash = XXH64_digest(&state);
+		uint *bucket = raxFind(buckets, (unsigned char *)&hash, sizeof(hash));
+		if(bucket == raxNotFound) bucket = array_new(uint, 1);
+		bucket = array_append(bucket, i);
+		raxInsert(buckets, (unsigned char *)&hash, sizeof(hash), bucket, NULL);
+	}
+
+	// Probe the table with every labeled node.
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, n->label, SCHEMA_NODE);
+	if(s && raxSize(buckets) > 0) {
+		GxB_MatrixTupleIter *iter;
+		GxB_MatrixTupleIter_new(&iter, Graph_GetLabelMatrix(gc->g, s->id));
+		while(true) {
+			GrB_Index id;
+			bool depleted = false;
+			GxB_MatrixTupleIter_next(iter, &id, NULL, &depleted);
+			if(depleted) break;
+
+			Node node = GE_NEW_LABELED_NODE(n->label, s->id);
+			Graph_GetNode(gc->g, id, &node);
+
+			bool missing = false;
+			XXH64_reset(&state, 0);
+			for(int j = 0; j < key_count && !missing; j++) {
+				SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node, map->keys[j]);
+				missing = (v == PROPERTY_NOTFOUND);
+				if(!missing) SIValue_HashUpdate(*v, &state);
+			}
+			if(missing) continue;
+
+			XXH64_hash_t hash = XXH64_digest(&state);
+			uint *bucket = raxFind(buckets, (unsigned char *)&hash, sizeof(hash));
+			if(bucket == raxNotFound) continue;
+
+			uint bucket_size = array_len(bucket);
+			for(uint j = 0; j < bucket_size; j++) {
+				uint idx = bucket[j];
+				if(!_PropertiesMatch(&node, map, keys + (idx * key_count))) continue;
+				// Pattern was successfully matched.
+				Record r = OpBase_CloneRecord(op->input_records[idx]);
+				Record_AddNode(r, n->node_idx, node);
+				op->output_records = array_append(op->output_records, r);
+				matched[idx] = true;
+				(*match_count)++;
+			}
+		}
+		GxB_MatrixTupleIter_free(iter);
+	}
+
+	for(int i = 0; i < value_count; i++) SIValue_Free(keys[i]);
+
+	// Create the pattern for every unmatched record.
+	bool must_create_records = false;
+	for(uint i = 0; i < input_count; i++) {
+		Record lhs_record = op->input_records[i];
+		if(matched[i]) {
+			OpBase_DeleteRecord(lhs_record);
+		} else {
+			_CreatePattern(op, lhs_record);
+			must_create_records = true;
 		}
 	}
+	array_clear(op->input_records);
+
+	raxFreeWithCallback(buckets, array_free);
+	rm_free(matched);
+	rm_free(keys);
+	return must_create_records;
+}
 
+// Attempt to resolve the pattern for every record from the bound variable stream,
+// or once if we have no bound variables.
+// Returns true if the pattern must be created.
+static bool _Match(OpMerge *op, uint *match_count) {
 	bool must_create_records = false;
 	bool reading_matches = true;
-	uint match_count = 0;
 	// Match mode: attempt to resolve the pattern for every record from the bound variable
 	// stream, or once if we have no bound variables.
 	while(reading_matches) {
@@ -282,22 +436,12 @@ static Record MergeConsume(OpBase *opBase) {
 			// Pattern was successfully matched.
 			should_create_pattern = false;
 			op->output_records = array_append(op->output_records, rhs_record);
-			match_count++;
+			(*match_count)++;
 		}
 
 		if(should_create_pattern) {
-			/* Transfer the LHS record to the Create stream to build once we finish reading.
-			 * We don't need to clone the record, as it won't be accessed again outside that stream,
-			 * but we must make sure its elements are access-safe, as the input stream will be freed
-			 * before entities are created. */
-			if(lhs_record) {
-				Record_PersistScalars(lhs_record);
-				Argument_AddRecord(op->create_argument_tap, lhs_record);
-				lhs_record = NULL;
-			}
-			Record r = _pullFromStream(op->create_stream);
-			UNUSED(r);
-			ASSERT(r == NULL); // Don't expect returned records
+			_CreatePattern(op, lhs_record);
+			lhs_record = NULL;
 			must_create_records = true;
 		}
 
@@ -305,6 +449,30 @@ static Record MergeConsume(OpBase *opBase) {
 		if(lhs_record) OpBase_DeleteRecord(lhs_record);
 	}
 
+	return must_create_records;
+}
+
+static Record MergeConsume(OpBase *opBase) {
+	OpMerge *op = (OpMerge *)opBase;
+
+	// Return mode, all data was consumed.
+	if(op->output_records) return _handoff(op);
+
+	// Consume mode.
+	op->output_records = array_new(Record, 32);
+	// If we have a bound variable stream, pull from it and store records until depleted.
+	if(op->bound_variable_stream) {
+		Record input_record;
+		while((input_record = _pullFromStream(op->bound_variable_stream))) {
+			op->input_records = array_append(op->input_records, input_record);
+		}
+	}
+
+	uint match_count = 0;
+	bool must_create_records = (op->batch_node) ?
+							   _BatchMatch(op, &match_count) :
+							   _Match(op, &match_count);
+
 	// Explicitly free the read streams in case either holds an index read lock.
 	if(op->bound_variable_stream) OpBase_PropagateFree(op->bound_variable_stream);
 	OpBase_PropagateFree(op->match_stream);
@@ -9,6 +9,7 @@
 #include "op.h"
 #include "op_argument.h"
 #include "../execution_plan.h"
+#include "../../ast/ast_shared.h"
 #include "../../resultset/resultset_statistics.h"
 
 /* The Merge operation accepts exactly one path in the query and attempts to match it.
@@ -26,6 +27,7 @@ typedef struct {
 	EntityUpdateEvalCtx *on_match;    // Updates to be performed on a successful match.
 	EntityUpdateEvalCtx *on_create;   // Updates to be performed on creation.
 	ResultSetStatistics *stats;       // Required for tracking statistics updates in ON MATCH.
+	NodeCreateCtx *batch_node;        // Node resolved for all bound records in a single label scan.
 } OpMerge;
 
 OpBase *NewMergeOp(const ExecutionPlan *plan, EntityUpdateEvalCtx *on_match,
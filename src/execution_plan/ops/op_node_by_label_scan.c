@@ -9,6 +9,7 @@
 #include "shared/print_functions.h"
 #include "../../ast/ast.h"
 #include "../../query_ctx.h"
+#include "../../util/arr.h"
 
 /* Forward declarations. */
 static OpResult NodeByLabelScanInit(OpBase *opBase);
@@ -31,6 +32,11 @@ OpBase *NewNodeByLabelScanOp(const ExecutionPlan *plan, NodeScanCtx n) {
 	op->n = n;
 	op->iter = NULL;
 	op->child_record = NULL;
+	op->filters = NULL;
+	op->batch = NULL;
+	op->batch_count = 0;
+	op->batch_idx = 0;
+	op->iter_depleted = false;
 	// Defaults to [0...UINT64_MAX].
 	op->id_range = UnsignedRange_New();
 
@@ -52,11 +58,32 @@ void NodeByLabelScanOp_SetIDRange(NodeByLabelScan *op, UnsignedRange *id_range)
 	op->op.name = "Node By Label and ID Scan";
 }
 
+void NodeByLabelScanOp_AddColumnFilter(NodeByLabelScan *op, ColumnFilter filter) {
+	if(op->filters == NULL) {
+		op->filters = array_new(ColumnFilter, 1);
+		op->batch = rm_malloc(sizeof(GrB_Index) * COLUMN_SCAN_BATCH_SIZE);
+	}
+	op->filters = array_append(op->filters, filter);
+}
+
+static void _ResolveColumnFilters(NodeByLabelScan *op, Schema *schema) {
+	op->batch_count = 0;
+	op->batch_idx = 0;
+	op->iter_depleted = false;
+	if(op->filters == NULL) return;
+
+	// Attributes and columns might have been introduced since the previous resolution.
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint filter_count = array_len(op->filters);
+	for(uint i = 0; i < filter_count; i++) ColumnFilter_Resolve(op->filters + i, gc, schema);
+}
+
 static GrB_Info _ConstructIterator(NodeByLabelScan *op, Schema *schema) {
 	GraphContext *gc = QueryCtx_GetGraphCtx();
 	GxB_MatrixTupleIter_new(&op->iter, Graph_GetLabelMatrix(gc->g, schema->id));
 	NodeID minId = op->id_range->include_min ? op->id_range->min : op->id_range->min + 1;
 	NodeID maxId = op->id_range->include_max ? op->id_range->max : op->id_range->max - 1;
+	_ResolveColumnFilters(op, schema);
 	return GxB_MatrixTupleIter_iterate_range(op->iter, minId, maxId);
 }
 
@@ -102,16 +129,53 @@ static inline void _UpdateRecord(NodeByLabelScan *op, Record r, GrB_Index node_i
 static inline void _ResetIterator(NodeByLabelScan *op) {
 	NodeID minId = op->id_range->include_min ? op->id_range->min : op->id_range->min + 1;
 	NodeID maxId = op->id_range->include_max ? op->id_range->max : op->id_range->max - 1 ;
+	op->batch_count = 0;
+	op->batch_idx = 0;
+	op->iter_depleted = false;
 	GxB_MatrixTupleIter_iterate_range(op->iter, minId, maxId);
 }
 
+/* Retrieves the next scanned node ID, returns false once depleted.
+ * If column filters are set, node IDs are read in batches
+ * to which each filter is applied in turn. */
+static bool _NextNodeID(NodeByLabelScan *op, GrB_Index *node_id) {
+	if(op->filters == NULL) {
+		bool depleted = true;
+		GxB_MatrixTupleIter_next(op->iter, NULL, node_id, &depleted);
+		return !depleted;
+	}
+
+	while(op->batch_idx == op->batch_count) {
+		if(op->iter_depleted) return false;
+
+		op->batch_count = 0;
+		op->batch_idx = 0;
+		while(op->batch_count < COLUMN_SCAN_BATCH_SIZE) {
+			bool depleted = true;
+			GxB_MatrixTupleIter_next(op->iter, NULL, op->batch + op->batch_count, &depleted);
+			if(depleted) {
+				op->iter_depleted = true;
+				break;
+			}
+			op->batch_count++;
+		}
+
+		uint filter_count = array_len(op->filters);
+		for(uint i = 0; i < filter_count && op->batch_count > 0; i++) {
+			ColumnFilter_Apply(op->filters + i, op->g, op->batch, &op->batch_count);
+		}
+	}
+
+	*node_id = op->batch[op->batch_idx++];
+	return true;
+}
+
 static Record NodeByLabelScanConsumeFromChild(OpBase *opBase) {
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
 
 	// Try to get new nodeID.
 	GrB_Index nodeId;
-	bool depleted = true;
-	GxB_MatrixTupleIter_next(op->iter, NULL, &nodeId, &depleted);
+	bool depleted = (op->iter == NULL || !_NextNodeID(op, &nodeId));
 	/* depleted will be true in the following cases:
 	 * 1. No iterator: GxB_MatrixTupleIter_next will fail and depleted will stay true. This scenario means
 	 * that there was no consumption of a record from a child, otherwise there was an iterator.
@@ -135,10 +199,15 @@ static Record NodeByLabelScanConsumeFromChild(OpBase *opBase) {
 		} else {
 			// Iterator depleted - reset.
 			// TODO: GxB_MatrixTupleIter_reset
+			if(op->filters) {
+				// Filtered attributes might have been introduced by the child.
+				GraphContext *gc = QueryCtx_GetGraphCtx();
+				_ResolveColumnFilters(op, GraphContext_GetSchema(gc, op->n.label, SCHEMA_NODE));
+			}
 			_ResetIterator(op);
 		}
 		// Try to get new NodeID.
-		GxB_MatrixTupleIter_next(op->iter, NULL, &nodeId, &depleted);
+		depleted = (op->iter == NULL || !_NextNodeID(op, &nodeId));
 	}
 
 	// We've got a record and NodeID.
@@ -153,9 +222,7 @@ static Record NodeByLabelScanConsume(OpBase *opBase) {
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
 
 	GrB_Index nodeId;
-	bool depleted = false;
-	GxB_MatrixTupleIter_next(op->iter, NULL, &nodeId, &depleted);
-	if(depleted) return NULL;
+	if(!_NextNodeID(op, &nodeId)) return NULL;
 
 	Record r = OpBase_CreateRecord((OpBase *)op);
 
@@ -185,6 +252,13 @@ static OpBase *NodeByLabelScanClone(const ExecutionPlan *plan, const OpBase *opB
 	ASSERT(opBase->type == OPType_NODE_BY_LABEL_SCAN);
 	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
 	OpBase *clone = NewNodeByLabelScanOp(plan, op->n);
+	if(op->filters) {
+		uint filter_count = array_len(op->filters);
+		for(uint i = 0; i < filter_count; i++) {
+			NodeByLabelScanOp_AddColumnFilter((NodeByLabelScan *)clone,
+											  ColumnFilter_Clone(op->filters + i));
+		}
+	}
 	return clone;
 }
 
@@ -205,5 +279,17 @@ static void NodeByLabelScanFree(OpBase *op) {
 		UnsignedRange_Free(nodeByLabelScan->id_range);
 		nodeByLabelScan->id_range = NULL;
 	}
+
+	if(nodeByLabelScan->filters) {
+		uint filter_count = array_len(nodeByLabelScan->filters);
+		for(uint i = 0; i < filter_count; i++) ColumnFilter_Free(nodeByLabelScan->filters + i);
+		array_free(nodeByLabelScan->filters);
+		nodeByLabelScan->filters = NULL;
+	}
+
+	if(nodeByLabelScan->batch) {
+		rm_free(nodeByLabelScan->batch);
+		nodeByLabelScan->batch = NULL;
+	}
 }
 
@@ -8,6 +8,7 @@
 
 #include "op.h"
 #include "shared/scan_functions.h"
+#include "shared/column_filter_functions.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../graph/entities/node.h"
@@ -16,6 +17,9 @@
 
 /* NodeByLabelScan, scans entire label. */
 
+// Number of scanned node IDs column filters are applied to at once.
+#define COLUMN_SCAN_BATCH_SIZE 1024
+
 typedef struct {
 	OpBase op;
 	Graph *g;
@@ -24,6 +28,11 @@ typedef struct {
 	UnsignedRange *id_range;    /* ID range to iterate over. */
 	GxB_MatrixTupleIter *iter;
 	Record child_record;        /* The Record this op acts on if it is not a tap. */
+	ColumnFilter *filters;      /* Attribute filters evaluated over the label's columns. */
+	GrB_Index *batch;           /* Scanned node IDs which passed all column filters. */
+	uint batch_count;           /* Number of node IDs in batch. */
+	uint batch_idx;             /* Position of next node ID within batch. */
+	bool iter_depleted;         /* The iterator was depleted while filling the batch. */
 } NodeByLabelScan;
 
 /* Creates a new NodeByLabelScan operation */
@@ -32,3 +41,6 @@ OpBase *NewNodeByLabelScanOp(const ExecutionPlan *plan, NodeScanCtx n);
 /* Transform a simple label scan to perform additional range query over the label  matrix. */
 void NodeByLabelScanOp_SetIDRange(NodeByLabelScan *op, UnsignedRange *id_range);
 
+/* Filter scanned nodes by an attribute comparison, evaluated over the label's columns. */
+void NodeByLabelScanOp_AddColumnFilter(NodeByLabelScan *op, ColumnFilter filter);
+
@@ -0,0 +1,379 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_parallel_aggregate.h"
+#include "RG.h"
+#include "op_aggregate.h"
+#include "op_all_node_scan.h"
+#include "op_node_by_label_scan.h"
+#include "../../errors.h"
+#include "../execution_plan_clone.h"
+#include "../../util/thpool/thpool.h"
+#include "../../util/range/unsigned_range.h"
+#include "../../arithmetic/aggregate_funcs/agg_funcs.h"
+
+// number of node IDs claimed by a worker at a time
+#define MORSEL_SIZE 16384
+
+extern threadpool _parallel_thpool; // Declared in module.c
+
+/* Forward declarations. */
+static OpResult ParallelAggregateInit(OpBase *opBase);
+static Record ParallelAggregateConsume(OpBase *opBase);
+static Record ParallelAggregateConsumeSerial(OpBase *opBase);
+static OpResult ParallelAggregateReset(OpBase *opBase);
+static OpBase *ParallelAggregateClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void ParallelAggregateFree(OpBase *opBase);
+
+// Determine how partial results of aggregate expression exp are combined.
+// Returns false if exp can't be computed from partial results.
+static bool _PartialCombine(const AR_ExpNode *exp, PartialCombine *combine) {
+	if(exp->type != AR_EXP_OP || !exp->op.f->aggregate) return false;
+	if(Aggregate_PerformsDistinct(exp->op.f->privdata)) return false;
+
+	const char *func_name = exp->op.func_name;
+	if(!strcasecmp(func_name, "count") || !strcasecmp(func_name, "sum")) {
+		*combine = PARTIAL_COMBINE_SUM;
+	} else if(!strcasecmp(func_name, "min")) {
+		*combine = PARTIAL_COMBINE_MIN;
+	} else if(!strcasecmp(func_name, "max")) {
+		*combine = PARTIAL_COMBINE_MAX;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+bool ParallelAggregate_Combinable(const OpBase *op) {
+	if(op->type != OPType_AGGREGATE) return false;
+
+	// Grouped aggregations are not supported.
+	const OpAggregate *aggregate = (const OpAggregate *)op;
+	if(aggregate->key_count != 0) return false;
+
+	PartialCombine combine;
+	for(uint i = 0; i < aggregate->aggregate_count; i++) {
+		if(!_PartialCombine(aggregate->aggregate_exps[i], &combine)) return false;
+	}
+
+	return true;
+}
+
+// Combine partial aggregate v into acc, v is not modified.
+static void _CombinePartial(PartialCombine combine, SIValue *acc, SIValue v) {
+	// NULL partials, e.g. min over NULL values, do not contribute.
+	if(SI_TYPE(v) == T_NULL) return;
+
+	if(SI_TYPE(*acc) == T_NULL) {
+		*acc = SI_CloneValue(v);
+		return;
+	}
+
+	int disjoint;
+	switch(combine) {
+	case PARTIAL_COMBINE_SUM:
+		if(SI_TYPE(*acc) == T_INT64 && SI_TYPE(v) == T_INT64) acc->longval += v.longval;
+		else *acc = SI_DoubleVal(SI_GET_NUMERIC(*acc) + SI_GET_NUMERIC(v));
+		break;
+	case PARTIAL_COMBINE_MIN:
+		if(SIValue_Compare(*acc, v, &disjoint) > 0) {
+			SIValue_Free(*acc);
+			*acc = SI_CloneValue(v);
+		}
+		break;
+	case PARTIAL_COMBINE_MAX:
+		if(SIValue_Compare(*acc, v, &disjoint) < 0) {
+			SIValue_Free(*acc);
+			*acc = SI_CloneValue(v);
+		}
+		break;
+	default:
+		ASSERT("Unknown partial combine function" && false);
+	}
+}
+
+static void _CombineRecord(OpParallelAggregate *op, MorselWorker *w, Record r) {
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		SIValue v = Record_Get(r, op->record_offsets[i]);
+		_CombinePartial(op->combine[i], w->partials + i, v);
+	}
+	w->produced = true;
+}
+
+static void _ResetPartials(OpParallelAggregate *op, MorselWorker *w) {
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		SIValue_Free(w->partials[i]);
+		w->partials[i] = SI_NullVal();
+	}
+	w->produced = false;
+}
+
+// Restrict scan to node IDs in the range [start, end).
+static void _SetMorsel(OpBase *scan, uint64_t start, uint64_t end) {
+	UnsignedRange *range = UnsignedRange_New();
+	range->min = start;
+	range->max = end;
+	range->include_min = true;
+	range->include_max = false;
+
+	if(scan->type == OPType_ALL_NODE_SCAN) AllNodeScanOp_SetIDRange((AllNodeScan *)scan, range);
+	else NodeByLabelScanOp_SetIDRange((NodeByLabelScan *)scan, range);
+
+	UnsignedRange_Free(range);
+}
+
+// Claim and aggregate morsels until the node ID range is exhausted.
+static void _ProcessMorsels(OpParallelAggregate *op, MorselWorker *w) {
+	while(true) {
+		uint64_t start = __atomic_fetch_add(&op->next_morsel, MORSEL_SIZE, __ATOMIC_RELAXED);
+		if(start >= op->max_id) break;
+		uint64_t end = MIN(start + MORSEL_SIZE, op->max_id);
+
+		_SetMorsel(w->scan, start, end);
+		OpBase_PropagateReset(w->root);
+
+		// A key-less aggregation produces at most a single record.
+		Record r = OpBase_Consume(w->root);
+		if(r) {
+			_CombineRecord(op, w, r);
+			OpBase_DeleteRecord(r);
+		}
+	}
+}
+
+// Stop workers from claiming additional morsels.
+static inline void _AbortMorsels(OpParallelAggregate *op) {
+	__atomic_store_n(&op->next_morsel, op->max_id, __ATOMIC_RELAXED);
+}
+
+// Thread pool job, processes morsels using a cloned pipeline.
+static void _RunWorker(void *arg) {
+	MorselWorker *w = arg;
+	OpParallelAggregate *op = w->op;
+	QueryCtx_SetTLS(op->query_ctx);
+
+	// Capture run-time errors raised while processing morsels.
+	int encountered_error = SET_EXCEPTION_HANDLER();
+	if(!encountered_error) {
+		_ProcessMorsels(op, w);
+	} else {
+		_AbortMorsels(op);
+		ErrorCtx *error_ctx = ErrorCtx_Get();
+		pthread_mutex_lock(&op->lock);
+		if(op->error == NULL && error_ctx->error) op->error = rm_strdup(error_ctx->error);
+		pthread_mutex_unlock(&op->lock);
+	}
+
+	ErrorCtx_Clear();
+	QueryCtx_RemoveFromTLS();
+
+	pthread_mutex_lock(&op->lock);
+	op->pending--;
+	pthread_cond_signal(&op->done);
+	pthread_mutex_unlock(&op->lock);
+}
+
+OpBase *NewParallelAggregateOp(const ExecutionPlan *plan) {
+	OpParallelAggregate *op = rm_malloc(sizeof(OpParallelAggregate));
+	op->error = NULL;
+	op->pending = 0;
+	op->max_id = 0;
+	op->combine = NULL;
+	op->workers = NULL;
+	op->emitted = false;
+	op->query_ctx = NULL;
+	op->next_morsel = 0;
+	op->worker_count = 0;
+	op->aggregate_count = 0;
+	op->record_offsets = NULL;
+
+	OpBase_Init((OpBase *)op, OPType_PARALLEL_AGGREGATE, "Parallel Aggregate",
+				ParallelAggregateInit, ParallelAggregateConsume, ParallelAggregateReset, NULL,
+				ParallelAggregateClone, ParallelAggregateFree, false, plan);
+
+	return (OpBase *)op;
+}
+
+static OpResult ParallelAggregateInit(OpBase *opBase) {
+	OpParallelAggregate *op = (OpParallelAggregate *)opBase;
+	ASSERT(opBase->childCount == 1);
+	ASSERT(ParallelAggregate_Combinable(opBase->children[0]));
+
+	OpAggregate *aggregate = (OpAggregate *)opBase->children[0];
+	op->aggregate_count = aggregate->aggregate_count;
+	op->record_offsets = rm_malloc(op->aggregate_count * sizeof(uint));
+	op->combine = rm_malloc(op->aggregate_count * sizeof(PartialCombine));
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		op->record_offsets[i] = aggregate->record_offsets[aggregate->key_count + i];
+		_PartialCombine(aggregate->aggregate_exps[i], op->combine + i);
+	}
+
+	// Parallelize only if the scanned ID range spans multiple morsels.
+	uint thread_count = (_parallel_thpool) ? thpool_num_threads(_parallel_thpool) : 0;
+	op->max_id = Graph_RequiredMatrixDim(QueryCtx_GetGraph());
+	if(thread_count == 0 || op->max_id < 2 * MORSEL_SIZE) {
+		OpBase_UpdateConsume(opBase, ParallelAggregateConsumeSerial);
+		return OP_OK;
+	}
+
+	op->query_ctx = QueryCtx_GetQueryCtx();
+	pthread_mutex_init(&op->lock, NULL);
+	pthread_cond_init(&op->done, NULL);
+
+	/* The first worker is driven by the calling thread over this op's own child,
+	 * which has not been initialized yet and is therefore safe to clone. */
+	op->worker_count = thread_count + 1;
+	op->workers = rm_calloc(op->worker_count, sizeof(MorselWorker));
+	for(uint i = 0; i < op->worker_count; i++) {
+		MorselWorker *w = op->workers + i;
+		w->op = op;
+		w->partials = rm_malloc(op->aggregate_count * sizeof(SIValue));
+		for(uint j = 0; j < op->aggregate_count; j++) w->partials[j] = SI_NullVal();
+
+		if(i == 0) {
+			w->root = (OpBase *)aggregate;
+		} else {
+			w->plan = ExecutionPlan_CloneOpTree((OpBase *)aggregate);
+			ExecutionPlan_Init(w->plan);
+			w->root = w->plan->root;
+		}
+
+		// The scan is the only leaf of the pipeline.
+		w->scan = w->root;
+		while(w->scan->childCount > 0) w->scan = w->scan->children[0];
+	}
+
+	return OP_OK;
+}
+
+static Record ParallelAggregateConsume(OpBase *opBase) {
+	OpParallelAggregate *op = (OpParallelAggregate *)opBase;
+	if(op->emitted) return NULL;
+	op->emitted = true;
+
+	op->next_morsel = 0;
+	op->pending = op->worker_count - 1;
+	for(uint i = 1; i < op->worker_count; i++) {
+		if(thpool_add_work(_parallel_thpool, _RunWorker, op->workers + i) != 0) {
+			pthread_mutex_lock(&op->lock);
+			op->pending--;
+			pthread_mutex_unlock(&op->lock);
+		}
+	}
+
+	/* The calling thread processes morsels as well, run-time errors must not
+	 * unwind past this point while workers are active, temporarily replace
+	 * the current exception handler. */
+	ErrorCtx *error_ctx = ErrorCtx_Get();
+	jmp_buf *breakpoint = error_ctx->breakpoint;
+	jmp_buf outer;
+	if(breakpoint) memcpy(&outer, breakpoint, sizeof(jmp_buf));
+
+	int encountered_error = SET_EXCEPTION_HANDLER();
+	if(!encountered_error) _ProcessMorsels(op, op->workers);
+	else _AbortMorsels(op);
+
+	// Restore the original exception handler.
+	if(breakpoint) {
+		memcpy(breakpoint, &outer, sizeof(jmp_buf));
+	} else {
+		rm_free(error_ctx->breakpoint);
+		error_ctx->breakpoint = NULL;
+	}
+
+	// Wait for all workers to finish.
+	pthread_mutex_lock(&op->lock);
+	while(op->pending > 0) pthread_cond_wait(&op->done, &op->lock);
+	pthread_mutex_unlock(&op->lock);
+
+	if(encountered_error) {
+		// Error is already set within this thread's error context.
+		ErrorCtx_RaiseRuntimeException(NULL);
+		return NULL;
+	}
+
+	if(op->error) {
+		ErrorCtx_RaiseRuntimeException("%s", op->error);
+		return NULL;
+	}
+
+	// Combine partial aggregates into the first worker's.
+	MorselWorker *result = op->workers;
+	for(uint i = 1; i < op->worker_count; i++) {
+		MorselWorker *w = op->workers + i;
+		if(!w->produced) continue;
+		for(uint j = 0; j < op->aggregate_count; j++) {
+			_CombinePartial(op->combine[j], result->partials + j, w->partials[j]);
+		}
+		result->produced = true;
+	}
+
+	// Just like Aggregate, no input produces no output.
+	if(!result->produced) return NULL;
+
+	Record r = OpBase_CreateRecord(opBase);
+	for(uint i = 0; i < op->aggregate_count; i++) {
+		// The record takes ownership over the combined value.
+		Record_AddScalar(r, op->record_offsets[i], result->partials[i]);
+		result->partials[i] = SI_NullVal();
+	}
+
+	return r;
+}
+
+// Scanned ID range is too small to split, pass through the aggregation.
+static Record ParallelAggregateConsumeSerial(OpBase *opBase) {
+	return OpBase_Consume(opBase->children[0]);
+}
+
+static OpResult ParallelAggregateReset(OpBase *opBase) {
+	OpParallelAggregate *op = (OpParallelAggregate *)opBase;
+	op->emitted = false;
+	for(uint i = 0; i < op->worker_count; i++) _ResetPartials(op, op->workers + i);
+	return OP_OK;
+}
+
+static inline OpBase *ParallelAggregateClone(const ExecutionPlan *plan, const OpBase *opBase) {
+	// The operation holds no planning state, opBase is only inspected by debug builds.
+	UNUSED(opBase);
+	ASSERT(opBase->type == OPType_PARALLEL_AGGREGATE);
+	return NewParallelAggregateOp(plan);
+}
+
+static void ParallelAggregateFree(OpBase *opBase) {
+	OpParallelAggregate *op = (OpParallelAggregate *)opBase;
+
+	if(op->workers) {
+		for(uint i = 0; i < op->worker_count; i++) {
+			MorselWorker *w = op->workers + i;
+			_ResetPartials(op, w);
+			rm_free(w->partials);
+			// The first worker's pipeline is freed as part of the execution plan.
+			if(w->plan) ExecutionPlan_Free(w->plan);
+		}
+		rm_free(op->workers);
+		op->workers = NULL;
+
+		pthread_mutex_destroy(&op->lock);
+		pthread_cond_destroy(&op->done);
+	}
+
+	if(op->record_offsets) {
+		rm_free(op->record_offsets);
+		op->record_offsets = NULL;
+	}
+
+	if(op->combine) {
+		rm_free(op->combine);
+		op->combine = NULL;
+	}
+
+	if(op->error) {
+		rm_free(op->error);
+		op->error = NULL;
+	}
+}
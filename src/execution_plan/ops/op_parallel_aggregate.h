@@ -0,0 +1,57 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../query_ctx.h"
+#include <pthread.h>
+
+/* Parallel Aggregate
+ * Splits the node ID range scanned beneath a key-less aggregation into
+ * morsels which are claimed by worker threads, each running its own clone
+ * of the aggregation pipeline. Partial aggregates are combined once all
+ * morsels are processed. */
+
+// How partial results of an aggregate function are combined.
+typedef enum {
+	PARTIAL_COMBINE_SUM,    // count, sum
+	PARTIAL_COMBINE_MIN,    // min
+	PARTIAL_COMBINE_MAX,    // max
+} PartialCombine;
+
+typedef struct {
+	OpBase *root;           // Aggregate operation of this worker's pipeline.
+	OpBase *scan;           // Scan operation at the bottom of the pipeline.
+	ExecutionPlan *plan;    // Cloned pipeline, NULL for the calling thread.
+	SIValue *partials;      // Combined partial aggregates.
+	bool produced;          // True if any morsel produced a partial aggregate.
+	void *op;               // Owning OpParallelAggregate.
+} MorselWorker;
+
+typedef struct {
+	OpBase op;
+	uint aggregate_count;       // Number of aggregate functions.
+	uint *record_offsets;       // Record offset of each aggregate function.
+	PartialCombine *combine;    // Combine function of each aggregate function.
+	MorselWorker *workers;      // Workers, the first is driven by the calling thread.
+	uint worker_count;          // Number of workers, 0 if executing serially.
+	uint64_t next_morsel;       // First node ID of the next unclaimed morsel.
+	uint64_t max_id;            // Upper bound on scanned node IDs.
+	QueryCtx *query_ctx;        // Query context shared with worker threads.
+	char *error;                // First error encountered by a worker thread.
+	uint pending;               // Number of worker threads yet to finish.
+	pthread_mutex_t lock;       // Guards pending and error.
+	pthread_cond_t done;        // Signaled when a worker thread finishes.
+	bool emitted;               // True once the combined record was returned.
+} OpParallelAggregate;
+
+OpBase *NewParallelAggregateOp(const ExecutionPlan *plan);
+
+/* Returns true if the aggregation performed by op can be computed
+ * by combining partial aggregations. */
+bool ParallelAggregate_Combinable(const OpBase *op);
@@ -13,6 +13,7 @@
 
 /* Forward declarations. */
 static Record ResultsConsume(OpBase *opBase);
+static uint ResultsConsumeBatch(OpBase *opBase, Record *batch, uint cap);
 static OpResult ResultsInit(OpBase *opBase);
 static OpBase *ResultsClone(const ExecutionPlan *plan, const OpBase *opBase);
 
@@ -22,13 +23,13 @@ OpBase *NewResultsOp(const ExecutionPlan *plan) {
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_RESULTS, "Results", ResultsInit, ResultsConsume,
 				NULL, NULL, ResultsClone, NULL, false, plan);
+	OpBase_SetConsumeBatch((OpBase *)op, ResultsConsumeBatch);
 
 	return (OpBase *)op;
 }
 
 static OpResult ResultsInit(OpBase *opBase) {
 	Results *op = (Results *)opBase;
-	op->result_set = QueryCtx_GetResultSet();
 	Config_Option_get(Config_RESULTSET_MAX_SIZE, &op->result_set_size_limit);
 	return OP_OK;
 }
@@ -38,20 +39,42 @@ static OpResult ResultsInit(OpBase *opBase) {
 static Record ResultsConsume(OpBase *opBase) {
 	Record r = NULL;
 	Results *op = (Results *)opBase;
+	// a resumed cursor replies with a new result-set
+	ResultSet *result_set = QueryCtx_GetResultSet();
 
 	// enforce result-set size limit
 	if(op->result_set_size_limit == 0) return NULL;
-	op->result_set_size_limit--;
+	// stop once the result-set is full, leaving the remaining records for a cursor
+	if(ResultSet_Capacity(result_set) == 0) return NULL;
 
 	OpBase *child = op->op.children[0];
 	r = OpBase_Consume(child);
 	if(!r) return NULL;
 
 	// append to final result set
-	ResultSet_AddRecord(op->result_set, r);
+	op->result_set_size_limit--;
+	ResultSet_AddRecord(result_set, r);
 	return r;
 }
 
+static uint ResultsConsumeBatch(OpBase *opBase, Record *batch, uint cap) {
+	Results *op = (Results *)opBase;
+	ResultSet *result_set = QueryCtx_GetResultSet();
+
+	// enforce result-set size limit
+	if(cap > op->result_set_size_limit) cap = op->result_set_size_limit;
+	if(cap > ResultSet_Capacity(result_set)) cap = ResultSet_Capacity(result_set);
+	if(cap == 0) return 0;
+
+	OpBase *child = op->op.children[0];
+	uint count = OpBase_ConsumeBatch(child, batch, cap);
+	op->result_set_size_limit -= count;
+
+	// append to final result set
+	for(uint i = 0; i < count; i++) ResultSet_AddRecord(result_set, batch[i]);
+	return count;
+}
+
 static inline OpBase *ResultsClone(const ExecutionPlan *plan, const OpBase *opBase) {
 	ASSERT(opBase->type == OPType_RESULTS);
 	return NewResultsOp(plan);
@@ -16,7 +16,6 @@
 
 typedef struct {
 	OpBase op;
-	ResultSet *result_set;
 	uint64_t result_set_size_limit;
 } Results;
 
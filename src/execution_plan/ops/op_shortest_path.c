@@ -0,0 +1,153 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_shortest_path.h"
+#include "shared/traverse_functions.h"
+#include "../../util/arr.h"
+#include "../../ast/ast.h"
+#include "../../graph/graphcontext.h"
+#include "../../query_ctx.h"
+
+/* Forward declarations. */
+static Record ShortestPathConsume(OpBase *opBase);
+static OpResult ShortestPathReset(OpBase *opBase);
+static OpBase *ShortestPathClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void ShortestPathFree(OpBase *opBase);
+
+static int ShortestPathToString(const OpBase *ctx, char *buf, uint buf_len) {
+	const ShortestPath *op = (const ShortestPath *)ctx;
+	const QueryGraph *qg = ctx->plan->query_graph;
+	QGEdge *e = QueryGraph_GetEdgeByAlias(qg, op->edge);
+
+	int offset = snprintf(buf, buf_len, "%s | ", ctx->name);
+	offset += QGNode_ToString(e->src, buf + offset, buf_len - offset);
+	offset += snprintf(buf + offset, buf_len - offset, "-");
+	offset += QGEdge_ToString(e, buf + offset, buf_len - offset);
+	offset += snprintf(buf + offset, buf_len - offset, e->bidirectional ? "-" : "->");
+	offset += QGNode_ToString(e->dest, buf + offset, buf_len - offset);
+	return offset;
+}
+
+OpBase *NewShortestPathOp(const ExecutionPlan *plan, Graph *g, const QGEdge *e) {
+	ASSERT(g != NULL);
+	ASSERT(e != NULL);
+	ASSERT(e->shortest_path);
+
+	ShortestPath *op = rm_malloc(sizeof(ShortestPath));
+	op->g = g;
+	op->r = NULL;
+	op->edge = e->alias;
+	op->single = !e->all_shortest_paths;
+	op->minHops = e->minHops;
+	op->maxHops = e->maxHops;
+	op->edgeRelationCount = 0;
+	op->edgeRelationTypes = NULL;
+	op->shortestPathCtx = NULL;
+	op->traverseDir = e->bidirectional ? GRAPH_EDGE_DIR_BOTH : GRAPH_EDGE_DIR_OUTGOING;
+
+	const char *name = op->single ? "Shortest Path" : "All Shortest Paths";
+	OpBase_Init((OpBase *)op, OPType_SHORTEST_PATH, name, NULL, ShortestPathConsume,
+				ShortestPathReset, ShortestPathToString, ShortestPathClone, ShortestPathFree,
+				false, plan);
+
+	// Both endpoints are resolved prior to computing the shortest path.
+	bool aware = OpBase_Aware((OpBase *)op, e->src->alias, &op->srcNodeIdx);
+	ASSERT(aware);
+	aware = OpBase_Aware((OpBase *)op, e->dest->alias, &op->destNodeIdx);
+	ASSERT(aware);
+	UNUSED(aware);
+
+	// populate path value in record only if it is referenced
+	AST *ast = QueryCtx_GetAST();
+	op->edgesIdx = AST_AliasIsReferenced(ast, e->alias) ? OpBase_Modifies((OpBase *)op, e->alias) : -1;
+
+	return (OpBase *)op;
+}
+
+static Record ShortestPathConsume(OpBase *opBase) {
+	ShortestPath *op = (ShortestPath *)opBase;
+	OpBase *child = op->op.children[0];
+	bool reused_record = true;
+	Path *p = NULL;
+
+	while(!(p = ShortestPathCtx_NextPath(op->shortestPathCtx))) {
+		reused_record = false;
+		Record childRecord = OpBase_Consume(child);
+		if(!childRecord) return NULL;
+
+		if(op->r) OpBase_DeleteRecord(op->r);
+		op->r = childRecord;
+
+		Node *srcNode = Record_GetNode(op->r, op->srcNodeIdx);
+		Node *destNode = Record_GetNode(op->r, op->destNodeIdx);
+		if(srcNode == NULL || destNode == NULL) {
+			/* The child Record may not contain either endpoint in scenarios like
+			 * a failed OPTIONAL MATCH. In this case, delete the Record and try again. */
+			OpBase_DeleteRecord(op->r);
+			op->r = NULL;
+			continue;
+		}
+
+		// Create edge relation type array on first call to consume.
+		if(!op->edgeRelationTypes) {
+			QGEdge *e = QueryGraph_GetEdgeByAlias(op->op.plan->query_graph, op->edge);
+			op->edgeRelationTypes = Traverse_RelationTypes(e);
+			op->edgeRelationCount = array_len(op->edgeRelationTypes);
+		}
+
+		ShortestPathCtx_Free(op->shortestPathCtx);
+		op->shortestPathCtx = ShortestPathCtx_New(srcNode, destNode, op->g, op->edgeRelationTypes,
+												  op->edgeRelationCount, op->traverseDir,
+												  op->minHops, op->maxHops, op->single);
+	}
+
+	if(op->edgesIdx >= 0) {
+		// If we're returning a new path from a previously-used Record,
+		// free the previous path to avoid a memory leak.
+		if(reused_record) SIValue_Free(Record_Get(op->r, op->edgesIdx));
+		// Add new path to Record.
+		Record_AddScalar(op->r, op->edgesIdx, SI_Path(p));
+	}
+
+	return OpBase_CloneRecord(op->r);
+}
+
+static OpResult ShortestPathReset(OpBase *ctx) {
+	ShortestPath *op = (ShortestPath *)ctx;
+	if(op->r) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+	ShortestPathCtx_Free(op->shortestPathCtx);
+	op->shortestPathCtx = NULL;
+	return OP_OK;
+}
+
+static OpBase *ShortestPathClone(const ExecutionPlan *plan, const OpBase *opBase) {
+	ASSERT(opBase->type == OPType_SHORTEST_PATH);
+	ShortestPath *op = (ShortestPath *)opBase;
+	QGEdge *e = QueryGraph_GetEdgeByAlias(plan->query_graph, op->edge);
+	return NewShortestPathOp(plan, QueryCtx_GetGraph(), e);
+}
+
+static void ShortestPathFree(OpBase *ctx) {
+	ShortestPath *op = (ShortestPath *)ctx;
+
+	if(op->edgeRelationTypes) {
+		array_free(op->edgeRelationTypes);
+		op->edgeRelationTypes = NULL;
+	}
+
+	if(op->r) {
+		OpBase_DeleteRecord(op->r);
+		op->r = NULL;
+	}
+
+	if(op->shortestPathCtx) {
+		ShortestPathCtx_Free(op->shortestPathCtx);
+		op->shortestPathCtx = NULL;
+	}
+}
@@ -0,0 +1,35 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../graph/entities/qg_edge.h"
+#include "../../algorithms/algorithms.h"
+
+/* OP Shortest Path
+ * Resolves shortestPath and allShortestPaths patterns
+ * between two already bound nodes. */
+typedef struct {
+	OpBase op;
+	Graph *g;
+	Record r;
+	const char *edge;               /* Alias of the shortest path edge. */
+	int srcNodeIdx;                 /* Source node record index. */
+	int destNodeIdx;                /* Destination node record index. */
+	int edgesIdx;                   /* Path set by operation. */
+	bool single;                    /* Produce a single path per source and destination. */
+	unsigned int minHops;           /* Minimum number of hops to perform. */
+	unsigned int maxHops;           /* Maximum number of hops to perform. */
+	int edgeRelationCount;          /* Length of edgeRelationTypes. */
+	int *edgeRelationTypes;         /* Relation(s) we're traversing. */
+	ShortestPathCtx *shortestPathCtx;
+	GRAPH_EDGE_DIR traverseDir;     /* Traverse direction. */
+} ShortestPath;
+
+OpBase *NewShortestPathOp(const ExecutionPlan *plan, Graph *g, const QGEdge *e);
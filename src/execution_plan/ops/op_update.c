@@ -31,6 +31,9 @@ static int _UpdateEntity(GraphEntity *ge, PendingUpdateCtx *update) {
 		goto cleanup;
 	}
 
+	// Snapshots keep reading the entity's current properties.
+	Graph_PrepareEntityWrite(QueryCtx_GetGraph(), update->entity_type, ENTITY_GET_ID(ge));
+
 	// Try to get current property value.
 	SIValue *old_value = GraphEntity_GetProperty(ge, attr_id);
 
@@ -46,6 +49,12 @@ static int _UpdateEntity(GraphEntity *ge, PendingUpdateCtx *update) {
 		GraphEntity_SetProperty(ge, attr_id, new_value);
 	}
 
+	EffectsBuffer *effects = QueryCtx_GetEffectsBuffer();
+	if(effects) {
+		EffectsBuffer_AddSetPropertyEffect(effects, QueryCtx_GetGraphCtx(), ge, update->entity_type,
+										   attr_id, new_value);
+	}
+
 cleanup:
 	SIValue_Free(new_value);
 	return res;
@@ -281,8 +290,10 @@ static void _EvalEntityUpdates(EntityUpdateCtx *ctx, GraphContext *gc,
 		/* Determine whether we must update the index for this set of updates.
 		 * If at least one property being updated is indexed, each node will be reindexed. */
 		if(!update_index && label) {
-			// If the label-index combination has an index, we must reindex this entity.
-			update_index = GraphContext_GetIndex(gc, label, &attr_id, IDX_ANY) != NULL;
+			// If the label-index combination has an index or a column, we must reindex this entity.
+			Schema *label_schema = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+			update_index = GraphContext_GetIndex(gc, label, &attr_id, IDX_ANY) != NULL ||
+						   (label_schema && Schema_HasColumn(label_schema, attr_id));
 			if(update_index && (i > 0)) {
 				/* Swap the current update expression with the first one
 				 * so that subsequent searches will find the index immediately.
@@ -5,10 +5,12 @@
 */
 
 #include "op_value_hash_join.h"
+#include "op_node_by_label_scan.h"
 #include "../../value.h"
+#include "../../query_ctx.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
-#include "../../util/qsort.h"
+#include "../execution_plan_build/execution_plan_modify.h"
 
 /* Forward declarations. */
 static OpResult ValueHashJoinInit(OpBase *opBase);
@@ -17,82 +19,44 @@ static OpResult ValueHashJoinReset(OpBase *opBase);
 static OpBase *ValueHashJoinClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void ValueHashJoinFree(OpBase *opBase);
 
-/* Determins order between two records by inspecting
- * element stored at postion idx. */
-static bool _record_islt(Record l, Record r, uint idx) {
-	SIValue lv = Record_Get(l, idx);
-	SIValue rv = Record_Get(r, idx);
-	return SIValue_Compare(lv, rv, NULL) < 0;
-}
-
-/* `idx` is an actual variable in the caller function.
- * Using it in a macro like this is rather ugly,
- * but the macro passed to QSORT must accept only 2 arguments. */
-#define RECORD_SORT_ON_ENTRY(a, b) (_record_islt((*a), (*b), idx))
-
-// Performs binary search, returns the leftmost index of a match.
-static bool _binarySearchLeftmost(uint *idx, Record *array, uint array_len,
-								  int join_key_idx, SIValue v) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(x, v, NULL) < 0) left = pos + 1;
-		else right = pos;
-	}
+#define UNKNOWN_STREAM_SIZE UINT64_MAX
 
-	// Make sure value was found.
-	*idx = left;
+// Types which can't be hashed, values of these types all share a single bucket.
+#define UNHASHABLE_TYPES (T_MAP | T_DATETIME | T_LOCALDATETIME | T_DATE | T_TIME | T_LOCALTIME | T_DURATION)
 
-	if(left == array_len) return false;
+static uint64_t _JoinValueHash(const void *key) {
+	SIValue v = *(const SIValue *)key;
+	if(SI_TYPE(v) & UNHASHABLE_TYPES) return SI_TYPE(v);
+	return SIValue_HashCode(v);
+}
 
-	x = Record_Get(array[*idx], join_key_idx);
-	// Return false if the value wasn't found or evaluated to NULL.
+// Returns 1 if both joined values are equal.
+static int _JoinValueCompare(void *privdata, const void *a, const void *b) {
 	int disjointOrNull = 0;
-	return (SIValue_Compare(x, v, &disjointOrNull) == 0 &&
-			disjointOrNull != COMPARED_NULL);
+	int res = SIValue_Compare(*(const SIValue *)a, *(const SIValue *)b, &disjointOrNull);
+	return (res == 0 && disjointOrNull != COMPARED_NULL);
 }
 
-// Performs binary search, returns the rightmost index of a match.
-// assuming 'v' exists in 'array'
-static bool _binarySearchRightmost(uint *idx, Record *array, uint array_len, int join_key_idx,
-								   SIValue v) {
-	ASSERT(idx != NULL);
-
-	SIValue x;
-	uint pos = 0;
-	uint left = 0;
-	uint right = array_len;
-
-	while(left < right) {
-		pos = (right + left) / 2;
-		x = Record_Get(array[pos], join_key_idx);
-		if(SIValue_Compare(v, x, NULL) < 0) right = pos;
-		else left = pos + 1;
-	}
-
-	*idx = right - 1;
-	return true;
-}
+// Hash table of joined values, keys are owned by the cached records.
+static dictType _join_value_dt = {
+	_JoinValueHash,
+	NULL,
+	NULL,
+	_JoinValueCompare,
+	NULL,
+	NULL
+};
 
 /* Retrive the next intersecting record
  * if such exists, otherwise returns NULL. */
 static Record _get_intersecting_record(OpValueHashJoin *op) {
 	// No more intersecting records.
-	if(op->intersect_idx == -1 ||
-	   op->number_of_intersections == 0) return NULL;
+	if(op->intersect_idx == -1) return NULL;
 
 	Record cr = op->cached_records[op->intersect_idx];
 
-	// Update intersection trackers.
-	op->intersect_idx++;
-	op->number_of_intersections--;
+	// Update intersection tracker.
+	op->intersect_idx = op->next_intersection[op->intersect_idx];
 
 	return cr;
 }
@@ -101,71 +65,94 @@ static Record _get_intersecting_record(OpValueHashJoin *op) {
  * Returns false if no intersecting record is found. */
 static bool _set_intersection_idx(OpValueHashJoin *op, SIValue v) {
 	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
-	uint record_count = array_len(op->cached_records);
 
-	uint leftmost_idx = 0;
-	uint rightmost_idx = 0;
+	// NULL values never intersect.
+	if(SIValue_IsNull(v)) return false;
 
-	if(!_binarySearchLeftmost(&leftmost_idx, op->cached_records,
-							  array_len(op->cached_records), op->join_value_rec_idx, v)) {
-		return false;
-	}
-
-	/* Value was found
-	 * idx points to the first intersecting record.
-	 * update number_of_intersections to count how many
-	 * records share the same value. */
-	op->intersect_idx = leftmost_idx;
-
-	/* Count how many records share the same node.
-	 * reduce search space by truncating left bound */
-	bool found = _binarySearchRightmost(&rightmost_idx, op->cached_records +
-								  leftmost_idx, record_count - leftmost_idx,
-								  op->join_value_rec_idx, v);
-	UNUSED(found);
-	ASSERT(found == true);
-
-	// Compensate index.
-	rightmost_idx += leftmost_idx;
-	// +1 consider rightmost_idx == leftmost_idx.
-	op->number_of_intersections = rightmost_idx - leftmost_idx + 1;
-	ASSERT(op->number_of_intersections > 0);
+	dictEntry *entry = HT_dictFind(op->ht, &v);
+	if(entry == NULL) return false;
 
+	op->intersect_idx = dictGetSignedIntegerVal(entry);
 	return true;
 }
 
-/* Sorts cached records by joined value. */
-void _sort_cached_records(OpValueHashJoin *op) {
-	uint idx = op->join_value_rec_idx;
-	QSORT(Record, op->cached_records,
-		  array_len(op->cached_records), RECORD_SORT_ON_ENTRY);
-}
-
-/* Caches all records coming from left branch. */
+/* Caches all records coming from left branch,
+ * indexing them by their joined value. */
 void _cache_records(OpValueHashJoin *op) {
 	ASSERT(op->cached_records == NULL);
 
 	OpBase *left_child = op->op.children[0];
 	op->cached_records = array_new(Record, 32);
+	op->next_intersection = array_new(int64_t, 32);
 
-	Record r = left_child->consume(left_child);
-	if(!r) return;
-
+	Record r;
 	// As long as there's data coming in from left branch.
-	do {
+	while((r = left_child->consume(left_child))) {
 		// Evaluate joined expression.
 		SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
 
 		// If the joined value is NULL, it cannot be compared to other values - skip this record.
-		if(SIValue_IsNull(v)) continue;
+		if(SIValue_IsNull(v)) {
+			OpBase_DeleteRecord(r);
+			continue;
+		}
 
-		// Add joined value to record.
-		Record_AddScalar(r, op->join_value_rec_idx, v);
+		// Add joined value to record, the hash table refers to the record's copy.
+		SIValue *key = Record_AddScalar(r, op->join_value_rec_idx, v);
+
+		/* Cache the record, chaining it in front of previously cached records
+		 * which share its joined value. */
+		int64_t idx = array_len(op->cached_records);
+		int64_t next = -1;
+		dictEntry *existing;
+		dictEntry *entry = HT_dictAddRaw(op->ht, key, &existing);
+		if(entry == NULL) {
+			entry = existing;
+			next = dictGetSignedIntegerVal(existing);
+		}
+		dictSetSignedIntegerVal(entry, idx);
 
-		// Cache the record.
 		op->cached_records = array_append(op->cached_records, r);
-	} while((r = left_child->consume(left_child)));
+		op->next_intersection = array_append(op->next_intersection, next);
+	}
+}
+
+/* Estimates the number of records a stream produces by the number of nodes its tap scans.
+ * Returns UNKNOWN_STREAM_SIZE if the stream isn't tapped by a node scan. */
+static uint64_t _estimate_stream_size(const OpBase *stream) {
+	const OpBase *tap = stream;
+	while(tap->childCount > 0) tap = tap->children[0];
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(tap->type == OPType_ALL_NODE_SCAN) return Graph_NodeCount(gc->g);
+	if(tap->type == OPType_NODE_BY_LABEL_SCAN) {
+		const NodeByLabelScan *scan = (const NodeByLabelScan *)tap;
+		Schema *s = GraphContext_GetSchema(gc, scan->n.label, SCHEMA_NODE);
+		return (s) ? Graph_LabeledNodeCount(gc->g, s->id) : 0;
+	}
+	return UNKNOWN_STREAM_SIZE;
+}
+
+/* Caches the smaller stream, as estimated by the number of nodes each stream scans,
+ * swapping the joined streams if required.
+ * The planner places a filtered stream on the left, which is retained. */
+static void _select_cached_stream(OpValueHashJoin *op) {
+	OpBase *left = op->op.children[0];
+	OpBase *right = op->op.children[1];
+
+	bool left_filtered = (ExecutionPlan_LocateOp(left, OPType_FILTER) != NULL);
+	bool right_filtered = (ExecutionPlan_LocateOp(right, OPType_FILTER) != NULL);
+	if(left_filtered && !right_filtered) return;
+
+	uint64_t left_size = _estimate_stream_size(left);
+	uint64_t right_size = _estimate_stream_size(right);
+	if(left_size == UNKNOWN_STREAM_SIZE || right_size >= left_size) return;
+
+	op->op.children[0] = right;
+	op->op.children[1] = left;
+	AR_ExpNode *exp = op->lhs_exp;
+	op->lhs_exp = op->rhs_exp;
+	op->rhs_exp = exp;
 }
 
 /* String representation of operation */
@@ -203,7 +190,8 @@ OpBase *NewValueHashJoin(const ExecutionPlan *plan, AR_ExpNode *lhs_exp, AR_ExpN
 	op->rhs_exp = rhs_exp;
 	op->intersect_idx = -1;
 	op->cached_records = NULL;
-	op->number_of_intersections = 0;
+	op->next_intersection = NULL;
+	op->ht = HT_dictCreate(&_join_value_dt, NULL);
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_VALUE_HASH_JOIN, "Value Hash Join", ValueHashJoinInit,
@@ -216,6 +204,7 @@ OpBase *NewValueHashJoin(const ExecutionPlan *plan, AR_ExpNode *lhs_exp, AR_ExpN
 
 static OpResult ValueHashJoinInit(OpBase *ctx) {
 	ASSERT(ctx->childCount == 2);
+	_select_cached_stream((OpValueHashJoin *)ctx);
 	return OP_OK;
 }
 
@@ -227,11 +216,7 @@ static Record ValueHashJoinConsume(OpBase *opBase) {
 	OpBase *right_child = op->op.children[1];
 
 	// Eager, pull from left branch until depleted.
-	if(op->cached_records == NULL) {
-		_cache_records(op);
-		// Sort cache on intersect node ID.
-		_sort_cached_records(op);
-	}
+	if(op->cached_records == NULL) _cache_records(op);
 
 	/* Try to produce a record:
 	 * given a right hand side record R,
@@ -242,61 +227,46 @@ static Record ValueHashJoinConsume(OpBase *opBase) {
 	 * return merged record:
 	 * X merged with R. */
 
-	Record l;
-	if(op->number_of_intersections > 0) {
-		while((l = _get_intersecting_record(op))) {
+	while(true) {
+		Record l = _get_intersecting_record(op);
+		if(l) {
 			// Clone cached record before merging rhs.
 			Record c = OpBase_CloneRecord(l);
 			Record_Merge(c, op->rhs_rec);
 			return c;
 		}
-	}
 
-	/* If we're here there are no more
-	 * left hand side records which intersect with R
-	 * discard R. */
-	if(op->rhs_rec) OpBase_DeleteRecord(op->rhs_rec);
+		/* If we're here there are no more
+		 * left hand side records which intersect with R
+		 * discard R. */
+		if(op->rhs_rec) {
+			OpBase_DeleteRecord(op->rhs_rec);
+			op->rhs_rec = NULL;
+		}
 
-	/* Try to get new right hand side record
-	 * which intersect with a left hand side record. */
-	while(true) {
-		// Pull from right branch.
+		/* Try to get new right hand side record
+		 * which intersect with a left hand side record. */
 		op->rhs_rec = right_child->consume(right_child);
 		if(!op->rhs_rec) return NULL;
 
 		// Get value on which we're intersecting.
 		SIValue v = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
-
-		bool found_intersection = _set_intersection_idx(op, v);
+		_set_intersection_idx(op, v);
 		SIValue_Free(v);
-		// No intersection, discard R.
-		if(!found_intersection) {
-			OpBase_DeleteRecord(op->rhs_rec);
-			continue;
-		}
-
-		// Found atleast one intersecting record.
-		l = _get_intersecting_record(op);
-
-		// Clone cached record before merging rhs.
-		Record c = OpBase_CloneRecord(l);
-		Record_Merge(c, op->rhs_rec);
-
-		return c;
 	}
 }
 
-static OpResult ValueHashJoinReset(OpBase *ctx) {
-	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
+static void _clear_cached_records(OpValueHashJoin *op) {
 	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
 
-	// Clear cached records.
 	if(op->rhs_rec) {
 		OpBase_DeleteRecord(op->rhs_rec);
 		op->rhs_rec = NULL;
 	}
 
+	// Keys are owned by the cached records, empty the hash table first.
+	HT_dictEmpty(op->ht, NULL);
+
 	if(op->cached_records) {
 		uint record_count = array_len(op->cached_records);
 		for(uint i = 0; i < record_count; i++) {
@@ -307,6 +277,16 @@ static OpResult ValueHashJoinReset(OpBase *ctx) {
 		op->cached_records = NULL;
 	}
 
+	if(op->next_intersection) {
+		array_free(op->next_intersection);
+		op->next_intersection = NULL;
+	}
+}
+
+static OpResult ValueHashJoinReset(OpBase *ctx) {
+	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
+	// Clear cached records.
+	_clear_cached_records(op);
 	return OP_OK;
 }
 
@@ -319,20 +299,11 @@ static inline OpBase *ValueHashJoinClone(const ExecutionPlan *plan, const OpBase
 /* Frees ValueHashJoin */
 static void ValueHashJoinFree(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
-	// Free cached records.
-	if(op->rhs_rec) {
-		OpBase_DeleteRecord(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
-
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			OpBase_DeleteRecord(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
+	if(op->ht) {
+		// Free cached records.
+		_clear_cached_records(op);
+		HT_dictRelease(op->ht);
+		op->ht = NULL;
 	}
 
 	if(op->lhs_exp) {
@@ -345,4 +316,3 @@ static void ValueHashJoinFree(OpBase *ctx) {
 		op->rhs_exp = NULL;
 	}
 }
-
@@ -8,6 +8,7 @@
 
 #include "op.h"
 #include "../execution_plan.h"
+#include "../../util/dict.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
 typedef struct {
@@ -15,10 +16,11 @@ typedef struct {
 	Record rhs_rec;                     // Right hand side record.
 	AR_ExpNode *lhs_exp;                // Left hand side expression to join on.
 	AR_ExpNode *rhs_exp;                // Right hand side expression to join on.
-	int64_t intersect_idx;              // Current intersection, < number_of_intersections
 	Record *cached_records;             // Cached left hand side records.
+	int64_t *next_intersection;         // Next cached record sharing the same joined value, -1 if none.
+	dict *ht;                           // Maps each joined value to the first cached record it joins.
+	int64_t intersect_idx;              // Next cached record intersecting with rhs_rec, -1 if none.
 	uint join_value_rec_idx;            // position on joined expression within record.
-	int64_t number_of_intersections;    // Number of intersections located.
 } OpValueHashJoin;
 
 /* Creates a new ValueHashJoin operation */
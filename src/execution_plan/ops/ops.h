@@ -37,4 +37,7 @@
 #include "op_semi_apply.h"
 #include "op_apply_multiplexer.h"
 #include "op_optional.h"
+#include "op_parallel_aggregate.h"
+#include "op_shortest_path.h"
+#include "op_intersect.h"
 
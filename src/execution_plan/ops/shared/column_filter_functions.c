@@ -0,0 +1,149 @@
+/*
+ * Copyright 2018-2020 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#include "column_filter_functions.h"
+#include "RG.h"
+#include "../../../util/rmalloc.h"
+#include "../../../filter_tree/filter_tree.h"
+
+ColumnFilter ColumnFilter_New(const char *attr, AST_Operator op, AR_ExpNode *exp) {
+	ColumnFilter filter = {
+		.attr = rm_strdup(attr),
+		.op = op,
+		.exp = exp,
+		.constant = SI_NullVal(),
+		.column = NULL,
+	};
+	return filter;
+}
+
+ColumnFilter ColumnFilter_Clone(const ColumnFilter *filter) {
+	return ColumnFilter_New(filter->attr, filter->op, AR_EXP_Clone(filter->exp));
+}
+
+void ColumnFilter_Resolve(ColumnFilter *filter, GraphContext *gc, Schema *s) {
+	// Parameters are constant throughout the query.
+	SIValue_Free(filter->constant);
+	filter->constant = AR_EXP_Evaluate(filter->exp, NULL);
+
+	filter->column = NULL;
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, filter->attr);
+	if(attr_id == ATTRIBUTE_NOTFOUND) return;
+	filter->column = ColumnStore_GetColumn(s->columns, gc->g, s->id, attr_id);
+}
+
+static inline bool _RelationPasses(int rel, AST_Operator op) {
+	switch(op) {
+	case OP_EQUAL:
+		return rel == 0;
+	case OP_NEQUAL:
+		return rel != 0;
+	case OP_LT:
+		return rel < 0;
+	case OP_LE:
+		return rel <= 0;
+	case OP_GT:
+		return rel > 0;
+	case OP_GE:
+		return rel >= 0;
+	default:
+		ASSERT(false);
+		return false;
+	}
+}
+
+// Evaluates filter against a non-null row, through the filter tree comparison.
+static bool _RowPasses(const ColumnFilter *filter, const Graph *g, GrB_Index id) {
+	const PropertyColumn *col = filter->column;
+	SIValue v;
+	if(PropertyColumn_IsSpilled(col, id)) {
+		// Value isn't held by the column, read it from the node.
+		Node n = GE_NEW_NODE();
+		Graph_GetNode(g, id, &n);
+		SIValue *prop = GraphEntity_GetProperty((GraphEntity *)&n, col->attr_id);
+		if(prop == PROPERTY_NOTFOUND) return false;
+		v = *prop;
+	} else {
+		v = PropertyColumn_GetValue(col, id);
+	}
+	SIValue constant = filter->constant;
+	return FilterTree_applyOperator(&v, &constant, filter->op);
+}
+
+/* Keeps the rows of ids whose typed value v passes the comparison rel,
+ * spilled rows are compared by _RowPasses. */
+#define FILTER_ROWS(T, rel)                                          \
+	do {                                                             \
+		const T *values = col->values;                               \
+		for(uint i = 0; i < n; i++) {                                \
+			GrB_Index id = ids[i];                                   \
+			if(PropertyColumn_IsNull(col, id)) continue;             \
+			if(PropertyColumn_IsSpilled(col, id)) {                  \
+				if(_RowPasses(filter, g, id)) ids[kept++] = id;      \
+				continue;                                            \
+			}                                                        \
+			T v = values[id];                                        \
+			if(_RelationPasses((rel), filter->op)) ids[kept++] = id; \
+		}                                                            \
+	} while(0)
+
+#define COMPARE(a, b) (((a) > (b)) - ((a) < (b)))
+
+void ColumnFilter_Apply(const ColumnFilter *filter, const Graph *g, GrB_Index *ids,
+						uint *count) {
+	ASSERT(filter && ids && count);
+
+	// Comparisons against a missing attribute or NULL evaluate to NULL.
+	const PropertyColumn *col = filter->column;
+	SIValue c = filter->constant;
+	if(col == NULL || SIValue_IsNull(c)) {
+		*count = 0;
+		return;
+	}
+
+	uint n = *count;
+	uint kept = 0;
+	SIType t = SI_TYPE(c);
+
+	if(col->type == PROP_COLUMN_INT64 && t == T_INT64) {
+		int64_t b = c.longval;
+		FILTER_ROWS(int64_t, COMPARE(v, b));
+	} else if(col->type == PROP_COLUMN_INT64 && t == T_DOUBLE) {
+		double b = c.doubleval;
+		FILTER_ROWS(int64_t, COMPARE((double)v, b));
+	} else if(col->type == PROP_COLUMN_DOUBLE && (t & SI_NUMERIC)) {
+		double b = SI_GET_NUMERIC(c);
+		FILTER_ROWS(double, COMPARE(v, b));
+	} else if(col->type == PROP_COLUMN_BOOL && t == T_BOOL) {
+		bool b = c.longval;
+		FILTER_ROWS(bool, COMPARE(v, b));
+	} else if(col->type == PROP_COLUMN_STRING && t == T_STRING) {
+		uint32_t b;
+		if((filter->op == OP_EQUAL || filter->op == OP_NEQUAL) &&
+		   PropertyColumn_StringCode(col, c.stringval, &b)) {
+			// Equality is decided by dictionary codes.
+			FILTER_ROWS(uint32_t, (v != b));
+		} else {
+			const char *str = c.stringval;
+			FILTER_ROWS(uint32_t, strcmp(col->dict[v], str));
+		}
+	} else {
+		// Disjoint or untyped column, compare row by row.
+		for(uint i = 0; i < n; i++) {
+			GrB_Index id = ids[i];
+			if(PropertyColumn_IsNull(col, id)) continue;
+			if(_RowPasses(filter, g, id)) ids[kept++] = id;
+		}
+	}
+
+	*count = kept;
+}
+
+void ColumnFilter_Free(ColumnFilter *filter) {
+	rm_free(filter->attr);
+	AR_EXP_Free(filter->exp);
+	SIValue_Free(filter->constant);
+}
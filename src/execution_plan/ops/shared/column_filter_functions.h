@@ -0,0 +1,36 @@
+/*
+ * Copyright 2018-2020 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#pragma once
+
+#include "../../../schema/schema.h"
+#include "../../../graph/graphcontext.h"
+#include "../../../ast/ast_shared.h"
+#include "../../../arithmetic/arithmetic_expression.h"
+
+// Comparison between a scanned node's attribute and a constant,
+// evaluated over the attribute's column in the label's column store.
+typedef struct {
+	char *attr;               // Name of filtered attribute.
+	AST_Operator op;          // Comparison operator, attribute on its left hand side.
+	AR_ExpNode *exp;          // Constant or parameter the attribute is compared against.
+	SIValue constant;         // Evaluated exp.
+	PropertyColumn *column;   // Column of filtered attribute, NULL if attribute is missing.
+} ColumnFilter;
+
+// Creates a filter comparing attr against exp, taking ownership of exp.
+ColumnFilter ColumnFilter_New(const char *attr, AST_Operator op, AR_ExpNode *exp);
+
+ColumnFilter ColumnFilter_Clone(const ColumnFilter *filter);
+
+// Evaluates the filter's constant and retrieves its column, building it if missing.
+void ColumnFilter_Resolve(ColumnFilter *filter, GraphContext *gc, Schema *s);
+
+// Compacts ids to the count nodes passing filter, preserving their order.
+void ColumnFilter_Apply(const ColumnFilter *filter, const Graph *g, GrB_Index *ids,
+						uint *count);
+
+void ColumnFilter_Free(ColumnFilter *filter);
@@ -12,19 +12,18 @@
 // Add properties to the GraphEntity.
 static inline void _AddProperties(ResultSetStatistics *stats, GraphEntity *ge,
 								  PendingProperties *props) {
-	int failed_updates = 0;
-	for(int i = 0; i < props->property_count; i++) {
-		bool updated = GraphEntity_AddProperty(ge, props->attr_keys[i], props->values[i]);
-		if(!updated) failed_updates++;
-	}
+	// NULL values are skipped and not counted as set.
+	uint added = GraphEntity_AddProperties(ge, props->attr_keys, props->values,
+										   props->property_count);
 
-	if(stats) stats->properties_set += props->property_count - failed_updates;
+	if(stats) stats->properties_set += added;
 }
 
 /* Commit insertions. */
 static void _CommitNodes(PendingCreations *pending) {
 	Node *n;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	EffectsBuffer *effects = QueryCtx_GetEffectsBuffer();
 	Graph *g = gc->g;
 
 	/* Create missing schemas.
@@ -67,12 +66,15 @@ static void _CommitNodes(PendingCreations *pending) {
 														   pending->node_properties[i]);
 
 		if(s && Schema_HasIndices(s)) Schema_AddNodeToIndices(s, n);
+
+		if(effects) EffectsBuffer_AddCreateNodeEffect(effects, gc, n);
 	}
 }
 
 static void _CommitEdges(PendingCreations *pending) {
 	Edge *e;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	EffectsBuffer *effects = QueryCtx_GetEffectsBuffer();
 	Graph *g = gc->g;
 
 	/* Create missing schemas.
@@ -117,6 +119,8 @@ static void _CommitEdges(PendingCreations *pending) {
 
 		if(pending->edge_properties[i]) _AddProperties(pending->stats, (GraphEntity *)e,
 														   pending->edge_properties[i]);
+
+		if(effects) EffectsBuffer_AddCreateEdgeEffect(effects, gc, e);
 	}
 }
 
@@ -6,6 +6,7 @@
 
 #include "traverse_functions.h"
 #include "../../../query_ctx.h"
+#include "../../../graph/graphcontext.h"
 
 // Collect edges between the source and destination nodes.
 static void _Traverse_CollectEdges(EdgeTraverseCtx *edge_ctx, NodeID src, NodeID dest) {
@@ -35,6 +36,28 @@ static void _Traverse_SetRelationTypes(EdgeTraverseCtx *edge_ctx, QGEdge *e) {
 	}
 }
 
+int *Traverse_RelationTypes(const QGEdge *e) {
+	uint reltype_count = array_len(e->reltypeIDs);
+	if(reltype_count == 0) {
+		int *types = array_new(int, 1);
+		types = array_append(types, GRAPH_NO_RELATION);
+		return types;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	int *types = array_new(int, reltype_count);
+	for(uint i = 0; i < reltype_count; i++) {
+		int rel_id = e->reltypeIDs[i];
+		if(rel_id != GRAPH_UNKNOWN_RELATION) {
+			types = array_append(types, rel_id);
+		} else {
+			Schema *s = GraphContext_GetSchema(gc, e->reltypes[i], SCHEMA_EDGE);
+			if(s) types = array_append(types, s->id);
+		}
+	}
+	return types;
+}
+
 // Determine the edge directions we need to collect.
 static GRAPH_EDGE_DIR _Traverse_SetDirection(const AlgebraicExpression *ae, const QGEdge *e) {
 	// Bidirectional traversals should match both incoming and outgoing edges.
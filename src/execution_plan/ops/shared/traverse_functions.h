@@ -18,6 +18,12 @@ typedef struct {
 	GRAPH_EDGE_DIR direction;   // The direction of the referenced edge being traversed.
 } EdgeTraverseCtx;
 
+/* Resolves the relation type IDs traversed by e, relation types introduced
+ * since planning are looked up by name and missing ones are skipped,
+ * an edge without relation types yields GRAPH_NO_RELATION.
+ * The caller owns the returned array. */
+int *Traverse_RelationTypes(const QGEdge *e);
+
 // Initialize an EdgeTraverseCtx struct to populate edges appropriately for traversal operations.
 EdgeTraverseCtx *Traverse_NewEdgeCtx(AlgebraicExpression *ae, QGEdge *e, int idx);
 
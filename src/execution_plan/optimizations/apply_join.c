@@ -67,7 +67,8 @@ static OpBase *_build_hash_join_op(const ExecutionPlan *plan, OpBase *left_branc
 
 	/* The Value Hash Join will cache its left-hand stream. To reduce the cache size,
 	 * prefer to cache the stream which will produce the smallest number of records.
-	 * Our current heuristic for this is to prefer a stream which contains a filter operation. */
+	 * Our current heuristic for this is to prefer a stream which contains a filter operation,
+	 * streams are reconsidered at runtime by their scanned label sizes. */
 	bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
 	bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
 	if(!left_branch_filtered && right_branch_filtered) {
@@ -0,0 +1,169 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "intersect_cycles.h"
+#include "RG.h"
+#include "../../config.h"
+#include "../../util/arr.h"
+#include "../../util/strcmp.h"
+#include "../../util/rax_extensions.h"
+#include "../ops/op_intersect.h"
+#include "../ops/op_expand_into.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+/* Returns true if every operand of the expression is either
+ * a label matrix of one of the endpoints or a matrix connecting them,
+ * i.e. the expression describes a single hop between 'a' and 'b'. */
+static bool _SingleHop(const AlgebraicExpression *exp, const char *a, const char *b) {
+	if(exp->type == AL_OPERATION) {
+		uint child_count = AlgebraicExpression_ChildCount(exp);
+		for(uint i = 0; i < child_count; i++) {
+			if(!_SingleHop(exp->operation.children[i], a, b)) return false;
+		}
+		return true;
+	}
+
+	const char *src = exp->operand.src;
+	const char *dest = exp->operand.dest;
+	if(!src || !dest) return false;
+	if(exp->operand.diagonal) return !RG_STRCMP(src, a) || !RG_STRCMP(src, b);
+	return (!RG_STRCMP(src, a) && !RG_STRCMP(dest, b)) ||
+		   (!RG_STRCMP(src, b) && !RG_STRCMP(dest, a));
+}
+
+/* Returns the single-hop edge connecting the endpoints of the expression,
+ * NULL if there isn't exactly one such edge. */
+static QGEdge *_ConnectingEdge(const QueryGraph *qg, AlgebraicExpression *ae) {
+	const char *a = AlgebraicExpression_Source(ae);
+	const char *b = AlgebraicExpression_Destination(ae);
+	if(!RG_STRCMP(a, b) || !_SingleHop(ae, a, b)) return NULL;
+
+	QGEdge *connecting = NULL;
+	uint edge_count = array_len(qg->edges);
+	for(uint i = 0; i < edge_count; i++) {
+		QGEdge *e = qg->edges[i];
+		if((!RG_STRCMP(e->src->alias, a) && !RG_STRCMP(e->dest->alias, b)) ||
+		   (!RG_STRCMP(e->src->alias, b) && !RG_STRCMP(e->dest->alias, a))) {
+			if(connecting) return NULL;
+			connecting = e;
+		}
+	}
+
+	if(!connecting || connecting->minHops != 1 || connecting->maxHops != 1) return NULL;
+	return connecting;
+}
+
+// Returns true if the edge can be scanned from its endpoint other than 'alias'.
+static bool _Scannable(const QGEdge *e, const char *alias) {
+	// Scanning outgoing edges of the bound node.
+	if(!e->bidirectional && !RG_STRCMP(e->dest->alias, alias)) return true;
+	// Scanning incoming edges, which requires transposed relation matrices.
+	if(array_len(e->reltypeIDs) == 0) return true;
+	bool maintain_transpose;
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
+	return maintain_transpose;
+}
+
+static bool _Modifies(const OpBase *op, const char *alias) {
+	uint modifies_count = array_len(op->modifies);
+	for(uint i = 0; i < modifies_count; i++) {
+		if(!RG_STRCMP(op->modifies[i], alias)) return true;
+	}
+	return false;
+}
+
+/* Locates the operation below 'op' resolving either 'a' or 'b',
+ * returns NULL if any operation in between might depend on the
+ * number of records or the operation isn't reached via a single-child chain. */
+static OpBase *_LocateResolver(OpBase *op, const char *a, const char *b) {
+	while(op->childCount == 1) {
+		op = op->children[0];
+		if(_Modifies(op, a) || _Modifies(op, b)) return op;
+		switch(op->type) {
+		case OPType_FILTER:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+		case OPType_INTERSECT:
+			break;
+		default:
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
+// Returns true if 'alias' is resolved by 'op' or one of its descendants.
+static bool _IsBound(const OpBase *op, const char *alias) {
+	rax *bound_vars = raxNew();
+	ExecutionPlan_BoundVariables(op, bound_vars);
+	bool bound = raxFind(bound_vars, (unsigned char *)alias, strlen(alias)) != raxNotFound;
+	raxFree(bound_vars);
+	return bound;
+}
+
+// Tries to fold the expand-into operation into an intersection, returns true on success.
+static bool _IntersectExpandInto(ExecutionPlan *plan, OpExpandInto *expand) {
+	const QueryGraph *qg = expand->op.plan->query_graph;
+	if(!qg || !QueryGraph_ContainsCycle(qg)) return false;
+	// The connecting edge is referenced and should be collected.
+	if(expand->edge_ctx) return false;
+
+	QGEdge *closing = _ConnectingEdge(qg, expand->ae);
+	if(!closing) return false;
+
+	const char *a = closing->src->alias;
+	const char *b = closing->dest->alias;
+	OpBase *resolver = _LocateResolver((OpBase *)expand, a, b);
+	if(!resolver) return false;
+
+	if(resolver->type == OPType_INTERSECT) {
+		// Node is already resolved by an intersection, add a constraint.
+		OpIntersect *intersect = (OpIntersect *)resolver;
+		const char *alias = intersect->alias;
+		const char *other = RG_STRCMP(alias, a) ? a : b;
+		if(!_Scannable(closing, alias)) return false;
+		if(!_IsBound(resolver->children[0], other)) return false;
+		IntersectOp_AddEdge(intersect, closing->alias);
+	} else if(resolver->type == OPType_CONDITIONAL_TRAVERSE) {
+		OpCondTraverse *traverse = (OpCondTraverse *)resolver;
+		if(traverse->edge_ctx) return false;
+
+		QGEdge *traversed = _ConnectingEdge(resolver->plan->query_graph, traverse->ae);
+		if(!traversed || traversed == closing) return false;
+
+		const char *alias = AlgebraicExpression_Destination(traverse->ae);
+		const char *other = RG_STRCMP(alias, a) ? a : b;
+		if(RG_STRCMP(alias, a) && RG_STRCMP(alias, b)) return false;
+		if(!_Scannable(traversed, alias) || !_Scannable(closing, alias)) return false;
+		if(!_IsBound(resolver->children[0], other)) return false;
+
+		const char **edges = array_new(const char *, 2);
+		edges = array_append(edges, traversed->alias);
+		edges = array_append(edges, closing->alias);
+		OpBase *intersect = NewIntersectOp(resolver->plan, traverse->graph, alias, edges);
+		array_free(edges);
+
+		ExecutionPlan_ReplaceOp(plan, resolver, intersect);
+		OpBase_Free(resolver);
+	} else {
+		return false;
+	}
+
+	ExecutionPlan_RemoveOp(plan, (OpBase *)expand);
+	OpBase_Free((OpBase *)expand);
+	return true;
+}
+
+void intersectCycles(ExecutionPlan *plan) {
+	OpBase **expand_ops = ExecutionPlan_CollectOps(plan->root, OPType_EXPAND_INTO);
+	uint expand_count = array_len(expand_ops);
+	for(uint i = 0; i < expand_count; i++) {
+		_IntersectExpandInto(plan, (OpExpandInto *)expand_ops[i]);
+	}
+
+	array_free(expand_ops);
+}
@@ -0,0 +1,30 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* A node closing a cycle is resolved by traversing from one of its
+ * neighbors and then discarding every node which isn't connected to
+ * the others, the intermediate result grows with the degree of the
+ * traversed node regardless of how many nodes actually close the cycle.
+ *
+ * Consider the following query, execution plan:
+ * MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c) RETURN count(c)
+ * AGGREGATE
+ * EXPAND INTO (a)-[:R]->(c)
+ * CONDITIONAL TRAVERSE (b)-[:R]->(c)
+ * CONDITIONAL TRAVERSE (a)-[:R]->(b)
+ * SCAN (a)
+ * The traverse and expand-into pair is replaced by a single Intersect
+ * operation which resolves (c) by intersecting the sorted adjacency rows
+ * of (a) and (b):
+ * AGGREGATE
+ * INTERSECT (b)-[:R]->(c), (a)-[:R]->(c)
+ * CONDITIONAL TRAVERSE (a)-[:R]->(b)
+ * SCAN (a) */
+void intersectCycles(ExecutionPlan *plan);
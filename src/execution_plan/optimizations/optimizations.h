@@ -15,10 +15,14 @@
 #include "./reduce_scans.h"
 #include "./reduce_filters.h"
 #include "./traverse_order.h"
+#include "./intersect_cycles.h"
 #include "./compact_filters.h"
 #include "./utilize_indices.h"
+#include "./utilize_columns.h"
 #include "./reduce_distinct.h"
 #include "./reduce_traversal.h"
+#include "./prune_var_len_traversal.h"
+#include "./parallelize_aggregation.h"
 #include "./optimize_cartesian_product.h"
 
 #endif
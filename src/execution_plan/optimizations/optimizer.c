@@ -27,6 +27,9 @@ void optimizePlan(ExecutionPlan *plan) {
 	// Try to reduce SCAN + FILTER to a node seek operation.
 	seekByID(plan);
 
+	// Evaluate attribute filters over property columns within label scans.
+	utilizeColumns(plan);
+
 	// Try to optimize cartesian product.
 	reduceCartesianProductStreamCount(plan);
 
@@ -39,6 +42,12 @@ void optimizePlan(ExecutionPlan *plan) {
 	// Reduce traversals where both src and dest nodes are already resolved into an expand into operation.
 	reduceTraversal(plan);
 
+	// Resolve nodes closing cycles by intersecting the adjacency of their bound neighbors.
+	intersectCycles(plan);
+
+	// Report each reachable node once for variable length traversals whose paths are irrelevant.
+	pruneVarLenTraversal(plan);
+
 	// Try to reduce distinct if it follows aggregation.
 	reduceDistinct(plan);
 
@@ -50,5 +59,8 @@ void optimizePlan(ExecutionPlan *plan) {
 
 	// Let operations know about specified skip(s)
 	applySkip(plan);
+
+	// Split key-less aggregations over node scans between multiple threads.
+	parallelizeAggregation(plan);
 }
 
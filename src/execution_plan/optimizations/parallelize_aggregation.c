@@ -0,0 +1,51 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "parallelize_aggregation.h"
+#include "RG.h"
+#include "../ops/ops.h"
+#include "../../config.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// Operations which can be executed by multiple threads over disjoint morsels.
+static bool _MorselSafeOp(const OpBase *op) {
+	switch(op->type) {
+	case OPType_FILTER:
+	case OPType_CONDITIONAL_TRAVERSE:
+	case OPType_EXPAND_INTO:
+	case OPType_INTERSECT:
+		return op->childCount == 1;
+	case OPType_ALL_NODE_SCAN:
+	case OPType_NODE_BY_LABEL_SCAN:
+		return op->childCount == 0;
+	default:
+		return false;
+	}
+}
+
+void parallelizeAggregation(ExecutionPlan *plan) {
+	uint thread_count = 0;
+	Config_Option_get(Config_PARALLEL_THREAD_COUNT, &thread_count);
+	if(thread_count == 0) return;
+
+	// Expecting "Scan -> [Filter | Traverse]* -> Aggregate -> Results".
+	OpBase *results = plan->root;
+	if(results->type != OPType_RESULTS || results->childCount != 1) return;
+
+	OpBase *aggregate = results->children[0];
+	if(!ParallelAggregate_Combinable(aggregate) || aggregate->childCount != 1) return;
+
+	// Verify the pipeline is a chain of morsel-safe operations ending with a scan.
+	OpBase *op = aggregate->children[0];
+	while(true) {
+		if(!_MorselSafeOp(op)) return;
+		if(op->childCount == 0) break;
+		op = op->children[0];
+	}
+
+	OpBase *parallel = NewParallelAggregateOp(aggregate->plan);
+	ExecutionPlan_PushBelow(aggregate, parallel);
+}
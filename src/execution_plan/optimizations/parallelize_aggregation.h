@@ -0,0 +1,18 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* The parallelizeAggregation optimization looks for execution plans
+ * which aggregate, without grouping, a stream of records produced by
+ * a single node scan followed by filters and traversals, e.g.
+ * MATCH (a:L)-[]->(b) WHERE b.v > 1 RETURN count(b)
+ * In which case a Parallel Aggregate operation is introduced above the
+ * aggregation, splitting the scanned node ID range between multiple threads.
+ * Applies only when PARALLEL_THREAD_COUNT is configured. */
+void parallelizeAggregation(ExecutionPlan *plan);
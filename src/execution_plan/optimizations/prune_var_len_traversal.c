@@ -0,0 +1,76 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "prune_var_len_traversal.h"
+#include "RG.h"
+#include "../ops/op_cond_var_len_traverse.h"
+#include "../../util/arr.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+static const OPType VAR_LEN_TRAVERSE_OPS[] = {OPType_CONDITIONAL_VAR_LEN_TRAVERSE,
+											  OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO
+											 };
+#define VAR_LEN_TRAVERSE_OP_COUNT 2
+
+/* Returns true if records produced by op are either deduplicated
+ * or only checked for existence by an upstream operation,
+ * and none of the operations in between depends on the number of records. */
+static bool _DuplicatesIrrelevant(const OpBase *op) {
+	const OpBase *child = op;
+	const OpBase *parent = op->parent;
+	while(parent) {
+		switch(parent->type) {
+		case OPType_DISTINCT:
+			return true;
+		case OPType_SEMI_APPLY:
+		case OPType_ANTI_SEMI_APPLY:
+		case OPType_OR_APPLY_MULTIPLEXER:
+		case OPType_AND_APPLY_MULTIPLEXER:
+			// Only the existence of records produced by the non-bound branches matters.
+			return parent->children[0] != child;
+		case OPType_FILTER:
+		case OPType_PROJECT:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO:
+			break;
+		default:
+			return false;
+		}
+		child = parent;
+		parent = parent->parent;
+	}
+	return false;
+}
+
+static bool _PrunableTraversal(const CondVarLenTraverse *op) {
+	// The path is projected, every path must be produced.
+	if(op->edgesIdx >= 0) return false;
+
+	/* Revisiting nodes is required whenever a node may be reported
+	 * by a path longer than its distance from the source. */
+	const char *edge = AlgebraicExpression_Edge(op->ae);
+	const QGEdge *e = QueryGraph_GetEdgeByAlias(op->op.plan->query_graph, edge);
+	if(e->minHops > 1) return false;
+	/* A bidirectional traversal reaches its source again by
+	 * going back and forth the same edge, which isn't a valid path. */
+	if(e->minHops == 1 && op->traverseDir == GRAPH_EDGE_DIR_BOTH) return false;
+
+	return _DuplicatesIrrelevant((const OpBase *)op);
+}
+
+void pruneVarLenTraversal(ExecutionPlan *plan) {
+	OpBase **traversals = ExecutionPlan_CollectOpsMatchingType(plan->root, VAR_LEN_TRAVERSE_OPS,
+														 VAR_LEN_TRAVERSE_OP_COUNT);
+	uint traversal_count = array_len(traversals);
+	for(uint i = 0; i < traversal_count; i++) {
+		CondVarLenTraverse *op = (CondVarLenTraverse *)traversals[i];
+		if(_PrunableTraversal(op)) CondVarLenTraverseOp_Prune(op);
+	}
+
+	array_free(traversals);
+}
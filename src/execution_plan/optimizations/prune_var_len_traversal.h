@@ -0,0 +1,24 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* Variable length traversals produce a record per path,
+ * when neither the path nor the number of records matter to later operations
+ * the traversal only needs to report each reachable node once.
+ *
+ * Consider the following query, execution plan:
+ * MATCH (a)-[*1..5]->(b) RETURN DISTINCT b
+ * DISTINCT
+ * PROJECT
+ * CONDITIONAL VARIABLE LENGTH TRAVERSE (a)-[*1..5]->(b)
+ * SCAN (a)
+ * As results are made distinct and the traversed path isn't referenced,
+ * the traversal is switched to a pruned mode which computes reachability
+ * level by level, never revisiting a node. */
+void pruneVarLenTraversal(ExecutionPlan *plan);
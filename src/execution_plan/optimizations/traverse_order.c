@@ -6,184 +6,249 @@
 
 #include "./traverse_order.h"
 #include "../../config.h"
+#include "../../query_ctx.h"
 #include "../../util/arr.h"
 #include "../../util/strcmp.h"
 #include "../../util/rmalloc.h"
+#include "../../schema/schema.h"
+#include <float.h>
 
 #define T 1           // Transpose penalty.
 #define L 2 * T       // Label score.
 #define F 4 * T       // Filter score.
 #define B 8 * F       // Bound variable bonus.
 
-typedef AlgebraicExpression **Arrangement;
-
-// create arrangement
-static inline Arrangement _Arrangement_New(uint size) {
-	return rm_malloc(sizeof(AlgebraicExpression *) * size);
+#define FILTER_SELECTIVITY 0.1      // Estimated fraction of entities passing a filter.
+#define COST_TOLERANCE 0.01         // Relative cost difference considered insignificant.
+#define EXHAUSTIVE_SEARCH_MAX 12    // Maximum number of expressions ordered by an exhaustive search.
+
+/* Cardinality estimates for a set of expressions,
+ * derived from the graph's label node counts and relation edge counts. */
+typedef struct {
+	Graph *g;                // Graph statistics are read from, NULL if unavailable.
+	GraphContext *gc;        // Graph context, used for resolving schemas.
+	double node_count;       // Number of nodes in the graph.
+	const char **aliases;    // Distinct expression source and destination aliases.
+	double *cards;           // Estimated number of candidates of each alias.
+	uint *src;               // Alias index of each expression's source.
+	uint *dest;              // Alias index of each expression's destination.
+	double *density;         // Estimated fraction of (src, dest) pairs connected by each expression.
+} TraversalStats;
+
+// State of the search for an ordering of a subset of the expressions.
+typedef struct {
+	bool reachable;   // Subset can be ordered in a valid arrangement.
+	double rows;      // Estimated number of records produced once the subset is evaluated.
+	double cost;      // Estimated number of records produced while evaluating the subset.
+	int score;        // Heuristic score, breaks ties between similar costs.
+	uint64_t nodes;   // Aliases resolved by the subset.
+	int last;         // Last expression evaluated.
+} OrderState;
+
+static inline double _cap(double x, double max) {
+	return (x < max) ? x : max;
 }
 
-// clone arrangement
-static inline Arrangement _Arrangement_Clone(const Arrangement arrangement, uint size) {
-	ASSERT(arrangement != NULL);
-	Arrangement clone = _Arrangement_New(size);
-	memcpy(clone, arrangement, sizeof(AlgebraicExpression *) * size);
-	return clone;
+// returns the index of alias, introducing it if it wasn't seen before
+static uint _TraversalStats_AliasIdx(TraversalStats *stats, const char *alias) {
+	uint alias_count = array_len(stats->aliases);
+	for(uint i = 0; i < alias_count; i++) {
+		if(!RG_STRCMP(stats->aliases[i], alias)) return i;
+	}
+	stats->aliases = array_append(stats->aliases, alias);
+	return alias_count;
 }
 
-// print arrangement
-static inline void _Arrangement_Print(Arrangement arrangement, uint size) {
-	printf("Arrangement_Print\n");
-	for(uint i = 0; i < size; i++) {
-		AlgebraicExpression *exp = arrangement[i];
-		printf("%d, src: %s, dest: %s\n", i, AlgebraicExpression_Source(exp),
-			   AlgebraicExpression_Destination(exp));
+static double _TraversalStats_Card(const TraversalStats *stats, const char *alias) {
+	uint alias_count = array_len(stats->aliases);
+	for(uint i = 0; i < alias_count; i++) {
+		if(!RG_STRCMP(stats->aliases[i], alias)) return stats->cards[i];
 	}
+	ASSERT(false);
+	return stats->node_count;
 }
 
-// free arrangement
-static inline void _Arrangement_Free(Arrangement arrangement) {
-	ASSERT(arrangement != NULL);
-	rm_free(arrangement);
-}
+// estimated number of candidates for node n
+static double _TraversalStats_NodeCard(const TraversalStats *stats, const QGNode *n,
+									   rax *filtered_entities, rax *bound_vars) {
+	size_t len = strlen(n->alias);
+
+	// a bound variable holds a single node per record
+	if(bound_vars && raxFind(bound_vars, (unsigned char *)n->alias, len) != raxNotFound) {
+		return 1;
+	}
+
+	double card = stats->node_count;
+	if(stats->g && n->label) {
+		card = (n->labelID < 0) ? 0 : Graph_LabeledNodeCount(stats->g, n->labelID);
+	}
+
+	if(raxFind(filtered_entities, (unsigned char *)n->alias, len) != raxNotFound) {
+		card *= FILTER_SELECTIVITY;
+	}
 
-// computes x!
-static inline unsigned long _factorial(uint x) {
-	unsigned long res = 1;
-	for(int i = 2; i <= x; i++) res *= i;
-	return res;
+	return card;
 }
 
-// swaps exps[i] with exps[j]
-static inline void _swap(Arrangement exps, uint i, uint  j) {
-	AlgebraicExpression *temp;
-	temp = exps[i];
-	exps[i] = exps[j];
-	exps[j] = temp;
+// number of entries in the matrix represented by operand
+static double _TraversalStats_OperandEntries(const TraversalStats *stats,
+											 const AlgebraicExpression *operand) {
+	const char *label = operand->operand.label;
+
+	if(operand->operand.matrix == IDENTITY_MATRIX) return stats->node_count;
+
+	if(operand->operand.diagonal) {
+		if(label == NULL) return stats->node_count;
+		Schema *s = GraphContext_GetSchema(stats->gc, label, SCHEMA_NODE);
+		return (s) ? Graph_LabeledNodeCount(stats->g, s->id) : 0;
+	}
+
+	if(label == NULL) return Graph_EdgeCount(stats->g);
+	Schema *s = GraphContext_GetSchema(stats->gc, label, SCHEMA_EDGE);
+	return (s) ? Graph_RelationEdgeCount(stats->g, s->id) : 0;
 }
 
-// computes all permutations of set exps
-static inline void _permute(Arrangement set, int l, int r, Arrangement **permutations) {
-	int i;
-	if(l == r) {
-		Arrangement permutation = _Arrangement_Clone(set, r + 1);
-		*permutations = array_append(*permutations, permutation);
-	} else {
-		for(i = l; i <= r; i++) {
-			_swap(set, l, i);
-			_permute(set, l + 1, r, permutations);
-			_swap(set, l, i);   // backtrack.
+/* Estimates the fraction of (src, dest) pairs connected by exp,
+ * treating each matrix as if its entries were uniformly distributed.
+ * Labels of src and dest are accounted for by their cardinality. */
+static double _TraversalStats_Density(const TraversalStats *stats, const AlgebraicExpression *exp,
+									  const char *src, const char *dest) {
+	double n = stats->node_count;
+	double density;
+	uint child_count;
+
+	if(exp->type == AL_OPERAND) {
+		if(exp->operand.diagonal && exp->operand.matrix != IDENTITY_MATRIX &&
+		   (!RG_STRCMP(exp->operand.src, src) || !RG_STRCMP(exp->operand.src, dest))) {
+			return 1 / n;
+		}
+		return _TraversalStats_OperandEntries(stats, exp) / (n * n);
+	}
+
+	child_count = AlgebraicExpression_ChildCount(exp);
+	switch(exp->operation.op) {
+	case AL_EXP_MUL:
+		density = _TraversalStats_Density(stats, exp->operation.children[0], src, dest);
+		for(uint i = 1; i < child_count; i++) {
+			double d = _TraversalStats_Density(stats, exp->operation.children[i], src, dest);
+			density = _cap(density * d * n, 1);
+		}
+		return density;
+	case AL_EXP_ADD:
+		density = 0;
+		for(uint i = 0; i < child_count; i++) {
+			density += _TraversalStats_Density(stats, exp->operation.children[i], src, dest);
 		}
+		return _cap(density, 1);
+	case AL_EXP_TRANSPOSE:
+		return _TraversalStats_Density(stats, exp->operation.children[0], src, dest);
+	default:
+		return 1;
 	}
 }
 
-// computes all possible permutations of exps
-static Arrangement *_permutations(const Arrangement exps, uint exps_count) {
-	// Number of permutations of a set S is |S|!.
-	unsigned long permutation_count = _factorial(exps_count);
-	Arrangement *permutations = array_new(Arrangement, permutation_count);
+static void _TraversalStats_Init(TraversalStats *stats, QueryGraph *qg, AlgebraicExpression **exps,
+								 uint exp_count, rax *filtered_entities, rax *bound_vars) {
+	stats->gc = QueryCtx_GetGraphCtx();
+	stats->g = stats->gc->g;
+	stats->aliases = array_new(const char *, exp_count * 2);
+	stats->src = rm_malloc(sizeof(uint) * exp_count);
+	stats->dest = rm_malloc(sizeof(uint) * exp_count);
+	stats->density = rm_malloc(sizeof(double) * exp_count);
 
-	// Compute permutations.
-	_permute(exps, 0, exps_count - 1, &permutations);
-	ASSERT(array_len(permutations) == permutation_count);
+	for(uint i = 0; i < exp_count; i++) {
+		stats->src[i] = _TraversalStats_AliasIdx(stats, AlgebraicExpression_Source(exps[i]));
+		stats->dest[i] = _TraversalStats_AliasIdx(stats, AlgebraicExpression_Destination(exps[i]));
+	}
+	uint alias_count = array_len(stats->aliases);
+	stats->cards = rm_malloc(sizeof(double) * alias_count);
+
+	/* counters are read without the read lock, such that planning doesn't wait
+	 * for writers, a concurrent write merely skews the estimates
+	 * without statistics all nodes and expressions look alike */
+	stats->node_count = 1;
+	if(stats->g) {
+		stats->node_count = Graph_NodeCount(stats->g);
+		if(stats->node_count < 1) stats->node_count = 1;
+	}
 
-	return permutations;
-}
+	for(uint i = 0; i < alias_count; i++) {
+		QGNode *n = QueryGraph_GetNodeByAlias(qg, stats->aliases[i]);
+		stats->cards[i] = _TraversalStats_NodeCard(stats, n, filtered_entities, bound_vars);
+	}
 
-/* A valid arrangement of expressions is one in which the ith expression
- * source or destination nodes appear in a previous expression k where k < i. */
-static bool _valid_arrangement(const Arrangement arrangement, uint exps_count, QueryGraph *qg) {
-	AlgebraicExpression *exp = arrangement[0];
-	/* A 1 hop traversals where either the source node
-	 * or destination node is labeled, can't be the opening expression
-	 * in an arrangement.
-	 * Consider: MATCH (a:L0)-[:R*]->(b:L1)
-	 * [L0] * [R] * [L1] but because R is a variable length traversal
-	 * we're dealing with 3 different expressions:
-	 * exp0: [L0]
-	 * exp1: [R]
-	 * exp2: [L1]
-	 * the arrangement where [R] is the first expression:
-	 * exp0: [R]
-	 * exp1: [L0]
-	 * exp2: [L1]
-	 * Isn't valid, as currently the first expression is converted
-	 * into a scan operation. */
-	QGNode *src = QueryGraph_GetNodeByAlias(qg,
-											AlgebraicExpression_Source(exp)); // TODO unwisely expensive
-	QGNode *dest = QueryGraph_GetNodeByAlias(qg,
-											 AlgebraicExpression_Destination(exp)); // TODO unwisely expensive
-	if((src->label || dest->label) &&
-	   AlgebraicExpression_Edge(exp) &&
-	   AlgebraicExpression_OperandCount(exp) == 1) return false;
-
-	for(int i = 1; i < exps_count; i++) {
-		exp = arrangement[i];
-		int j = i - 1;
-
-		// Scan previous expressions.
-		for(; j >= 0; j--) {
-			AlgebraicExpression *prev_exp = arrangement[j];
-			const char *exp_src = AlgebraicExpression_Source(exp);
-			const char *exp_dest = AlgebraicExpression_Destination(exp);
-			const char *prev_exp_src = AlgebraicExpression_Source(prev_exp);
-			const char *prev_exp_dest = AlgebraicExpression_Destination(prev_exp);
-
-			if(!RG_STRCMP(prev_exp_src, exp_src)     ||
-			   !RG_STRCMP(prev_exp_dest, exp_src)    ||
-			   !RG_STRCMP(prev_exp_src, exp_dest)    ||
-			   !RG_STRCMP(prev_exp_dest, exp_dest)) break;
+	for(uint i = 0; i < exp_count; i++) {
+		if(stats->g == NULL) {
+			stats->density[i] = 1;
+			continue;
 		}
-		/* Nither src or dest nodes are mentioned in previous expressions
-		 * as such the arrangement is invalid. */
-		if(j < 0) return false;
+		stats->density[i] = _TraversalStats_Density(stats, exps[i],
+				AlgebraicExpression_Source(exps[i]), AlgebraicExpression_Destination(exps[i]));
 	}
-	return true;
 }
 
-static int _penalty_arrangement(Arrangement arrangement, uint exp_count) {
-	int penalty = 0;
-
-	/* see if graph maintains transpose matrices
-	 * if it does, there's no penalty */
-	bool maintain_transpose = false;
-	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
-	if(maintain_transpose) return 0;
+static void _TraversalStats_Free(TraversalStats *stats) {
+	array_free(stats->aliases);
+	rm_free(stats->cards);
+	rm_free(stats->src);
+	rm_free(stats->dest);
+	rm_free(stats->density);
+}
 
-	AlgebraicExpression *exp;
+/* Estimated number of records produced by extending each of `rows` records
+ * with the ith expression. */
+static double _extend_rows(const TraversalStats *stats, double rows, uint i,
+						   bool src_resolved, bool dest_resolved) {
+	rows *= stats->density[i];
+	if(!src_resolved) rows = _cap(rows * stats->cards[stats->src[i]], DBL_MAX);
+	if(!dest_resolved && stats->dest[i] != stats->src[i]) {
+		rows = _cap(rows * stats->cards[stats->dest[i]], DBL_MAX);
+	}
+	return rows;
+}
 
-	// account for first expression transposes
-	exp = arrangement[0];
-	uint transpose_count = AlgebraicExpression_OperationCount(exp, AL_EXP_TRANSPOSE);
-	penalty += transpose_count * T;
+// returns true if cost a is preferable to cost b, using scores to break ties
+static bool _preferable(double cost_a, int score_a, double cost_b, int score_b) {
+	if(cost_a < cost_b * (1 - COST_TOLERANCE)) return true;
+	if(cost_b < cost_a * (1 - COST_TOLERANCE)) return false;
+	return score_a > score_b;
+}
 
-	for(uint i = 1; i < exp_count; i++) {
-		exp = arrangement[i];
-		bool src_resolved = false;
+/* A 1 hop traversals where either the source node
+ * or destination node is labeled, can't be the opening expression
+ * in an arrangement.
+ * Consider: MATCH (a:L0)-[:R*]->(b:L1)
+ * [L0] * [R] * [L1] but because R is a variable length traversal
+ * we're dealing with 3 different expressions:
+ * exp0: [L0]
+ * exp1: [R]
+ * exp2: [L1]
+ * the arrangement where [R] is the first expression:
+ * exp0: [R]
+ * exp1: [L0]
+ * exp2: [L1]
+ * Isn't valid, as currently the first expression is converted
+ * into a scan operation. */
+static bool _valid_entry(AlgebraicExpression *exp, QueryGraph *qg) {
+	QGNode *src = QueryGraph_GetNodeByAlias(qg, AlgebraicExpression_Source(exp));
+	QGNode *dest = QueryGraph_GetNodeByAlias(qg, AlgebraicExpression_Destination(exp));
+	return !((src->label || dest->label) &&
+			 AlgebraicExpression_Edge(exp) &&
+			 AlgebraicExpression_OperandCount(exp) == 1);
+}
 
-		// see if source is already resolved
-		for(int j = i - 1; j >= 0; j--) {
-			AlgebraicExpression *prev_exp = arrangement[j];
-			if(!RG_STRCMP(AlgebraicExpression_Source(prev_exp), AlgebraicExpression_Source(exp)) ||
-			   !RG_STRCMP(AlgebraicExpression_Destination(prev_exp), AlgebraicExpression_Source(exp))) {
-				src_resolved = true;
-				break;
-			}
-		}
+static int _penalty_expression(AlgebraicExpression *exp, bool src_resolved,
+							   bool maintain_transpose) {
+	// if the graph maintains transpose matrices there's no penalty
+	if(maintain_transpose) return 0;
 
-		// dest must be resolved as we're working with valid arrangemet
-		if(src_resolved) {
-			// count how many transposes are performed
-			transpose_count = AlgebraicExpression_OperationCount(exp, AL_EXP_TRANSPOSE);
-			penalty += transpose_count * T;
-		} else {
-			// count how many transposes we require to perform
-			transpose_count = AlgebraicExpression_OperationCount(exp, AL_EXP_TRANSPOSE);
-			uint operand_count = AlgebraicExpression_OperandCount(exp);
-			penalty += (operand_count - transpose_count) * T;
-		}
-	}
+	// count how many transposes are performed
+	uint transpose_count = AlgebraicExpression_OperationCount(exp, AL_EXP_TRANSPOSE);
+	if(src_resolved) return transpose_count * T;
 
-	return penalty;
+	// count how many transposes we require to perform
+	uint operand_count = AlgebraicExpression_OperandCount(exp);
+	return (operand_count - transpose_count) * T;
 }
 
 static int _reward_expression(AlgebraicExpression *exp, QueryGraph *qg,
@@ -221,27 +286,131 @@ static int _reward_expression(AlgebraicExpression *exp, QueryGraph *qg,
 	return reward;
 }
 
-static int _reward_arrangement(Arrangement arrangement, uint exp_count, QueryGraph *qg,
-							   rax *filtered_entities, rax *bound_vars) {
-	int reward = 0;
+/* Heuristic score of evaluating exp as the pos'th expression,
+ * the opening expression is evaluated from its source. */
+static int _score_expression(AlgebraicExpression *exp, uint pos, uint exp_count,
+							 bool src_resolved, QueryGraph *qg, rax *filtered_entities,
+							 rax *bound_vars, bool maintain_transpose) {
+	uint reward_factor = exp_count - pos;
+	int score = _reward_expression(exp, qg, filtered_entities, bound_vars, reward_factor);
+	score -= _penalty_expression(exp, src_resolved || pos == 0, maintain_transpose);
+	return score;
+}
 
-	// A bit naive at the moment.
-	for(uint i = 0; i < exp_count; i++) {
-		uint reward_factor = exp_count - i;
-		AlgebraicExpression *exp = arrangement[i];
-		reward += _reward_expression(exp, qg, filtered_entities, bound_vars,
-				reward_factor);
+/* Orders exps by searching all subsets of expressions,
+ * the cheapest arrangement of each subset is extended
+ * by any expression connected to it. */
+static void _order_exhaustive(QueryGraph *qg, AlgebraicExpression **exps, uint exp_count,
+							  const TraversalStats *stats, rax *filtered_entities,
+							  rax *bound_vars, bool maintain_transpose) {
+	ASSERT(exp_count <= EXHAUSTIVE_SEARCH_MAX);
+
+	uint set_count = 1 << exp_count;
+	uint full_set = set_count - 1;
+	OrderState *states = rm_calloc(set_count, sizeof(OrderState));
+	states[0].reachable = true;
+	states[0].rows = 1;
+
+	// subsets are visited before their supersets
+	for(uint set = 0; set < full_set; set++) {
+		OrderState *state = states + set;
+		if(!state->reachable) continue;
+
+		uint pos = __builtin_popcount(set);
+		for(uint i = 0; i < exp_count; i++) {
+			if(set & (1 << i)) continue;
+
+			AlgebraicExpression *exp = exps[i];
+			bool src_resolved = state->nodes & (1ULL << stats->src[i]);
+			bool dest_resolved = state->nodes & (1ULL << stats->dest[i]);
+
+			// each expression must be connected to a previous one
+			if(pos == 0 && !_valid_entry(exp, qg)) continue;
+			if(pos > 0 && !src_resolved && !dest_resolved) continue;
+
+			double rows = _extend_rows(stats, state->rows, i, src_resolved, dest_resolved);
+			double cost = state->cost + rows;
+			int score = state->score + _score_expression(exp, pos, exp_count, src_resolved,
+														 qg, filtered_entities, bound_vars, maintain_transpose);
+
+			OrderState *next = states + (set | (1 << i));
+			if(next->reachable && !_preferable(cost, score, next->cost, next->score)) continue;
+
+			next->reachable = true;
+			next->rows = rows;
+			next->cost = cost;
+			next->score = score;
+			next->nodes = state->nodes | (1ULL << stats->src[i]) | (1ULL << stats->dest[i]);
+			next->last = i;
+		}
 	}
 
-	return reward;
+	ASSERT(states[full_set].reachable);
+
+	// reconstruct the winning arrangement from its end
+	AlgebraicExpression *arrangement[EXHAUSTIVE_SEARCH_MAX];
+	uint set = full_set;
+	for(int pos = exp_count - 1; pos >= 0; pos--) {
+		int i = states[set].last;
+		arrangement[pos] = exps[i];
+		set &= ~(1 << i);
+	}
+	memcpy(exps, arrangement, sizeof(AlgebraicExpression *) * exp_count);
+
+	rm_free(states);
 }
 
-static int _score_arrangement(Arrangement arrangement, uint exp_count, QueryGraph *qg,
-							  rax *filtered_entities, rax *bound_vars) {
-	int score = 0;
-	score -= _penalty_arrangement(arrangement, exp_count);
-	score += _reward_arrangement(arrangement, exp_count, qg, filtered_entities, bound_vars);
-	return score;
+/* Orders exps by repeatedly picking the cheapest expression
+ * connected to the ones picked so far. */
+static void _order_greedy(QueryGraph *qg, AlgebraicExpression **exps, uint exp_count,
+						  const TraversalStats *stats, rax *filtered_entities,
+						  rax *bound_vars, bool maintain_transpose) {
+	double rows = 1;
+	bool *resolved = rm_calloc(array_len(stats->aliases), sizeof(bool));
+	AlgebraicExpression **arrangement = rm_malloc(sizeof(AlgebraicExpression *) * exp_count);
+	uint *remaining = rm_malloc(sizeof(uint) * exp_count);
+	uint remaining_count = exp_count;
+	for(uint i = 0; i < exp_count; i++) remaining[i] = i;
+
+	for(uint pos = 0; pos < exp_count; pos++) {
+		int best = -1;
+		int best_score = 0;
+		double best_rows = 0;
+
+		for(uint j = 0; j < remaining_count; j++) {
+			uint i = remaining[j];
+			AlgebraicExpression *exp = exps[i];
+			bool src_resolved = resolved[stats->src[i]];
+			bool dest_resolved = resolved[stats->dest[i]];
+
+			// each expression must be connected to a previous one
+			if(pos == 0 && !_valid_entry(exp, qg)) continue;
+			if(pos > 0 && !src_resolved && !dest_resolved) continue;
+
+			double r = _extend_rows(stats, rows, i, src_resolved, dest_resolved);
+			int score = _score_expression(exp, pos, exp_count, src_resolved, qg,
+										  filtered_entities, bound_vars, maintain_transpose);
+			if(best == -1 || _preferable(r, score, best_rows, best_score)) {
+				best = j;
+				best_rows = r;
+				best_score = score;
+			}
+		}
+
+		ASSERT(best != -1);
+		uint i = remaining[best];
+		remaining[best] = remaining[--remaining_count];
+		arrangement[pos] = exps[i];
+		resolved[stats->src[i]] = true;
+		resolved[stats->dest[i]] = true;
+		rows = best_rows;
+	}
+
+	memcpy(exps, arrangement, sizeof(AlgebraicExpression *) * exp_count);
+
+	rm_free(resolved);
+	rm_free(remaining);
+	rm_free(arrangement);
 }
 
 // Transpose out-of-order expressions
@@ -273,11 +442,12 @@ static void _resolve_winning_sequence(AlgebraicExpression **exps, uint exp_count
  * If the source is bounded, we will not transpose,
  * if only the destination is bounded, we will.
  *
- * If neither are bounded, we fall back to label and filter heuristics.
+ * Otherwise we start at the node with the fewest estimated candidates,
+ * if estimates are similar we fall back to label and filter heuristics.
  * Filters are considered more valuable than labels in selecting a starting point,
  * so we'll select the starting point with the best combination available of filters and labels. */
 static void _select_entry_point(QueryGraph *qg, AlgebraicExpression **ae, rax *filtered_entities,
-								rax *bound_vars) {
+								rax *bound_vars, const TraversalStats *stats) {
 
 	AlgebraicExpression *exp = *ae;
 	const char *src = AlgebraicExpression_Source(exp);
@@ -305,6 +475,15 @@ static void _select_entry_point(QueryGraph *qg, AlgebraicExpression **ae, rax *f
 		}
 	}
 
+	// start at the node with significantly fewer candidates
+	double src_card = _TraversalStats_Card(stats, src);
+	double dest_card = _TraversalStats_Card(stats, dest);
+	if(src_card < dest_card * (1 - COST_TOLERANCE)) return;
+	if(dest_card < src_card * (1 - COST_TOLERANCE)) {
+		AlgebraicExpression_Transpose(ae);
+		return;
+	}
+
 	int src_score  = 0;
 	int dest_score = 0;
 
@@ -328,7 +507,8 @@ static void _select_entry_point(QueryGraph *qg, AlgebraicExpression **ae, rax *f
 
 /* Given a set of algebraic expressions representing a graph traversal
  * we pick the order in which the expressions will be evaluated
- * taking into account filters and transposes.
+ * taking into account the estimated number of records produced
+ * by each step, filters and transposes.
  * exps will reordered. */
 void orderExpressions(QueryGraph *qg, AlgebraicExpression **exps, uint exp_count,
 					  const FT_FilterNode *filters, rax *bound_vars) {
@@ -341,44 +521,28 @@ void orderExpressions(QueryGraph *qg, AlgebraicExpression **exps, uint exp_count
 
 	// Collect all filtered aliases.
 	rax *filtered_entities = FilterTree_CollectModified(filters);
-	// Compute all possible permutations of algebraic expressions.
-	Arrangement *arrangements = _permutations(exps, exp_count);
-	uint arrangement_count = array_len(arrangements);
 
-	/* If we only have one arrangement, we still want to select the optimal entry point
-	 * but have no other work to do. */
-	if(arrangement_count == 1) goto select_entry_point;
+	// Estimate the cardinality of each expression's source and destination.
+	TraversalStats stats;
+	bool maintain_transpose = false;
+	_TraversalStats_Init(&stats, qg, exps, exp_count, filtered_entities, bound_vars);
 
-	// Remove invalid arrangements.
-	Arrangement *valid_arrangements = array_new(Arrangement, arrangement_count);
-	for(int i = 0; i < arrangement_count; i++) {
-		if(_valid_arrangement(arrangements[i], exp_count, qg)) {
-			valid_arrangements = array_append(valid_arrangements, arrangements[i]);
-		}
-	}
-	uint valid_arrangement_count = array_len(valid_arrangements);
-	ASSERT(valid_arrangement_count > 0);
-
-	/* Score each arrangement,
-	 * keep track after arrangement with highest score. */
-	int max_score = INT_MIN;
-	Arrangement top_arrangement = valid_arrangements[0];
-
-	for(uint i = 0; i < valid_arrangement_count; i++) {
-		Arrangement arrangement = valid_arrangements[i];
-		int score = _score_arrangement(arrangement, exp_count, qg, filtered_entities, bound_vars);
-		// printf("score: %d\n", score);
-		// _Arrangement_Print(arrangement, exp_count);
-		if(max_score < score) {
-			max_score = score;
-			top_arrangement = arrangement;
-		}
-	}
+	/* If we only have one expression, we still want to select the optimal entry point
+	 * but have no other work to do. */
+	if(exp_count == 1) goto select_entry_point;
 
-	array_free(valid_arrangements);
+	// see if graph maintains transpose matrices
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
 
-	// Update input.
-	for(uint i = 0; i < exp_count; i++) exps[i] = top_arrangement[i];
+	/* Pick the arrangement producing the fewest intermediate records,
+	 * searching exhaustively if the number of expressions permits. */
+	if(exp_count <= EXHAUSTIVE_SEARCH_MAX) {
+		_order_exhaustive(qg, exps, exp_count, &stats, filtered_entities, bound_vars,
+						  maintain_transpose);
+	} else {
+		_order_greedy(qg, exps, exp_count, &stats, filtered_entities, bound_vars,
+					  maintain_transpose);
+	}
 
 	// Depending on how the expressions have been ordered, we may have to transpose expressions
 	// so that their source nodes have already been resolved by previous expressions.
@@ -386,10 +550,8 @@ void orderExpressions(QueryGraph *qg, AlgebraicExpression **exps, uint exp_count
 
 select_entry_point:
 	// Transpose the winning expression if the destination node is a more efficient starting place.
-	_select_entry_point(qg, exps + 0, filtered_entities, bound_vars);
+	_select_entry_point(qg, exps + 0, filtered_entities, bound_vars, &stats);
 
+	_TraversalStats_Free(&stats);
 	raxFree(filtered_entities);
-	for(uint i = 0; i < arrangement_count; i++) _Arrangement_Free(arrangements[i]);
-	array_free(arrangements);
 }
-
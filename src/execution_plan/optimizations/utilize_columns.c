@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018-2020 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#include "utilize_columns.h"
+#include "RG.h"
+#include "../../config.h"
+#include "../../util/arr.h"
+#include "../ops/op_filter.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../../arithmetic/arithmetic_op.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// Returns true if exp is an attribute of alias, setting attr to the attribute name.
+static bool _AliasAttribute(const AR_ExpNode *exp, const char *alias, char **attr) {
+	if(!AR_EXP_IsAttribute(exp, attr)) return false;
+	const AR_ExpNode *entity = exp->op.children[0];
+	return (entity->type == AR_EXP_OPERAND &&
+			entity->operand.type == AR_EXP_VARIADIC &&
+			strcmp(entity->operand.variadic.entity_alias, alias) == 0);
+}
+
+static inline bool _ConstantExp(AR_ExpNode *exp) {
+	return (AR_EXP_IsConstant(exp) || AR_EXP_IsParameter(exp));
+}
+
+/* Tries to convert filter into a column filter,
+ * which is the case for a comparison between an attribute of alias and a constant. */
+static bool _ColumnFilter(const FT_FilterNode *f, const char *alias, ColumnFilter *filter) {
+	if(f->t != FT_N_PRED) return false;
+
+	AST_Operator op = f->pred.op;
+	switch(op) {
+	case OP_EQUAL:
+	case OP_NEQUAL:
+	case OP_LT:
+	case OP_LE:
+	case OP_GT:
+	case OP_GE:
+		break;
+	default:
+		return false;
+	}
+
+	char *attr;
+	AR_ExpNode *constant;
+	if(_AliasAttribute(f->pred.lhs, alias, &attr) && _ConstantExp(f->pred.rhs)) {
+		constant = f->pred.rhs;
+	} else if(_AliasAttribute(f->pred.rhs, alias, &attr) && _ConstantExp(f->pred.lhs)) {
+		// Constant is on the left hand side, e.g. 5 < n.v
+		constant = f->pred.lhs;
+		op = ArithmeticOp_ReverseOp(op);
+	} else {
+		return false;
+	}
+
+	*filter = ColumnFilter_New(attr, op, AR_EXP_Clone(constant));
+	return true;
+}
+
+static void _UseColumns(ExecutionPlan *plan, NodeByLabelScan *scan) {
+	OpBase *parent = ((OpBase *)scan)->parent;
+	while(parent && parent->type == OPType_FILTER) {
+		OpBase *grandparent = parent->parent; // Track the next op to visit in case we free parent.
+		OpFilter *filter = (OpFilter *)parent;
+
+		ColumnFilter column_filter;
+		if(_ColumnFilter(filter->filterTree, scan->n.alias, &column_filter)) {
+			NodeByLabelScanOp_AddColumnFilter(scan, column_filter);
+
+			// Free replaced operations.
+			ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
+			OpBase_Free((OpBase *)filter);
+		}
+		// Advance.
+		parent = grandparent;
+	}
+}
+
+void utilizeColumns(ExecutionPlan *plan) {
+	ASSERT(plan != NULL);
+
+	bool columnar_store = false;
+	Config_Option_get(Config_COLUMNAR_STORE, &columnar_store);
+	if(!columnar_store) return;
+
+	const OPType types[] = {OPType_NODE_BY_LABEL_SCAN, OPType_NODE_BY_LABEL_AND_ID_SCAN};
+	OpBase **scan_ops = ExecutionPlan_CollectOpsMatchingType(plan->root, types, 2);
+
+	uint scan_count = array_len(scan_ops);
+	for(uint i = 0; i < scan_count; i++) {
+		_UseColumns(plan, (NodeByLabelScan *)scan_ops[i]);
+	}
+
+	array_free(scan_ops);
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright 2018-2020 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* The utilize columns optimization searches for label scans on which
+ * filters of the form n.attr op X are applied, where X is a constant or a
+ * parameter, in which case the filters are evaluated by the scan itself
+ * over the label's property columns, see COLUMNAR_STORE. */
+void utilizeColumns(ExecutionPlan *plan);
@@ -438,6 +438,207 @@ void _predicateTreeToRange(const FT_FilterNode *tree, rax *string_ranges, rax *n
 	}
 }
 
+//------------------------------------------------------------------------------
+// Range index
+//------------------------------------------------------------------------------
+
+// Boolean value a field is constrained to.
+#define BOOL_FALSE    (void *)1
+#define BOOL_TRUE     (void *)2
+#define BOOL_CONFLICT (void *)3  // Field is constrained to both true and false.
+
+/* Checks to see if given filter can be resolved by a range index,
+ * a single comparison between an indexed attribute of the scanned entity and a constant. */
+static bool _applicableRangeFilter(Index *idx, const char *alias, FT_FilterNode **filter) {
+	FT_FilterNode *filter_tree = *filter;
+	if(filter_tree->t != FT_N_PRED || filter_tree->pred.op == OP_NEQUAL) return false;
+	if(!_simple_predicates(filter_tree)) return false;
+
+	// Filter should only refer to the scanned entity.
+	rax *modified = FilterTree_CollectModified(filter_tree);
+	bool scanned_entity = (raxSize(modified) == 1 &&
+						   raxFind(modified, (unsigned char *)alias, strlen(alias)) != raxNotFound);
+	raxFree(modified);
+	if(!scanned_entity) return false;
+
+	_normalize_filter(filter);
+
+	// Booleans are indexed apart from numbers, and are only compared for equality.
+	SIValue c = (*filter)->pred.rhs->operand.constant;
+	if(SI_TYPE(c) == T_BOOL && (*filter)->pred.op != OP_EQUAL) return false;
+
+	char *field;
+	AR_EXP_IsAttribute((*filter)->pred.lhs, &field);
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	return Index_ContainsAttribute(idx, GraphContext_GetAttributeID(gc, field));
+}
+
+/* Reduce a range index filter into a range object or a boolean value.
+ * Returns false if the filter isn't resolved exactly by the index, which is the case
+ * for integers sharing their key with their neighbors, such a filter is reduced
+ * into an inclusive range containing its key and must remain in the plan. */
+static bool _rangeFilterToRange(const FT_FilterNode *tree, rax *string_ranges,
+								rax *numeric_ranges, rax *bool_values) {
+	char *prop;
+	AR_EXP_IsAttribute(tree->pred.lhs, &prop);
+	size_t prop_len = strlen(prop);
+	SIValue c = tree->pred.rhs->operand.constant;
+
+	if(SI_TYPE(c) == T_BOOL) {
+		void *v = (c.longval) ? BOOL_TRUE : BOOL_FALSE;
+		void *prev = raxFind(bool_values, (unsigned char *)prop, prop_len);
+		if(prev != raxNotFound && prev != v) v = BOOL_CONFLICT;
+		raxInsert(bool_values, (unsigned char *)prop, prop_len, v, NULL);
+		return true;
+	}
+
+	if(!(SI_TYPE(c) & SI_NUMERIC) || RangeIndex_ExactNumeric(c)) {
+		_predicateTreeToRange(tree, string_ranges, numeric_ranges);
+		return true;
+	}
+
+	NumericRange *nr = raxFind(numeric_ranges, (unsigned char *)prop, prop_len);
+	if(nr == raxNotFound) {
+		nr = NumericRange_New();
+		raxInsert(numeric_ranges, (unsigned char *)prop, prop_len, nr, NULL);
+	}
+
+	int op = tree->pred.op;
+	if(op == OP_LT) op = OP_LE;
+	else if(op == OP_GT) op = OP_GE;
+	NumericRange_TightenRange(nr, op, SI_GET_NUMERIC(c));
+	return false;
+}
+
+/* Builds a range index query out of the ranges of the leading index fields.
+ * Sets covered to the number of fields constrained by the query,
+ * returns NULL if the first index field isn't constrained. */
+static RangeIndexQuery *_rangesToRangeQuery(Index *idx, rax *string_ranges, rax *numeric_ranges,
+											rax *bool_values, uint *covered) {
+	*covered = 0;
+	RangeIndexQuery *q = RangeIndexQuery_New();
+	uint fields_count = Index_FieldsCount(idx);
+	const char **fields = Index_GetFields(idx);
+
+	for(uint i = 0; i < fields_count; i++) {
+		const char *field = fields[i];
+		StringRange *sr = raxFind(string_ranges, (unsigned char *)field, strlen(field));
+		NumericRange *nr = raxFind(numeric_ranges, (unsigned char *)field, strlen(field));
+		void *b = raxFind(bool_values, (unsigned char *)field, strlen(field));
+		if(sr == raxNotFound && nr == raxNotFound && b == raxNotFound) break;
+
+		*covered = i + 1;
+
+		/* Make sure each property is bound to a single type, either numeric,
+		 * string or boolean, e.g. a.v = 1 AND a.v = 'a'
+		 * in which case no node satisfies the query. */
+		int types = (sr != raxNotFound) + (nr != raxNotFound) + (b != raxNotFound);
+		if(types > 1 || b == BOOL_CONFLICT) {
+			RangeIndexQuery_SetEmpty(q);
+			break;
+		}
+
+		if(b != raxNotFound) {
+			RangeIndexQuery_AddEquality(q, SI_BoolVal(b == BOOL_TRUE));
+			continue;
+		}
+
+		if(nr != raxNotFound) {
+			// A single value range constrains the field to that value.
+			if(NumericRange_IsValid(nr) && nr->min == nr->max) {
+				RangeIndexQuery_AddEquality(q, SI_DoubleVal(nr->min));
+				continue;
+			}
+			RangeIndexQuery_SetNumericRange(q, nr);
+		} else {
+			if(StringRange_IsValid(sr) && sr->min && sr->max && strcmp(sr->min, sr->max) == 0) {
+				RangeIndexQuery_AddEquality(q, SI_ConstStringVal(sr->min));
+				continue;
+			}
+			RangeIndexQuery_SetStringRange(q, sr);
+		}
+
+		// No further field can be constrained once a field is constrained to a range.
+		break;
+	}
+
+	if(*covered == 0) {
+		RangeIndexQuery_Free(q);
+		return NULL;
+	}
+
+	return q;
+}
+
+/* Try to replace given Label Scan operation and a set of Filter operations with
+ * a single range Index Scan operation.
+ * Returns true if the scan was replaced. */
+static bool _reduce_scan_op_range(ExecutionPlan *plan, NodeByLabelScan *scan, Index *idx) {
+	// Collect applicable filters.
+	OpFilter **filters = array_new(OpFilter *, 0);
+	OpBase *current = scan->op.parent;
+	while(current->type == OPType_FILTER) {
+		OpFilter *filter = (OpFilter *)current;
+		if(_applicableRangeFilter(idx, scan->n.alias, &filter->filterTree)) {
+			filters = array_append(filters, filter);
+		}
+		current = current->parent;
+	}
+
+	uint filters_count = array_len(filters);
+	if(filters_count == 0) {
+		array_free(filters);
+		return false;
+	}
+
+	// Reduce filters into ranges.
+	rax *string_ranges = raxNew();
+	rax *numeric_ranges = raxNew();
+	rax *bool_values = raxNew();
+	bool *exact = rm_malloc(sizeof(bool) * filters_count);
+	for(uint i = 0; i < filters_count; i++) {
+		exact[i] = _rangeFilterToRange(filters[i]->filterTree, string_ranges, numeric_ranges,
+									   bool_values);
+	}
+
+	uint covered;
+	RangeIndexQuery *q = _rangesToRangeQuery(idx, string_ranges, numeric_ranges, bool_values,
+											 &covered);
+	raxFreeWithCallback(string_ranges, (void(*)(void *))StringRange_Free);
+	raxFreeWithCallback(numeric_ranges, (void(*)(void *))NumericRange_Free);
+	raxFree(bool_values);
+
+	if(q == NULL) {
+		rm_free(exact);
+		array_free(filters);
+		return false;
+	}
+
+	OpBase *indexOp = NewRangeIndexScanOp(scan->op.plan, scan->g, scan->n, idx->range, q);
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, indexOp);
+	OpBase_Free((OpBase *)scan);
+
+	/* Remove filters resolved by the index, filters over fields following
+	 * the covered fields and filters not resolved exactly remain. */
+	const char **fields = Index_GetFields(idx);
+	for(uint i = 0; i < filters_count; i++) {
+		if(!exact[i]) continue;
+		OpFilter *filter = filters[i];
+		char *field;
+		AR_EXP_IsAttribute(filter->filterTree->pred.lhs, &field);
+		for(uint j = 0; j < covered; j++) {
+			if(strcmp(fields[j], field) != 0) continue;
+			ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
+			OpBase_Free((OpBase *)filter);
+			break;
+		}
+	}
+
+	rm_free(exact);
+	array_free(filters);
+	return true;
+}
+
 /* Try to replace given Label Scan operation and a set of Filter operations with
  * a single Index Scan operation. */
 void reduce_scan_op(ExecutionPlan *plan, NodeByLabelScan *scan) {
@@ -447,9 +648,14 @@ void reduce_scan_op(ExecutionPlan *plan, NodeByLabelScan *scan) {
 	rax *string_ranges = NULL;
 	rax *numeric_ranges = NULL;
 
-	// Make sure there's an index for scanned label.
 	const char *label = scan->n.label;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	// Prefer a range index, which resolves ranges over leading fields in key order.
+	Index *range_idx = GraphContext_GetIndex(gc, label, NULL, IDX_RANGE);
+	if(range_idx && range_idx->range && _reduce_scan_op_range(plan, scan, range_idx)) return;
+
+	// Make sure there's an index for scanned label.
 	Index *idx = GraphContext_GetIndex(gc, label, NULL, IDX_EXACT_MATCH);
 	if(idx == NULL) return;
 
@@ -89,6 +89,15 @@ void Record_TransferEntries(Record *to, Record from) {
 	}
 }
 
+void Record_ShareEntries(Record to, const Record from) {
+	uint len = Record_length(from);
+	for(uint i = 0; i < len; i++) {
+		if(from->entries[i].type == REC_TYPE_UNKNOWN) continue;
+		to->entries[i] = from->entries[i];
+		if(to->entries[i].type == REC_TYPE_SCALAR) SIValue_MakeVolatile(&to->entries[i].value.s);
+	}
+}
+
 RecordEntryType Record_GetType(const Record r, int idx) {
 	return r->entries[idx].type;
 }
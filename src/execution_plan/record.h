@@ -52,6 +52,9 @@ void Record_Merge(Record a, const Record b);
 // Merge record b into a, transfer value ownership from b to a.
 void Record_TransferEntries(Record *to, Record from);
 
+// Merge record b into a, b retains value ownership.
+void Record_ShareEntries(Record to, const Record from);
+
 // Returns number of entries record can hold.
 uint Record_length(const Record r);
 
@@ -0,0 +1,347 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "compiled_filter_tree.h"
+#include "RG.h"
+#include "../query_ctx.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+// Number of evaluations between reorderings of AND/OR operands.
+#define REORDER_INTERVAL 1024
+
+static uint64_t _ExpCost(const AR_ExpNode *exp) {
+	if(exp->type != AR_EXP_OP) return 1;
+
+	uint64_t cost = 1;
+	for(int i = 0; i < exp->op.child_count; i++) cost += _ExpCost(exp->op.children[i]);
+	return cost;
+}
+
+static uint64_t _FilterCost(const FT_FilterNode *filter) {
+	switch(filter->t) {
+	case FT_N_EXP:
+		return _ExpCost(filter->exp.exp);
+	case FT_N_PRED:
+		return 1 + _ExpCost(filter->pred.lhs) + _ExpCost(filter->pred.rhs);
+	case FT_N_COND:
+		return _FilterCost(filter->cond.left) + _FilterCost(filter->cond.right);
+	default:
+		ASSERT(false);
+		return 1;
+	}
+}
+
+/* Returns true if alias is known to be bound to a node or an edge,
+ * accessing an attribute of any other value, e.g. an integer, raises an error. */
+static bool _EntityAlias(const QueryGraph *qg, const char *alias) {
+	if(qg == NULL || alias == NULL) return false;
+	return QueryGraph_GetEntityTypeByAlias(qg, alias) != ENTITY_UNKNOWN;
+}
+
+/* Returns true if expression can't raise a run-time error:
+ * a constant, a parameter, a variable or an attribute of a graph entity. */
+static bool _PlainExp(const AR_ExpNode *exp, const QueryGraph *qg) {
+	if(exp->type == AR_EXP_OPERAND) return true;
+	if(!AR_EXP_IsAttribute(exp, NULL)) return false;
+	const AR_ExpNode *entity = exp->op.children[0];
+	return (entity->type == AR_EXP_OPERAND && entity->operand.type == AR_EXP_VARIADIC &&
+			_EntityAlias(qg, entity->operand.variadic.entity_alias));
+}
+
+// Returns the operator testing the same relation once its operands are swapped.
+static AST_Operator _ReverseOperator(AST_Operator op) {
+	switch(op) {
+	case OP_LT:
+		return OP_GT;
+	case OP_LE:
+		return OP_GE;
+	case OP_GT:
+		return OP_LT;
+	case OP_GE:
+		return OP_LE;
+	default:
+		return op;
+	}
+}
+
+static CFT_Node *_NewNode(CFT_NodeType t, const FT_FilterNode *filter) {
+	CFT_Node *node = rm_calloc(1, sizeof(CFT_Node));
+	node->t = t;
+	node->filter = filter;
+	node->rec_idx = INVALID_INDEX;
+	node->attr_id = ATTRIBUTE_NOTFOUND;
+	return node;
+}
+
+/* Tries to compile predicate into a comparison between
+ * an entity attribute and a constant, e.g. n.v > 5
+ * returns false if predicate isn't of that form. */
+static bool _CompileAttributeFilter(const FT_FilterNode *filter, CFT_Node *node,
+								   const QueryGraph *qg) {
+	switch(filter->pred.op) {
+	case OP_EQUAL:
+	case OP_NEQUAL:
+	case OP_LT:
+	case OP_LE:
+	case OP_GT:
+	case OP_GE:
+		break;
+	default:
+		return false;
+	}
+
+	AST_Operator op = filter->pred.op;
+	AR_ExpNode *attr = filter->pred.lhs;
+	AR_ExpNode *constant = filter->pred.rhs;
+	if(AR_EXP_IsConstant(attr) || AR_EXP_IsParameter(attr)) {
+		// Constant is on the left hand side, e.g. 5 < n.v
+		attr = filter->pred.rhs;
+		constant = filter->pred.lhs;
+		op = _ReverseOperator(op);
+	}
+
+	char *attr_name;
+	if(!AR_EXP_IsAttribute(attr, &attr_name)) return false;
+	AR_ExpNode *entity = attr->op.children[0];
+	if(entity->type != AR_EXP_OPERAND || entity->operand.type != AR_EXP_VARIADIC) return false;
+
+	if(AR_EXP_IsConstant(constant)) {
+		node->constant = constant->operand.constant;
+	} else if(AR_EXP_IsParameter(constant)) {
+		// Parameters are constant throughout the query.
+		rax *params = QueryCtx_GetParams();
+		const char *param_name = constant->operand.param_name;
+		AR_ExpNode *param = raxFind(params, (unsigned char *)param_name, strlen(param_name));
+		if(param == raxNotFound) return false;
+		node->constant = param->operand.constant;
+	} else {
+		return false;
+	}
+
+	node->t = CFT_ATTRIBUTE;
+	node->op = op;
+	node->alias = entity->operand.variadic.entity_alias;
+	node->attr_name = attr_name;
+	node->attr_id = attr->op.children[2]->operand.constant.longval;
+	node->cost = 1;
+	node->reorderable = _EntityAlias(qg, node->alias);
+	return true;
+}
+
+static CFT_Node *_Compile(const FT_FilterNode *filter, const QueryGraph *qg);
+
+// Collects the operands of a chain of AND/OR conditions.
+static void _CollectOperands(CFT_Node *node, AST_Operator op, const FT_FilterNode *filter,
+							 const QueryGraph *qg) {
+	if(filter->t == FT_N_COND && filter->cond.op == op) {
+		_CollectOperands(node, op, filter->cond.left, qg);
+		_CollectOperands(node, op, filter->cond.right, qg);
+		return;
+	}
+
+	CFT_Node *operand = _Compile(filter, qg);
+	node->cost += operand->cost;
+	node->reorderable &= operand->reorderable;
+	node->operands = array_append(node->operands, operand);
+}
+
+static CFT_Node *_Compile(const FT_FilterNode *filter, const QueryGraph *qg) {
+	if(filter->t == FT_N_COND && (filter->cond.op == OP_AND || filter->cond.op == OP_OR)) {
+		CFT_Node *node = _NewNode((filter->cond.op == OP_AND) ? CFT_AND : CFT_OR, filter);
+		node->operands = array_new(CFT_Node *, 2);
+		node->reorderable = true;
+		_CollectOperands(node, filter->cond.op, filter, qg);
+		return node;
+	}
+
+	CFT_Node *node = _NewNode(CFT_FILTER, filter);
+	if(filter->t == FT_N_PRED && _CompileAttributeFilter(filter, node, qg)) return node;
+
+	node->cost = _FilterCost(filter);
+	node->reorderable = (filter->t == FT_N_PRED && _PlainExp(filter->pred.lhs, qg) &&
+						 _PlainExp(filter->pred.rhs, qg));
+	return node;
+}
+
+/* Estimated cost of evaluating operand until its AND/OR node is resolved,
+ * cheap operands which are likely to resolve the node are ranked first. */
+static double _OperandRank(const CFT_Node *operand, CFT_NodeType t) {
+	double evaluations = operand->evaluations + 2;
+	double resolving = (t == CFT_AND) ?
+					   operand->evaluations - operand->passes + 1 :
+					   operand->passes + 1;
+	return operand->cost * evaluations / resolving;
+}
+
+/* Reorders each run of consecutive reorderable operands,
+ * operands which may raise an error retain their position, such that
+ * the same operands are evaluated ahead of them. */
+static void _ReorderOperands(CFT_Node *node) {
+	uint count = array_len(node->operands);
+	uint start = 0;
+	while(start < count) {
+		if(!node->operands[start]->reorderable) {
+			start++;
+			continue;
+		}
+
+		uint end = start + 1;
+		while(end < count && node->operands[end]->reorderable) end++;
+
+		// Insertion sort operands [start, end) by rank.
+		for(uint i = start + 1; i < end; i++) {
+			CFT_Node *operand = node->operands[i];
+			double rank = _OperandRank(operand, node->t);
+			uint j = i;
+			while(j > start && _OperandRank(node->operands[j - 1], node->t) > rank) {
+				node->operands[j] = node->operands[j - 1];
+				j--;
+			}
+			node->operands[j] = operand;
+		}
+
+		start = end;
+	}
+}
+
+// Retrieve attribute, starting at the position it was last found at.
+static SIValue *_GetAttribute(CFT_Node *node, const GraphEntity *ge) {
+	const Entity *e = ge->entity;
+	int prop_idx = node->prop_idx;
+	if(prop_idx < e->prop_count && e->properties[prop_idx].id == node->attr_id) {
+		return &e->properties[prop_idx].value;
+	}
+
+	for(int i = 0; i < e->prop_count; i++) {
+		if(e->properties[i].id == node->attr_id) {
+			node->prop_idx = i;
+			return &e->properties[i].value;
+		}
+	}
+
+	return PROPERTY_NOTFOUND;
+}
+
+static int _applyAttributeFilter(CFT_Node *node, const Record r) {
+	if(node->rec_idx == INVALID_INDEX) {
+		node->rec_idx = Record_GetEntryIdx(r, node->alias);
+		if(node->rec_idx == INVALID_INDEX) return FilterTree_applyFilters(node->filter, r);
+	}
+
+	GraphEntity *ge = NULL;
+	switch(Record_GetType(r, node->rec_idx)) {
+	case REC_TYPE_NODE:
+	case REC_TYPE_EDGE:
+		ge = Record_GetGraphEntity(r, node->rec_idx);
+		break;
+	case REC_TYPE_SCALAR: {
+		SIValue v = Record_Get(r, node->rec_idx);
+		if(SI_TYPE(v) & (T_NODE | T_EDGE)) ge = v.ptrval;
+		break;
+	}
+	default:
+		break;
+	}
+
+	// Anything but a graph entity, e.g. NULL or a map, is handled by the filter tree.
+	if(ge == NULL || ge->entity == NULL) return FilterTree_applyFilters(node->filter, r);
+
+	if(node->attr_id == ATTRIBUTE_NOTFOUND) {
+		// Attribute might have been introduced since compilation.
+		node->attr_id = GraphContext_GetAttributeID(QueryCtx_GetGraphCtx(), node->attr_name);
+		// Missing attribute evaluates to NULL, which fails any comparison.
+		if(node->attr_id == ATTRIBUTE_NOTFOUND) return FILTER_FAIL;
+	}
+
+	SIValue *v = _GetAttribute(node, ge);
+	if(v == PROPERTY_NOTFOUND) return FILTER_FAIL;
+
+	if(SI_TYPE(*v) == T_INT64 && SI_TYPE(node->constant) == T_INT64) {
+		int64_t a = v->longval;
+		int64_t b = node->constant.longval;
+		switch(node->op) {
+		case OP_EQUAL:
+			return a == b;
+		case OP_NEQUAL:
+			return a != b;
+		case OP_LT:
+			return a < b;
+		case OP_LE:
+			return a <= b;
+		case OP_GT:
+			return a > b;
+		case OP_GE:
+			return a >= b;
+		default:
+			ASSERT(false);
+			break;
+		}
+	}
+
+	return FilterTree_applyOperator(v, &node->constant, node->op);
+}
+
+static int _applyFilters(CFT_Node *node, const Record r) {
+	int pass = FILTER_PASS;
+
+	switch(node->t) {
+	case CFT_AND:
+	case CFT_OR: {
+		if(node->evaluations > 0 && node->evaluations % REORDER_INTERVAL == 0) _ReorderOperands(node);
+
+		// AND is resolved by the first failing operand, OR by the first passing one.
+		int resolving = (node->t == CFT_AND) ? FILTER_FAIL : FILTER_PASS;
+		pass = !resolving;
+		uint count = array_len(node->operands);
+		for(uint i = 0; i < count; i++) {
+			if(_applyFilters(node->operands[i], r) == resolving) {
+				pass = resolving;
+				break;
+			}
+		}
+		break;
+	}
+	case CFT_ATTRIBUTE:
+		pass = _applyAttributeFilter(node, r);
+		break;
+	case CFT_FILTER:
+		pass = FilterTree_applyFilters(node->filter, r);
+		break;
+	default:
+		ASSERT(false);
+		break;
+	}
+
+	node->evaluations++;
+	node->passes += pass;
+	return pass;
+}
+
+static void _FreeNode(CFT_Node *node) {
+	if(node->operands) {
+		uint count = array_len(node->operands);
+		for(uint i = 0; i < count; i++) _FreeNode(node->operands[i]);
+		array_free(node->operands);
+	}
+	rm_free(node);
+}
+
+CompiledFilterTree *CompiledFilterTree_New(const FT_FilterNode *root, const QueryGraph *qg) {
+	ASSERT(root != NULL);
+	CompiledFilterTree *tree = rm_malloc(sizeof(CompiledFilterTree));
+	tree->root = _Compile(root, qg);
+	return tree;
+}
+
+int CompiledFilterTree_applyFilters(CompiledFilterTree *tree, const Record r) {
+	return _applyFilters(tree->root, r);
+}
+
+void CompiledFilterTree_Free(CompiledFilterTree *tree) {
+	_FreeNode(tree->root);
+	rm_free(tree);
+}
@@ -0,0 +1,62 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "filter_tree.h"
+#include "../graph/query_graph.h"
+#include "../graph/entities/graph_entity.h"
+
+/* A compiled filter tree is an execution form of a filter tree:
+ * nested AND/OR chains are flattened into a single n-ary node,
+ * whose operands are periodically reordered such that cheap and selective
+ * operands are evaluated first, and comparisons between an entity attribute
+ * and a constant are evaluated without going through the arithmetic expression
+ * evaluator.
+ * Operands which may raise a run-time error, e.g. toInteger(n.s) > 1,
+ * are never moved, the operands guarding them remain ahead of them,
+ * attributes are only considered safe to access on aliases the query graph
+ * binds to a node or an edge.
+ * The compiled tree refers to the filter tree it was compiled from,
+ * which must outlive it. */
+
+typedef enum {
+	CFT_AND,        // Conjunction of operands.
+	CFT_OR,         // Disjunction of operands.
+	CFT_FILTER,     // Filter tree node, evaluated by the filter tree.
+	CFT_ATTRIBUTE,  // Entity attribute compared against a constant.
+} CFT_NodeType;
+
+typedef struct CFT_Node {
+	CFT_NodeType t;
+	struct CFT_Node **operands;   // AND/OR operands.
+	const FT_FilterNode *filter;  // Filter tree node this node was compiled from.
+	const char *alias;            // Alias of filtered entity.
+	int rec_idx;                  // Position of filtered entity within record.
+	const char *attr_name;        // Name of filtered attribute.
+	Attribute_ID attr_id;         // ID of filtered attribute.
+	int prop_idx;                 // Last position of the attribute within an entity's properties.
+	SIValue constant;             // Constant the attribute is compared against.
+	AST_Operator op;              // Comparison operator, attribute on its left hand side.
+	uint64_t cost;                // Estimated evaluation cost.
+	bool reorderable;             // Node can't raise an error, it can be evaluated in any order.
+	uint64_t evaluations;         // Number of times node was evaluated.
+	uint64_t passes;              // Number of times node evaluated to true.
+} CFT_Node;
+
+typedef struct {
+	CFT_Node *root;
+} CompiledFilterTree;
+
+/* Compiles filter tree, qg (may be NULL) determines which aliases
+ * are bound to graph entities. */
+CompiledFilterTree *CompiledFilterTree_New(const FT_FilterNode *root, const QueryGraph *qg);
+
+/* Runs record through the compiled filter tree. */
+int CompiledFilterTree_applyFilters(CompiledFilterTree *tree, const Record r);
+
+/* Free compiled filter tree. */
+void CompiledFilterTree_Free(CompiledFilterTree *tree);
@@ -135,7 +135,7 @@ FT_FilterNode **FilterTree_SubTrees(FT_FilterNode *root) {
 
 /* Applies a single filter to a single result.
  * Compares given values, tests if values maintain desired relation (op) */
-int _applyFilter(SIValue *aVal, SIValue *bVal, AST_Operator op) {
+int FilterTree_applyOperator(SIValue *aVal, SIValue *bVal, AST_Operator op) {
 	int disjointOrNull = 0;
 	int rel = SIValue_Compare(*aVal, *bVal, &disjointOrNull);
 	// If there was null comparison, return false.
@@ -176,7 +176,7 @@ int _applyPredicateFilters(const FT_FilterNode *root, const Record r) {
 	SIValue lhs = AR_EXP_Evaluate(root->pred.lhs, r);
 	SIValue rhs = AR_EXP_Evaluate(root->pred.rhs, r);
 
-	int ret = _applyFilter(&lhs, &rhs, root->pred.op);
+	int ret = FilterTree_applyOperator(&lhs, &rhs, root->pred.op);
 
 	SIValue_Free(lhs);
 	SIValue_Free(rhs);
@@ -603,7 +603,7 @@ static bool _FilterTree_Compact_Pred(FT_FilterNode *node) {
 		SIValue lhs = AR_EXP_Evaluate(node->pred.lhs, NULL);
 		SIValue rhs = AR_EXP_Evaluate(node->pred.rhs, NULL);
 		// Evalute result.
-		int ret = _applyFilter(&lhs, &rhs, node->pred.op);
+		int ret = FilterTree_applyOperator(&lhs, &rhs, node->pred.op);
 		SIValue v = SI_BoolVal(ret);
 		// Free resources and do in place replacment.
 		AR_EXP_Free(node->pred.lhs);
@@ -84,6 +84,9 @@ FT_FilterNode *FilterTree_CreateConditionFilter(AST_Operator op);
 /* Runs val through the filter tree. */
 int FilterTree_applyFilters(const FT_FilterNode *root, const Record r);
 
+/* Compares given values, tests if values maintain desired relation (op). */
+int FilterTree_applyOperator(SIValue *aVal, SIValue *bVal, AST_Operator op);
+
 /* Extract every modified record ID mentioned in the tree
  * without duplications. */
 rax *FilterTree_CollectModified(const FT_FilterNode *root);
@@ -66,6 +66,37 @@ SIValue *GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue v
 	return &(e->entity->properties[prop_idx].value);
 }
 
+uint GraphEntity_AddProperties(GraphEntity *e, const Attribute_ID *attr_ids,
+							   const SIValue *values, uint count) {
+	ASSERT(e);
+
+	// Count non NULL values, these are the ones we're about to add.
+	uint added = 0;
+	for(uint i = 0; i < count; i++) {
+		if(!SIValue_IsNull(values[i])) added++;
+	}
+	if(added == 0) return 0;
+
+	// Grow properties bag once, rather than once per property.
+	int prop_count = e->entity->prop_count;
+	size_t size = sizeof(EntityProperty) * (prop_count + added);
+	if(e->entity->properties == NULL) {
+		e->entity->properties = rm_malloc(size);
+	} else {
+		e->entity->properties = rm_realloc(e->entity->properties, size);
+	}
+
+	for(uint i = 0; i < count; i++) {
+		if(SIValue_IsNull(values[i])) continue;
+		e->entity->properties[prop_count].id = attr_ids[i];
+		e->entity->properties[prop_count].value = SI_CloneValue(values[i]);
+		prop_count++;
+	}
+	e->entity->prop_count = prop_count;
+
+	return added;
+}
+
 SIValue *GraphEntity_GetProperty(const GraphEntity *e, Attribute_ID attr_id) {
 	if(attr_id == ATTRIBUTE_NOTFOUND) return PROPERTY_NOTFOUND;
 	if(e->entity == NULL) {
@@ -218,6 +249,18 @@ inline bool GraphEntity_IsDeleted(const GraphEntity *e) {
 	return Graph_EntityIsDeleted(e->entity);
 }
 
+void CloneEntityProperties(Entity *e) {
+	ASSERT(e);
+	if(e->properties == NULL) return;
+
+	EntityProperty *properties = rm_malloc(sizeof(EntityProperty) * e->prop_count);
+	for(int i = 0; i < e->prop_count; i++) {
+		properties[i].id = e->properties[i].id;
+		properties[i].value = SI_CloneValue(e->properties[i].value);
+	}
+	e->properties = properties;
+}
+
 void FreeEntity(Entity *e) {
 	ASSERT(e);
 	if(e->properties != NULL) {
@@ -65,6 +65,12 @@ typedef struct {
  * returns - reference to newly added property. */
 SIValue *GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value);
 
+/* Adds multiple properties to entity using a single allocation
+ * NULL values are skipped
+ * returns - number of properties added. */
+uint GraphEntity_AddProperties(GraphEntity *e, const Attribute_ID *attr_ids,
+							   const SIValue *values, uint count);
+
 /* Retrieves entity's property
  * NOTE: If the key does not exist, we return the special
  * constant value PROPERTY_NOTFOUND. */
@@ -81,6 +87,10 @@ void GraphEntity_ToString(const GraphEntity *e, char **buffer, size_t *bufferLen
 // Returns true if the given graph entity has been deleted.
 bool GraphEntity_IsDeleted(const GraphEntity *e);
 
+/* Replaces entity's properties with a private copy,
+ * used when a copied entity is to outlive its origin. */
+void CloneEntityProperties(Entity *e);
+
 /* Release all memory allocated by entity */
 void FreeEntity(Entity *e);
 
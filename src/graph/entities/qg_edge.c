@@ -19,6 +19,8 @@ QGEdge *QGEdge_New(QGNode *src, QGNode *dest, const char *relationship, const ch
 	e->minHops = 1;
 	e->maxHops = 1;
 	e->bidirectional = false;
+	e->shortest_path = false;
+	e->all_shortest_paths = false;
 
 	return e;
 }
@@ -20,6 +20,8 @@ struct QGEdge {
 	uint minHops;           /* Minimum number of hops this edge represents. */
 	uint maxHops;           /* Maximum number of hops this edge represents. */
     bool bidirectional;     /* Edge doesn't have a direction. */
+	bool shortest_path;     /* Edge is resolved as shortestPath between its endpoints. */
+	bool all_shortest_paths;/* Edge is resolved as allShortestPaths between its endpoints. */
 };
 
 typedef struct QGEdge QGEdge;
@@ -4,6 +4,8 @@
 * This file is available under the Redis Labs Source Available License Agreement
 */
 
+#include <string.h>
+
 #include "graph.h"
 #include "RG.h"
 #include "config.h"
@@ -19,6 +21,13 @@ static GxB_SelectOp _select_delete_edges = NULL;
 
 /* ========================= Forward declarations  ========================= */
 void _MatrixResizeToCapacity(const Graph *g, RG_Matrix m);
+static void _Graph_CloseSnapshot(Graph *g);
+static void _Graph_PublishWrites(Graph *g);
+static void _Graph_PreserveMatrix(const Graph *g, RG_Matrix m);
+static inline void _Graph_ApplyPending(GrB_Matrix m);
+static inline const Graph *_Graph_View(const Graph *g);
+size_t _Graph_NodeCap(const Graph *g);
+void Graph_UpdateRelationEdgeCount(Graph *g, int r, int64_t delta);
 
 
 /* ========================= GraphBLAS functions ========================= */
@@ -92,6 +101,7 @@ static RG_Matrix RG_Matrix_New(GrB_Type data_type, GrB_Index nrows, GrB_Index nc
 	RG_Matrix matrix = rm_calloc(1, sizeof(_RG_Matrix));
 
 	matrix->allow_multi_edge = true;
+	matrix->synced_dim = RG_MATRIX_DIRTY;
 
 	GrB_Info matrix_res = GrB_Matrix_new(&matrix->grb_matrix, data_type, nrows, ncols);
 	ASSERT(matrix_res == GrB_SUCCESS);
@@ -121,6 +131,22 @@ static inline bool _RG_Matrix_MultiEdgeEnabled(RG_Matrix matrix) {
 	return matrix->allow_multi_edge;
 }
 
+// Marks matrix as modified, readers will have to synchronize it.
+static inline void _RG_Matrix_MarkDirty(RG_Matrix matrix) {
+	__atomic_store_n(&matrix->synced_dim, RG_MATRIX_DIRTY, __ATOMIC_RELAXED);
+}
+
+// Marks matrix as synchronized to dimension 'dim'
+// must be called once all pending changes have been flushed.
+static inline void _RG_Matrix_MarkSynced(RG_Matrix matrix, GrB_Index dim) {
+	__atomic_store_n(&matrix->synced_dim, dim, __ATOMIC_RELEASE);
+}
+
+// Returns true if matrix has no pending changes and is of dimension 'dim'.
+static inline bool _RG_Matrix_IsSynced(RG_Matrix matrix, GrB_Index dim) {
+	return __atomic_load_n(&matrix->synced_dim, __ATOMIC_ACQUIRE) == dim;
+}
+
 // Free RG_Matrix.
 static void RG_Matrix_Free(RG_Matrix matrix) {
 	GrB_Matrix_free(&matrix->grb_matrix);
@@ -128,6 +154,261 @@ static void RG_Matrix_Free(RG_Matrix matrix) {
 	rm_free(matrix);
 }
 
+// Edge arrays are owned by a single matrix, copies of relation matrices clone them.
+static GrB_UnaryOp _edge_clone_op = NULL;
+
+static void _edge_clone(void *z, const void *x) {
+	EdgeID id = *(const EdgeID *)x;
+	if(!(SINGLE_EDGE(id))) {
+		EdgeID *ids;
+		array_clone(ids, (EdgeID *)id);
+		id = (EdgeID)ids;
+	}
+	*(EdgeID *)z = id;
+}
+
+// Returns a copy of matrix resized to dim, to be read by snapshots.
+static RG_Matrix _RG_Matrix_Copy(RG_Matrix matrix, GrB_Index dim) {
+	GrB_Info info;
+	UNUSED(info);
+	RG_Matrix copy = rm_calloc(1, sizeof(_RG_Matrix));
+	copy->allow_multi_edge = matrix->allow_multi_edge;
+	copy->refcount = 1;
+
+	info = GrB_Matrix_dup(&copy->grb_matrix, matrix->grb_matrix);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_resize(copy->grb_matrix, dim, dim);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Type type;
+	GxB_Matrix_type(&type, copy->grb_matrix);
+	if(type == GrB_UINT64) {
+		info = GrB_Matrix_apply(copy->grb_matrix, GrB_NULL, GrB_NULL, _edge_clone_op,
+								copy->grb_matrix, GrB_NULL);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	_Graph_ApplyPending(copy->grb_matrix);
+	_RG_Matrix_MarkSynced(copy, dim);
+
+	int res = pthread_mutex_init(&copy->mutex, NULL);
+	UNUSED(res);
+	ASSERT(res == 0);
+	return copy;
+}
+
+// Drops a snapshot's reference to a matrix copy,
+// the last snapshot holding the copy frees it along with its edge arrays.
+static void _RG_Matrix_Release(RG_Matrix copy) {
+	if(copy == NULL || --copy->refcount > 0) return;
+
+	GrB_Type type;
+	GxB_Matrix_type(&type, copy->grb_matrix);
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, copy->grb_matrix);
+	if(type == GrB_UINT64 && nvals > 0) {
+		uint64_t *X = rm_malloc(sizeof(uint64_t) * nvals);
+		GrB_Matrix_extractTuples_UINT64(GrB_NULL, GrB_NULL, X, &nvals, copy->grb_matrix);
+		for(GrB_Index i = 0; i < nvals; i++) {
+			if(!(SINGLE_EDGE(X[i]))) array_free((EdgeID *)X[i]);
+		}
+		rm_free(X);
+	}
+
+	RG_Matrix_Free(copy);
+}
+
+/* ========================= RelationDegrees functions ========================= */
+
+// Maps a relation matrix entry to the number of edges it holds.
+static GrB_UnaryOp _edge_count_op = NULL;
+
+static void _edge_count(void *z, const void *x) {
+	EdgeID id = *(const EdgeID *)x;
+	*(uint64_t *)z = (SINGLE_EDGE(id)) ? 1 : array_len((EdgeID *)id);
+}
+
+static inline RelationDegrees RelationDegrees_New(GrB_Index dim) {
+	RelationDegrees d = {.out = NULL, .in = NULL, .edge_count = 0};
+	GrB_Vector_new(&d.out, GrB_UINT64, dim);
+	GrB_Vector_new(&d.in, GrB_UINT64, dim);
+	return d;
+}
+
+static void RelationDegrees_Free(RelationDegrees *d) {
+	if(d->out) GrB_Vector_free(&d->out);
+	if(d->in) GrB_Vector_free(&d->in);
+}
+
+// Makes sure degree vectors can hold dim nodes.
+static void _RelationDegrees_Fit(RelationDegrees *d, GrB_Index dim) {
+	GrB_Index n;
+	GrB_Vector_size(&n, d->out);
+	if(n >= dim) return;
+	GrB_Info info;
+	UNUSED(info);
+	info = GxB_Vector_resize(d->out, dim);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Vector_resize(d->in, dim);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+// Accounts for a single edge leaving src and entering dest, or for its removal.
+static void _RelationDegrees_Connect(const Graph *g, RelationDegrees *d, NodeID src, NodeID dest,
+									 bool remove) {
+	// Resizing assembles pending degrees, grow along with node capacity.
+	_RelationDegrees_Fit(d, _Graph_NodeCap(g));
+
+	// Nodes gaining their first edge are added as pending tuples.
+	GrB_BinaryOp accum = (remove) ? GrB_MINUS_UINT64 : GrB_PLUS_UINT64;
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Index I = src;
+	info = GxB_Vector_subassign_UINT64(d->out, GrB_NULL, accum, 1, &I, 1, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	I = dest;
+	info = GxB_Vector_subassign_UINT64(d->in, GrB_NULL, accum, 1, &I, 1, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+// Adds the number of times each node appears in ids to its degree in v.
+static void _RelationDegrees_AddIDs(GrB_Vector v, const GrB_Index *ids, const uint64_t *ones,
+									GrB_Index n) {
+	GrB_Index dim;
+	GrB_Vector_size(&dim, v);
+
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Vector D;
+	GrB_Vector_new(&D, GrB_UINT64, dim);
+	info = GrB_Vector_build_UINT64(D, ids, ones, n, GrB_PLUS_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_eWiseAdd_Vector_BinaryOp(v, GrB_NULL, GrB_NULL, GrB_PLUS_UINT64, v, D, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	GrB_Vector_free(&D);
+}
+
+// Accounts for n edges, the kth leaving I[k] and entering J[k].
+static void _RelationDegrees_ConnectMany(const Graph *g, RelationDegrees *d, const GrB_Index *I,
+										 const GrB_Index *J, GrB_Index n) {
+	if(n == 0) return;
+	_RelationDegrees_Fit(d, _Graph_NodeCap(g));
+
+	uint64_t *ones = rm_malloc(sizeof(uint64_t) * n);
+	for(GrB_Index k = 0; k < n; k++) ones[k] = 1;
+	_RelationDegrees_AddIDs(d->out, I, ones, n);
+	_RelationDegrees_AddIDs(d->in, J, ones, n);
+	rm_free(ones);
+}
+
+// Returns C, where C[i,j] is the number of edges held by relation matrix entry R[i,j].
+static GrB_Matrix _EdgeCountMatrix(GrB_Matrix R) {
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Matrix_nrows(&nrows, R);
+	GrB_Matrix_ncols(&ncols, R);
+
+	GrB_Matrix C;
+	GrB_Matrix_new(&C, GrB_UINT64, nrows, ncols);
+	GrB_Matrix_apply(C, GrB_NULL, GrB_NULL, _edge_count_op, R, GrB_NULL);
+	return C;
+}
+
+/* Accounts for the edges held by A, a subset of relation matrix r,
+ * in r's edge count and node degrees, subtracting them if remove is set. */
+void Graph_AccumRelationDegrees(Graph *g, int r, GrB_Matrix A, bool remove) {
+	ASSERT(r >= 0 && r < array_len(g->degrees));
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, A);
+	if(nvals == 0) return;
+
+	RelationDegrees *d = g->degrees + r;
+	GrB_Matrix C = _EdgeCountMatrix(A);
+	GrB_Index nrows;
+	GrB_Matrix_nrows(&nrows, C);
+	_RelationDegrees_Fit(d, nrows);
+
+	// Vectors and C must agree on dimensions.
+	GrB_Index dim;
+	GrB_Vector_size(&dim, d->out);
+	if(dim != nrows) GxB_Matrix_resize(C, dim, dim);
+
+	uint64_t edge_count = 0;
+	GrB_Matrix_reduce_UINT64(&edge_count, GrB_NULL, GxB_PLUS_UINT64_MONOID, C, GrB_NULL);
+	Graph_UpdateRelationEdgeCount(g, r, (remove) ? -(int64_t)edge_count : (int64_t)edge_count);
+
+	// Rows hold outgoing edges, columns hold incoming edges.
+	GrB_BinaryOp accum = (remove) ? GrB_MINUS_UINT64 : GrB_PLUS_UINT64;
+	GrB_Matrix_reduce_Monoid(d->out, GrB_NULL, accum, GxB_PLUS_UINT64_MONOID, C, GrB_NULL);
+	GrB_Matrix_reduce_Monoid(d->in, GrB_NULL, accum, GxB_PLUS_UINT64_MONOID, C, GrB_DESC_T0);
+	GrB_Matrix_free(&C);
+}
+
+// Assembles pending degrees, such that concurrent readers don't have to.
+static void _Graph_FlushDegrees(Graph *g) {
+	GrB_Index nvals;
+	uint relation_count = array_len(g->degrees);
+	for(uint i = 0; i < relation_count; i++) {
+		GrB_Vector_nvals(&nvals, g->degrees[i].out);
+		GrB_Vector_nvals(&nvals, g->degrees[i].in);
+	}
+}
+
+/* Counts the edges of type r leaving or entering node id off g's relation matrices,
+ * snapshots don't maintain degrees as their matrices are never modified. */
+static uint64_t _Graph_CountDegree(const Graph *g, int r, NodeID id, bool incoming) {
+	// Row id of R holds outgoing edges, column id holds incoming edges.
+	GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+	GrB_Descriptor desc = GrB_DESC_T0;
+	if(incoming) {
+		if(g->t_relations) R = Graph_GetTransposedRelationMatrix(g, r);
+		else desc = GrB_NULL;
+	}
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, R);
+	if(id >= n) return 0;
+
+	uint64_t degree = 0;
+	GrB_Vector w;
+	GrB_Vector_new(&w, GrB_UINT64, n);
+	GrB_Col_extract(w, GrB_NULL, GrB_NULL, R, GrB_ALL, n, id, desc);
+	GrB_Vector_apply(w, GrB_NULL, GrB_NULL, _edge_count_op, w, GrB_NULL);
+	GrB_Vector_reduce_UINT64(&degree, GrB_NULL, GxB_PLUS_UINT64_MONOID, w, GrB_NULL);
+	GrB_Vector_free(&w);
+	return degree;
+}
+
+// Returns the number of edges of type r leaving or entering node id.
+static uint64_t _RelationDegree(const Graph *g, int r, NodeID id, bool incoming) {
+	const RelationDegrees *d = g->degrees + r;
+	if(d->edge_count == 0) return 0;
+	if(g->_live) return _Graph_CountDegree(g, r, id, incoming);
+
+	// Nodes without edges of type r have no entry.
+	uint64_t degree;
+	GrB_Vector v = (incoming) ? d->in : d->out;
+	if(GrB_Vector_extractElement_UINT64(&degree, v, id) != GrB_SUCCESS) degree = 0;
+	return degree;
+}
+
+/* Adds delta edges of type r, a negative delta accounts for removed edges. */
+void Graph_UpdateRelationEdgeCount(Graph *g, int r, int64_t delta) {
+	ASSERT(r >= 0 && r < array_len(g->degrees));
+	RelationDegrees *d = g->degrees + r;
+	ASSERT(delta >= 0 || d->edge_count >= (uint64_t)(-delta));
+	// Edge count is read without holding the read lock.
+	__atomic_add_fetch(&d->edge_count, delta, __ATOMIC_RELAXED);
+}
+
+/* Adds delta nodes labeled as label, a negative delta accounts for removed nodes. */
+void Graph_UpdateLabelNodeCount(Graph *g, int label, int64_t delta) {
+	ASSERT(label >= 0 && label < array_len(g->label_counts));
+	ASSERT(delta >= 0 || g->label_counts[label] >= (uint64_t)(-delta));
+	// Node count is read without holding the read lock.
+	__atomic_add_fetch(g->label_counts + label, delta, __ATOMIC_RELAXED);
+}
+
 /* ========================= Synchronization functions ========================= */
 
 /* Acquire a lock that does not restrict access from additional reader threads */
@@ -139,6 +420,7 @@ void Graph_AcquireReadLock(Graph *g) {
 void Graph_AcquireWriteLock(Graph *g) {
 	pthread_rwlock_wrlock(&g->_rwlock);
 	g->_writelocked = true;
+	if(g->_snapshot_reads) _Graph_CloseSnapshot(g);
 }
 
 /* Release the held lock */
@@ -150,10 +432,20 @@ void Graph_ReleaseLock(Graph *g) {
 	 * for a reader thread to be considered as writer, performing illegal access to
 	 * underline matrices, consider a context switch after unlocking `_rwlock` but
 	 * before setting `_writelocked` to false. */
-	g->_writelocked = false;
+	if(g->_writelocked) {
+		// Publish a new epoch, writer might have modified the graph.
+		_Graph_FlushDegrees(g);
+		__atomic_add_fetch(&g->_epoch, 1, __ATOMIC_RELEASE);
+		if(g->_snapshot_reads) _Graph_PublishWrites(g);
+		g->_writelocked = false;
+	}
 	pthread_rwlock_unlock(&g->_rwlock);
 }
 
+uint64_t Graph_GetEpoch(const Graph *g) {
+	return __atomic_load_n(&g->_epoch, __ATOMIC_ACQUIRE);
+}
+
 /* Writer request access to graph. */
 void Graph_WriterEnter(Graph *g) {
 	pthread_mutex_lock(&g->_writers_mutex);
@@ -227,6 +519,7 @@ void _Graph_GetEdgesConnectingNodes(const Graph *g, NodeID src, NodeID dest, int
 // Tests if there's an edge of type r between src and dest nodes.
 bool Graph_EdgeExists(const Graph *g, NodeID srcID, NodeID destID, int r) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	EdgeID edgeId;
 	GrB_Matrix M = Graph_GetRelationMatrix(g, r);
 	GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, M, destID, srcID);
@@ -252,6 +545,9 @@ void _MatrixSynchronize(const Graph *g, RG_Matrix rg_matrix) {
 
 	// If the graph belongs to one thread, we don't need to lock the mutex.
 	if(g->_writelocked) {
+		// Writer is about to modify matrix.
+		_Graph_PreserveMatrix(g, rg_matrix);
+		_RG_Matrix_MarkDirty(rg_matrix);
 		if((n_rows != dims) || (n_cols != dims)) {
 			GrB_Info res = GxB_Matrix_resize(m, dims, dims);
 			ASSERT(res == GrB_SUCCESS);
@@ -260,8 +556,15 @@ void _MatrixSynchronize(const Graph *g, RG_Matrix rg_matrix) {
 		// Writer under write lock, no need to flush pending changes.
 		return;
 	}
+
+	// Matrix is up to date, no need to enter critical section.
+	if(_RG_Matrix_IsSynced(rg_matrix, dims)) return;
+
 	// Lock the matrix.
 	RG_Matrix_Lock(rg_matrix);
+	// Snapshots may be copying the matrix.
+	pthread_mutex_t *snapshots_mutex = (pthread_mutex_t *)&g->_snapshots_mutex;
+	if(g->_snapshot_reads) pthread_mutex_lock(snapshots_mutex);
 
 	bool pending = false;
 	GxB_Matrix_Pending(m, &pending);
@@ -280,6 +583,9 @@ void _MatrixSynchronize(const Graph *g, RG_Matrix rg_matrix) {
 		// Flush changes to matrix.
 		_Graph_ApplyPending(m);
 	}
+	// Let subsequent readers skip synchronization.
+	_RG_Matrix_MarkSynced(rg_matrix, dims);
+	if(g->_snapshot_reads) pthread_mutex_unlock(snapshots_mutex);
 	// Unlock matrix mutex.
 	_RG_Matrix_Unlock(rg_matrix);
 }
@@ -293,6 +599,10 @@ void _MatrixResizeToCapacity(const Graph *g, RG_Matrix matrix) {
 	GrB_Matrix_nrows(&nrows, m);
 	GrB_Index cap = _Graph_NodeCap(g);
 
+	// Matrix is about to be modified.
+	_Graph_PreserveMatrix(g, matrix);
+	_RG_Matrix_MarkDirty(matrix);
+
 	// This policy should only be used in a thread-safe context, so no locking is required.
 	if(ncols != cap || nrows != cap) {
 		GrB_Info res = GxB_Matrix_resize(m, cap, cap);
@@ -327,18 +637,21 @@ void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy) {
 	}
 }
 
-/* Synchronize and resize all matrices in graph. */
-void Graph_ApplyAllPending(Graph *g) {
+/* Applies sync to every matrix in graph, the zero matrix aside. */
+static void _Graph_SynchronizeMatrices(const Graph *g, SyncMatrixFunc sync) {
 	RG_Matrix M;
 
+	sync(g, g->adjacency_matrix);
+	sync(g, g->_t_adjacency_matrix);
+
 	for(int i = 0; i < array_len(g->labels); i ++) {
 		M = g->labels[i];
-		g->SynchronizeMatrix(g, M);
+		sync(g, M);
 	}
 
 	for(int i = 0; i < array_len(g->relations); i ++) {
 		M = g->relations[i];
-		g->SynchronizeMatrix(g, M);
+		sync(g, M);
 	}
 
 	bool maintain_transpose;
@@ -347,9 +660,396 @@ void Graph_ApplyAllPending(Graph *g) {
 	if(maintain_transpose) {
 		for(int i = 0; i < array_len(g->t_relations); i ++) {
 			M = g->t_relations[i];
-			g->SynchronizeMatrix(g, M);
+			sync(g, M);
+		}
+	}
+}
+
+/* Synchronize and resize all matrices in graph. */
+void Graph_ApplyAllPending(Graph *g) {
+	_Graph_SynchronizeMatrices(g, g->SynchronizeMatrix);
+	_Graph_FlushDegrees(g);
+}
+
+void Graph_SynchronizeWrites(Graph *g) {
+	ASSERT(g);
+
+	// Nothing was committed since last synchronization.
+	uint64_t epoch = Graph_GetEpoch(g);
+	if(epoch == g->_synced_epoch) return;
+
+	/* Synchronize as a reader, matrices untouched by the writer
+	 * are skipped as they're already in sync. */
+	Graph_AcquireReadLock(g);
+	Graph_ApplyAllPending(g);
+	Graph_ReleaseLock(g);
+
+	g->_synced_epoch = epoch;
+}
+
+/* ============================= Snapshot functions ============================ */
+
+struct GraphSnapshot {
+	Graph g;         // Graph as of epoch, matrices are copied from the live graph on first access.
+	uint64_t epoch;  // Epoch published along with snapshot.
+	uint pins;       // Number of readers executing against snapshot.
+	bool closed;     // Snapshot is not preserved by the current writer, and can't be pinned.
+};
+
+// Thread local storage key of the snapshot attached to the calling thread.
+static pthread_key_t _tlsSnapshotKey;
+static pthread_once_t _tlsSnapshotKeyOnce = PTHREAD_ONCE_INIT;
+
+static void _Graph_CreateSnapshotKey(void) {
+	int res = pthread_key_create(&_tlsSnapshotKey, NULL);
+	UNUSED(res);
+	ASSERT(res == 0);
+}
+
+// Returns the snapshot of g attached to the calling thread, g itself if there's none.
+static inline const Graph *_Graph_View(const Graph *g) {
+	if(!g->_snapshot_reads) return g;
+	GraphSnapshot *s = pthread_getspecific(_tlsSnapshotKey);
+	return (s != NULL && s->g._live == g) ? &s->g : g;
+}
+
+// Returns the live matrix snapshot's slot holds a copy of.
+static RG_Matrix _GraphSnapshot_Source(const GraphSnapshot *s, RG_Matrix *slot) {
+	const Graph *g = &s->g;
+	const Graph *live = g->_live;
+	if(slot == &g->adjacency_matrix) return live->adjacency_matrix;
+	if(slot == &g->_t_adjacency_matrix) return live->_t_adjacency_matrix;
+	if(slot == &g->_zero_matrix) return live->_zero_matrix;
+	if(slot >= g->labels && slot < g->labels + array_len(g->labels)) {
+		return live->labels[slot - g->labels];
+	}
+	if(slot >= g->relations && slot < g->relations + array_len(g->relations)) {
+		return live->relations[slot - g->relations];
+	}
+	ASSERT(slot >= g->t_relations && slot < g->t_relations + array_len(g->t_relations));
+	return live->t_relations[slot - g->t_relations];
+}
+
+// Returns the slot of snapshot holding a copy of live matrix m,
+// NULL if m was created after snapshot was taken.
+static RG_Matrix *_GraphSnapshot_Slot(GraphSnapshot *s, RG_Matrix m) {
+	Graph *g = &s->g;
+	const Graph *live = g->_live;
+	if(m == live->adjacency_matrix) return &g->adjacency_matrix;
+	if(m == live->_t_adjacency_matrix) return &g->_t_adjacency_matrix;
+	if(m == live->_zero_matrix) return &g->_zero_matrix;
+
+	uint label_count = array_len(g->labels);
+	for(uint i = 0; i < label_count; i++) {
+		if(live->labels[i] == m) return g->labels + i;
+	}
+
+	uint relation_count = array_len(g->relations);
+	for(uint i = 0; i < relation_count; i++) {
+		if(live->relations[i] == m) return g->relations + i;
+		if(g->t_relations && live->t_relations[i] == m) return g->t_relations + i;
+	}
+
+	return NULL;
+}
+
+// Returns the matrix held by slot of g, a snapshot copies
+// the matrix from the live graph on first access.
+static RG_Matrix _Graph_Matrix(const Graph *g, RG_Matrix const *slot) {
+	if(g->_live == NULL) return *slot;
+
+	RG_Matrix m = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+	if(m != NULL) return m;
+
+	// Live matrix wasn't modified since snapshot was taken, copy it.
+	GraphSnapshot *s = (GraphSnapshot *)g;
+	Graph *live = g->_live;
+	pthread_mutex_lock(&live->_snapshots_mutex);
+	{
+		m = *slot;
+		if(m == NULL) {
+			m = _RG_Matrix_Copy(_GraphSnapshot_Source(s, (RG_Matrix *)slot),
+								Graph_RequiredMatrixDim(g));
+			__atomic_store_n((RG_Matrix *)slot, m, __ATOMIC_RELEASE);
+		}
+	}
+	pthread_mutex_unlock(&live->_snapshots_mutex);
+
+	return m;
+}
+
+/* Copies m into every snapshot lacking it before the writer modifies it,
+ * a matrix is copied at most once per epoch. */
+static void _Graph_PreserveMatrix(const Graph *g, RG_Matrix m) {
+	if(!g->_snapshot_reads) return;
+
+	// Epoch about to be published by the writer.
+	uint64_t epoch = g->_epoch + 1;
+	if(m->modified == epoch) return;
+
+	pthread_mutex_t *snapshots_mutex = (pthread_mutex_t *)&g->_snapshots_mutex;
+	pthread_mutex_lock(snapshots_mutex);
+	{
+		// Snapshots of equal dimensions share a copy.
+		RG_Matrix copy = NULL;
+		uint snapshot_count = array_len(g->_snapshots);
+		for(uint i = 0; i < snapshot_count; i++) {
+			GraphSnapshot *s = g->_snapshots[i];
+			if(s->closed) continue;
+			RG_Matrix *slot = _GraphSnapshot_Slot(s, m);
+			if(slot == NULL || *slot != NULL) continue;
+
+			GrB_Index dim = Graph_RequiredMatrixDim(&s->g);
+			if(copy != NULL && copy->synced_dim == dim) copy->refcount++;
+			else copy = _RG_Matrix_Copy(m, dim);
+			__atomic_store_n(slot, copy, __ATOMIC_RELEASE);
+		}
+		m->modified = epoch;
+	}
+	pthread_mutex_unlock(snapshots_mutex);
+}
+
+// Returns prev's copy of live matrix m if m was not modified since prev was published.
+static RG_Matrix _GraphSnapshot_Inherit(const GraphSnapshot *prev, RG_Matrix copy, RG_Matrix m,
+										GrB_Index dim) {
+	if(prev == NULL || copy == NULL) return NULL;
+	if(m->modified > prev->epoch || copy->synced_dim != dim) return NULL;
+	copy->refcount++;
+	return copy;
+}
+
+// Returns a snapshot's array of copies of matrices, sharing prev's copies.
+static RG_Matrix *_GraphSnapshot_InheritArray(const GraphSnapshot *prev, RG_Matrix *copies,
+											  RG_Matrix *matrices, GrB_Index dim) {
+	uint count = array_len(matrices);
+	uint prev_count = (prev) ? array_len(copies) : 0;
+	RG_Matrix *arr = array_newlen(RG_Matrix, count);
+	for(uint i = 0; i < count; i++) {
+		arr[i] = (i < prev_count) ? _GraphSnapshot_Inherit(prev, copies[i], matrices[i], dim) : NULL;
+	}
+	return arr;
+}
+
+/* Takes a snapshot of g, matrices and blocks which were not modified
+ * since prev was taken are shared with prev. */
+static GraphSnapshot *_GraphSnapshot_New(Graph *g, const GraphSnapshot *prev) {
+	GraphSnapshot *s = rm_calloc(1, sizeof(GraphSnapshot));
+	s->epoch = g->_epoch;
+
+	Graph *sg = &s->g;
+	sg->_live = g;
+	sg->_epoch = g->_epoch;
+	sg->_synced_epoch = g->_epoch;
+	sg->SynchronizeMatrix = _MatrixNOP;
+	sg->nodes = DataBlock_Snapshot(g->nodes, (prev) ? prev->g.nodes : NULL,
+								   (fpCopy)CloneEntityProperties);
+	sg->edges = DataBlock_Snapshot(g->edges, (prev) ? prev->g.edges : NULL,
+								   (fpCopy)CloneEntityProperties);
+
+	GrB_Index dim = Graph_RequiredMatrixDim(sg);
+	const Graph *pg = (prev) ? &prev->g : NULL;
+	sg->adjacency_matrix = _GraphSnapshot_Inherit(prev, (pg) ? pg->adjacency_matrix : NULL,
+												  g->adjacency_matrix, dim);
+	sg->_t_adjacency_matrix = _GraphSnapshot_Inherit(prev, (pg) ? pg->_t_adjacency_matrix : NULL,
+													 g->_t_adjacency_matrix, dim);
+	sg->_zero_matrix = _GraphSnapshot_Inherit(prev, (pg) ? pg->_zero_matrix : NULL,
+											  g->_zero_matrix, dim);
+	sg->labels = _GraphSnapshot_InheritArray(prev, (pg) ? pg->labels : NULL, g->labels, dim);
+	sg->relations = _GraphSnapshot_InheritArray(prev, (pg) ? pg->relations : NULL, g->relations,
+												dim);
+	sg->t_relations = (g->t_relations) ?
+					  _GraphSnapshot_InheritArray(prev, (pg) ? pg->t_relations : NULL, g->t_relations, dim) :
+					  NULL;
+
+	// Degrees are counted off the snapshot's relation matrices.
+	uint relation_count = array_len(g->degrees);
+	sg->degrees = array_newlen(RelationDegrees, relation_count);
+	for(uint i = 0; i < relation_count; i++) {
+		sg->degrees[i] = (RelationDegrees) {
+			.out = NULL, .in = NULL, .edge_count = g->degrees[i].edge_count
+		};
+	}
+
+	array_clone(sg->label_counts, g->label_counts);
+	int res = pthread_mutex_init(&sg->_stats_mutex, NULL);
+	ASSERT(res == 0);
+
+	return s;
+}
+
+/* Frees snapshot along with the copies no other snapshot shares,
+ * called while holding the graph's snapshots mutex. */
+static void _GraphSnapshot_Free(Graph *g, GraphSnapshot *s) {
+	uint snapshot_count = array_len(g->_snapshots);
+	for(uint i = 0; i < snapshot_count; i++) {
+		if(g->_snapshots[i] == s) {
+			array_del(g->_snapshots, i);
+			break;
+		}
+	}
+
+	Graph *sg = &s->g;
+	_RG_Matrix_Release(sg->adjacency_matrix);
+	_RG_Matrix_Release(sg->_t_adjacency_matrix);
+	_RG_Matrix_Release(sg->_zero_matrix);
+
+	uint label_count = array_len(sg->labels);
+	for(uint i = 0; i < label_count; i++) _RG_Matrix_Release(sg->labels[i]);
+	array_free(sg->labels);
+
+	uint relation_count = array_len(sg->relations);
+	for(uint i = 0; i < relation_count; i++) {
+		_RG_Matrix_Release(sg->relations[i]);
+		if(sg->t_relations) _RG_Matrix_Release(sg->t_relations[i]);
+		RelationDegrees_Free(sg->degrees + i);
+	}
+	array_free(sg->relations);
+	if(sg->t_relations) array_free(sg->t_relations);
+	array_free(sg->degrees);
+	array_free(sg->label_counts);
+	pthread_mutex_destroy(&sg->_stats_mutex);
+
+	DataBlock_Free(sg->nodes);
+	DataBlock_Free(sg->edges);
+	rm_free(s);
+}
+
+/* Publishes the graph's current state as its latest snapshot, called while holding
+ * the snapshots mutex once all matrices were flushed, no writer may modify the graph meanwhile. */
+static void _Graph_PublishSnapshot(Graph *g) {
+	GraphSnapshot *prev = g->_snapshot;
+	GraphSnapshot *s = _GraphSnapshot_New(g, prev);
+	g->_snapshots = array_append(g->_snapshots, s);
+	__atomic_store_n(&g->_snapshot, s, __ATOMIC_RELEASE);
+
+	// An outdated snapshot is freed by its last reader.
+	if(prev != NULL && prev->pins == 0) _GraphSnapshot_Free(g, prev);
+	pthread_cond_broadcast(&g->_snapshots_cond);
+}
+
+/* Flushes a matrix modified by the writer, snapshots copy matrices as they are. */
+static void _MatrixFlush(const Graph *g, RG_Matrix matrix) {
+	if(__atomic_load_n(&matrix->synced_dim, __ATOMIC_ACQUIRE) != RG_MATRIX_DIRTY) return;
+
+	GrB_Matrix m = RG_Matrix_Get_GrB_Matrix(matrix);
+	GrB_Index n_rows;
+	GrB_Index n_cols;
+	GrB_Matrix_nrows(&n_rows, m);
+	GrB_Matrix_ncols(&n_cols, m);
+	GrB_Index dims = Graph_RequiredMatrixDim(g);
+	if((n_rows != dims) || (n_cols != dims)) {
+		GrB_Info res = GxB_Matrix_resize(m, dims, dims);
+		ASSERT(res == GrB_SUCCESS);
+	}
+	_Graph_ApplyPending(m);
+	_RG_Matrix_MarkSynced(matrix, dims);
+}
+
+/* Called by the writer as it releases the write lock, publishes its changes
+ * once readers started executing against snapshots. */
+static void _Graph_PublishWrites(Graph *g) {
+	if(__atomic_load_n(&g->_snapshot, __ATOMIC_ACQUIRE) == NULL) return;
+
+	// Matrices untouched by the writer were flushed by earlier writers.
+	_Graph_SynchronizeMatrices(g, _MatrixFlush);
+	_MatrixFlush(g, g->_zero_matrix);
+
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	_Graph_PublishSnapshot(g);
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+}
+
+/* Called by the writer as it acquires the write lock, the latest snapshot
+ * is not preserved unless pinned, readers arriving meanwhile wait for the
+ * writer to publish the next snapshot. */
+static void _Graph_CloseSnapshot(Graph *g) {
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	{
+		GraphSnapshot *s = g->_snapshot;
+		if(s != NULL && s->pins == 0) {
+			s->closed = true;
+			DataBlock_DetachSnapshot(s->g.nodes);
+			DataBlock_DetachSnapshot(s->g.edges);
+		}
+	}
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+}
+
+bool Graph_SnapshotReads(const Graph *g) {
+	ASSERT(g);
+	return g->_snapshot_reads;
+}
+
+GraphSnapshot *Graph_PinSnapshot(Graph *g) {
+	ASSERT(g && g->_live == NULL);
+	if(!g->_snapshot_reads) return NULL;
+
+	if(__atomic_load_n(&g->_snapshot, __ATOMIC_ACQUIRE) == NULL) {
+		/* No snapshot was taken since graph was loaded, take one
+		 * under the read lock such that no writer modifies the graph meanwhile. */
+		Graph_AcquireReadLock(g);
+		_Graph_SynchronizeMatrices(g, _MatrixSynchronize);
+		_MatrixSynchronize(g, g->_zero_matrix);
+		pthread_mutex_lock(&g->_snapshots_mutex);
+		if(g->_snapshot == NULL) _Graph_PublishSnapshot(g);
+		pthread_mutex_unlock(&g->_snapshots_mutex);
+		Graph_ReleaseLock(g);
+	}
+
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	while(g->_snapshot->closed) pthread_cond_wait(&g->_snapshots_cond, &g->_snapshots_mutex);
+	GraphSnapshot *s = g->_snapshot;
+	s->pins++;
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+
+	return s;
+}
+
+void Graph_UnpinSnapshot(GraphSnapshot *s) {
+	ASSERT(s);
+	Graph *g = s->g._live;
+
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	{
+		ASSERT(s->pins > 0);
+		s->pins--;
+		// Only the latest snapshot outlives its readers.
+		if(s->pins == 0 && s != g->_snapshot) _GraphSnapshot_Free(g, s);
+	}
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+}
+
+uint64_t Graph_PinnedEpoch(Graph *g) {
+	ASSERT(g && g->_live == NULL);
+	uint64_t epoch = UINT64_MAX;
+
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	// Snapshots are kept oldest first.
+	uint snapshot_count = array_len(g->_snapshots);
+	for(uint i = 0; i < snapshot_count; i++) {
+		if(g->_snapshots[i]->pins > 0) {
+			epoch = g->_snapshots[i]->epoch;
+			break;
 		}
 	}
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+
+	return epoch;
+}
+
+void Graph_AttachSnapshot(GraphSnapshot *s) {
+	ASSERT(s);
+	pthread_setspecific(_tlsSnapshotKey, s);
+}
+
+void Graph_DetachSnapshot(void) {
+	pthread_setspecific(_tlsSnapshotKey, NULL);
+}
+
+void Graph_PrepareEntityWrite(Graph *g, GraphEntityType t, EntityID id) {
+	ASSERT(g && g->_live == NULL);
+	if(!g->_snapshot_reads) return;
+	DataBlock_PrepareWrite((t == GETYPE_NODE) ? g->nodes : g->edges, id);
 }
 
 /* ================================ Graph API ================================ */
@@ -362,6 +1062,8 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	g->edges = DataBlock_New(edge_cap, sizeof(Entity), (fpDestructor)FreeEntity);
 	g->labels = array_new(RG_Matrix, GRAPH_DEFAULT_LABEL_CAP);
 	g->relations = array_new(RG_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->degrees = array_new(RelationDegrees, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->label_counts = array_new(uint64_t, GRAPH_DEFAULT_LABEL_CAP);
 	g->adjacency_matrix = RG_Matrix_New(GrB_BOOL, node_cap, node_cap);
 	g->_t_adjacency_matrix = RG_Matrix_New(GrB_BOOL, node_cap, node_cap);
 	g->_zero_matrix = RG_Matrix_New(GrB_BOOL, node_cap, node_cap);
@@ -378,6 +1080,14 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	res = pthread_rwlock_init(&g->_rwlock, NULL);
 	ASSERT(res == 0);
 	g->_writelocked = false;
+	g->_epoch = 0;
+	g->_synced_epoch = 0;
+
+	// Readers pin snapshots once snapshot reads are enabled.
+	Config_Option_get(Config_SNAPSHOT_READS, &g->_snapshot_reads);
+	g->_live = NULL;
+	g->_snapshot = NULL;
+	g->_snapshots = array_new(GraphSnapshot *, 0);
 
 	// Force GraphBLAS updates and resize matrices to node count by default
 	Graph_SetMatrixPolicy(g, SYNC_AND_MINIMIZE_SPACE);
@@ -386,6 +1096,17 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	res = pthread_mutex_init(&g->_writers_mutex, NULL);
 	ASSERT(res == 0);
 
+	res = pthread_mutex_init(&g->_stats_mutex, NULL);
+	ASSERT(res == 0);
+
+	res = pthread_mutex_init(&g->_snapshots_mutex, NULL);
+	ASSERT(res == 0);
+
+	res = pthread_cond_init(&g->_snapshots_cond, NULL);
+	ASSERT(res == 0);
+
+	if(g->_snapshot_reads) pthread_once(&_tlsSnapshotKeyOnce, _Graph_CreateSnapshotKey);
+
 	// Create edge accumulator binary function
 	if(!_graph_edge_accum) {
 		GrB_Info info;
@@ -394,12 +1115,29 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 		ASSERT(info == GrB_SUCCESS);
 	}
 
+	// Create edge count unary function
+	if(!_edge_count_op) {
+		GrB_Info info;
+		UNUSED(info);
+		info = GrB_UnaryOp_new(&_edge_count_op, _edge_count, GrB_UINT64, GrB_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// Create edge clone unary function
+	if(!_edge_clone_op) {
+		GrB_Info info;
+		UNUSED(info);
+		info = GrB_UnaryOp_new(&_edge_clone_op, _edge_clone, GrB_UINT64, GrB_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
 	return g;
 }
 
 // All graph matrices are required to be squared NXN
 // where N is Graph_RequiredMatrixDim.
 size_t Graph_RequiredMatrixDim(const Graph *g) {
+	g = _Graph_View(g);
 	// Matrix dimensions should be at least:
 	// Number of nodes + number of deleted nodes.
 	return g->nodes->itemCount + array_len(g->nodes->deletedIdx);
@@ -407,39 +1145,148 @@ size_t Graph_RequiredMatrixDim(const Graph *g) {
 
 size_t Graph_NodeCount(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return g->nodes->itemCount;
 }
 
 uint Graph_DeletedNodeCount(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return DataBlock_DeletedItemsCount(g->nodes);
 }
 
 size_t Graph_LabeledNodeCount(const Graph *g, int label) {
-	GrB_Index nvals = 0;
-	GrB_Matrix m = Graph_GetLabelMatrix(g, label);
-	if(m) GrB_Matrix_nvals(&nvals, m);
-	return nvals;
+	ASSERT(g && label >= 0);
+	g = _Graph_View(g);
+
+	// Writers may grow label counts meanwhile.
+	pthread_mutex_t *lock = (pthread_mutex_t *)&g->_stats_mutex;
+	pthread_mutex_lock(lock);
+	// Label was introduced after snapshot was taken.
+	uint64_t count = 0;
+	if(label < array_len(g->label_counts)) {
+		count = __atomic_load_n(g->label_counts + label, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(lock);
+	return count;
 }
 
 size_t Graph_EdgeCount(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return g->edges->itemCount;
 }
 
 uint Graph_DeletedEdgeCount(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return DataBlock_DeletedItemsCount(g->edges);
 }
 
 int Graph_RelationTypeCount(const Graph *g) {
+	g = _Graph_View(g);
 	return array_len(g->relations);
 }
 
 int Graph_LabelTypeCount(const Graph *g) {
+	g = _Graph_View(g);
 	return array_len(g->labels);
 }
 
+uint64_t Graph_GetNodeDegree(const Graph *g, NodeID id, GRAPH_EDGE_DIR dir, int r) {
+	ASSERT(g);
+	g = _Graph_View(g);
+	if(r == GRAPH_UNKNOWN_RELATION) return 0;
+
+	// Sum degrees over all relation types.
+	if(r == GRAPH_NO_RELATION) {
+		uint64_t degree = 0;
+		uint relation_count = array_len(g->degrees);
+		for(uint i = 0; i < relation_count; i++) {
+			degree += Graph_GetNodeDegree(g, id, dir, i);
+		}
+		return degree;
+	}
+
+	// Relation type was introduced after snapshot was taken.
+	if(g->_live && r >= array_len(g->degrees)) return 0;
+
+	ASSERT(r < array_len(g->degrees));
+	uint64_t degree = 0;
+	if(dir == GRAPH_EDGE_DIR_OUTGOING || dir == GRAPH_EDGE_DIR_BOTH) {
+		degree += _RelationDegree(g, r, id, false);
+	}
+	if(dir == GRAPH_EDGE_DIR_INCOMING || dir == GRAPH_EDGE_DIR_BOTH) {
+		degree += _RelationDegree(g, r, id, true);
+	}
+	return degree;
+}
+
+uint64_t Graph_RelationEdgeCount(const Graph *g, int r) {
+	ASSERT(g);
+	if(r == GRAPH_UNKNOWN_RELATION) return 0;
+	if(r == GRAPH_NO_RELATION) return Graph_EdgeCount(g);
+
+	g = _Graph_View(g);
+
+	// Writers may grow degrees meanwhile.
+	pthread_mutex_t *lock = (pthread_mutex_t *)&g->_stats_mutex;
+	pthread_mutex_lock(lock);
+	// Relation type was introduced after snapshot was taken.
+	uint64_t count = 0;
+	if(r < array_len(g->degrees)) {
+		count = __atomic_load_n(&g->degrees[r].edge_count, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(lock);
+	return count;
+}
+
+// Estimates the memory held by m's entries, of value_size bytes each.
+static size_t _MatrixMemoryUsage(const RG_Matrix m, size_t value_size) {
+	if(m == NULL) return 0;
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, m->grb_matrix);
+	return nvals * (sizeof(GrB_Index) + value_size);
+}
+
+static size_t _DataBlockMemoryUsage(const DataBlock *dataBlock) {
+	return dataBlock->itemCap * dataBlock->itemSize;
+}
+
+size_t Graph_MemoryUsage(const Graph *g) {
+	ASSERT(g);
+	size_t usage = sizeof(Graph);
+	usage += _DataBlockMemoryUsage(g->nodes);
+	usage += _DataBlockMemoryUsage(g->edges);
+
+	usage += _MatrixMemoryUsage(g->adjacency_matrix, sizeof(bool));
+	usage += _MatrixMemoryUsage(g->_t_adjacency_matrix, sizeof(bool));
+	uint label_count = array_len(g->labels);
+	for(uint i = 0; i < label_count; i++) {
+		usage += _MatrixMemoryUsage(g->labels[i], sizeof(bool));
+	}
+
+	uint relation_count = array_len(g->relations);
+	for(uint i = 0; i < relation_count; i++) {
+		usage += _MatrixMemoryUsage(g->relations[i], sizeof(uint64_t));
+		if(g->t_relations) usage += _MatrixMemoryUsage(g->t_relations[i], sizeof(uint64_t));
+
+		// Edges sharing an entry are held by an array.
+		GrB_Index nvals;
+		GrB_Matrix_nvals(&nvals, g->relations[i]->grb_matrix);
+		const RelationDegrees *d = g->degrees + i;
+		if(d->edge_count > nvals) usage += (d->edge_count - nvals) * sizeof(EdgeID);
+
+		GrB_Vector degrees[2] = {d->out, d->in};
+		for(int j = 0; j < 2; j++) {
+			GrB_Vector_nvals(&nvals, degrees[j]);
+			usage += nvals * (sizeof(GrB_Index) + sizeof(uint64_t));
+		}
+	}
+
+	return usage;
+}
+
 void Graph_AllocateNodes(Graph *g, size_t n) {
 	ASSERT(g);
 	DataBlock_Accommodate(g->nodes, n);
@@ -452,13 +1299,16 @@ void Graph_AllocateEdges(Graph *g, size_t n) {
 
 int Graph_GetNode(const Graph *g, NodeID id, Node *n) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	n->entity = _Graph_GetEntity(g->nodes, id);
 	n->id = id;
 	return (n->entity != NULL);
 }
 
 int Graph_GetEdge(const Graph *g, EdgeID id, Edge *e) {
-	ASSERT(g && id < _Graph_EdgeCap(g));
+	ASSERT(g);
+	g = _Graph_View(g);
+	ASSERT(id < _Graph_EdgeCap(g));
 	e->entity = _Graph_GetEntity(g->edges, id);
 	e->id = id;
 	return (e->entity != NULL);
@@ -466,6 +1316,7 @@ int Graph_GetEdge(const Graph *g, EdgeID id, Edge *e) {
 
 int Graph_GetNodeLabel(const Graph *g, NodeID nodeID) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	int label = GRAPH_NO_LABEL;
 	for(int i = 0; i < array_len(g->labels); i++) {
 		bool x = false;
@@ -482,6 +1333,7 @@ int Graph_GetNodeLabel(const Graph *g, NodeID nodeID) {
 
 int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
 	ASSERT(g && e);
+	g = _Graph_View(g);
 	NodeID srcNodeID = Edge_GetSrcNodeID(e);
 	NodeID destNodeID = Edge_GetDestNodeID(e);
 	EdgeID id = ENTITY_GET_ID(e);
@@ -522,12 +1374,17 @@ int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
 
 void Graph_GetEdgesConnectingNodes(const Graph *g, NodeID srcID, NodeID destID, int r,
 								   Edge **edges) {
-	ASSERT(g && r < Graph_RelationTypeCount(g) && edges);
+	ASSERT(g && edges);
+	g = _Graph_View(g);
 
 	// Invalid relation type specified; this can occur on multi-type traversals like:
 	// MATCH ()-[:real_type|fake_type]->()
 	if(r == GRAPH_UNKNOWN_RELATION) return;
 
+	// Relation type was introduced after snapshot was taken.
+	if(g->_live && r >= Graph_RelationTypeCount(g)) return;
+	ASSERT(r < Graph_RelationTypeCount(g));
+
 	Node srcNode = GE_NEW_NODE();
 	Node destNode = GE_NEW_NODE();
 	ASSERT(Graph_GetNode(g, srcID, &srcNode));
@@ -544,11 +1401,8 @@ void Graph_GetEdgesConnectingNodes(const Graph *g, NodeID srcID, NodeID destID,
 	}
 }
 
-void Graph_CreateNode(Graph *g, int label, Node *n) {
-	ASSERT(g);
-
-	NodeID id;
-	Entity *en = DataBlock_AllocateItem(g->nodes, &id);
+// Initializes node n, allocated at position id, and labels it accordingly.
+static void _Graph_InitNode(Graph *g, NodeID id, Entity *en, int label, Node *n) {
 	n->id = id;
 	n->entity = en;
 	en->prop_count = 0;
@@ -559,15 +1413,33 @@ void Graph_CreateNode(Graph *g, int label, Node *n) {
 		// incase of a failure, scale matrix.
 		RG_Matrix matrix = g->labels[label];
 		GrB_Matrix m = RG_Matrix_Get_GrB_Matrix(matrix);
+		_Graph_PreserveMatrix(g, matrix);
+		_RG_Matrix_MarkDirty(matrix);
 		GrB_Info res = GrB_Matrix_setElement_BOOL(m, true, id, id);
 		if(res != GrB_SUCCESS) {
 			_MatrixResizeToCapacity(g, matrix);
 			res = GrB_Matrix_setElement_BOOL(m, true, id, id);
 			ASSERT(res == GrB_SUCCESS);
 		}
+		Graph_UpdateLabelNodeCount(g, label, 1);
 	}
 }
 
+void Graph_CreateNode(Graph *g, int label, Node *n) {
+	ASSERT(g);
+
+	NodeID id;
+	Entity *en = DataBlock_AllocateItem(g->nodes, &id);
+	_Graph_InitNode(g, id, en, label, n);
+}
+
+void Graph_CreateNodeAt(Graph *g, NodeID id, int label, Node *n) {
+	ASSERT(g);
+
+	Entity *en = DataBlock_AllocateItemAt(g->nodes, id);
+	_Graph_InitNode(g, id, en, label, n);
+}
+
 void Graph_FormConnection(Graph *g, NodeID src, NodeID dest, EdgeID edge_id, int r) {
 	GrB_Info info;
 	UNUSED(info);
@@ -634,6 +1506,9 @@ void Graph_FormConnection(Graph *g, NodeID src, NodeID dest, EdgeID edge_id, int
 			ASSERT(info == GrB_SUCCESS);
 		}
 	}
+
+	Graph_UpdateRelationEdgeCount(g, r, 1);
+	_RelationDegrees_Connect(g, g->degrees + r, src, dest, false);
 }
 
 int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
@@ -648,8 +1523,13 @@ int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
 	ASSERT(res == 1);
 	ASSERT(g && r < Graph_RelationTypeCount(g));
 
-	EdgeID id;
-	Entity *en = DataBlock_AllocateItem(g->edges, &id);
+	Graph_CreateEdge(g, src, dest, r, e);
+	Graph_FormConnection(g, src, dest, e->id, r);
+	return 1;
+}
+
+// Initializes edge e, allocated at position id.
+static void _Graph_InitEdge(EdgeID id, Entity *en, NodeID src, NodeID dest, int r, Edge *e) {
 	en->prop_count = 0;
 	en->properties = NULL;
 	e->id = id;
@@ -657,10 +1537,130 @@ int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
 	e->relationID = r;
 	e->srcNodeID = src;
 	e->destNodeID = dest;
+}
+
+void Graph_CreateEdge(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
+	ASSERT(g && e);
+
+	EdgeID id;
+	Entity *en = DataBlock_AllocateItem(g->edges, &id);
+	_Graph_InitEdge(id, en, src, dest, r, e);
+}
+
+int Graph_ConnectNodesAt(Graph *g, EdgeID id, NodeID src, NodeID dest, int r, Edge *e) {
+	ASSERT(g && e && r < Graph_RelationTypeCount(g));
+
+	Entity *en = DataBlock_AllocateItemAt(g->edges, id);
+	_Graph_InitEdge(id, en, src, dest, r, e);
 	Graph_FormConnection(g, src, dest, id, r);
 	return 1;
 }
 
+/* Merges n connections of relation type r into the relation and adjacency
+ * matrices. Each (I[k], J[k]) pair must appear at most once. */
+static void _Graph_MergeConnections(Graph *g, int r, GrB_Index *I, GrB_Index *J,
+									uint64_t *X, GrB_Index n, bool maintain_transpose) {
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Matrix adj = Graph_GetAdjacencyMatrix(g);
+	GrB_Matrix tadj = Graph_GetTransposedAdjacencyMatrix(g);
+	GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+	GrB_Matrix TR = maintain_transpose ? Graph_GetTransposedRelationMatrix(g, r) : NULL;
+
+	/* Existing entries are combined with the new edge ID the same way
+	 * Graph_FormConnection does, multi-edge disabled matrices are overwritten. */
+	GrB_BinaryOp accum = _RG_Matrix_MultiEdgeEnabled(g->relations[r]) ?
+						 _graph_edge_accum : GrB_SECOND_UINT64;
+
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Matrix_nrows(&nrows, R);
+	GrB_Matrix_ncols(&ncols, R);
+
+	// M[src, dest] = edge ID, tuples are unique so no dup operator is applied.
+	GrB_Matrix M;
+	info = GrB_Matrix_new(&M, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_build_UINT64(M, I, J, X, n, GrB_SECOND_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	// R = R + M.
+	info = GrB_eWiseAdd_Matrix_BinaryOp(R, GrB_NULL, GrB_NULL, accum, R, M, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	// TR = TR + M'.
+	if(TR) {
+		info = GrB_eWiseAdd_Matrix_BinaryOp(TR, GrB_NULL, GrB_NULL, accum, TR, M, GrB_DESC_T1);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// Edge IDs are stored with their MSB set, and therefore cast to true.
+	// adj = adj | M.
+	info = GrB_eWiseAdd_Matrix_BinaryOp(adj, GrB_NULL, GrB_NULL, GrB_LOR, adj, M, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	// tadj = tadj | M'.
+	info = GrB_eWiseAdd_Matrix_BinaryOp(tadj, GrB_NULL, GrB_NULL, GrB_LOR, tadj, M, GrB_DESC_T1);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&M);
+	_RelationDegrees_ConnectMany(g, g->degrees + r, I, J, n);
+}
+
+void Graph_ConnectEdges(Graph *g, Edge *edges, uint64_t edge_count) {
+	ASSERT(g && edges);
+	if(edge_count == 0) return;
+
+	bool maintain_transpose;
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
+
+	// Group edges by relation type and connected node pair.
+#define is_connection_lt(a, b) ((a)->relationID != (b)->relationID ? \
+		(a)->relationID < (b)->relationID : (a)->srcNodeID != (b)->srcNodeID ? \
+		(a)->srcNodeID < (b)->srcNodeID : (a)->destNodeID < (b)->destNodeID)
+	QSORT(Edge, edges, edge_count, is_connection_lt);
+#undef is_connection_lt
+
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * edge_count);
+	GrB_Index *J = rm_malloc(sizeof(GrB_Index) * edge_count);
+	uint64_t *X = rm_malloc(sizeof(uint64_t) * edge_count);
+	// Edges connecting an already connected node pair.
+	Edge **multi_edges = array_new(Edge *, 0);
+
+	uint64_t i = 0;
+	while(i < edge_count) {
+		// Collect all edges of the current relation type.
+		int r = edges[i].relationID;
+		ASSERT(r >= 0 && r < Graph_RelationTypeCount(g));
+		GrB_Index n = 0;
+		for(; i < edge_count && edges[i].relationID == r; i++) {
+			Edge *e = edges + i;
+			if(n > 0 && I[n - 1] == e->srcNodeID && J[n - 1] == e->destNodeID) {
+				multi_edges = array_append(multi_edges, e);
+				continue;
+			}
+			I[n] = e->srcNodeID;
+			J[n] = e->destNodeID;
+			X[n] = SET_MSB(e->id);
+			n++;
+			Graph_UpdateRelationEdgeCount(g, r, 1);
+		}
+
+		_Graph_MergeConnections(g, r, I, J, X, n, maintain_transpose);
+
+		// Additional edges between the same pair are rare, add them one by one.
+		uint multi_edge_count = array_len(multi_edges);
+		for(uint j = 0; j < multi_edge_count; j++) {
+			Edge *e = multi_edges[j];
+			Graph_FormConnection(g, e->srcNodeID, e->destNodeID, e->id, r);
+		}
+		array_clear(multi_edges);
+	}
+
+	array_free(multi_edges);
+	rm_free(I);
+	rm_free(J);
+	rm_free(X);
+}
+
 /* Retrieves all either incoming or outgoing edges
  * to/from given node N, depending on given direction. */
 void Graph_GetNodeEdges(const Graph *g, const Node *n, GRAPH_EDGE_DIR dir, int edgeType,
@@ -743,6 +1743,9 @@ int Graph_DeleteEdge(Graph *g, Edge *e) {
 	info = GrB_Matrix_extractElement(&edge_id, R, src_id, dest_id);
 	if(info != GrB_SUCCESS) return 0;
 
+	Graph_UpdateRelationEdgeCount(g, r, -1);
+	_RelationDegrees_Connect(g, g->degrees + r, src_id, dest_id, true);
+
 	if(SINGLE_EDGE(edge_id)) {
 		// Single edge of type R connecting src to dest, delete entry.
 		info = GxB_Matrix_Delete(R, src_id, dest_id);
@@ -840,8 +1843,12 @@ void Graph_DeleteNode(Graph *g, Node *n) {
 	// Clear label matrix at position node ID.
 	uint32_t label_count = array_len(g->labels);
 	for(int i = 0; i < label_count; i++) {
+		bool x;
 		GrB_Matrix M = Graph_GetLabelMatrix(g, i);
+		GrB_Info res = GrB_Matrix_extractElement_BOOL(&x, M, ENTITY_GET_ID(n), ENTITY_GET_ID(n));
+		if(res != GrB_SUCCESS) continue;
 		GxB_Matrix_Delete(M, ENTITY_GET_ID(n), ENTITY_GET_ID(n));
+		Graph_UpdateLabelNodeCount(g, i, -1);
 	}
 
 	DataBlock_DeleteItem(g->nodes, ENTITY_GET_ID(n));
@@ -979,6 +1986,9 @@ static void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 		 * A will contain all implicitly deleted edges from R. */
 		GrB_Matrix_apply(A, Mask, GrB_NULL, GrB_IDENTITY_UINT64, R, desc);
 
+		// Discount implicitly deleted edges from node degrees.
+		Graph_AccumRelationDegrees(g, i, A, true);
+
 		/* Free each multi edge array entry in A
 		 * Call _select_op_free_edge on each entry of A. */
 		GxB_select(A, GrB_NULL, GrB_NULL, _select_delete_edges, A, thunk, GrB_NULL);
@@ -1033,8 +2043,13 @@ static void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 	 * All nodes marked for deleteion are detected, no incoming / outgoing edges. */
 	int node_type_count = Graph_LabelTypeCount(g);
 	for(int i = 0; i < node_type_count; i++) {
+		GrB_Index before;
+		GrB_Index after;
 		GrB_Matrix L = Graph_GetLabelMatrix(g, i);
+		GrB_Matrix_nvals(&before, L);
 		GrB_Matrix_apply(L, Nodes, GrB_NULL, GrB_IDENTITY_BOOL, L, desc);
+		GrB_Matrix_nvals(&after, L);
+		Graph_UpdateLabelNodeCount(g, i, -(int64_t)(before - after));
 	}
 
 	for(uint i = 0; i < node_count; i++) {
@@ -1072,6 +2087,8 @@ static void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
 		GrB_Matrix R = Graph_GetRelationMatrix(g, r);  // Relation matrix.
 		GrB_Matrix TR = maintain_transpose ? Graph_GetTransposedRelationMatrix(g, r) : NULL;
 		GrB_Matrix_extractElement(&edge_id, R, src_id, dest_id);
+		Graph_UpdateRelationEdgeCount(g, r, -1);
+		_RelationDegrees_Connect(g, g->degrees + r, src_id, dest_id, true);
 
 		if(SINGLE_EDGE(edge_id)) {
 			update_adj_matrices = true;
@@ -1242,18 +2259,32 @@ void Graph_BulkDelete(Graph *g, Node *nodes, uint node_count, Edge *edges, uint
 
 DataBlockIterator *Graph_ScanNodes(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return DataBlock_Scan(g->nodes);
 }
 
+DataBlockIterator *Graph_ScanNodeRange(const Graph *g, NodeID start, NodeID end) {
+	ASSERT(g);
+	g = _Graph_View(g);
+	return DataBlock_ScanRange(g->nodes, start, end);
+}
+
 DataBlockIterator *Graph_ScanEdges(const Graph *g) {
 	ASSERT(g);
+	g = _Graph_View(g);
 	return DataBlock_Scan(g->edges);
 }
 
 int Graph_AddLabel(Graph *g) {
 	ASSERT(g);
 	RG_Matrix m = RG_Matrix_New(GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+	// Snapshots may be copying label matrices.
+	if(g->_snapshot_reads) pthread_mutex_lock(&g->_snapshots_mutex);
 	array_append(g->labels, m);
+	pthread_mutex_lock(&g->_stats_mutex);
+	g->label_counts = array_append(g->label_counts, 0);
+	pthread_mutex_unlock(&g->_stats_mutex);
+	if(g->_snapshot_reads) pthread_mutex_unlock(&g->_snapshots_mutex);
 	return array_len(g->labels) - 1;
 }
 
@@ -1262,7 +2293,12 @@ int Graph_AddRelationType(Graph *g) {
 
 	size_t dims = Graph_RequiredMatrixDim(g);
 	RG_Matrix m = RG_Matrix_New(GrB_UINT64, dims, dims);
+	// Snapshots may be copying relation matrices.
+	if(g->_snapshot_reads) pthread_mutex_lock(&g->_snapshots_mutex);
 	g->relations = array_append(g->relations, m);
+	pthread_mutex_lock(&g->_stats_mutex);
+	g->degrees = array_append(g->degrees, RelationDegrees_New(_Graph_NodeCap(g)));
+	pthread_mutex_unlock(&g->_stats_mutex);
 	bool maintain_transpose;
 	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
 
@@ -1270,6 +2306,7 @@ int Graph_AddRelationType(Graph *g) {
 		RG_Matrix tm = RG_Matrix_New(GrB_UINT64, dims, dims);
 		g->t_relations = array_append(g->t_relations, tm);
 	}
+	if(g->_snapshot_reads) pthread_mutex_unlock(&g->_snapshots_mutex);
 
 	int relationID = Graph_RelationTypeCount(g) - 1;
 	return relationID;
@@ -1277,7 +2314,8 @@ int Graph_AddRelationType(Graph *g) {
 
 GrB_Matrix Graph_GetAdjacencyMatrix(const Graph *g) {
 	ASSERT(g);
-	RG_Matrix m = g->adjacency_matrix;
+	g = _Graph_View(g);
+	RG_Matrix m = _Graph_Matrix(g, &g->adjacency_matrix);
 	g->SynchronizeMatrix(g, m);
 	return RG_Matrix_Get_GrB_Matrix(m);
 }
@@ -1285,39 +2323,52 @@ GrB_Matrix Graph_GetAdjacencyMatrix(const Graph *g) {
 // Get the transposed adjacency matrix.
 GrB_Matrix Graph_GetTransposedAdjacencyMatrix(const Graph *g) {
 	ASSERT(g);
-	RG_Matrix m = g->_t_adjacency_matrix;
+	g = _Graph_View(g);
+	RG_Matrix m = _Graph_Matrix(g, &g->_t_adjacency_matrix);
 	g->SynchronizeMatrix(g, m);
 	return RG_Matrix_Get_GrB_Matrix(m);
 }
 
 GrB_Matrix Graph_GetLabelMatrix(const Graph *g, int label_idx) {
-	ASSERT(g && label_idx < array_len(g->labels));
-	RG_Matrix m = g->labels[label_idx];
+	ASSERT(g);
+	g = _Graph_View(g);
+	// Label was introduced after snapshot was taken.
+	if(g->_live && label_idx >= (int)array_len(g->labels)) return Graph_GetZeroMatrix(g);
+
+	ASSERT(label_idx < array_len(g->labels));
+	RG_Matrix m = _Graph_Matrix(g, g->labels + label_idx);
 	g->SynchronizeMatrix(g, m);
 	return RG_Matrix_Get_GrB_Matrix(m);
 }
 
 GrB_Matrix Graph_GetRelationMatrix(const Graph *g, int relation_idx) {
-	ASSERT(g && (relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g)));
+	ASSERT(g);
+	g = _Graph_View(g);
+	// Relation type was introduced after snapshot was taken.
+	if(g->_live && relation_idx >= Graph_RelationTypeCount(g)) return Graph_GetZeroMatrix(g);
+	ASSERT(relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g));
 
 	if(relation_idx == GRAPH_NO_RELATION) {
 		return Graph_GetAdjacencyMatrix(g);
 	} else {
-		RG_Matrix m = g->relations[relation_idx];
+		RG_Matrix m = _Graph_Matrix(g, g->relations + relation_idx);
 		g->SynchronizeMatrix(g, m);
 		return RG_Matrix_Get_GrB_Matrix(m);
 	}
 }
 
 GrB_Matrix Graph_GetTransposedRelationMatrix(const Graph *g, int relation_idx) {
-	ASSERT(g && (relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g)));
+	ASSERT(g);
+	g = _Graph_View(g);
+	if(g->_live && relation_idx >= Graph_RelationTypeCount(g)) return Graph_GetZeroMatrix(g);
+	ASSERT(relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g));
 
 	if(relation_idx == GRAPH_NO_RELATION) {
 		return Graph_GetTransposedAdjacencyMatrix(g);
 	} else {
 		ASSERT(g->t_relations && "tried to retrieve nonexistent transposed matrix.");
 
-		RG_Matrix m = g->t_relations[relation_idx];
+		RG_Matrix m = _Graph_Matrix(g, g->t_relations + relation_idx);
 		g->SynchronizeMatrix(g, m);
 		return RG_Matrix_Get_GrB_Matrix(m);
 	}
@@ -1325,7 +2376,8 @@ GrB_Matrix Graph_GetTransposedRelationMatrix(const Graph *g, int relation_idx) {
 
 GrB_Matrix Graph_GetZeroMatrix(const Graph *g) {
 	GrB_Index nvals;
-	RG_Matrix z = g->_zero_matrix;
+	g = _Graph_View(g);
+	RG_Matrix z = _Graph_Matrix(g, &g->_zero_matrix);
 	g->SynchronizeMatrix(g, z);
 
 	// Make sure zero matrix is indeed empty.
@@ -1337,6 +2389,17 @@ GrB_Matrix Graph_GetZeroMatrix(const Graph *g) {
 
 void Graph_Free(Graph *g) {
 	ASSERT(g);
+	// Free snapshots, no reader pins them anymore.
+	pthread_mutex_lock(&g->_snapshots_mutex);
+	while(array_len(g->_snapshots) > 0) {
+		GraphSnapshot *s = array_tail(g->_snapshots);
+		ASSERT(s->pins == 0);
+		_GraphSnapshot_Free(g, s);
+	}
+	g->_snapshot = NULL;
+	pthread_mutex_unlock(&g->_snapshots_mutex);
+	array_free(g->_snapshots);
+
 	// Free matrices.
 	Entity *en;
 	DataBlockIterator *it;
@@ -1348,11 +2411,19 @@ void Graph_Free(Graph *g) {
 	array_free(g->relations);
 	array_free(g->t_relations);
 
+	uint32_t relationCount = array_len(g->degrees);
+	for(int i = 0; i < relationCount; i++) {
+		RelationDegrees_Free(g->degrees + i);
+	}
+	array_free(g->degrees);
+
 	uint32_t labelCount = array_len(g->labels);
 	for(int i = 0; i < labelCount; i++) {
 		RG_Matrix_Free(g->labels[i]);
 	}
 	array_free(g->labels);
+	array_free(g->label_counts);
+	pthread_mutex_destroy(&g->_stats_mutex);
 
 	it = Graph_ScanNodes(g);
 	while((en = (Entity *)DataBlockIterator_Next(it, NULL)) != NULL)
@@ -1375,6 +2446,12 @@ void Graph_Free(Graph *g) {
 	res = pthread_mutex_destroy(&g->_writers_mutex);
 	ASSERT(res == 0);
 
+	res = pthread_mutex_destroy(&g->_snapshots_mutex);
+	ASSERT(res == 0);
+
+	res = pthread_cond_destroy(&g->_snapshots_cond);
+	ASSERT(res == 0);
+
 	if(g->_writelocked) Graph_ReleaseLock(g);
 	res = pthread_rwlock_destroy(&g->_rwlock);
 	ASSERT(res == 0);
@@ -51,16 +51,32 @@ typedef enum {
 	DISABLED,
 } MATRIX_POLICY;
 
+// Marks an RG_Matrix which might hold pending changes.
+#define RG_MATRIX_DIRTY UINT64_MAX
+
 // Forward declaration of RG_Matrix type. Internal to graph.
 typedef struct {
 	bool allow_multi_edge;              // Entry i,j can contain multiple edges
 	GrB_Matrix grb_matrix;              // Underlying GrB_Matrix.
+	GrB_Index synced_dim;               // Dimension matrix was last synchronized to, RG_MATRIX_DIRTY if modified since.
 	pthread_mutex_t mutex;              // Lock.
+	uint64_t modified;                  // Epoch published by the writer which last modified matrix.
+	uint refcount;                      // Number of snapshots sharing a matrix copy.
 } _RG_Matrix;
 typedef _RG_Matrix *RG_Matrix;
 
+// Number of edges of a single relation type per node,
+// maintained by the writer as edges are formed and deleted.
+typedef struct {
+	GrB_Vector out;                     // Sparse outgoing edge count by node ID, NULL for snapshots.
+	GrB_Vector in;                      // Sparse incoming edge count by node ID, NULL for snapshots.
+	uint64_t edge_count;                // Number of edges of this relation type.
+} RelationDegrees;
+
 // Forward declaration of Graph struct
 typedef struct Graph Graph;
+// Graph as of a published epoch, see Graph_PinSnapshot.
+typedef struct GraphSnapshot GraphSnapshot;
 // typedef for synchronization function pointer
 typedef void (*SyncMatrixFunc)(const Graph *, RG_Matrix);
 
@@ -72,11 +88,22 @@ struct Graph {
 	RG_Matrix *labels;                  // Label matrices.
 	RG_Matrix *relations;               // Relation matrices.
 	RG_Matrix *t_relations;             // Transposed relation matrices.
+	RelationDegrees *degrees;           // Per relation node degrees.
+	uint64_t *label_counts;             // Number of nodes per label.
+	pthread_mutex_t _stats_mutex;       // Guards growth of counters read without the read-write lock.
 	RG_Matrix _zero_matrix;             // Zero matrix.
 	pthread_mutex_t _writers_mutex;     // Mutex restrict single writer.
 	pthread_rwlock_t _rwlock;           // Read-write lock scoped to this specific graph
 	bool _writelocked;                  // true if the read-write lock was acquired by a writer
+	uint64_t _epoch;                    // Number of times a writer released the write lock.
+	uint64_t _synced_epoch;             // Epoch at which writes were last synchronized.
 	SyncMatrixFunc SynchronizeMatrix;   // Function pointer to matrix synchronization routine.
+	bool _snapshot_reads;               // Readers may execute against snapshots rather than under the read lock.
+	Graph *_live;                       // Graph a snapshot was taken of, NULL if graph isn't a snapshot.
+	GraphSnapshot *_snapshot;           // Latest published snapshot, NULL if none was taken yet.
+	GraphSnapshot **_snapshots;         // Snapshots which are yet to be freed, oldest first.
+	pthread_mutex_t _snapshots_mutex;   // Guards snapshots and the copies of matrices they hold.
+	pthread_cond_t _snapshots_cond;     // Signaled once a new snapshot is published.
 };
 
 /* Graph synchronization functions
@@ -91,6 +118,43 @@ void Graph_AcquireWriteLock(Graph *g);
 /* Release the held lock */
 void Graph_ReleaseLock(Graph *g);
 
+/* Returns graph's epoch, incremented every time a writer releases
+ * the write lock, an unchanged epoch guarantees no modifications
+ * took place in between. */
+uint64_t Graph_GetEpoch(const Graph *g);
+
+/* Snapshot reads
+ * Once enabled, every writer publishes a snapshot of the graph as it releases
+ * the write lock, readers pin the latest snapshot and execute against it
+ * without holding the read lock, such that writers don't wait for them.
+ * Before a writer modifies a matrix or a block of entities it copies it into
+ * every pinned snapshot, once the last reader unpins an outdated snapshot
+ * the copies it holds are freed. */
+
+/* Returns true if reads may execute against snapshots of graph. */
+bool Graph_SnapshotReads(const Graph *g);
+
+/* Pins the latest snapshot of graph, waiting for the current writer to publish
+ * a new one if the latest was not pinned by the time the writer acquired the write lock.
+ * Returns NULL if snapshot reads are disabled. */
+GraphSnapshot *Graph_PinSnapshot(Graph *g);
+
+/* Releases a snapshot pinned by Graph_PinSnapshot. */
+void Graph_UnpinSnapshot(GraphSnapshot *s);
+
+/* Returns the epoch of the oldest snapshot pinned by a reader,
+ * UINT64_MAX if no snapshot is pinned. */
+uint64_t Graph_PinnedEpoch(Graph *g);
+
+/* Directs reads of the snapshot's graph issued by the calling thread to the snapshot. */
+void Graph_AttachSnapshot(GraphSnapshot *s);
+
+/* Directs reads issued by the calling thread back to the live graph. */
+void Graph_DetachSnapshot(void);
+
+/* Must be called by a writer before it modifies the properties of an existing entity. */
+void Graph_PrepareEntityWrite(Graph *g, GraphEntityType t, EntityID id);
+
 /* Writer request access to graph. */
 void Graph_WriterEnter(Graph *g);
 
@@ -103,6 +167,11 @@ void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy);
 /* Synchronize and resize all matrices in graph. */
 void Graph_ApplyAllPending(Graph *g);
 
+/* Flush pending changes introduced by a writer, called by the writer
+ * once it released the write lock, such that readers which follow
+ * will not have to pay for synchronizing modified matrices. */
+void Graph_SynchronizeWrites(Graph *g);
+
 // Create a new graph.
 Graph *Graph_New(
 	size_t node_cap,    // Allocation size for node datablocks and matrix dimensions.
@@ -139,6 +208,14 @@ void Graph_CreateNode(
 	Node *n
 );
 
+// Create a single node at position id, which must not hold a node.
+void Graph_CreateNodeAt(
+	Graph *g,
+	NodeID id,
+	int label,
+	Node *n
+);
+
 // Connects source node to destination node.
 // Returns 1 if connection is formed, 0 otherwise.
 int Graph_ConnectNodes(
@@ -149,6 +226,37 @@ int Graph_ConnectNodes(
 	Edge *e
 );
 
+// Connects source node to destination node by an edge at position id,
+// which must not hold an edge.
+// Returns 1 if connection is formed, 0 otherwise.
+int Graph_ConnectNodesAt(
+	Graph *g,           // Graph on which to operate.
+	EdgeID id,          // Edge ID.
+	NodeID src,         // Source node ID.
+	NodeID dest,        // Destination node ID.
+	int r,              // Edge type.
+	Edge *e
+);
+
+// Creates an edge entity without connecting its endpoints,
+// connections are later formed in bulk by Graph_ConnectEdges.
+void Graph_CreateEdge(
+	Graph *g,           // Graph on which to operate.
+	NodeID src,         // Source node ID.
+	NodeID dest,        // Destination node ID.
+	int r,              // Edge type.
+	Edge *e
+);
+
+// Connects the endpoints of edges created by Graph_CreateEdge,
+// building each relation matrix update in a single pass.
+// Reorders the edges array.
+void Graph_ConnectEdges(
+	Graph *g,           // Graph on which to operate.
+	Edge *edges,        // Edges to connect.
+	uint64_t edge_count // Number of edges.
+);
+
 // Removes node and all of its connections within the graph.
 void Graph_DeleteNode(
 	Graph *g,
@@ -189,6 +297,14 @@ DataBlockIterator *Graph_ScanNodes(
 	const Graph *g
 );
 
+// Retrieves a node iterator which can be used to access
+// every node with an ID in the range [start, end).
+DataBlockIterator *Graph_ScanNodeRange(
+	const Graph *g,
+	NodeID start,
+	NodeID end
+);
+
 // Retrieves an edge iterator which can be used to access
 // every edge in the graph.
 DataBlockIterator *Graph_ScanEdges(
@@ -205,7 +321,8 @@ uint Graph_DeletedNodeCount(
 	const Graph *g
 );
 
-// Returns number of nodes with given label.
+// Returns number of nodes with given label,
+// may be called without holding the graph's read lock.
 size_t Graph_LabeledNodeCount(
 	const Graph *g,
 	int label
@@ -291,6 +408,27 @@ void Graph_GetNodeEdges(
 	Edge **edges            // array_t incoming/outgoing edges.
 );
 
+// Returns the number of edges of type r connected to node id,
+// all relation types are considered when r is GRAPH_NO_RELATION.
+uint64_t Graph_GetNodeDegree(
+	const Graph *g,         // Graph to inspect.
+	NodeID id,              // Node ID.
+	GRAPH_EDGE_DIR dir,     // Edge direction.
+	int r                   // Relation type.
+);
+
+// Returns number of edges of type r,
+// may be called without holding the graph's read lock.
+uint64_t Graph_RelationEdgeCount(
+	const Graph *g,
+	int r
+);
+
+// Returns an estimate of the memory consumed by the graph, in bytes.
+size_t Graph_MemoryUsage(
+	const Graph *g
+);
+
 // Retrieves the adjacency matrix.
 // Matrix is resized if its size doesn't match graph's node count.
 GrB_Matrix Graph_GetAdjacencyMatrix(
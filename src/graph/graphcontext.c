@@ -73,6 +73,7 @@ GraphContext *GraphContext_New(const char *graph_name, size_t node_cap, size_t e
 	// allocate the default space for schemas and indices
 	gc->node_schemas = array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
 	gc->relation_schemas = array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	gc->retired_schemas = NULL;
 
 	// initialize the read-write lock to protect access to the attributes rax
 	assert(pthread_rwlock_init(&gc->_attribute_rwlock, NULL) == 0);
@@ -82,6 +83,7 @@ GraphContext *GraphContext_New(const char *graph_name, size_t node_cap, size_t e
 	Config_Option_get(Config_CACHE_SIZE, &cache_size);
 	gc->cache = Cache_New(cache_size, (CacheEntryFreeFunc)ExecutionCtx_Free,
 	  	(CacheEntryCopyFunc)ExecutionCtx_Clone);
+	gc->query_costs = rm_calloc(QUERY_COST_TABLE_SIZE, sizeof(uint64_t));
 
 	Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
 	QueryCtx_SetGraphCtx(gc);
@@ -150,6 +152,11 @@ GraphContext *GraphContext_Retrieve(RedisModuleCtx *ctx, RedisModuleString *grap
 	return gc;
 }
 
+void GraphContext_Retain(GraphContext *gc) {
+	ASSERT(gc);
+	_GraphContext_IncreaseRefCount(gc);
+}
+
 void GraphContext_Release(GraphContext *gc) {
 	ASSERT(gc);
 	_GraphContext_DecreaseRefCount(gc);
@@ -246,6 +253,41 @@ Schema *GraphContext_GetSchema(const GraphContext *gc, const char *label, Schema
 	return GraphContext_GetSchemaByID(gc, id, t);
 }
 
+// Frees schema arrays no snapshot reader may be using, an array replaced
+// during epoch E is reachable only by readers of snapshots as of E or earlier.
+static void _GraphContext_FreeRetiredSchemas(GraphContext *gc) {
+	uint retired_count = array_len(gc->retired_schemas);
+	if(retired_count == 0) return;
+
+	uint64_t pinned = Graph_PinnedEpoch(gc->g);
+	uint kept = 0;
+	for(uint i = 0; i < retired_count; i++) {
+		RetiredSchemas retired = gc->retired_schemas[i];
+		if(retired.epoch < pinned) array_free(retired.schemas);
+		else gc->retired_schemas[kept++] = retired;
+	}
+	gc->retired_schemas = array_trimm_len(gc->retired_schemas, kept);
+}
+
+// Appends schema to schemas, snapshot readers don't hold the graph's
+// read lock, the array is replaced rather than reallocated under them.
+static void _GraphContext_AppendSchema(GraphContext *gc, Schema ***schemas, Schema *schema) {
+	if(!Graph_SnapshotReads(gc->g)) {
+		*schemas = array_append(*schemas, schema);
+		return;
+	}
+
+	Schema **replacement;
+	array_clone(replacement, *schemas);
+	replacement = array_append(replacement, schema);
+	RetiredSchemas retired = {.schemas = *schemas, .epoch = Graph_GetEpoch(gc->g)};
+	__atomic_store_n(schemas, replacement, __ATOMIC_RELEASE);
+
+	_GraphContext_FreeRetiredSchemas(gc);
+	if(gc->retired_schemas == NULL) gc->retired_schemas = array_new(RetiredSchemas, 1);
+	gc->retired_schemas = array_append(gc->retired_schemas, retired);
+}
+
 Schema *GraphContext_AddSchema(GraphContext *gc, const char *label, SchemaType t) {
 	int label_id;
 	Schema *schema;
@@ -253,11 +295,11 @@ Schema *GraphContext_AddSchema(GraphContext *gc, const char *label, SchemaType t
 	if(t == SCHEMA_NODE) {
 		label_id = Graph_AddLabel(gc->g);
 		schema = Schema_New(label, label_id);
-		gc->node_schemas = array_append(gc->node_schemas, schema);
+		_GraphContext_AppendSchema(gc, &gc->node_schemas, schema);
 	} else {
 		label_id = Graph_AddRelationType(gc->g);
 		schema = Schema_New(label, label_id);
-		gc->relation_schemas = array_append(gc->relation_schemas, schema);
+		_GraphContext_AppendSchema(gc, &gc->relation_schemas, schema);
 	}
 
 	// new schema added, update graph version
@@ -407,6 +449,10 @@ void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n) {
 	if(idx) Index_RemoveNode(idx, n);
 	idx = Schema_GetIndex(s, NULL, IDX_EXACT_MATCH);
 	if(idx) Index_RemoveNode(idx, n);
+	idx = Schema_GetIndex(s, NULL, IDX_RANGE);
+	if(idx) Index_RemoveNode(idx, n);
+
+	ColumnStore_RemoveNode(s->columns, ENTITY_GET_ID(n));
 }
 
 //------------------------------------------------------------------------------
@@ -503,6 +549,14 @@ static void _GraphContext_Free(void *arg) {
 		array_free(gc->relation_schemas);
 	}
 
+	if(gc->retired_schemas) {
+		len = array_len(gc->retired_schemas);
+		for(uint32_t i = 0; i < len; i ++) {
+			array_free(gc->retired_schemas[i].schemas);
+		}
+		array_free(gc->retired_schemas);
+	}
+
 	//--------------------------------------------------------------------------
 	// Free attribute mappings
 	//--------------------------------------------------------------------------
@@ -527,6 +581,7 @@ static void _GraphContext_Free(void *arg) {
 	//--------------------------------------------------------------------------
 
 	if(gc->cache) Cache_Free(gc->cache);
+	rm_free(gc->query_costs);
 
 	GraphEncodeContext_Free(gc->encoding_context);
 	GraphDecodeContext_Free(gc->decoding_context);
@@ -26,6 +26,12 @@
  * can use the graph version to understand if the schema was modified
  * and take action accordingly */
 
+// Schema array replaced while snapshot readers may still use it.
+typedef struct {
+	Schema **schemas;                       // Replaced array.
+	uint64_t epoch;                         // Graph epoch during which the array was replaced.
+} RetiredSchemas;
+
 typedef struct {
 	Graph *g;                               // Container for all matrices and entity properties
 	int ref_count;                          // Number of active references.
@@ -35,11 +41,13 @@ typedef struct {
 	char **string_mapping;                  // From attribute IDs to strings
 	Schema **node_schemas;                  // Array of schemas for each node label
 	Schema **relation_schemas;              // Array of schemas for each relation type
+	RetiredSchemas *retired_schemas;        // Schema arrays replaced while snapshot readers may use them
 	unsigned short index_count;             // Number of indicies.
 	SlowLog *slowlog;                       // Slowlog associated with graph.
 	GraphEncodeContext *encoding_context;   // Encode context of the graph.
 	GraphDecodeContext *decoding_context;   // Decode context of the graph.
 	Cache *cache;                           // Global cache of execution plans.
+	uint64_t *query_costs;                  // Cost classes of executed queries, by query hash.
 	XXH32_hash_t version;                   // Graph version.
 } GraphContext;
 
@@ -53,6 +61,8 @@ GraphContext *GraphContext_New(const char *graph_name, size_t node_cap, size_t e
  * readOnly is the access mode to the graph key */
 GraphContext *GraphContext_Retrieve(RedisModuleCtx *ctx, RedisModuleString *graphID, bool readOnly,
 									bool shouldCreate);
+// Retains an already retrieved GraphContext, to be released by GraphContext_Release.
+void GraphContext_Retain(GraphContext *gc);
 // GraphContext_Retrieve counterpart, releases a retrieved GraphContext.
 void GraphContext_Release(GraphContext *gc);
 // Mark graph key as "dirty" for Redis to pick up on.
@@ -304,8 +304,22 @@ QueryGraph *BuildQueryGraph(const AST *ast) {
 		const cypher_astnode_t *path = paths[i];
 		QueryGraph_AddPath(qg, path);
 	}
+	array_free(paths);
 
+	// Mark edges resolved by shortestPath and allShortestPaths.
+	paths = AST_GetTypedNodes(ast->root, CYPHER_AST_SHORTEST_PATH);
+	n = array_len(paths);
+	for(uint i = 0; i < n; i++) {
+		const cypher_astnode_t *path = cypher_ast_shortest_path_get_path(paths[i]);
+		// Validations guarantee a single relationship, (a)-[e]-(b).
+		const cypher_astnode_t *ast_edge = cypher_ast_pattern_path_get_element(path, 1);
+		QGEdge *e = QueryGraph_GetEdgeByAlias(qg, AST_GetEntityName(ast, ast_edge));
+		ASSERT(e != NULL);
+		e->shortest_path = true;
+		e->all_shortest_paths = !cypher_ast_shortest_path_is_single(paths[i]);
+	}
 	array_free(paths);
+
 	return qg;
 }
 
@@ -543,6 +557,52 @@ QueryGraph **QueryGraph_ConnectedComponents(const QueryGraph *qg) {
 	return connected_components;
 }
 
+// Returns the position of node n within the query graph's nodes array.
+static uint _QueryGraph_NodeIdx(const QueryGraph *qg, const QGNode *n) {
+	uint node_count = QueryGraph_NodeCount(qg);
+	for(uint i = 0; i < node_count; i++) {
+		if(qg->nodes[i] == n) return i;
+	}
+	ASSERT(false);
+	return 0;
+}
+
+// Returns the representative of node i, compressing the path along the way.
+static uint _QueryGraph_FindSet(uint *parents, uint i) {
+	while(parents[i] != i) {
+		parents[i] = parents[parents[i]];
+		i = parents[i];
+	}
+	return i;
+}
+
+bool QueryGraph_ContainsCycle(const QueryGraph *qg) {
+	ASSERT(qg != NULL);
+
+	uint node_count = QueryGraph_NodeCount(qg);
+	uint edge_count = QueryGraph_EdgeCount(qg);
+	if(edge_count == 0) return false;
+	// A forest of N nodes contains at most N-1 edges.
+	if(edge_count >= node_count) return true;
+
+	/* Union-find over the nodes, ignoring edge direction,
+	 * an edge connecting two nodes of the same set closes a cycle. */
+	bool cycle = false;
+	uint *parents = rm_malloc(sizeof(uint) * node_count);
+	for(uint i = 0; i < node_count; i++) parents[i] = i;
+
+	for(uint i = 0; i < edge_count && !cycle; i++) {
+		QGEdge *e = qg->edges[i];
+		uint src = _QueryGraph_FindSet(parents, _QueryGraph_NodeIdx(qg, e->src));
+		uint dest = _QueryGraph_FindSet(parents, _QueryGraph_NodeIdx(qg, e->dest));
+		if(src == dest) cycle = true;
+		else parents[src] = dest;
+	}
+
+	rm_free(parents);
+	return cycle;
+}
+
 uint QueryGraph_NodeCount(const QueryGraph *qg) {
 	return array_len(qg->nodes);
 }
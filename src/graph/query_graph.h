@@ -85,6 +85,10 @@ QGEdge *QueryGraph_RemoveEdge(QueryGraph *g, QGEdge *e);
  * Returns an array object */
 QueryGraph **QueryGraph_ConnectedComponents(const QueryGraph *qg);
 
+/* Returns true if the query graph contains a cycle,
+ * edge direction is ignored. */
+bool QueryGraph_ContainsCycle(const QueryGraph *qg);
+
 /* Retrieve the number of nodes in a QueryGraph. */
 uint QueryGraph_NodeCount(const QueryGraph *qg);
 
@@ -5,51 +5,131 @@
 */
 
 #include "group_cache.h"
+#include "RG.h"
+#include "../util/arr.h"
 #include "../util/rmalloc.h"
 
-CacheGroup *CacheGroupNew() {
-	return raxNew();
+// Minimal number of buckets.
+#define MIN_BUCKET_COUNT 16
+
+// Returns the smallest power of 2 greater or equal to n.
+static uint64_t _NextPowerOf2(uint64_t n) {
+	uint64_t p = MIN_BUCKET_COUNT;
+	while(p < n) p <<= 1;
+	return p;
+}
+
+// Group keys are equal if each pair of keys compare equal, NULLs are equal to one another.
+static bool _KeysEqual(const SIValue *a, const SIValue *b, uint key_count) {
+	for(uint i = 0; i < key_count; i++) {
+		if(SIValue_Compare(a[i], b[i], NULL) != 0) return false;
+	}
+	return true;
+}
+
+// Inserts group into the first free bucket along its probe sequence.
+static void _Insert(CacheGroupBucket *buckets, uint64_t bucket_count, XXH64_hash_t hash,
+					Group *group) {
+	uint64_t mask = bucket_count - 1;
+	uint64_t idx = hash & mask;
+	while(buckets[idx].group) idx = (idx + 1) & mask;
+	buckets[idx].hash = hash;
+	buckets[idx].group = group;
+}
+
+// Doubles the number of buckets, rehashing is avoided as hashes are stored in buckets.
+static void _Grow(CacheGroup *groups) {
+	uint64_t bucket_count = groups->bucket_count * 2;
+	CacheGroupBucket *buckets = rm_calloc(bucket_count, sizeof(CacheGroupBucket));
+
+	for(uint64_t i = 0; i < groups->bucket_count; i++) {
+		CacheGroupBucket *bucket = groups->buckets + i;
+		if(bucket->group) _Insert(buckets, bucket_count, bucket->hash, bucket->group);
+	}
+
+	rm_free(groups->buckets);
+	groups->buckets = buckets;
+	groups->bucket_count = bucket_count;
+}
+
+CacheGroup *CacheGroupNew(uint64_t size_hint) {
+	CacheGroup *groups = rm_malloc(sizeof(CacheGroup));
+	// Maintain a load factor of at most 1/2.
+	groups->bucket_count = _NextPowerOf2(size_hint * 2);
+	groups->buckets = rm_calloc(groups->bucket_count, sizeof(CacheGroupBucket));
+	groups->groups = array_new(Group *, size_hint);
+	return groups;
 }
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group) {
-	raxInsert(groups, (unsigned char *)key, strlen(key), group, NULL);
+XXH64_hash_t CacheGroup_KeyHash(const SIValue *keys, uint key_count) {
+	XXH64_state_t state;
+	XXH_errorcode res = XXH64_reset(&state, 0);
+	UNUSED(res);
+	ASSERT(res != XXH_ERROR);
+
+	for(uint i = 0; i < key_count; i++) SIValue_HashUpdate(keys[i], &state);
+
+	return XXH64_digest(&state);
+}
+
+void CacheGroupAdd(CacheGroup *groups, XXH64_hash_t hash, Group *group) {
+	uint64_t group_count = array_len(groups->groups);
+	if((group_count + 1) * 2 > groups->bucket_count) _Grow(groups);
+
+	_Insert(groups->buckets, groups->bucket_count, hash, group);
+	groups->groups = array_append(groups->groups, group);
 }
 
 // Retrives a group,
-// Sets group to NULL if key is missing.
-Group *CacheGroupGet(CacheGroup *groups, char *key) {
-	Group *g = raxFind(groups, (unsigned char *)key, strlen(key));
-	if(g == raxNotFound) return NULL;
-	return g;
+// Returns NULL if keys are missing.
+Group *CacheGroupGet(CacheGroup *groups, XXH64_hash_t hash, const SIValue *keys, uint key_count) {
+	uint64_t mask = groups->bucket_count - 1;
+	uint64_t idx = hash & mask;
+
+	// Probe until an empty bucket is encountered.
+	CacheGroupBucket *bucket;
+	while((bucket = groups->buckets + idx)->group) {
+		if(bucket->hash == hash && _KeysEqual(bucket->group->keys, keys, key_count)) {
+			return bucket->group;
+		}
+		idx = (idx + 1) & mask;
+	}
+
+	return NULL;
+}
+
+inline uint64_t CacheGroupCount(const CacheGroup *groups) {
+	return array_len(groups->groups);
 }
 
 void FreeGroupCache(CacheGroup *groups) {
-	raxFreeWithCallback(groups, (void (*)(void *))FreeGroup);
+	uint64_t group_count = array_len(groups->groups);
+	for(uint64_t i = 0; i < group_count; i++) FreeGroup(groups->groups[i]);
+	array_free(groups->groups);
+	rm_free(groups->buckets);
+	rm_free(groups);
 }
 
 // Populates an iterator to scan entire group cache
 CacheGroupIterator *CacheGroupIter(CacheGroup *groups) {
 	CacheGroupIterator *iter = rm_malloc(sizeof(CacheGroupIterator));
-
-	raxStart(iter, groups);
-	raxSeek(iter, "^", NULL, 0);
-
+	iter->groups = groups;
+	iter->idx = 0;
 	return iter;
 }
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group) {
-	int res = raxNext(iter);
-	if(res == 0) {
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group) {
+	if(iter->idx >= array_len(iter->groups->groups)) {
 		*group = NULL;
-	} else {
-		*group = iter->data; // TODO revisit this to fix up
+		return 0;
 	}
-	return res;
+
+	*group = iter->groups->groups[iter->idx++];
+	return 1;
 }
 
 void CacheGroupIterator_Free(CacheGroupIterator *iter) {
 	if(iter == NULL) return;
-	raxStop(iter);
 	rm_free(iter);
 }
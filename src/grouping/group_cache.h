@@ -8,27 +8,53 @@
 #define GROUP_CACHE_H_
 
 #include "group.h"
-#include "rax.h"
+#include "xxhash.h"
 
-typedef raxIterator CacheGroupIterator;
-typedef rax CacheGroup;
+/* Group cache
+ * An open addressing hash table mapping group keys to groups.
+ * Buckets hold the 64-bit hash of a group's keys, which is compared before
+ * the keys themselves. Groups are iterated in insertion order. */
 
-CacheGroup *CacheGroupNew();
+typedef struct {
+	XXH64_hash_t hash;          // Hash of group keys.
+	Group *group;               // Group, NULL if bucket is empty.
+} CacheGroupBucket;
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group);
+typedef struct {
+	CacheGroupBucket *buckets;  // Hash table buckets, probed linearly.
+	uint64_t bucket_count;      // Number of buckets, a power of 2.
+	Group **groups;             // Groups in insertion order.
+} CacheGroup;
+
+typedef struct {
+	CacheGroup *groups;         // Iterated group cache.
+	uint64_t idx;               // Position of next group.
+} CacheGroupIterator;
+
+// Create a new group cache, sized to accommodate size_hint groups.
+CacheGroup *CacheGroupNew(uint64_t size_hint);
+
+// Computes the hash of group keys.
+XXH64_hash_t CacheGroup_KeyHash(const SIValue *keys, uint key_count);
+
+// Adds group to cache, hash is the hash of the group's keys.
+void CacheGroupAdd(CacheGroup *groups, XXH64_hash_t hash, Group *group);
 
 // Retrives a group,
-// Sets group to NULL if key is missing.
-Group *CacheGroupGet(CacheGroup *groups, char *key);
+// Returns NULL if keys are missing.
+Group *CacheGroupGet(CacheGroup *groups, XXH64_hash_t hash, const SIValue *keys, uint key_count);
+
+// Returns number of groups in cache.
+uint64_t CacheGroupCount(const CacheGroup *groups);
 
 void FreeGroupCache(CacheGroup *groups);
 
 // Populates an iterator to scan group cache
 CacheGroupIterator *CacheGroupIter(CacheGroup *groups);
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group);
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group);
 
 void CacheGroupIterator_Free(CacheGroupIterator *iter);
 
-#endif
\ No newline at end of file
+#endif
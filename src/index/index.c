@@ -12,6 +12,22 @@
 #include "../util/rmalloc.h"
 #include "../graph/graphcontext.h"
 #include "../graph/entities/node.h"
+#include "../util/thpool/thpool.h"
+#include <pthread.h>
+
+// Number of node IDs scanned by a single indexing task.
+#define INDEX_SHARD_SIZE 16384
+// Number of indexed documents between progress log messages.
+#define INDEX_PROGRESS_LOG_INTERVAL 1000000
+
+extern threadpool _parallel_thpool; // Declared in module.c
+
+// Synchronizes the shards of a parallel index build.
+typedef struct {
+	uint pending;               // Number of dispatched shards yet to finish.
+	pthread_mutex_t lock;       // Guards pending.
+	pthread_cond_t done;        // Signaled when a shard finishes.
+} IndexBuild;
 
 static int _getNodeAttribute(void *ctx, const char *fieldName, const void *id, char **strVal,
 							 double *doubleVal) {
@@ -42,20 +58,78 @@ static int _getNodeAttribute(void *ctx, const char *fieldName, const void *id, c
 	return ret;
 }
 
-static void _populateIndex(Index *idx) {
-	GraphContext *gc = QueryCtx_GetGraphCtx();
-	Schema *s = GraphContext_GetSchema(gc, idx->label, SCHEMA_NODE);
+// Indexing task, builds documents for every labeled node within a node ID range.
+typedef struct {
+	Index *idx;                 // Index being populated.
+	Graph *g;                   // Indexed graph.
+	GrB_Matrix label_matrix;    // Label matrix of the indexed label.
+	NodeID start;               // First node ID of the range.
+	NodeID end;                 // Last node ID of the range, inclusive.
+	void **entries;             // Documents or range index keys built for the range.
+	IndexBuild *build;          // Build this task belongs to.
+} IndexShard;
+
+// Create a document out of node, returns NULL if node has no indexed property.
+static RSDoc *_Index_NodeDocument(Index *idx, const Node *n) {
+	double score = 0;           // Default score.
+	const char *lang = NULL;    // Default language.
+	NodeID node_id = ENTITY_GET_ID(n);
+	uint doc_field_count = 0;
 
-	// Label doesn't exists.
-	if(s == NULL) return;
+	// Create a document out of node.
+	RSDoc *doc = RediSearch_CreateDocument(&node_id, sizeof(EntityID), score, lang);
+
+	// Add document field for each indexed property.
+	for(uint i = 0; i < idx->fields_count; i++) {
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, idx->fields_ids[i]);
+		if(v == PROPERTY_NOTFOUND) continue;
+
+		doc_field_count++;
+		if(idx->type == IDX_FULLTEXT) {
+			// Value must be of type string.
+			if(SI_TYPE(*v) == T_STRING) {
+				RediSearch_DocumentAddFieldString(doc,
+												  idx->fields[i],
+												  v->stringval,
+												  strlen(v->stringval),
+												  RSFLDTYPE_FULLTEXT);
+			}
+		} else {
+			if(SI_TYPE(*v) == T_STRING) {
+				RediSearch_DocumentAddFieldString(doc, idx->fields[i], v->stringval, strlen(v->stringval),
+												  RSFLDTYPE_TAG);
+			} else if(SI_TYPE(*v) & (SI_NUMERIC | T_BOOL)) {
+				double d = SI_GET_NUMERIC(*v);
+				RediSearch_DocumentAddFieldNumber(doc, idx->fields[i], d, RSFLDTYPE_NUMERIC);
+			} else {
+				continue;
+			}
+		}
+	}
+
+	if(doc_field_count > 0) return doc;
+
+	RediSearch_FreeDocument(doc);
+	return NULL;
+}
 
+// Encode node's range index key, returns NULL if node has no indexed property.
+static RangeIndexKey *_Index_NodeRangeKey(Index *idx, const Node *n) {
+	const SIValue *values[idx->fields_count];
+	for(uint i = 0; i < idx->fields_count; i++) {
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, idx->fields_ids[i]);
+		values[i] = (v == PROPERTY_NOTFOUND) ? NULL : v;
+	}
+	return RangeIndex_BuildKey(ENTITY_GET_ID(n), values, idx->fields_count);
+}
+
+// Builds documents for each labeled node within the shard's range.
+static void _Index_BuildShard(IndexShard *shard) {
 	Node node = GE_NEW_NODE();
 	NodeID node_id;
-	Graph *g = gc->g;
-	int label_id = s->id;
 	GxB_MatrixTupleIter *it;
-	const GrB_Matrix label_matrix = Graph_GetLabelMatrix(g, label_id);
-	GxB_MatrixTupleIter_new(&it, label_matrix);
+	GxB_MatrixTupleIter_new(&it, shard->label_matrix);
+	GxB_MatrixTupleIter_iterate_range(it, shard->start, shard->end);
 
 	// Iterate over each labeled node.
 	while(true) {
@@ -63,16 +137,132 @@ static void _populateIndex(Index *idx) {
 		GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
 		if(depleted) break;
 
-		Graph_GetNode(g, node_id, &node);
-		Index_IndexNode(idx, &node);
+		Graph_GetNode(shard->g, node_id, &node);
+		void *entry = (shard->idx->type == IDX_RANGE) ?
+					  (void *)_Index_NodeRangeKey(shard->idx, &node) :
+					  (void *)_Index_NodeDocument(shard->idx, &node);
+		if(entry) shard->entries = array_append(shard->entries, entry);
 	}
 	GxB_MatrixTupleIter_free(it);
 }
 
+// Thread pool job, builds a shard and notifies the waiting thread.
+static void _Index_RunShard(void *arg) {
+	IndexShard *shard = arg;
+	IndexBuild *build = shard->build;
+	_Index_BuildShard(shard);
+
+	pthread_mutex_lock(&build->lock);
+	build->pending--;
+	pthread_cond_signal(&build->done);
+	pthread_mutex_unlock(&build->lock);
+}
+
+/* Documents are built concurrently by the parallel thread pool, each
+ * thread handles a different range of node IDs. RediSearch does not support
+ * concurrent insertions, built documents are added by the calling thread,
+ * range index keys are built and added in the same manner. */
+static void _populateIndex(Index *idx) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, idx->label, SCHEMA_NODE);
+
+	// Label doesn't exists.
+	if(s == NULL) return;
+
+	Graph *g = gc->g;
+	const GrB_Matrix label_matrix = Graph_GetLabelMatrix(g, s->id);
+	GrB_Index label_count;
+	GrB_Matrix_nvals(&label_count, label_matrix);
+	NodeID max_id = Graph_RequiredMatrixDim(g);
+
+	uint thread_count = (_parallel_thpool) ? thpool_num_threads(_parallel_thpool) : 0;
+	// Don't bother spawning tasks for a single shard.
+	if(max_id <= INDEX_SHARD_SIZE) thread_count = 0;
+	uint shard_count = thread_count + 1;
+
+	IndexBuild build;
+	if(thread_count > 0) {
+		pthread_mutex_init(&build.lock, NULL);
+		pthread_cond_init(&build.done, NULL);
+	}
+
+	IndexShard shards[shard_count];
+	for(uint i = 0; i < shard_count; i++) {
+		shards[i].g = g;
+		shards[i].idx = idx;
+		shards[i].build = &build;
+		shards[i].label_matrix = label_matrix;
+		shards[i].entries = array_new(void *, 0);
+	}
+
+	// Only large builds, which report progress, are logged at notice level.
+	const char *log_level = (label_count >= INDEX_PROGRESS_LOG_INTERVAL) ? "notice" : "verbose";
+	RedisModule_Log(NULL, log_level, "Indexing %llu nodes of label %s using %u threads",
+					(unsigned long long)label_count, idx->label, shard_count);
+
+	uint64_t indexed = 0;
+	uint64_t next_progress_log = INDEX_PROGRESS_LOG_INTERVAL;
+	for(NodeID start = 0; start < max_id; start += shard_count * INDEX_SHARD_SIZE) {
+		// Assign consecutive node ID ranges to shards.
+		for(uint i = 0; i < shard_count; i++) {
+			shards[i].start = start + i * INDEX_SHARD_SIZE;
+			shards[i].end = MIN(shards[i].start + INDEX_SHARD_SIZE, max_id) - 1;
+		}
+
+		// Dispatch all but the first shard, which is built by the calling thread.
+		if(thread_count > 0) build.pending = 0;
+		for(uint i = 1; i < shard_count; i++) {
+			if(shards[i].start >= max_id) break;
+			pthread_mutex_lock(&build.lock);
+			build.pending++;
+			pthread_mutex_unlock(&build.lock);
+			if(thpool_add_work(_parallel_thpool, _Index_RunShard, shards + i) != 0) {
+				// Failed to dispatch, build shard on the calling thread.
+				_Index_RunShard(shards + i);
+			}
+		}
+		_Index_BuildShard(shards);
+
+		// Wait for dispatched shards.
+		if(thread_count > 0) {
+			pthread_mutex_lock(&build.lock);
+			while(build.pending > 0) pthread_cond_wait(&build.done, &build.lock);
+			pthread_mutex_unlock(&build.lock);
+		}
+
+		// Add documents in node ID order.
+		for(uint i = 0; i < shard_count; i++) {
+			uint entry_count = array_len(shards[i].entries);
+			for(uint j = 0; j < entry_count; j++) {
+				if(idx->type == IDX_RANGE) RangeIndex_InsertKey(idx->range, shards[i].entries[j]);
+				else RediSearch_SpecAddDocument(idx->idx, shards[i].entries[j]);
+			}
+			indexed += entry_count;
+			array_clear(shards[i].entries);
+		}
+
+		if(indexed >= next_progress_log) {
+			RedisModule_Log(NULL, "notice", "Indexed %llu nodes of label %s",
+							(unsigned long long)indexed, idx->label);
+			next_progress_log = indexed + INDEX_PROGRESS_LOG_INTERVAL;
+		}
+	}
+
+	RedisModule_Log(NULL, log_level, "Done indexing label %s, %llu documents indexed",
+					idx->label, (unsigned long long)indexed);
+
+	for(uint i = 0; i < shard_count; i++) array_free(shards[i].entries);
+	if(thread_count > 0) {
+		pthread_mutex_destroy(&build.lock);
+		pthread_cond_destroy(&build.done);
+	}
+}
+
 // Create a new index.
 Index *Index_New(const char *label, IndexType type) {
 	Index *idx = rm_malloc(sizeof(Index));
 	idx->idx = NULL;
+	idx->range = NULL;
 	idx->fields_count = 0;
 	idx->type = type;
 	idx->label = rm_strdup(label);
@@ -112,50 +302,27 @@ void Index_RemoveField(Index *idx, const char *field) {
 }
 
 void Index_IndexNode(Index *idx, const Node *n) {
-	double score = 0;           // Default score.
-	const char *lang = NULL;    // Default language.
-	RSIndex *rsIdx = idx->idx;
-	NodeID node_id = ENTITY_GET_ID(n);
-	uint doc_field_count = 0;
-
-	// Create a document out of node.
-	RSDoc *doc = RediSearch_CreateDocument(&node_id, sizeof(EntityID), score, lang);
-
-	// Add document field for each indexed property.
-	for(uint i = 0; i < idx->fields_count; i++) {
-		SIValue *v = GraphEntity_GetProperty((GraphEntity *)n, idx->fields_ids[i]);
-		if(v == PROPERTY_NOTFOUND) continue;
-
-		doc_field_count++;
-		if(idx->type == IDX_FULLTEXT) {
-			// Value must be of type string.
-			if(SI_TYPE(*v) == T_STRING) {
-				RediSearch_DocumentAddFieldString(doc,
-												  idx->fields[i],
-												  v->stringval,
-												  strlen(v->stringval),
-												  RSFLDTYPE_FULLTEXT);
-			}
-		} else {
-			if(SI_TYPE(*v) == T_STRING) {
-				RediSearch_DocumentAddFieldString(doc, idx->fields[i], v->stringval, strlen(v->stringval),
-												  RSFLDTYPE_TAG);
-			} else if(SI_TYPE(*v) & (SI_NUMERIC | T_BOOL)) {
-				double d = SI_GET_NUMERIC(*v);
-				RediSearch_DocumentAddFieldNumber(doc, idx->fields[i], d, RSFLDTYPE_NUMERIC);
-			} else {
-				continue;
-			}
-		}
+	if(idx->type == IDX_RANGE) {
+		// Index is yet to be constructed.
+		if(idx->range == NULL) return;
+		RangeIndexKey *key = _Index_NodeRangeKey(idx, n);
+		// Node may have lost all of its indexed properties.
+		if(key) RangeIndex_InsertKey(idx->range, key);
+		else RangeIndex_Remove(idx->range, ENTITY_GET_ID(n));
+		return;
 	}
 
-	if(doc_field_count > 0) RediSearch_SpecAddDocument(rsIdx, doc);
-	else RediSearch_FreeDocument(doc);
+	RSDoc *doc = _Index_NodeDocument(idx, n);
+	if(doc) RediSearch_SpecAddDocument(idx->idx, doc);
 }
 
 void Index_RemoveNode(Index *idx, const Node *n) {
 	ASSERT(idx != NULL && n != NULL);
 	NodeID node_id = ENTITY_GET_ID(n);
+	if(idx->type == IDX_RANGE) {
+		if(idx->range) RangeIndex_Remove(idx->range, node_id);
+		return;
+	}
 	RediSearch_DeleteDocument(idx->idx, &node_id, sizeof(EntityID));
 }
 
@@ -163,6 +330,14 @@ void Index_RemoveNode(Index *idx, const Node *n) {
 void Index_Construct(Index *idx) {
 	ASSERT(idx != NULL);
 
+	// Range indices are maintained by RedisGraph.
+	if(idx->type == IDX_RANGE) {
+		if(idx->range) RangeIndex_Free(idx->range);
+		idx->range = RangeIndex_New();
+		_populateIndex(idx);
+		return;
+	}
+
 	/* RediSearch index already exists
 	 * re-construct */
 	if(idx->idx) {
@@ -239,6 +414,7 @@ bool Index_ContainsAttribute(const Index *idx, Attribute_ID attribute_id) {
 void Index_Free(Index *idx) {
 	ASSERT(idx != NULL);
 	if(idx->idx) RediSearch_DropIndex(idx->idx);
+	if(idx->range) RangeIndex_Free(idx->range);
 
 	rm_free(idx->label);
 
@@ -8,6 +8,7 @@
 
 #include "../graph/entities/node.h"
 #include "../graph/entities/graph_entity.h"
+#include "range_index.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
@@ -17,6 +18,7 @@ typedef enum {
 	IDX_ANY = 0,
 	IDX_EXACT_MATCH = 1,
 	IDX_FULLTEXT = 2,
+	IDX_RANGE = 3,
 } IndexType;
 
 typedef struct {
@@ -25,13 +27,14 @@ typedef struct {
 	Attribute_ID *fields_ids;   // Indexed field IDs.
 	uint fields_count;          // Number of fields.
 	RSIndex *idx;               // RediSearch index.
-	IndexType type;             // Index type exact-match / fulltext.
+	RangeIndex *range;          // Ordered index, range indices only.
+	IndexType type;             // Index type exact-match / fulltext / range.
 } Index;
 
 /**
  * @brief  Create a new index.
  * @param  *label: Indexed label
- * @param  type: Index type - exact match or full text.
+ * @param  type: Index type - exact match, full text or range.
  * @retval New constructed index for the label.
  */
 Index *Index_New(const char *label, IndexType type);
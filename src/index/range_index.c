@@ -0,0 +1,382 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "RG.h"
+#include "range_index.h"
+#include "../util/rmalloc.h"
+#include <math.h>
+#include <string.h>
+
+/* Encoded value types, ordered such that missing values precede booleans,
+ * which precede numbers, which precede strings. */
+#define KEY_MISSING 0x00
+#define KEY_BOOL    0x01
+#define KEY_NUMERIC 0x02
+#define KEY_STRING  0x03
+
+#define BOOL_KEY_LEN 2
+#define NUMERIC_KEY_LEN (1 + sizeof(uint64_t))
+
+//------------------------------------------------------------------------------
+// Key encoding
+//------------------------------------------------------------------------------
+
+// Returns true if v can be indexed.
+static inline bool _Indexable(const SIValue *v) {
+	if(v == NULL) return false;
+	if(SI_TYPE(*v) & (T_STRING | T_BOOL)) return true;
+	if(SI_TYPE(*v) & SI_NUMERIC) return !isnan(SI_GET_NUMERIC(*v));
+	return false;
+}
+
+static inline size_t _EncodedLen(const SIValue *v) {
+	if(!_Indexable(v)) return 1;
+	if(SI_TYPE(*v) == T_STRING) return 1 + strlen(v->stringval) + 1;
+	if(SI_TYPE(*v) == T_BOOL) return BOOL_KEY_LEN;
+	return NUMERIC_KEY_LEN;
+}
+
+/* Encode d such that encoded numbers compare like their values,
+ * positive numbers have their sign bit flipped, negative numbers all of their bits. */
+static void _EncodeNumeric(unsigned char *buf, double d) {
+	uint64_t bits;
+	if(d == 0) d = 0; // Treat -0 as 0.
+	memcpy(&bits, &d, sizeof(bits));
+	bits = (bits & (1ULL << 63)) ? ~bits : (bits | (1ULL << 63));
+
+	buf[0] = KEY_NUMERIC;
+	for(int i = 0; i < 8; i++) buf[1 + i] = bits >> (56 - 8 * i);
+}
+
+// Encode v into buf, returns number of bytes written.
+static size_t _Encode(unsigned char *buf, const SIValue *v) {
+	if(!_Indexable(v)) {
+		buf[0] = KEY_MISSING;
+		return 1;
+	}
+
+	if(SI_TYPE(*v) == T_STRING) {
+		// Strings are null terminated, a string precedes its extensions.
+		size_t len = strlen(v->stringval) + 1;
+		buf[0] = KEY_STRING;
+		memcpy(buf + 1, v->stringval, len);
+		return 1 + len;
+	}
+
+	if(SI_TYPE(*v) == T_BOOL) {
+		buf[0] = KEY_BOOL;
+		buf[1] = v->longval ? 0x01 : 0x00;
+		return BOOL_KEY_LEN;
+	}
+
+	_EncodeNumeric(buf, SI_GET_NUMERIC(*v));
+	return NUMERIC_KEY_LEN;
+}
+
+// Returns the length of the encoded value at the beginning of buf.
+static size_t _EncodedValueLen(const unsigned char *buf, size_t len) {
+	switch(buf[0]) {
+	case KEY_MISSING:
+		return 1;
+	case KEY_BOOL:
+		return BOOL_KEY_LEN;
+	case KEY_NUMERIC:
+		return NUMERIC_KEY_LEN;
+	case KEY_STRING: {
+		const unsigned char *end = memchr(buf + 1, '\0', len - 1);
+		ASSERT(end != NULL);
+		return end - buf + 1;
+	}
+	default:
+		ASSERT(false);
+		return len;
+	}
+}
+
+// Node IDs are encoded big-endian, ordering nodes sharing the same values by ID.
+static inline void _EncodeID(unsigned char *buf, NodeID id) {
+	for(int i = 0; i < 8; i++) buf[i] = id >> (56 - 8 * i);
+}
+
+static inline NodeID _DecodeID(const unsigned char *buf) {
+	NodeID id = 0;
+	for(int i = 0; i < 8; i++) id = (id << 8) | buf[i];
+	return id;
+}
+
+static inline int _Compare(const unsigned char *a, size_t a_len, const unsigned char *b,
+						   size_t b_len) {
+	int res = memcmp(a, b, (a_len < b_len) ? a_len : b_len);
+	if(res != 0) return res;
+	return (a_len > b_len) - (a_len < b_len);
+}
+
+//------------------------------------------------------------------------------
+// Range index
+//------------------------------------------------------------------------------
+
+RangeIndex *RangeIndex_New(void) {
+	RangeIndex *idx = rm_malloc(sizeof(RangeIndex));
+	idx->keys = raxNew();
+	idx->entries = raxNew();
+	idx->version = 0;
+	return idx;
+}
+
+RangeIndexKey *RangeIndex_BuildKey(NodeID id, const SIValue **values, uint value_count) {
+	bool indexable = false;
+	size_t len = sizeof(NodeID);
+	for(uint i = 0; i < value_count; i++) {
+		indexable |= _Indexable(values[i]);
+		len += _EncodedLen(values[i]);
+	}
+
+	// Node has none of the indexed properties.
+	if(!indexable) return NULL;
+
+	RangeIndexKey *key = rm_malloc(sizeof(RangeIndexKey) + len);
+	key->id = id;
+	key->len = len;
+
+	unsigned char *buf = key->data;
+	for(uint i = 0; i < value_count; i++) buf += _Encode(buf, values[i]);
+	_EncodeID(buf, id);
+
+	return key;
+}
+
+void RangeIndex_InsertKey(RangeIndex *idx, RangeIndexKey *key) {
+	ASSERT(idx != NULL && key != NULL);
+
+	RangeIndex_Remove(idx, key->id);
+	raxInsert(idx->keys, key->data, key->len, NULL, NULL);
+	raxInsert(idx->entries, (unsigned char *)&key->id, sizeof(NodeID), key, NULL);
+	idx->version++;
+}
+
+void RangeIndex_Remove(RangeIndex *idx, NodeID id) {
+	ASSERT(idx != NULL);
+
+	RangeIndexKey *key = raxFind(idx->entries, (unsigned char *)&id, sizeof(NodeID));
+	if(key == raxNotFound) return;
+
+	raxRemove(idx->keys, key->data, key->len, NULL);
+	raxRemove(idx->entries, (unsigned char *)&id, sizeof(NodeID), NULL);
+	rm_free(key);
+	idx->version++;
+}
+
+uint64_t RangeIndex_NodeCount(const RangeIndex *idx) {
+	ASSERT(idx != NULL);
+	return raxSize(idx->entries);
+}
+
+void RangeIndex_Free(RangeIndex *idx) {
+	ASSERT(idx != NULL);
+	raxFree(idx->keys);
+	raxFreeWithCallback(idx->entries, rm_free);
+	rm_free(idx);
+}
+
+bool RangeIndex_ExactNumeric(SIValue v) {
+	ASSERT(SI_TYPE(v) & SI_NUMERIC);
+	if(SI_TYPE(v) != T_INT64) return true;
+	// Integers of a greater magnitude round to the same double as their neighbors.
+	return (v.longval > -(1LL << 53) && v.longval < (1LL << 53));
+}
+
+//------------------------------------------------------------------------------
+// Range index query
+//------------------------------------------------------------------------------
+
+RangeIndexQuery *RangeIndexQuery_New(void) {
+	return rm_calloc(1, sizeof(RangeIndexQuery));
+}
+
+void RangeIndexQuery_AddEquality(RangeIndexQuery *q, SIValue v) {
+	ASSERT(q != NULL && !q->ranged);
+	ASSERT(_Indexable(&v));
+
+	size_t len = _EncodedLen(&v);
+	q->prefix = rm_realloc(q->prefix, q->prefix_len + len);
+	q->prefix_len += _Encode(q->prefix + q->prefix_len, &v);
+}
+
+void RangeIndexQuery_SetNumericRange(RangeIndexQuery *q, const NumericRange *range) {
+	ASSERT(q != NULL && !q->ranged);
+
+	q->ranged = true;
+	q->type = KEY_NUMERIC;
+	if(!NumericRange_IsValid(range)) {
+		q->empty = true;
+		return;
+	}
+
+	if(range->min != -INFINITY) {
+		q->min_len = NUMERIC_KEY_LEN;
+		q->min = rm_malloc(NUMERIC_KEY_LEN);
+		_EncodeNumeric(q->min, range->min);
+		if(!range->include_min) {
+			// Lower bound becomes the number following min.
+			int i = NUMERIC_KEY_LEN - 1;
+			for(; i > 0 && q->min[i] == 0xFF; i--) q->min[i] = 0;
+			if(i == 0) q->empty = true;
+			else q->min[i]++;
+		}
+	}
+
+	if(range->max != INFINITY) {
+		q->max_len = NUMERIC_KEY_LEN;
+		q->max = rm_malloc(NUMERIC_KEY_LEN);
+		q->include_max = range->include_max;
+		_EncodeNumeric(q->max, range->max);
+	}
+}
+
+void RangeIndexQuery_SetStringRange(RangeIndexQuery *q, const StringRange *range) {
+	ASSERT(q != NULL && !q->ranged);
+
+	q->ranged = true;
+	q->type = KEY_STRING;
+	if(!StringRange_IsValid(range)) {
+		q->empty = true;
+		return;
+	}
+
+	if(range->min) {
+		/* Encoded strings are null terminated, replacing the terminator with 0x01
+		 * yields a bound following min but preceding any greater string. */
+		SIValue min = SI_ConstStringVal(range->min);
+		q->min_len = _EncodedLen(&min);
+		q->min = rm_malloc(q->min_len);
+		_Encode(q->min, &min);
+		if(!range->include_min) q->min[q->min_len - 1] = 0x01;
+	}
+
+	if(range->max) {
+		SIValue max = SI_ConstStringVal(range->max);
+		q->max_len = _EncodedLen(&max);
+		q->max = rm_malloc(q->max_len);
+		q->include_max = range->include_max;
+		_Encode(q->max, &max);
+	}
+}
+
+void RangeIndexQuery_SetEmpty(RangeIndexQuery *q) {
+	ASSERT(q != NULL);
+	q->empty = true;
+}
+
+void RangeIndexQuery_Free(RangeIndexQuery *q) {
+	if(q == NULL) return;
+	if(q->prefix) rm_free(q->prefix);
+	if(q->min) rm_free(q->min);
+	if(q->max) rm_free(q->max);
+	rm_free(q);
+}
+
+// Returns true if key and every key following it fall outside of q.
+static bool _RangeIndexQuery_PastEnd(const RangeIndexQuery *q, const unsigned char *key,
+									 size_t len) {
+	size_t values_len = len - sizeof(NodeID);
+
+	// Keys are visited in order, the first key not sharing the prefix ends the scan.
+	if(values_len < q->prefix_len) return true;
+	if(memcmp(key, q->prefix, q->prefix_len) != 0) return true;
+	if(!q->ranged) return false;
+
+	const unsigned char *field = key + q->prefix_len;
+	size_t field_len = _EncodedValueLen(field, values_len - q->prefix_len);
+
+	// Values of a different type follow the scanned range.
+	if(field[0] != q->type) return true;
+
+	if(q->max) {
+		int res = _Compare(field, field_len, q->max, q->max_len);
+		if(res > 0 || (res == 0 && !q->include_max)) return true;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// Range index iterator
+//------------------------------------------------------------------------------
+
+static void _RangeIndexIterator_SetLast(RangeIndexIterator *iter, const unsigned char *key,
+										size_t len) {
+	if(iter->last_cap < len) {
+		iter->last_cap = len;
+		iter->last = rm_realloc(iter->last, len);
+	}
+	if(len > 0) memcpy(iter->last, key, len);
+	iter->last_len = len;
+}
+
+void RangeIndexIterator_Init(RangeIndexIterator *iter, RangeIndex *idx, const RangeIndexQuery *q) {
+	ASSERT(iter != NULL && idx != NULL && q != NULL);
+
+	iter->q = q;
+	iter->idx = idx;
+	iter->last = NULL;
+	iter->last_len = 0;
+	iter->last_cap = 0;
+	raxStart(&iter->it, idx->keys);
+	RangeIndexIterator_Reset(iter);
+}
+
+void RangeIndexIterator_Reset(RangeIndexIterator *iter) {
+	ASSERT(iter != NULL);
+	const RangeIndexQuery *q = iter->q;
+
+	iter->seek_op = ">=";
+	iter->positioned = false;
+	iter->depleted = q->empty;
+
+	// Seek to the first key sharing the prefix and within the range lower bound.
+	size_t bound_len = (q->min) ? q->min_len : (q->ranged) ? 1 : 0;
+	_RangeIndexIterator_SetLast(iter, q->prefix, q->prefix_len);
+	if(bound_len > 0) {
+		const unsigned char *bound = (q->min) ? q->min : &q->type;
+		if(iter->last_cap < q->prefix_len + bound_len) {
+			iter->last_cap = q->prefix_len + bound_len;
+			iter->last = rm_realloc(iter->last, iter->last_cap);
+		}
+		memcpy(iter->last + q->prefix_len, bound, bound_len);
+		iter->last_len += bound_len;
+	}
+}
+
+bool RangeIndexIterator_Next(RangeIndexIterator *iter, NodeID *id) {
+	ASSERT(iter != NULL && id != NULL);
+	if(iter->depleted) return false;
+
+	// Position iterator, reposition if the index was modified since.
+	if(!iter->positioned || iter->version != iter->idx->version) {
+		if(iter->last_len == 0) raxSeek(&iter->it, "^", NULL, 0);
+		else raxSeek(&iter->it, iter->seek_op, iter->last, iter->last_len);
+		iter->positioned = true;
+		iter->version = iter->idx->version;
+	}
+
+	if(raxNext(&iter->it) && !_RangeIndexQuery_PastEnd(iter->q, iter->it.key, iter->it.key_len)) {
+		// Remember returned key, in case iteration has to be resumed.
+		_RangeIndexIterator_SetLast(iter, iter->it.key, iter->it.key_len);
+		iter->seek_op = ">";
+		*id = _DecodeID(iter->it.key + iter->it.key_len - sizeof(NodeID));
+		return true;
+	}
+
+	iter->depleted = true;
+	return false;
+}
+
+void RangeIndexIterator_Free(RangeIndexIterator *iter) {
+	ASSERT(iter != NULL);
+	raxStop(&iter->it);
+	if(iter->last) rm_free(iter->last);
+	iter->last = NULL;
+}
@@ -0,0 +1,173 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "rax.h"
+#include "../value.h"
+#include "../graph/entities/node.h"
+#include "../util/range/string_range.h"
+#include "../util/range/numeric_range.h"
+
+/* A range index keeps its nodes ordered by the values of the indexed fields.
+ * Each node is stored under a key made of its encoded field values,
+ * in field order, followed by its ID, keys compare like the values they encode,
+ * such that a range of values maps to a contiguous range of keys.
+ * Each encoded value is tagged by its type, numbers are encoded as doubles,
+ * such that integers beyond 2^53 may share their key with their neighbors. */
+typedef struct {
+	rax *keys;          // Encoded node keys, in order.
+	rax *entries;       // Key of each indexed node, keyed by node ID.
+	uint64_t version;   // Incremented whenever the index is modified.
+} RangeIndex;
+
+// Encoded key of an indexed node.
+typedef struct {
+	NodeID id;              // Indexed node ID.
+	size_t len;             // Key length.
+	unsigned char data[];   // Encoded field values followed by the node ID.
+} RangeIndexKey;
+
+/* Bounds of a range index scan, the leading fields are each constrained
+ * to a single value, the field following them may be constrained to a range. */
+typedef struct {
+	unsigned char *prefix;  // Encoded values of the leading fields.
+	size_t prefix_len;      // Prefix length.
+	bool ranged;            // The field following the prefix is constrained.
+	unsigned char type;     // Encoded type of the constrained field.
+	unsigned char *min;     // Inclusive lower bound of the constrained field, NULL if unbounded.
+	size_t min_len;         // Lower bound length.
+	unsigned char *max;     // Upper bound of the constrained field, NULL if unbounded.
+	size_t max_len;         // Upper bound length.
+	bool include_max;       // Upper bound is inclusive.
+	bool empty;             // No node satisfies the constraints.
+} RangeIndexQuery;
+
+// Iterates over the IDs of the nodes matching a query, in key order.
+typedef struct {
+	RangeIndex *idx;            // Scanned index.
+	const RangeIndexQuery *q;   // Scan bounds.
+	raxIterator it;             // Position within the index.
+	bool positioned;            // Iterator has been positioned at the current version.
+	uint64_t version;           // Index version the iterator is positioned at.
+	const char *seek_op;        // Operator used to reposition the iterator.
+	unsigned char *last;        // Key the iterator is repositioned relative to.
+	size_t last_len;            // Length of last.
+	size_t last_cap;            // Capacity of last.
+	bool depleted;              // No more matching nodes.
+} RangeIndexIterator;
+
+// Create a new, empty, range index.
+RangeIndex *RangeIndex_New(void);
+
+/* Encode the key of node id, values[i] holds the value of the ith indexed field
+ * or NULL if the node has no such property.
+ * Returns NULL if none of the values can be indexed.
+ * Doesn't access the index, keys can be built concurrently. */
+RangeIndexKey *RangeIndex_BuildKey
+(
+	NodeID id,
+	const SIValue **values,
+	uint value_count
+);
+
+// Index key, replacing any previous key of the same node, the index takes ownership of key.
+void RangeIndex_InsertKey
+(
+	RangeIndex *idx,
+	RangeIndexKey *key
+);
+
+// Remove node id from the index.
+void RangeIndex_Remove
+(
+	RangeIndex *idx,
+	NodeID id
+);
+
+// Returns number of indexed nodes.
+uint64_t RangeIndex_NodeCount
+(
+	const RangeIndex *idx
+);
+
+// Free range index.
+void RangeIndex_Free
+(
+	RangeIndex *idx
+);
+
+/* Returns true if comparisons against the number v are resolved exactly by keys,
+ * which isn't the case for integers that share their key with other integers. */
+bool RangeIndex_ExactNumeric
+(
+	SIValue v
+);
+
+// Create a query matching every indexed node.
+RangeIndexQuery *RangeIndexQuery_New(void);
+
+// Constrain the next field to a single value.
+void RangeIndexQuery_AddEquality
+(
+	RangeIndexQuery *q,
+	SIValue v
+);
+
+// Constrain the next field to a numeric range, no further field can be constrained.
+void RangeIndexQuery_SetNumericRange
+(
+	RangeIndexQuery *q,
+	const NumericRange *range
+);
+
+// Constrain the next field to a string range, no further field can be constrained.
+void RangeIndexQuery_SetStringRange
+(
+	RangeIndexQuery *q,
+	const StringRange *range
+);
+
+// Mark query as unsatisfiable.
+void RangeIndexQuery_SetEmpty
+(
+	RangeIndexQuery *q
+);
+
+// Free query.
+void RangeIndexQuery_Free
+(
+	RangeIndexQuery *q
+);
+
+// Initialize an iterator over the nodes of idx matching q.
+void RangeIndexIterator_Init
+(
+	RangeIndexIterator *iter,
+	RangeIndex *idx,
+	const RangeIndexQuery *q
+);
+
+/* Sets id to the next matching node, returns false once depleted.
+ * The index may be modified between calls, in which case iteration
+ * resumes after the last returned key. */
+bool RangeIndexIterator_Next
+(
+	RangeIndexIterator *iter,
+	NodeID *id
+);
+
+// Restart iteration from the first matching node.
+void RangeIndexIterator_Reset
+(
+	RangeIndexIterator *iter
+);
+
+// Release iterator resources.
+void RangeIndexIterator_Free
+(
+	RangeIndexIterator *iter
+);
@@ -45,6 +45,7 @@ bool process_is_child;              // Flag indicating whether the running proce
 // Thread pool variables
 //------------------------------------------------------------------------------
 threadpool _thpool = NULL;
+threadpool _parallel_thpool = NULL;  // Workers for intra-query parallel scans.
 
 extern CommandCtx **command_ctxs;
 
@@ -60,6 +61,18 @@ static int _Setup_ThreadPOOL(int threadCount) {
 	return 1;
 }
 
+/* Set up the parallel scan thread pool,
+ * a thread count of 0 disables parallel scans.
+ * Returns 1 if thread pool initialized or not required, 0 otherwise. */
+static int _Setup_ParallelThreadPOOL(int threadCount) {
+	if(threadCount == 0) return 1;
+
+	_parallel_thpool = thpool_init(threadCount);
+	if(_parallel_thpool == NULL) return 0;
+
+	return 1;
+}
+
 static int _RegisterDataTypes(RedisModuleCtx *ctx) {
 	if(GraphContextType_Register(ctx) == REDISMODULE_ERR) {
 		printf("Failed to register GraphContext type\n");
@@ -127,6 +140,15 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	if(!_Setup_ThreadPOOL(threadCount)) return REDISMODULE_ERR;
 	RedisModule_Log(ctx, "notice", "Thread pool created, using %d threads.", threadCount);
 
+	int parallelThreadCount;
+	Config_Option_get(Config_PARALLEL_THREAD_COUNT, &parallelThreadCount);
+
+	if(!_Setup_ParallelThreadPOOL(parallelThreadCount)) return REDISMODULE_ERR;
+	if(parallelThreadCount > 0) {
+		RedisModule_Log(ctx, "notice", "Parallel scan thread pool created, using %d threads.",
+						parallelThreadCount);
+	}
+
 	int ompThreadCount;
 	Config_Option_get(Config_OPENMP_NTHREAD, &ompThreadCount);
 
@@ -176,11 +198,21 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 		return REDISMODULE_ERR;
 	}
 
+	if(RedisModule_CreateCommand(ctx, "graph.CURSOR", CommandDispatch, "readonly", 1, 1,
+								 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
 	if(RedisModule_CreateCommand(ctx, "graph.CONFIG", MGraph_Config, "write", 1, 1,
 								 1) == REDISMODULE_ERR) {
 		return REDISMODULE_ERR;
 	}
 
+	if(RedisModule_CreateCommand(ctx, "graph.EFFECT", MGraph_Effect, "write", 1, 1,
+								 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
 	setupCrashHandlers(ctx);
 
 	return REDISMODULE_OK;
@@ -0,0 +1,84 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_range_create_index.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../index/index.h"
+
+//------------------------------------------------------------------------------
+// range createNodeIndex
+//------------------------------------------------------------------------------
+
+// CALL db.idx.range.createNodeIndex(label, fields...)
+// CALL db.idx.range.createNodeIndex('person', 'country', 'age')
+// Nodes are ordered by their fields values, in the order fields are specified.
+ProcedureResult Proc_RangeCreateNodeIdxInvoke(ProcedureCtx *ctx,
+		const SIValue *args, const char **yield) {
+	UNUSED(ctx);
+	UNUSED(yield);
+
+	uint arg_count = array_len((SIValue *)args);
+	if(arg_count < 2) return PROCEDURE_ERR;
+
+	// Validation, all arguments should be of type string.
+	for(uint i = 0; i < arg_count; i++) {
+		if(!(SI_TYPE(args[i]) & T_STRING)) return PROCEDURE_ERR;
+	}
+
+	// Create range index.
+	const char *label = args[0].stringval;
+	uint fields_count = arg_count - 1;
+	const SIValue *fields = args + 1; // Skip label.
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Index *idx = GraphContext_GetIndex(gc, label, NULL, IDX_RANGE);
+
+	// Index doesn't exists, create.
+	if(idx == NULL) {
+		GraphContext_AddIndex(&idx, gc, label, fields[0].stringval, IDX_RANGE);
+	}
+
+	// Introduce fields to index, new fields are appended to the key.
+	for(uint i = 0; i < fields_count; i++) {
+		const char *field = fields[i].stringval;
+		// It's OK to add existing field.
+		Index_AddField(idx, field);
+	}
+
+	// Build index.
+	Index_Construct(idx);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_RangeCreateNodeIdxStep(ProcedureCtx *ctx) {
+	return NULL;
+}
+
+ProcedureResult Proc_RangeCreateNodeIdxFree(ProcedureCtx *ctx) {
+	// Clean up.
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_RangeCreateNodeIdxGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.range.createNodeIndex",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   output,
+								   Proc_RangeCreateNodeIdxStep,
+								   Proc_RangeCreateNodeIdxInvoke,
+								   Proc_RangeCreateNodeIdxFree,
+								   privateData,
+								   false);
+
+	return ctx;
+}
+
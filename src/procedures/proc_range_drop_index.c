@@ -0,0 +1,62 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_range_drop_index.h"
+#include "../query_ctx.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+//------------------------------------------------------------------------------
+// range drop
+//------------------------------------------------------------------------------
+
+// CALL db.idx.range.drop(label)
+// CALL db.idx.range.drop('person')
+
+ProcedureResult Proc_RangeDropIndexInvoke(ProcedureCtx *ctx,
+		const SIValue *args, const char **yield) {
+	UNUSED(ctx);
+	UNUSED(yield);
+
+	if(array_len((SIValue *)args) != 1) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[0]) & T_STRING)) return PROCEDURE_ERR;
+
+	const char *label = args[0].stringval;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	if(!s) return PROCEDURE_ERR;
+
+	if(Schema_RemoveIndex(s, NULL, IDX_RANGE) == INDEX_FAIL) return PROCEDURE_ERR;
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_RangeDropIndexStep(ProcedureCtx *ctx) {
+	return NULL;
+}
+
+ProcedureResult Proc_RangeDropIndexFree(ProcedureCtx *ctx) {
+	// Clean up.
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_RangeDropIdxGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.range.drop",
+								   1,
+								   output,
+								   Proc_RangeDropIndexStep,
+								   Proc_RangeDropIndexInvoke,
+								   Proc_RangeDropIndexFree,
+								   privateData,
+								   false);
+
+	return ctx;
+}
+
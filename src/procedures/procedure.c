@@ -39,6 +39,8 @@ void Proc_Register() {
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
 	_procRegister("db.idx.fulltext.queryNodes", Proc_FulltextQueryNodeGen);
 	_procRegister("db.idx.fulltext.createNodeIndex", Proc_FulltextCreateNodeIdxGen);
+	_procRegister("db.idx.range.drop", Proc_RangeDropIdxGen);
+	_procRegister("db.idx.range.createNodeIndex", Proc_RangeCreateNodeIdxGen);
 }
 
 ProcedureCtx *ProcCtxNew(const char *name,
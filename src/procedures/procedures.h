@@ -13,3 +13,5 @@
 #include "proc_fulltext_query.h"
 #include "proc_fulltext_drop_index.h"
 #include "proc_fulltext_create_index.h"
+#include "proc_range_drop_index.h"
+#include "proc_range_create_index.h"
@@ -7,6 +7,7 @@
 #include "query_ctx.h"
 #include "RG.h"
 #include "errors.h"
+#include "config.h"
 #include "util/simple_timer.h"
 #include "arithmetic/arithmetic_expression.h"
 #include "serializers/graphcontext_type.h"
@@ -45,6 +46,23 @@ void QueryCtx_BeginTimer(void) {
 	simple_tic(ctx->internal_exec_ctx.timer); // Start the execution timer.
 }
 
+QueryCtx *QueryCtx_GetQueryCtx(void) {
+	return _QueryCtx_GetCtx();
+}
+
+void QueryCtx_SetTLS(QueryCtx *query_ctx) {
+	ASSERT(query_ctx != NULL);
+	pthread_setspecific(_tlsQueryCtxKey, query_ctx);
+	// Keep reading the query's snapshot.
+	if(query_ctx->snapshot) Graph_AttachSnapshot(query_ctx->snapshot);
+}
+
+void QueryCtx_RemoveFromTLS(void) {
+	QueryCtx *ctx = pthread_getspecific(_tlsQueryCtxKey);
+	if(ctx && ctx->snapshot) Graph_DetachSnapshot();
+	pthread_setspecific(_tlsQueryCtxKey, NULL);
+}
+
 void QueryCtx_SetGlobalExecutionCtx(CommandCtx *cmd_ctx) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ctx->gc = CommandCtx_GetGraphContext(cmd_ctx);
@@ -52,6 +70,7 @@ void QueryCtx_SetGlobalExecutionCtx(CommandCtx *cmd_ctx) {
 	ctx->global_exec_ctx.bc = CommandCtx_GetBlockingClient(cmd_ctx);
 	ctx->global_exec_ctx.redis_ctx = CommandCtx_GetRedisCtx(cmd_ctx);
 	ctx->global_exec_ctx.command_name = CommandCtx_GetCommandName(cmd_ctx);
+	Config_Option_get(Config_EFFECTS_REPLICATION, &ctx->internal_exec_ctx.replicate_effects);
 }
 
 void QueryCtx_SetAST(AST *ast) {
@@ -74,6 +93,25 @@ void QueryCtx_SetLastWriter(OpBase *last_writer) {
 	ctx->internal_exec_ctx.last_writer = last_writer;
 }
 
+bool QueryCtx_PinSnapshot(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx->gc && !ctx->snapshot);
+	ctx->snapshot = Graph_PinSnapshot(ctx->gc->g);
+	if(!ctx->snapshot) return false;
+
+	Graph_AttachSnapshot(ctx->snapshot);
+	return true;
+}
+
+void QueryCtx_UnpinSnapshot(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(!ctx->snapshot) return;
+
+	Graph_DetachSnapshot();
+	Graph_UnpinSnapshot(ctx->snapshot);
+	ctx->snapshot = NULL;
+}
+
 AST *QueryCtx_GetAST(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx->query_data.ast);
@@ -112,6 +150,13 @@ ResultSetStatistics *QueryCtx_GetResultSetStatistics(void) {
 	return &ctx->internal_exec_ctx.result_set->stats;
 }
 
+EffectsBuffer *QueryCtx_GetEffectsBuffer(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(!ctx->internal_exec_ctx.replicate_effects) return NULL;
+	if(!ctx->internal_exec_ctx.effects) ctx->internal_exec_ctx.effects = EffectsBuffer_New();
+	return ctx->internal_exec_ctx.effects;
+}
+
 void QueryCtx_PrintQuery(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	printf("%s\n", ctx->query_data.query);
@@ -172,11 +217,23 @@ static void _QueryCtx_UnlockCommit(QueryCtx *ctx) {
 	GraphContext *gc = ctx->gc;
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 
-	if(ResultSetStat_IndicateModification(ctx->internal_exec_ctx.result_set->stats)) {
+	ResultSetStatistics stats = ctx->internal_exec_ctx.result_set->stats;
+	if(ResultSetStat_IndicateModification(stats)) {
 		// Replicate only in case of changes.
-		RedisModule_Replicate(redis_ctx, ctx->global_exec_ctx.command_name, "cc!", gc->graph_name,
-							  ctx->query_data.query);
+		EffectsBuffer *effects = ctx->internal_exec_ctx.effects;
+		/* Index creation and removal aren't logged as effects,
+		 * queries introducing these are replicated verbatim. */
+		if(effects && EffectsBuffer_Replicable(effects) &&
+		   stats.indices_created <= 0 && stats.indices_deleted <= 0) {
+			RedisModule_Replicate(redis_ctx, "GRAPH.EFFECT", "cb!", gc->graph_name,
+								  effects->buffer, effects->len);
+		} else {
+			RedisModule_Replicate(redis_ctx, ctx->global_exec_ctx.command_name, "cc!", gc->graph_name,
+								  ctx->query_data.query);
+		}
 	}
+	EffectsBuffer_Free(ctx->internal_exec_ctx.effects);
+	ctx->internal_exec_ctx.effects = NULL;
 
 	ctx->internal_exec_ctx.locked_for_commit = false;
 	// Release graph R/W lock.
@@ -228,6 +285,9 @@ void QueryCtx_Free(void) {
 		ctx->query_data.params = NULL;
 	}
 
+	EffectsBuffer_Free(ctx->internal_exec_ctx.effects);
+	QueryCtx_UnpinSnapshot();
+
 	rm_free(ctx);
 	// NULL-set the context for reuse the next time this thread receives a query
 	pthread_setspecific(_tlsQueryCtxKey, NULL);
@@ -12,6 +12,7 @@
 #include "graph/graphcontext.h"
 #include "commands/cmd_context.h"
 #include "resultset/resultset.h"
+#include "effects/effects.h"
 #include "execution_plan/ops/op.h"
 #include <pthread.h>
 
@@ -29,6 +30,8 @@ typedef struct {
 	ResultSet *result_set;      // Save the execution result set.
 	bool locked_for_commit;     // Indicates if a call for QueryCtx_LockForCommit issued before.
 	OpBase *last_writer;        // The last writer operation which indicates the need for commit.
+	bool replicate_effects;     // Replicate the query by its effects rather than verbatim.
+	EffectsBuffer *effects;     // Changes introduced by the query, when replicated by effects.
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -42,6 +45,7 @@ typedef struct {
 	QueryCtx_InternalExecCtx internal_exec_ctx; // The data related to internal query execution.
 	QueryCtx_GlobalExecCtx global_exec_ctx;     // The data rlated to global redis execution.
 	GraphContext *gc;                           // The GraphContext associated with this query's graph.
+	GraphSnapshot *snapshot;                    // Snapshot of the graph read by the query, if pinned.
 } QueryCtx;
 
 /* Instantiate the thread-local QueryCtx on module load. */
@@ -51,6 +55,14 @@ void QueryCtx_Finalize(void);
 /* Start timing query execution. */
 void QueryCtx_BeginTimer(void);
 
+/* Retrieve the thread-local QueryCtx. */
+QueryCtx *QueryCtx_GetQueryCtx(void);
+/* Share an existing QueryCtx with the calling thread,
+ * used by worker threads executing parts of a query on its behalf. */
+void QueryCtx_SetTLS(QueryCtx *query_ctx);
+/* Detach the calling thread from a QueryCtx set by QueryCtx_SetTLS without freeing it. */
+void QueryCtx_RemoveFromTLS(void);
+
 /* Setters */
 /* Sets the global execution context */
 void QueryCtx_SetGlobalExecutionCtx(CommandCtx *cmd_ctx);
@@ -62,6 +74,11 @@ void QueryCtx_SetGraphCtx(GraphContext *gc);
 void QueryCtx_SetResultSet(ResultSet *result_set);
 /* Set the last writer which needs to commit */
 void QueryCtx_SetLastWriter(OpBase *op);
+/* Pins the latest snapshot of the query's graph and reads it from the calling thread,
+ * returns false if the graph doesn't take snapshots. */
+bool QueryCtx_PinSnapshot(void);
+/* Unpins the query's snapshot, if any. */
+void QueryCtx_UnpinSnapshot(void);
 
 /* Getters */
 /* Retrieve the AST. */
@@ -78,6 +95,9 @@ RedisModuleCtx *QueryCtx_GetRedisModuleCtx(void);
 ResultSet *QueryCtx_GetResultSet(void);
 /* Retrive the resultset statistics. */
 ResultSetStatistics *QueryCtx_GetResultSetStatistics(void);
+/* Retrieve the buffer logging the query's changes,
+ * NULL if the query is replicated verbatim. */
+EffectsBuffer *QueryCtx_GetEffectsBuffer(void);
 
 /* Print the current query. */
 void QueryCtx_PrintQuery(void);
@@ -99,7 +119,7 @@ bool QueryCtx_LockForCommit(void);
  * The method get an OpBase and compares it to the last writer, if they are equal then the commit
  * and unlock flow will start.
  * Unlocking flow is:
- * 1. Replicate.
+ * 1. Replicate, either the query itself or its effects.
  * 2. Unlock graph R/W lock
  * 3. Close key
  * 4. Unlock GIL */
@@ -7,6 +7,7 @@
 #include "resultset.h"
 #include "RG.h"
 #include "../value.h"
+#include "../config.h"
 #include "../errors.h"
 #include "../util/arr.h"
 #include "../query_ctx.h"
@@ -18,6 +19,8 @@ static void _ResultSet_ReplayStats(RedisModuleCtx *ctx, ResultSet *set) {
 	size_t resultset_size = 2; // execution time, cached
 	int buflen;
 
+	if(set->cursor_id != 0) resultset_size++;
+
 	if(set->stats.labels_added > 0) resultset_size++;
 	if(set->stats.nodes_created > 0) resultset_size++;
 	if(set->stats.properties_set > 0) resultset_size++;
@@ -72,6 +75,11 @@ static void _ResultSet_ReplayStats(RedisModuleCtx *ctx, ResultSet *set) {
 	buflen = sprintf(buff, "Cached execution: %d", set->stats.cached ? 1 : 0);
 	RedisModule_ReplyWithStringBuffer(ctx, (const char *)buff, buflen);
 
+	if(set->cursor_id != 0) {
+		buflen = sprintf(buff, "Cursor: %llu", (unsigned long long)set->cursor_id);
+		RedisModule_ReplyWithStringBuffer(ctx, (const char *)buff, buflen);
+	}
+
 	// Emit query execution time.
 	ResultSet_ReportQueryRuntime(ctx);
 }
@@ -133,6 +141,8 @@ ResultSet *NewResultSet(RedisModuleCtx *ctx, ResultSetFormatterType format) {
 	set->formatter = ResultSetFormatter_GetFormatter(format);
 	set->columns = NULL;
 	set->recordCount = 0;
+	set->capacity = RESULTSET_SIZE_UNLIMITED;
+	set->cursor_id = 0;
 	set->column_count = 0;
 	set->header_emitted = false;
 	set->columns_record_map = NULL;
@@ -161,6 +171,8 @@ int ResultSet_AddRecord(ResultSet *set, Record r) {
 	// If result-set format is NOP, don't process record.
 	if(set->format == FORMATTER_NOP) return RESULTSET_OK;
 
+	if(set->recordCount >= set->capacity) return RESULTSET_FULL;
+
 	// If this is the first Record encountered
 	if(set->header_emitted == false) {
 		// Map columns to record indices.
@@ -177,6 +189,22 @@ int ResultSet_AddRecord(ResultSet *set, Record r) {
 	return RESULTSET_OK;
 }
 
+void ResultSet_SetCapacity(ResultSet *set, uint64_t capacity) {
+	ASSERT(set != NULL);
+	ASSERT(set->recordCount <= capacity);
+	set->capacity = capacity;
+}
+
+uint64_t ResultSet_Capacity(const ResultSet *set) {
+	ASSERT(set != NULL);
+	return set->capacity - set->recordCount;
+}
+
+void ResultSet_SetCursor(ResultSet *set, uint64_t cursor_id) {
+	ASSERT(set != NULL);
+	set->cursor_id = cursor_id;
+}
+
 void ResultSet_IndexCreated(ResultSet *set, int status_code) {
 	if(status_code == INDEX_OK) {
 		if(set->stats.indices_created == STAT_NOT_SET) {
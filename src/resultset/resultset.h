@@ -23,6 +23,8 @@ typedef struct {
 	const char **columns;           /* Field names for each column of results. */
 	uint *columns_record_map;       /* Mapping between column name and record index.*/
 	size_t recordCount;             /* Number of records introduced. */
+	uint64_t capacity;              /* Maximum number of records in result set. */
+	uint64_t cursor_id;             /* Cursor holding the remaining records, 0 if none. */
 	double timer[2];                /* Query runtime tracker. */
 	ResultSetStatistics stats;      /* ResultSet statistics. */
 	ResultSetFormatterType format;  /* Result-set format; compact/verbose/nop. */
@@ -38,6 +40,15 @@ uint64_t ResultSet_RecordCount(const ResultSet *set);
 
 int ResultSet_AddRecord(ResultSet *set, Record r);
 
+// limits the number of records the result-set replies with
+void ResultSet_SetCapacity(ResultSet *set, uint64_t capacity);
+
+// returns number of additional records the result-set can hold
+uint64_t ResultSet_Capacity(const ResultSet *set);
+
+// reports a cursor from which the records following this result-set are read
+void ResultSet_SetCursor(ResultSet *set, uint64_t cursor_id);
+
 void ResultSet_IndexCreated(ResultSet *set, int status_code);
 
 void ResultSet_IndexDeleted(ResultSet *set, int status_code);
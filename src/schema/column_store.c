@@ -0,0 +1,262 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "column_store.h"
+#include "RG.h"
+#include <string.h>
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+// Number of rows allocated once a column first holds a value.
+#define COLUMN_INITIAL_CAP 1024
+
+static size_t _ValueSize(PropertyColumnType t) {
+	switch(t) {
+	case PROP_COLUMN_INT64:
+		return sizeof(int64_t);
+	case PROP_COLUMN_DOUBLE:
+		return sizeof(double);
+	case PROP_COLUMN_BOOL:
+		return sizeof(bool);
+	case PROP_COLUMN_STRING:
+		return sizeof(uint32_t);
+	default:
+		ASSERT(false);
+		return 0;
+	}
+}
+
+// Column type able to hold v, PROP_COLUMN_UNTYPED if none.
+static PropertyColumnType _ColumnTypeOf(SIValue v) {
+	switch(SI_TYPE(v)) {
+	case T_INT64:
+		return PROP_COLUMN_INT64;
+	case T_DOUBLE:
+		return PROP_COLUMN_DOUBLE;
+	case T_BOOL:
+		return PROP_COLUMN_BOOL;
+	case T_STRING:
+		return PROP_COLUMN_STRING;
+	default:
+		return PROP_COLUMN_UNTYPED;
+	}
+}
+
+static inline void _SetBit(uint64_t *bitmap, NodeID id, bool set) {
+	if(set) bitmap[id / 64] |= (1ULL << (id % 64));
+	else bitmap[id / 64] &= ~(1ULL << (id % 64));
+}
+
+static PropertyColumn *_PropertyColumn_New(Attribute_ID attr_id) {
+	PropertyColumn *col = rm_calloc(1, sizeof(PropertyColumn));
+	col->attr_id = attr_id;
+	col->type = PROP_COLUMN_UNTYPED;
+	return col;
+}
+
+// Grow column to hold row id, new rows are null.
+static void _PropertyColumn_Grow(PropertyColumn *col, NodeID id) {
+	uint64_t cap = (col->cap) ? col->cap : COLUMN_INITIAL_CAP;
+	while(cap <= id) cap *= 2;
+
+	size_t words = col->cap / 64;
+	size_t new_words = cap / 64;
+	col->nulls = rm_realloc(col->nulls, new_words * sizeof(uint64_t));
+	col->spills = rm_realloc(col->spills, new_words * sizeof(uint64_t));
+	memset(col->nulls + words, 0xFF, (new_words - words) * sizeof(uint64_t));
+	memset(col->spills + words, 0, (new_words - words) * sizeof(uint64_t));
+	if(col->values) col->values = rm_realloc(col->values, cap * _ValueSize(col->type));
+	col->cap = cap;
+}
+
+static uint32_t _PropertyColumn_EncodeString(PropertyColumn *col, const char *str) {
+	size_t len = strlen(str);
+	void *code = raxFind(col->dict_codes, (unsigned char *)str, len);
+	if(code != raxNotFound) return (uintptr_t)code;
+
+	uint32_t new_code = array_len(col->dict);
+	col->dict = array_append(col->dict, rm_strdup(str));
+	raxInsert(col->dict_codes, (unsigned char *)str, len, (void *)(uintptr_t)new_code, NULL);
+	return new_code;
+}
+
+static void _PropertyColumn_Set(PropertyColumn *col, NodeID id, const SIValue *v) {
+	if(v == PROPERTY_NOTFOUND || SIValue_IsNull(*v)) {
+		if(id < col->cap) _SetBit(col->nulls, id, true);
+		return;
+	}
+
+	if(id >= col->cap) _PropertyColumn_Grow(col, id);
+	_SetBit(col->nulls, id, false);
+
+	PropertyColumnType t = _ColumnTypeOf(*v);
+	if(col->type == PROP_COLUMN_UNTYPED && t != PROP_COLUMN_UNTYPED) {
+		// First typed value determines the column type.
+		col->type = t;
+		col->values = rm_malloc(col->cap * _ValueSize(t));
+		if(t == PROP_COLUMN_STRING) {
+			col->dict = array_new(char *, 16);
+			col->dict_codes = raxNew();
+		}
+	}
+
+	// Values of any other type are read from the node's property set.
+	bool spilled = (t == PROP_COLUMN_UNTYPED || t != col->type);
+	_SetBit(col->spills, id, spilled);
+	if(spilled) return;
+
+	switch(t) {
+	case PROP_COLUMN_INT64:
+		((int64_t *)col->values)[id] = v->longval;
+		break;
+	case PROP_COLUMN_DOUBLE:
+		((double *)col->values)[id] = v->doubleval;
+		break;
+	case PROP_COLUMN_BOOL:
+		((bool *)col->values)[id] = v->longval;
+		break;
+	case PROP_COLUMN_STRING:
+		((uint32_t *)col->values)[id] = _PropertyColumn_EncodeString(col, v->stringval);
+		break;
+	default:
+		ASSERT(false);
+		break;
+	}
+}
+
+static inline void _PropertyColumn_SetNode(PropertyColumn *col, const Node *n) {
+	SIValue *v = GraphEntity_GetProperty((const GraphEntity *)n, col->attr_id);
+	_PropertyColumn_Set(col, ENTITY_GET_ID(n), v);
+}
+
+// Populate column from all nodes of label.
+static void _PropertyColumn_Build(PropertyColumn *col, const Graph *g, int label_id) {
+	GxB_MatrixTupleIter *iter;
+	GxB_MatrixTupleIter_new(&iter, Graph_GetLabelMatrix(g, label_id));
+
+	GrB_Index id;
+	bool depleted = false;
+	while(true) {
+		GxB_MatrixTupleIter_next(iter, NULL, &id, &depleted);
+		if(depleted) break;
+		Node n = GE_NEW_NODE();
+		if(!Graph_GetNode(g, id, &n)) continue;
+		_PropertyColumn_SetNode(col, &n);
+	}
+
+	GxB_MatrixTupleIter_free(iter);
+}
+
+static void _PropertyColumn_Free(PropertyColumn *col) {
+	if(col->dict) {
+		uint count = array_len(col->dict);
+		for(uint i = 0; i < count; i++) rm_free(col->dict[i]);
+		array_free(col->dict);
+	}
+	if(col->dict_codes) raxFree(col->dict_codes);
+	rm_free(col->values);
+	rm_free(col->nulls);
+	rm_free(col->spills);
+	rm_free(col);
+}
+
+SIValue PropertyColumn_GetValue(const PropertyColumn *col, NodeID id) {
+	ASSERT(!PropertyColumn_IsNull(col, id) && !PropertyColumn_IsSpilled(col, id));
+
+	switch(col->type) {
+	case PROP_COLUMN_INT64:
+		return SI_LongVal(((int64_t *)col->values)[id]);
+	case PROP_COLUMN_DOUBLE:
+		return SI_DoubleVal(((double *)col->values)[id]);
+	case PROP_COLUMN_BOOL:
+		return SI_BoolVal(((bool *)col->values)[id]);
+	case PROP_COLUMN_STRING:
+		return SI_ConstStringVal(col->dict[((uint32_t *)col->values)[id]]);
+	default:
+		ASSERT(false);
+		return SI_NullVal();
+	}
+}
+
+bool PropertyColumn_StringCode(const PropertyColumn *col, const char *str, uint32_t *code) {
+	ASSERT(col->type == PROP_COLUMN_STRING);
+	void *c = raxFind(col->dict_codes, (unsigned char *)str, strlen(str));
+	if(c == raxNotFound) return false;
+	*code = (uintptr_t)c;
+	return true;
+}
+
+ColumnStore *ColumnStore_New(void) {
+	ColumnStore *cs = rm_malloc(sizeof(ColumnStore));
+	cs->columns = array_new(PropertyColumn *, 0);
+	int res = pthread_mutex_init(&cs->lock, NULL);
+	UNUSED(res);
+	ASSERT(res == 0);
+	return cs;
+}
+
+static PropertyColumn *_ColumnStore_FindColumn(const ColumnStore *cs, Attribute_ID attr_id) {
+	uint count = array_len(cs->columns);
+	for(uint i = 0; i < count; i++) {
+		if(cs->columns[i]->attr_id == attr_id) return cs->columns[i];
+	}
+	return NULL;
+}
+
+uint ColumnStore_ColumnCount(ColumnStore *cs) {
+	ASSERT(cs);
+	pthread_mutex_lock(&cs->lock);
+	uint count = array_len(cs->columns);
+	pthread_mutex_unlock(&cs->lock);
+	return count;
+}
+
+bool ColumnStore_HasColumn(ColumnStore *cs, Attribute_ID attr_id) {
+	ASSERT(cs);
+	pthread_mutex_lock(&cs->lock);
+	bool found = (_ColumnStore_FindColumn(cs, attr_id) != NULL);
+	pthread_mutex_unlock(&cs->lock);
+	return found;
+}
+
+PropertyColumn *ColumnStore_GetColumn(ColumnStore *cs, const Graph *g, int label_id,
+									  Attribute_ID attr_id) {
+	ASSERT(cs && g);
+	ASSERT(attr_id != ATTRIBUTE_NOTFOUND);
+
+	// Readers holding the graph's read lock may build columns concurrently.
+	pthread_mutex_lock(&cs->lock);
+	PropertyColumn *col = _ColumnStore_FindColumn(cs, attr_id);
+	if(col == NULL) {
+		col = _PropertyColumn_New(attr_id);
+		_PropertyColumn_Build(col, g, label_id);
+		cs->columns = array_append(cs->columns, col);
+	}
+	pthread_mutex_unlock(&cs->lock);
+
+	return col;
+}
+
+void ColumnStore_UpdateNode(ColumnStore *cs, const Node *n) {
+	ASSERT(cs && n);
+	uint count = array_len(cs->columns);
+	for(uint i = 0; i < count; i++) _PropertyColumn_SetNode(cs->columns[i], n);
+}
+
+void ColumnStore_RemoveNode(ColumnStore *cs, NodeID id) {
+	ASSERT(cs);
+	uint count = array_len(cs->columns);
+	for(uint i = 0; i < count; i++) _PropertyColumn_Set(cs->columns[i], id, PROPERTY_NOTFOUND);
+}
+
+void ColumnStore_Free(ColumnStore *cs) {
+	if(cs == NULL) return;
+	uint count = array_len(cs->columns);
+	for(uint i = 0; i < count; i++) _PropertyColumn_Free(cs->columns[i]);
+	array_free(cs->columns);
+	pthread_mutex_destroy(&cs->lock);
+	rm_free(cs);
+}
@@ -0,0 +1,93 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include "rax.h"
+#include "../value.h"
+#include "../graph/graph.h"
+#include "../graph/entities/node.h"
+
+/* A column store holds the values of a label's node attributes in typed
+ * dense vectors indexed by node ID, along with a null bitmap, such that
+ * label scans can evaluate attribute filters sequentially rather than
+ * searching each node's property set.
+ * Nodes' property sets remain the source of truth, a column is built
+ * once a scan first filters on its attribute, and from then on it is
+ * maintained alongside the label's indices. */
+
+typedef enum {
+	PROP_COLUMN_UNTYPED,  // Column holds no typed values yet.
+	PROP_COLUMN_INT64,
+	PROP_COLUMN_DOUBLE,
+	PROP_COLUMN_BOOL,
+	PROP_COLUMN_STRING,   // Dictionary encoded strings.
+} PropertyColumnType;
+
+typedef struct {
+	Attribute_ID attr_id;     // Attribute held by column.
+	PropertyColumnType type;  // Type of values vector, set by the first typed value.
+	uint64_t cap;             // Number of rows, one per node ID.
+	void *values;             // Typed values vector.
+	uint64_t *nulls;          // Bitmap of rows without a value.
+	uint64_t *spills;         // Bitmap of rows whose value isn't of the column type.
+	char **dict;              // String dictionary, from code to string.
+	rax *dict_codes;          // String dictionary, from string to code.
+} PropertyColumn;
+
+typedef struct {
+	PropertyColumn **columns;  // Columns, by order of creation.
+	pthread_mutex_t lock;      // Guards columns built by concurrent readers.
+} ColumnStore;
+
+/* Creates a new, empty column store. */
+ColumnStore *ColumnStore_New(void);
+
+/* Returns the number of columns in store. */
+uint ColumnStore_ColumnCount(ColumnStore *cs);
+
+/* Returns true if store holds a column for attribute. */
+bool ColumnStore_HasColumn(ColumnStore *cs, Attribute_ID attr_id);
+
+/* Returns the column of attribute, building it from the nodes
+ * of label if it doesn't exist yet. */
+PropertyColumn *ColumnStore_GetColumn(ColumnStore *cs, const Graph *g, int label_id,
+									  Attribute_ID attr_id);
+
+/* Updates node's row in every column to its current attributes,
+ * expected to be called under the graph's write lock. */
+void ColumnStore_UpdateNode(ColumnStore *cs, const Node *n);
+
+/* Clears node's row in every column,
+ * expected to be called under the graph's write lock. */
+void ColumnStore_RemoveNode(ColumnStore *cs, NodeID id);
+
+/* Free column store. */
+void ColumnStore_Free(ColumnStore *cs);
+
+static inline bool _ColumnBit(const uint64_t *bitmap, NodeID id) {
+	return bitmap[id / 64] & (1ULL << (id % 64));
+}
+
+/* Returns true if node has no value in column. */
+static inline bool PropertyColumn_IsNull(const PropertyColumn *col, NodeID id) {
+	return id >= col->cap || _ColumnBit(col->nulls, id);
+}
+
+/* Returns true if node's value isn't held by column,
+ * it is to be read from the node's property set. */
+static inline bool PropertyColumn_IsSpilled(const PropertyColumn *col, NodeID id) {
+	return _ColumnBit(col->spills, id);
+}
+
+/* Returns node's value, which must be neither null nor spilled,
+ * strings are shared with the column's dictionary. */
+SIValue PropertyColumn_GetValue(const PropertyColumn *col, NodeID id);
+
+/* Retrieves the dictionary code of str,
+ * returns false if no row holds str. */
+bool PropertyColumn_StringCode(const PropertyColumn *col, const char *str, uint32_t *code);
@@ -15,6 +15,8 @@ Schema *Schema_New(const char *name, int id) {
 	schema->id = id;
 	schema->index = NULL;
 	schema->fulltextIdx = NULL;
+	schema->rangeIdx = NULL;
+	schema->columns = ColumnStore_New();
 	schema->name = rm_strdup(name);
 	return schema;
 }
@@ -26,7 +28,12 @@ const char *Schema_GetName(const Schema *s) {
 
 bool Schema_HasIndices(const Schema *s) {
 	ASSERT(s);
-	return (s->fulltextIdx || s->index);
+	return (s->fulltextIdx || s->index || s->rangeIdx || ColumnStore_ColumnCount(s->columns) > 0);
+}
+
+bool Schema_HasColumn(const Schema *s, Attribute_ID attribute_id) {
+	ASSERT(s);
+	return ColumnStore_HasColumn(s->columns, attribute_id);
 }
 
 unsigned short Schema_IndexCount(const Schema *s) {
@@ -35,6 +42,7 @@ unsigned short Schema_IndexCount(const Schema *s) {
 
 	if(s->index) n += Index_FieldsCount(s->index);
 	if(s->fulltextIdx) n += Index_FieldsCount(s->fulltextIdx);
+	if(s->rangeIdx) n += Index_FieldsCount(s->rangeIdx);
 
 	return n;
 }
@@ -46,9 +54,16 @@ Index *Schema_GetIndex(const Schema *s, Attribute_ID *attribute_id, IndexType ty
 		idx = s->index;
 	} else if(type ==  IDX_FULLTEXT) {
 		idx = s->fulltextIdx;
+	} else if(type == IDX_RANGE) {
+		idx = s->rangeIdx;
 	} else {
 		// If type is unspecified, use the first index that exists.
-		idx = s->index ? : s->fulltextIdx;
+		Index *indices[3] = {s->index, s->fulltextIdx, s->rangeIdx};
+		for(int i = 0; i < 3; i++) {
+			if(!indices[i]) continue;
+			if(!attribute_id || Index_ContainsAttribute(indices[i], *attribute_id)) return indices[i];
+		}
+		return NULL;
 	}
 
 	if(!idx) return NULL;
@@ -76,6 +91,7 @@ int Schema_AddIndex(Index **idx, Schema *s, const char *field, IndexType type) {
 		// Index doesn't exist, create it.
 		_idx = Index_New(s->name, type);
 		if(type == IDX_FULLTEXT) s->fulltextIdx = _idx;
+		else if(type == IDX_RANGE) s->rangeIdx = _idx;
 		else s->index = _idx;
 	}
 
@@ -86,18 +102,27 @@ int Schema_AddIndex(Index **idx, Schema *s, const char *field, IndexType type) {
 }
 
 int Schema_RemoveIndex(Schema *s, const char *field, IndexType type) {
-	GraphContext *gc = QueryCtx_GetGraphCtx();
-	Attribute_ID attribute_id = GraphContext_GetAttributeID(gc, field);
-	Index *idx = Schema_GetIndex(s, &attribute_id, type);
+	Index *idx = NULL;
+	if(field) {
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		Attribute_ID attribute_id = GraphContext_GetAttributeID(gc, field);
+		idx = Schema_GetIndex(s, &attribute_id, type);
+	} else {
+		idx = Schema_GetIndex(s, NULL, type);
+	}
 	if(idx == NULL) return INDEX_FAIL;
 
 	type = idx->type;
 
-	// Currently dropping a full-text index doesn't take into account fields.
+	// Currently dropping a full-text or range index doesn't take into account fields.
 	if(type == IDX_FULLTEXT) {
 		ASSERT(field == NULL);
 		Index_Free(idx);
 		s->fulltextIdx = NULL;
+	} else if(type == IDX_RANGE) {
+		ASSERT(field == NULL);
+		Index_Free(idx);
+		s->rangeIdx = NULL;
 	} else {
 		// Index is of type IDX_EXACT_MATCH
 		ASSERT(type == IDX_EXACT_MATCH);
@@ -123,6 +148,11 @@ void Schema_AddNodeToIndices(const Schema *s, const Node *n) {
 
 	idx = s->index;
 	if(idx) Index_IndexNode(idx, n);
+
+	idx = s->rangeIdx;
+	if(idx) Index_IndexNode(idx, n);
+
+	ColumnStore_UpdateNode(s->columns, n);
 }
 
 void Schema_Free(Schema *schema) {
@@ -131,6 +161,8 @@ void Schema_Free(Schema *schema) {
 	// Free indicies.
 	if(schema->index) Index_Free(schema->index);
 	if(schema->fulltextIdx) Index_Free(schema->fulltextIdx);
+	if(schema->rangeIdx) Index_Free(schema->rangeIdx);
+	ColumnStore_Free(schema->columns);
 	rm_free(schema);
 }
 
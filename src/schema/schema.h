@@ -10,6 +10,7 @@
 #include "../index/index.h"
 #include "rax.h"
 #include "redisearch_api.h"
+#include "column_store.h"
 #include "../graph/entities/graph_entity.h"
 
 typedef enum {
@@ -25,6 +26,8 @@ typedef struct {
 	char *name;           // Schema name.
 	Index *index;         // Exact match index.
 	Index *fulltextIdx;   // Full-text index.
+	Index *rangeIdx;      // Range index.
+	ColumnStore *columns; // Property columns, built on demand by label scans.
 } Schema;
 
 /* Creates a new schema. */
@@ -32,9 +35,13 @@ Schema *Schema_New(const char *label, int id);
 
 const char *Schema_GetName(const Schema *s);
 
-/* Returns true if schema has either a full-text or exact-match index. */
+/* Returns true if schema has either a full-text, exact-match or range index,
+ * or property columns, all of which are maintained as nodes are updated. */
 bool Schema_HasIndices(const Schema *s);
 
+/* Returns true if schema holds a property column for attribute. */
+bool Schema_HasColumn(const Schema *s, Attribute_ID attribute_id);
+
 /* Returns number of indices in schema. */
 unsigned short Schema_IndexCount(const Schema *s);
 
@@ -46,10 +53,10 @@ Index *Schema_GetIndex(const Schema *s, Attribute_ID *attribute_id, IndexType ty
  * attribute must already exists and not associated with an index. */
 int Schema_AddIndex(Index **idx, Schema *s, const char *field, IndexType type);
 
-/* Removes index. */
+/* Removes index, a NULL field removes the entire index. */
 int Schema_RemoveIndex(Schema *s, const char *field, IndexType type);
 
-/* Introduce node schema indicies */
+/* Introduce node schema indicies and columns. */
 void Schema_AddNodeToIndices(const Schema *s, const Node *n);
 
 /* Free schema. */
@@ -0,0 +1,142 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "decode_v9.h"
+
+// Forward declarations.
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb);
+
+static SIValue _RdbLoadSIValue(RedisModuleIO *rdb) {
+	/* Format:
+	 * SIType
+	 * Value */
+	SIType t = RedisModule_LoadUnsigned(rdb);
+	switch(t) {
+	case T_INT64:
+		return SI_LongVal(RedisModule_LoadSigned(rdb));
+	case T_DOUBLE:
+		return SI_DoubleVal(RedisModule_LoadDouble(rdb));
+	case T_STRING:
+		// Transfer ownership of the heap-allocated string to the
+		// newly-created SIValue
+		return SI_TransferStringVal(RedisModule_LoadStringBuffer(rdb, NULL));
+	case T_BOOL:
+		return SI_BoolVal(RedisModule_LoadSigned(rdb));
+	case T_ARRAY:
+		return _RdbLoadSIArray(rdb);
+	case T_NULL:
+	default: // currently impossible
+		return SI_NullVal();
+	}
+}
+
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb) {
+	/* loads array as
+	   unsinged : array legnth
+	   array[0]
+	   .
+	   .
+	   .
+	   array[array length -1]
+	 */
+	uint arrayLen = RedisModule_LoadUnsigned(rdb);
+	SIValue list = SI_Array(arrayLen);
+	for(uint i = 0; i < arrayLen; i++) {
+		SIArray_Append(&list, _RdbLoadSIValue(rdb));
+	}
+	return list;
+}
+
+static void _RdbLoadEntity(RedisModuleIO *rdb, GraphContext *gc, GraphEntity *e) {
+	/* Format:
+	 * #properties N
+	 * (name, value type, value) X N
+	*/
+	uint64_t propCount = RedisModule_LoadUnsigned(rdb);
+	if(propCount == 0) return;
+
+	// Property count is read from the RDB, buffers are allocated on the heap.
+	Attribute_ID *attr_ids = rm_malloc(sizeof(Attribute_ID) * propCount);
+	SIValue *attr_values = rm_malloc(sizeof(SIValue) * propCount);
+	for(uint64_t i = 0; i < propCount; i++) {
+		attr_ids[i] = RedisModule_LoadUnsigned(rdb);
+		attr_values[i] = _RdbLoadSIValue(rdb);
+	}
+
+	// Add all properties at once.
+	GraphEntity_AddProperties(e, attr_ids, attr_values, propCount);
+	for(uint64_t i = 0; i < propCount; i++) SIValue_Free(attr_values[i]);
+	rm_free(attr_ids);
+	rm_free(attr_values);
+}
+
+
+void RdbLoadNodes_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t node_count) {
+	/* Node Format:
+	 *      ID
+	 *      #labels M
+	 *      (labels) X M
+	 *      #properties N
+	 *      (name, value type, value) X N
+	 */
+
+	for(uint64_t i = 0; i < node_count; i++) {
+		Node n;
+		NodeID id = RedisModule_LoadUnsigned(rdb);
+
+		// Extend this logic when multi-label support is added.
+		// #labels M
+		uint64_t nodeLabelCount = RedisModule_LoadUnsigned(rdb);
+
+		// * (labels) x M
+		// M will currently always be 0 or 1
+		// Label matrices are decoded as a whole, skip the label.
+		if(nodeLabelCount) RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_SetNode(gc->g, id, GRAPH_NO_LABEL, &n);
+
+		_RdbLoadEntity(rdb, gc, (GraphEntity *)&n);
+	}
+}
+
+void RdbLoadDeletedNodes_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t deleted_node_count) {
+	/* Format:
+	* node id X N */
+	for(uint64_t i = 0; i < deleted_node_count; i++) {
+		NodeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkNodeDeleted(gc->g, id);
+	}
+}
+
+void RdbLoadEdges_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t edge_count) {
+	/* Format:
+	 * {
+	 *  edge ID
+	 *  source node ID
+	 *  destination node ID
+	 *  relation type
+	 * } X N
+	 * edge properties X N */
+
+	// Connections are restored by the relation matrices, only allocate edges.
+	for(uint64_t i = 0; i < edge_count; i++) {
+		Edge e;
+		EdgeID edgeId = RedisModule_LoadUnsigned(rdb);
+		RedisModule_LoadUnsigned(rdb); // Source node ID.
+		RedisModule_LoadUnsigned(rdb); // Destination node ID.
+		RedisModule_LoadUnsigned(rdb); // Relation type.
+		Serializer_Graph_AllocateEdge(gc->g, edgeId, &e);
+		_RdbLoadEntity(rdb, gc, (GraphEntity *)&e);
+	}
+}
+
+void RdbLoadDeletedEdges_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t deleted_edge_count) {
+	/* Format:
+	 * edge id X N */
+	for(uint64_t i = 0; i < deleted_edge_count; i++) {
+		EdgeID id = RedisModule_LoadUnsigned(rdb);
+		Serializer_Graph_MarkEdgeDeleted(gc->g, id);
+	}
+}
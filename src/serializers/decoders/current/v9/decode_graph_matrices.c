@@ -0,0 +1,88 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "decode_v9.h"
+
+static void _RdbLoadMultipleEdges(RedisModuleIO *rdb, uint64_t *Ax) {
+	/* Format:
+	 * #multi-edge entries M
+	 * (entry position, #edges N, edge ID X N) X M */
+
+	uint64_t multi_edge_count = RedisModule_LoadUnsigned(rdb);
+	for(uint64_t i = 0; i < multi_edge_count; i++) {
+		GrB_Index k = RedisModule_LoadUnsigned(rdb);
+		uint64_t edge_count = RedisModule_LoadUnsigned(rdb);
+		EdgeID *ids = array_new(EdgeID, edge_count);
+		for(uint64_t j = 0; j < edge_count; j++) {
+			ids = array_append(ids, RedisModule_LoadUnsigned(rdb));
+		}
+		// Replace the stale entry with the newly constructed edge array.
+		Ax[k] = (uint64_t)ids;
+	}
+}
+
+static GrB_Matrix _RdbLoadMatrix(RedisModuleIO *rdb, GrB_Type type, bool relation) {
+	/* Format:
+	 * #rows
+	 * #columns
+	 * #entries N
+	 * row pointers (blob)
+	 * column indices (blob), if N > 0
+	 * values (blob), if N > 0
+	 * multi-edge entries, relation matrices only */
+
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Index nrows = RedisModule_LoadUnsigned(rdb);
+	GrB_Index ncols = RedisModule_LoadUnsigned(rdb);
+	GrB_Index nvals = RedisModule_LoadUnsigned(rdb);
+
+	// Blobs are allocated by the module allocator, which GraphBLAS shares,
+	// ownership is handed over to the imported matrix without copying.
+	GrB_Index *Ap = (GrB_Index *)RedisModule_LoadStringBuffer(rdb, NULL);
+	GrB_Index *Aj = NULL;
+	void *Ax = NULL;
+	if(nvals > 0) {
+		Aj = (GrB_Index *)RedisModule_LoadStringBuffer(rdb, NULL);
+		Ax = RedisModule_LoadStringBuffer(rdb, NULL);
+	}
+
+	if(relation) _RdbLoadMultipleEdges(rdb, (uint64_t *)Ax);
+
+	GrB_Matrix A;
+	if(nvals == 0) {
+		RedisModule_Free(Ap);
+		info = GrB_Matrix_new(&A, type, nrows, ncols);
+	} else {
+		info = GxB_Matrix_import_CSR(&A, type, nrows, ncols, nvals, -1, &Ap, &Aj, &Ax, GrB_NULL);
+	}
+	ASSERT(info == GrB_SUCCESS);
+
+	return A;
+}
+
+void RdbLoadMatrices_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t matrix_count) {
+	/* Format:
+	 * (matrix index, matrix) X matrix_count
+	 *
+	 * Index 0 is the adjacency matrix, followed by the label matrices
+	 * and the relation matrices. */
+
+	Graph *g = gc->g;
+	uint64_t label_count = Graph_LabelTypeCount(g);
+
+	for(uint64_t i = 0; i < matrix_count; i++) {
+		uint64_t idx = RedisModule_LoadUnsigned(rdb);
+		if(idx == 0) {
+			Serializer_Graph_SetAdjacencyMatrix(g, _RdbLoadMatrix(rdb, GrB_BOOL, false));
+		} else if(idx <= label_count) {
+			Serializer_Graph_SetLabelMatrix(g, idx - 1, _RdbLoadMatrix(rdb, GrB_BOOL, false));
+		} else {
+			Serializer_Graph_SetRelationMatrix(g, idx - 1 - label_count,
+											   _RdbLoadMatrix(rdb, GrB_UINT64, true));
+		}
+	}
+}
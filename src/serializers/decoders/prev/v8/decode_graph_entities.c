@@ -56,13 +56,21 @@ static void _RdbLoadEntity(RedisModuleIO *rdb, GraphContext *gc, GraphEntity *e)
 	 * (name, value type, value) X N
 	*/
 	uint64_t propCount = RedisModule_LoadUnsigned(rdb);
-
-	for(int i = 0; i < propCount; i++) {
-		Attribute_ID attr_id = RedisModule_LoadUnsigned(rdb);
-		SIValue attr_value = _RdbLoadSIValue(rdb);
-		GraphEntity_AddProperty(e, attr_id, attr_value);
-		SIValue_Free(attr_value);
+	if(propCount == 0) return;
+
+	// Property count is read from the RDB, buffers are allocated on the heap.
+	Attribute_ID *attr_ids = rm_malloc(sizeof(Attribute_ID) * propCount);
+	SIValue *attr_values = rm_malloc(sizeof(SIValue) * propCount);
+	for(uint64_t i = 0; i < propCount; i++) {
+		attr_ids[i] = RedisModule_LoadUnsigned(rdb);
+		attr_values[i] = _RdbLoadSIValue(rdb);
 	}
+
+	// Add all properties at once.
+	GraphEntity_AddProperties(e, attr_ids, attr_values, propCount);
+	for(uint64_t i = 0; i < propCount; i++) SIValue_Free(attr_values[i]);
+	rm_free(attr_ids);
+	rm_free(attr_values);
 }
 
 
@@ -4,7 +4,7 @@
 * This file is available under the Redis Labs Source Available License Agreement
 */
 
-#include "encode_v8.h"
+#include "encode_v9.h"
 
 extern bool process_is_child; // Global variable declared in module.c
 
@@ -74,6 +74,10 @@ static PayloadInfo _StatePayloadInfo(GraphContext *gc, EncodeState state,
 	case ENCODE_STATE_GRAPH_SCHEMA:
 		required_entities_count = 1;
 		break;
+	case ENCODE_STATE_MATRICES:
+		// Adjacency matrix, label matrices and relation matrices.
+		required_entities_count = 1 + Graph_LabelTypeCount(gc->g) + Graph_RelationTypeCount(gc->g);
+		break;
 	default:
 		ASSERT(false && "Unknown encoding state in _CurrentStatePayloadInfo");
 		break;
@@ -144,12 +148,12 @@ static PayloadInfo *_RdbSaveKeySchema(RedisModuleIO *rdb, GraphContext *gc) {
 	return payloads;
 }
 
-void RdbSaveGraph_v8(RedisModuleIO *rdb, void *value) {
+void RdbSaveGraph_v9(RedisModuleIO *rdb, void *value) {
 	/* Encoding format for graph context and graph meta key:
 	 *  Header
 	 *  Payload(s) count: N
 	 *  Key content X N:
-	 *      Payload type (Nodes / Edges / Deleted nodes/ Deleted edges/ Graph schema)
+	 *      Payload type (Nodes / Edges / Deleted nodes/ Deleted edges/ Graph schema / Matrices)
 	 *      Entities in payload
 	 *  Payload(s) X N
 	 *
@@ -158,7 +162,8 @@ void RdbSaveGraph_v8(RedisModuleIO *rdb, void *value) {
 	 * 2. Deleted nodes
 	 * 3. Edges
 	 * 4. Deleted edges
-	 * 5. Graph schema.
+	 * 5. Graph schema
+	 * 6. Matrices.
 	 *
 	 * Each payload type can spread over one or more keys. For example: A graph with 200,000 nodes, and the number of entities per payload
 	 * is 100,000 then there will be two nodes payloads, each containing 100,000 nodes, encoded into two different RDB meta keys.
@@ -189,19 +194,22 @@ void RdbSaveGraph_v8(RedisModuleIO *rdb, void *value) {
 		PayloadInfo payload = key_schema[i];
 		switch(payload.state) {
 		case ENCODE_STATE_NODES:
-			RdbSaveNodes_v8(rdb, gc, payload.entities_count);
+			RdbSaveNodes_v9(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_NODES:
-			RdbSaveDeletedNodes_v8(rdb, gc, payload.entities_count);
+			RdbSaveDeletedNodes_v9(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_EDGES:
-			RdbSaveEdges_v8(rdb, gc, payload.entities_count);
+			RdbSaveEdges_v9(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_EDGES:
-			RdbSaveDeletedEdges_v8(rdb, gc, payload.entities_count);
+			RdbSaveDeletedEdges_v9(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_GRAPH_SCHEMA:
-			RdbSaveGraphSchema_v8(rdb, gc);
+			RdbSaveGraphSchema_v9(rdb, gc);
+			break;
+		case ENCODE_STATE_MATRICES:
+			RdbSaveMatrices_v9(rdb, gc, payload.entities_count);
 			break;
 		default:
 			ASSERT(false && "Unknown encoding phase");
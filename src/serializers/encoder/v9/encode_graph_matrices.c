@@ -0,0 +1,105 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "encode_v9.h"
+
+static void _RdbSaveMultipleEdges(RedisModuleIO *rdb, const uint64_t *Ax, GrB_Index nvals) {
+	/* Format:
+	 * #multi-edge entries M
+	 * (entry position, #edges N, edge ID X N) X M */
+
+	GrB_Index multi_edge_count = 0;
+	for(GrB_Index k = 0; k < nvals; k++) {
+		if(!(SINGLE_EDGE(Ax[k]))) multi_edge_count++;
+	}
+	RedisModule_SaveUnsigned(rdb, multi_edge_count);
+
+	for(GrB_Index k = 0; k < nvals && multi_edge_count > 0; k++) {
+		if(SINGLE_EDGE(Ax[k])) continue;
+		EdgeID *ids = (EdgeID *)Ax[k];
+		uint edge_count = array_len(ids);
+		RedisModule_SaveUnsigned(rdb, k);
+		RedisModule_SaveUnsigned(rdb, edge_count);
+		for(uint i = 0; i < edge_count; i++) RedisModule_SaveUnsigned(rdb, ids[i]);
+		multi_edge_count--;
+	}
+}
+
+static void _RdbSaveMatrix(RedisModuleIO *rdb, uint64_t idx, GrB_Matrix M, bool relation) {
+	/* Format:
+	 * matrix index
+	 * #rows
+	 * #columns
+	 * #entries N
+	 * row pointers (blob)
+	 * column indices (blob), if N > 0
+	 * values (blob), if N > 0
+	 * multi-edge entries, relation matrices only */
+
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Type type;
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Index nvals;
+	int64_t nonempty;
+	GrB_Index *Ap = NULL;
+	GrB_Index *Aj = NULL;
+	void *Ax = NULL;
+	size_t type_size;
+
+	// Exporting hands over the matrix content, export a copy.
+	GrB_Matrix A;
+	info = GrB_Matrix_dup(&A, M);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_export_CSR(&A, &type, &nrows, &ncols, &nvals, &nonempty, &Ap, &Aj, &Ax,
+								 GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	GxB_Type_size(&type_size, type);
+
+	RedisModule_SaveUnsigned(rdb, idx);
+	RedisModule_SaveUnsigned(rdb, nrows);
+	RedisModule_SaveUnsigned(rdb, ncols);
+	RedisModule_SaveUnsigned(rdb, nvals);
+	RedisModule_SaveStringBuffer(rdb, (const char *)Ap, sizeof(GrB_Index) * (nrows + 1));
+	if(nvals > 0) {
+		RedisModule_SaveStringBuffer(rdb, (const char *)Aj, sizeof(GrB_Index) * nvals);
+		RedisModule_SaveStringBuffer(rdb, (const char *)Ax, type_size * nvals);
+	}
+
+	// Edge arrays are referenced by pointer, their IDs are saved separately.
+	if(relation) _RdbSaveMultipleEdges(rdb, (const uint64_t *)Ax, nvals);
+
+	rm_free(Ap);
+	rm_free(Aj);
+	rm_free(Ax);
+}
+
+void RdbSaveMatrices_v9(RedisModuleIO *rdb, GraphContext *gc, uint64_t matrices_to_encode) {
+	/* Format:
+	 * Matrix format * matrices_to_encode
+	 *
+	 * Matrices are encoded in the following order:
+	 * 1. Adjacency matrix
+	 * 2. Label matrices
+	 * 3. Relation matrices
+	 * Transposed matrices are recomputed when decoding. */
+
+	if(matrices_to_encode == 0) return;
+	// Get the number of matrices already encoded.
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+	uint64_t label_count = Graph_LabelTypeCount(gc->g);
+
+	for(uint64_t i = offset; i < offset + matrices_to_encode; i++) {
+		if(i == 0) {
+			_RdbSaveMatrix(rdb, i, Graph_GetAdjacencyMatrix(gc->g), false);
+		} else if(i <= label_count) {
+			_RdbSaveMatrix(rdb, i, Graph_GetLabelMatrix(gc->g, i - 1), false);
+		} else {
+			_RdbSaveMatrix(rdb, i, Graph_GetRelationMatrix(gc->g, i - 1 - label_count), true);
+		}
+	}
+}
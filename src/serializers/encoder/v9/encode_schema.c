@@ -4,7 +4,7 @@
 * This file is available under the Redis Labs Source Available License Agreement
 */
 
-#include "encode_v8.h"
+#include "encode_v9.h"
 
 static void _RdbSaveAttributeKeys(RedisModuleIO *rdb, GraphContext *gc) {
 	/* Format:
@@ -52,9 +52,12 @@ static void _RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 
 	// Fulltext indices.
 	_RdbSaveIndexData(rdb, s->fulltextIdx);
+
+	// Range indices, fields are saved in key order.
+	_RdbSaveIndexData(rdb, s->rangeIdx);
 }
 
-void RdbSaveGraphSchema_v8(RedisModuleIO *rdb, GraphContext *gc) {
+void RdbSaveGraphSchema_v9(RedisModuleIO *rdb, GraphContext *gc) {
 	/* Format:
 	 * attribute keys (unified schema)
 	 * #node schemas
@@ -6,6 +6,6 @@
 
 #pragma once
 
-#define GRAPH_ENCODING_VERSION_LATEST 8 // Latest RDB encoding version.
+#define GRAPH_ENCODING_VERSION_LATEST 9 // Latest RDB encoding version.
 #define GRAPHCONTEXT_TYPE_DECODE_MIN_V 4 // Lowest version that has backwards-compatibility decoding routines for graphcontext type.
 #define GRAPHMETA_TYPE_DECODE_MIN_V 7    // Lowest version that has backwards-compatibility decoding routines for graphmeta type.
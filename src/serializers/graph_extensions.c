@@ -6,10 +6,14 @@
 
 #include "graph_extensions.h"
 #include "../RG.h"
+#include "../config.h"
+#include "../util/arr.h"
 #include "../util/datablock/oo_datablock.h"
 
 // Functions declerations - implemented in graph.c
 void Graph_FormConnection(Graph *g, NodeID src, NodeID dest, EdgeID edge_id, int r);
+void Graph_AccumRelationDegrees(Graph *g, int r, GrB_Matrix A, bool remove);
+void Graph_UpdateLabelNodeCount(Graph *g, int label, int64_t delta);
 
 inline void Serializer_Graph_MarkEdgeDeleted(Graph *g, EdgeID id) {
 	DataBlock_MarkAsDeletedOutOfOrder(g->edges, id);
@@ -31,22 +35,107 @@ void Serializer_Graph_SetNode(Graph *g, NodeID id, int label, Node *n) {
 		// Set matrix at position [id, id]
 		GrB_Matrix m = Graph_GetLabelMatrix(g, label);
 		GrB_Matrix_setElement_BOOL(m, true, id, id);
+		Graph_UpdateLabelNodeCount(g, label, 1);
 	}
 }
 
 // Set a given edge in the graph - Used for deserialization of graph.
 void Serializer_Graph_SetEdge(Graph *g, EdgeID edge_id, NodeID src, NodeID dest, int r, Edge *e) {
-	GrB_Info info;
+	Serializer_Graph_AllocateEdge(g, edge_id, e);
+	e->relationID = r;
+	e->srcNodeID = src;
+	e->destNodeID = dest;
+	Graph_FormConnection(g, src, dest, edge_id, r);
+}
 
+// Allocates a given edge entity without connecting it.
+void Serializer_Graph_AllocateEdge(Graph *g, EdgeID edge_id, Edge *e) {
 	Entity *en = DataBlock_AllocateItemOutOfOrder(g->edges, edge_id);
 	en->prop_count = 0;
 	en->properties = NULL;
 	e->id = edge_id;
 	e->entity = en;
-	e->relationID = r;
-	e->srcNodeID = src;
-	e->destNodeID = dest;
-	Graph_FormConnection(g, src, dest, edge_id, r);
+}
+
+// Replaces the GraphBLAS matrix held by m, taking ownership of M.
+static void _Serializer_RG_Matrix_Set(RG_Matrix m, GrB_Matrix M) {
+	GrB_Matrix_free(&m->grb_matrix);
+	m->grb_matrix = M;
+	// Dimensions may differ from the graph's, force synchronization.
+	m->synced_dim = RG_MATRIX_DIRTY;
+}
+
+void Serializer_Graph_SetAdjacencyMatrix(Graph *g, GrB_Matrix M) {
+	_Serializer_RG_Matrix_Set(g->adjacency_matrix, M);
+}
+
+void Serializer_Graph_SetLabelMatrix(Graph *g, int label, GrB_Matrix M) {
+	ASSERT(label < Graph_LabelTypeCount(g));
+	_Serializer_RG_Matrix_Set(g->labels[label], M);
+
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, M);
+	Graph_UpdateLabelNodeCount(g, label, nvals);
+}
+
+void Serializer_Graph_SetRelationMatrix(Graph *g, int r, GrB_Matrix M) {
+	ASSERT(r < Graph_RelationTypeCount(g));
+	_Serializer_RG_Matrix_Set(g->relations[r], M);
+	Graph_AccumRelationDegrees(g, r, M, false);
+}
+
+// Unary operator giving each transposed multi-edge entry its own edge array.
+static void _CloneEdgeArray(void *z, const void *x) {
+	EdgeID id = *(const EdgeID *)x;
+	if(!(SINGLE_EDGE(id))) {
+		EdgeID *ids;
+		array_clone(ids, (EdgeID *)id);
+		id = (EdgeID)ids;
+	}
+	*(EdgeID *)z = id;
+}
+
+// Returns a new matrix holding the transpose of M.
+static GrB_Matrix _Serializer_Transpose(GrB_Matrix M, GrB_Type type) {
+	GrB_Info info;
+	UNUSED(info);
+	GrB_Index nrows;
+	GrB_Index ncols;
+	GrB_Matrix_nrows(&nrows, M);
+	GrB_Matrix_ncols(&ncols, M);
+
+	GrB_Matrix T;
+	info = GrB_Matrix_new(&T, type, ncols, nrows);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_transpose(T, GrB_NULL, GrB_NULL, M, GrB_NULL);
+	ASSERT(info == GrB_SUCCESS);
+	return T;
+}
+
+void Serializer_Graph_ComputeTransposedMatrices(Graph *g) {
+	GrB_Matrix adj = g->adjacency_matrix->grb_matrix;
+	_Serializer_RG_Matrix_Set(g->_t_adjacency_matrix, _Serializer_Transpose(adj, GrB_BOOL));
+
+	bool maintain_transpose;
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
+	if(!maintain_transpose) return;
+
+	GrB_Info info;
+	UNUSED(info);
+	GrB_UnaryOp clone_op;
+	info = GrB_UnaryOp_new(&clone_op, _CloneEdgeArray, GrB_UINT64, GrB_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint relation_count = Graph_RelationTypeCount(g);
+	for(uint i = 0; i < relation_count; i++) {
+		GrB_Matrix TR = _Serializer_Transpose(g->relations[i]->grb_matrix, GrB_UINT64);
+		// Transposed relation matrices own their edge arrays.
+		info = GrB_Matrix_apply(TR, GrB_NULL, GrB_NULL, clone_op, TR, GrB_NULL);
+		ASSERT(info == GrB_SUCCESS);
+		_Serializer_RG_Matrix_Set(g->t_relations[i], TR);
+	}
+
+	GrB_free(&clone_op);
 }
 
 
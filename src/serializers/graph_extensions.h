@@ -14,6 +14,21 @@ void Serializer_Graph_SetNode(Graph *g, NodeID id, int label, Node *n);
 // Set a given edge in the graph.
 void Serializer_Graph_SetEdge(Graph *g, EdgeID edge_id, NodeID src, NodeID dest, int r, Edge *e);
 
+// Allocates a given edge entity without connecting it.
+void Serializer_Graph_AllocateEdge(Graph *g, EdgeID edge_id, Edge *e);
+
+// Replaces the adjacency matrix, the graph takes ownership of M.
+void Serializer_Graph_SetAdjacencyMatrix(Graph *g, GrB_Matrix M);
+
+// Replaces a label matrix, the graph takes ownership of M.
+void Serializer_Graph_SetLabelMatrix(Graph *g, int label, GrB_Matrix M);
+
+// Replaces a relation matrix, the graph takes ownership of M.
+void Serializer_Graph_SetRelationMatrix(Graph *g, int r, GrB_Matrix M);
+
+// Computes the transposed adjacency and relation matrices from their originals.
+void Serializer_Graph_ComputeTransposedMatrices(Graph *g);
+
 // Marks a node ID as deleted.
 void Serializer_Graph_MarkNodeDeleted(Graph *g, NodeID ID);
 
@@ -68,6 +68,15 @@ static int _GraphContextType_AuxLoad(RedisModuleIO *rdb, int encver, int when) {
 	return REDISMODULE_OK;
 };
 
+static size_t _GraphContextType_MemUsage(const void *value) {
+	const GraphContext *gc = value;
+	// Called from the main thread, concurrently with queries.
+	Graph_AcquireReadLock(gc->g);
+	size_t usage = sizeof(GraphContext) + Graph_MemoryUsage(gc->g);
+	Graph_ReleaseLock(gc->g);
+	return usage;
+}
+
 static void _GraphContextType_Free(void *value) {
 	GraphContext *gc = value;
 	GraphContext_Delete(gc);
@@ -78,6 +87,7 @@ int GraphContextType_Register(RedisModuleCtx *ctx) {
 								 .rdb_load = _GraphContextType_RdbLoad,
 								 .rdb_save = _GraphContextType_RdbSave,
 								 .aof_rewrite = _GraphContextType_AofRewrite,
+								 .mem_usage = _GraphContextType_MemUsage,
 								 .free = _GraphContextType_Free,
 								};
 
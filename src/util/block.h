@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <sys/types.h>
 
@@ -14,6 +15,8 @@
 typedef struct Block {
 	size_t itemSize;        // Size of a single item in bytes.
 	struct Block *next;     // Pointer to next block.
+	uint64_t modified;      // Version of the owning container which last modified block.
+	uint refcount;          // Number of snapshots sharing a copied block.
 	unsigned char data[];   // Item array. MUST BE LAST MEMBER OF THE STRUCT!
 } Block;
 
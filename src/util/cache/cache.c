@@ -6,29 +6,64 @@
 
 #include "cache.h"
 #include "RG.h"
+#include "xxhash.h"
 #include "../rmalloc.h"
 #include "cache_array.h"
-#include <pthread.h>
-#include <stdatomic.h>
 
+// Returns the shard key is mapped to.
+static inline CacheShard *_Cache_GetShard(Cache *cache, const char *key, size_t key_len) {
+	XXH64_hash_t hash = XXH64(key, key_len, 0);
+	return cache->shards + (hash % CACHE_SHARD_COUNT);
+}
+
+static void _Cache_ShardLock(CacheShard *shard, bool write) {
+	int res = (write) ? pthread_rwlock_wrlock(&shard->_shard_rwlock) :
+			  pthread_rwlock_rdlock(&shard->_shard_rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+}
+
+static void _Cache_ShardUnlock(CacheShard *shard) {
+	int res = pthread_rwlock_unlock(&shard->_shard_rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+}
+
+/* Increments a statistics counter without a locked instruction,
+ * increments racing on the same counter may be lost. */
+static inline void _Cache_Count(uint64_t *counter) {
+	__atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+}
+
+// Assumes cache mutex is held.
 static CacheEntry *_CacheEvictLRU(Cache *cache) {
 	CacheEntry *entry = CacheArray_FindMinLRU(cache->arr, cache->cap);
-	// Remove evicted element from the rax.
-	raxRemove(cache->lookup, (unsigned  char *)entry->key,
-	  strlen(entry->key), NULL);
+	size_t key_len = strlen(entry->key);
+	CacheShard *shard = _Cache_GetShard(cache, entry->key, key_len);
+
+	/* Remove evicted element from its shard, readers of the shard
+	 * might be copying the evicted value. */
+	_Cache_ShardLock(shard, true);
+	raxRemove(shard->lookup, (unsigned char *)entry->key, key_len, NULL);
+	_Cache_ShardUnlock(shard);
+
 	CacheArray_CleanEntry(entry, cache->free_item);
+	__atomic_add_fetch(&cache->evictions, 1, __ATOMIC_RELAXED);
 
 	return entry;
 }
 
+// Assumes cache mutex is held.
 static bool _Cache_SetValue(Cache *cache, const char *key, void *value,
   		size_t key_len) {
 	ASSERT(key != NULL);
 	ASSERT(cache != NULL);
 
 	/* in case that another working thread had already inserted the item to the
-	 * cache, no need to re-insert it */
-	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key, key_len);
+	 * cache, no need to re-insert it
+	 * insertions are serialized, the shard can be searched without locking it */
+	CacheShard *shard = _Cache_GetShard(cache, key, key_len);
+	CacheEntry *entry = raxFind(shard->lookup, (unsigned char *)key, key_len);
 	if(entry != raxNotFound) {
 		return false;
 	}
@@ -45,12 +80,13 @@ static bool _Cache_SetValue(Cache *cache, const char *key, void *value,
 
 	// populate the entry
 	char *k = rm_strdup(key);
-	cache->counter++;
-	CacheArray_PopulateEntry(cache->counter, entry, k, value);
+	long long counter = __atomic_add_fetch(&cache->counter, 1, __ATOMIC_RELAXED);
+	CacheArray_PopulateEntry(counter, entry, k, value);
 
-
-	// Add the new entry to the rax.
-	raxInsert(cache->lookup, (unsigned char *)key, key_len, entry, NULL);
+	// Add the new entry to its shard.
+	_Cache_ShardLock(shard, true);
+	raxInsert(shard->lookup, (unsigned char *)key, key_len, entry, NULL);
+	_Cache_ShardUnlock(shard);
 
 	return true;
 }
@@ -62,15 +98,26 @@ Cache *Cache_New(uint cap, CacheEntryFreeFunc freeFunc, CacheEntryCopyFunc copyF
 	Cache *cache     = rm_malloc(sizeof(Cache));
 	cache->cap       = cap;
 	cache->size      = 0;
-	cache->lookup    = raxNew();       // Instantiate key entry mapping.
 	cache->counter   = 0;             // Initialize counter to zero.
+	cache->evictions = 0;
 	cache->copy_item = copyFunc;
 	cache->free_item = freeFunc;
 	cache->arr = rm_calloc(cap, sizeof(CacheEntry)); // Array of cached values.
 
-	// Initialize the read-write lock to protect access to the cache.
-	int res = pthread_rwlock_init(&cache->_cache_rwlock, NULL);
+	int res;
 	UNUSED(res);
+	for(uint i = 0; i < CACHE_SHARD_COUNT; i++) {
+		CacheShard *shard = cache->shards + i;
+		shard->hits   = 0;
+		shard->misses = 0;
+		shard->lookup = raxNew();       // Instantiate key entry mapping.
+
+		// Initialize the read-write lock to protect access to the shard.
+		res = pthread_rwlock_init(&shard->_shard_rwlock, NULL);
+		ASSERT(res == 0);
+	}
+
+	res = pthread_mutex_init(&cache->_cache_mutex, NULL);
 	ASSERT(res == 0);
 
 	return cache;
@@ -81,26 +128,31 @@ void *Cache_GetValue(Cache *cache, const char *key) {
 
 	ASSERT(cache != NULL);
 
-	int res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
-	UNUSED(res);
-	ASSERT(res == 0);
-
 	size_t key_len = strlen(key);
-	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key, key_len);
+	CacheShard *shard = _Cache_GetShard(cache, key, key_len);
+	_Cache_ShardLock(shard, false);
 
-	if(entry == raxNotFound) goto cleanup;
+	CacheEntry *entry = raxFind(shard->lookup, (unsigned char *)key, key_len);
+
+	if(entry == raxNotFound) {
+		_Cache_Count(&shard->misses);
+		goto cleanup;
+	}
 
 	/* element is now the most recently used; update its LRU
-	 * note that multiple threads can be here simultaneously */
-	cache->counter++;
-	entry->LRU = cache->counter;
+	 * note that multiple threads can be here simultaneously
+	 * the clock is advanced by every hit, such that eviction can tell
+	 * entries apart by their last use, concurrent hits may share a tick */
+	long long counter = __atomic_load_n(&cache->counter, __ATOMIC_RELAXED) + 1;
+	__atomic_store_n(&cache->counter, counter, __ATOMIC_RELAXED);
+	__atomic_store_n(&entry->LRU, counter, __ATOMIC_RELAXED);
+	_Cache_Count(&shard->hits);
 
 	// return a copy of element
 	item = cache->copy_item(entry->value);
 
 cleanup:
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
-	ASSERT(res == 0);
+	_Cache_ShardUnlock(shard);
 	return item;
 }
 
@@ -110,15 +162,15 @@ void Cache_SetValue(Cache *cache, const char *key, void *value) {
 
 	size_t key_len = strlen(key);
 
-	// Acquire WRITE lock
-	int res = pthread_rwlock_wrlock(&cache->_cache_rwlock);
+	// Acquire cache mutex
+	int res = pthread_mutex_lock(&cache->_cache_mutex);
 	UNUSED(res);
 	ASSERT(res == 0);
 
 	// Insert the value to the cache.
 	_Cache_SetValue(cache, key, value, key_len);
 
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	res = pthread_mutex_unlock(&cache->_cache_mutex);
 	ASSERT(res == 0);
 }
 
@@ -129,8 +181,8 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 	size_t key_len = strlen(key);
 	void *value_to_return = value;
 
-	// acquire WRITE lock
-	int res = pthread_rwlock_wrlock(&cache->_cache_rwlock);
+	// acquire cache mutex
+	int res = pthread_mutex_lock(&cache->_cache_mutex);
 	UNUSED(res);
 	ASSERT(res == 0);
 
@@ -140,12 +192,26 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 		value_to_return = cache->copy_item(value);
 	}
 
-	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	res = pthread_mutex_unlock(&cache->_cache_mutex);
 	ASSERT(res == 0);
 
 	return value_to_return;
 }
 
+CacheStats Cache_GetStats(Cache *cache) {
+	ASSERT(cache != NULL);
+
+	CacheStats stats = {0};
+	for(uint i = 0; i < CACHE_SHARD_COUNT; i++) {
+		CacheShard *shard = cache->shards + i;
+		stats.hits   += __atomic_load_n(&shard->hits, __ATOMIC_RELAXED);
+		stats.misses += __atomic_load_n(&shard->misses, __ATOMIC_RELAXED);
+	}
+	stats.evictions = __atomic_load_n(&cache->evictions, __ATOMIC_RELAXED);
+
+	return stats;
+}
+
 void Cache_Free(Cache *cache) {
 	ASSERT(cache != NULL);
 
@@ -157,12 +223,18 @@ void Cache_Free(Cache *cache) {
 	}
 
 	rm_free(cache->arr);
-	raxFree(cache->lookup);
 
-	int res = pthread_rwlock_destroy(&cache->_cache_rwlock);
+	int res;
 	UNUSED(res);
+	for(uint i = 0; i < CACHE_SHARD_COUNT; i++) {
+		CacheShard *shard = cache->shards + i;
+		raxFree(shard->lookup);
+		res = pthread_rwlock_destroy(&shard->_shard_rwlock);
+		ASSERT(res == 0);
+	}
+
+	res = pthread_mutex_destroy(&cache->_cache_mutex);
 	ASSERT(res == 0);
 
 	rm_free(cache);
 }
-
@@ -8,20 +8,47 @@
 
 #include "cache_array.h"
 #include "rax.h"
+#include <pthread.h>
+
+// Number of shards a cache's key lookup is divided into.
+#define CACHE_SHARD_COUNT 16
+
+/**
+ * @brief Cache shard, maps a subset of the cache keys to their entries.
+ * Readers of different shards never contend over a lock.
+ */
+typedef struct {
+	rax *lookup;                       // Mapping between keys to entries, for fast lookups.
+	uint64_t hits;                     // Approximate number of lookups which found their key.
+	uint64_t misses;                   // Approximate number of lookups which did not find their key.
+	pthread_rwlock_t _shard_rwlock;    // Read-write lock to protect access to the shard.
+} CacheShard;
+
+/**
+ * @brief Cache usage statistics.
+ */
+typedef struct {
+	uint64_t hits;                     // Number of lookups which found their key.
+	uint64_t misses;                   // Number of lookups which did not find their key.
+	uint64_t evictions;                // Number of entries evicted.
+} CacheStats;
 
 /**
  * @brief Key-value cache, uses LRU policy for eviction.
  * Assumes owership over stored objects.
+ * Keys are distributed across shards, each guarded by its own lock,
+ * while eviction considers all entries.
  */
 typedef struct Cache {
 	uint cap;                          // Cache capacity.
 	uint size;                         // Cache current size.
-	long long counter;                 // Atomic counter for number of reads.
-	rax *lookup;                       // Mapping between keys to entries, for fast lookups.
+	long long counter;                 // Logical clock, advanced by each insertion and hit.
+	uint64_t evictions;                // Number of entries evicted.
 	CacheEntry *arr;                   // Array of cache elements.
 	CacheEntryFreeFunc free_item;      // Callback function that free cached value.
 	CacheEntryCopyFunc copy_item;      // Callback function that copies cached value.
-	pthread_rwlock_t _cache_rwlock;    // Read-write lock to protect access to the cache.
+	CacheShard shards[CACHE_SHARD_COUNT]; // Key lookup shards.
+	pthread_mutex_t _cache_mutex;      // Serializes insertions and evictions.
 } Cache;
 
 /**
@@ -60,6 +87,14 @@ void Cache_SetValue(Cache *cache, const char *key, void *item);
  */
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value);
 
+/**
+ * @brief  Returns cache usage statistics, reported by INFO.
+ * @note   Concurrent lookups may go uncounted.
+ * @param  *cache: cache pointer.
+ * @retval Number of cache hits, misses and evictions.
+ */
+CacheStats Cache_GetStats(Cache *cache);
+
 /**
  * @brief  Destroys the cache and free all stored items.
  * @param  *cache: cache pointer
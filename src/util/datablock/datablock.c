@@ -10,6 +10,7 @@
 #include "../arr.h"
 #include "../rmalloc.h"
 #include <math.h>
+#include <string.h>
 #include <stdbool.h>
 
 // Computes the number of blocks required to accommodate n items.
@@ -24,13 +25,11 @@
 #define ITEM_POSITION_WITHIN_BLOCK(idx) \
     (idx % DATABLOCK_BLOCK_CAP)
 
-// Retrieves block in which item with index resides.
-#define GET_ITEM_BLOCK(dataBlock, idx) \
-    dataBlock->blocks[ITEM_INDEX_TO_BLOCK_INDEX(idx)]
-
 static void _DataBlock_AddBlocks(DataBlock *dataBlock, uint blockCount) {
 	ASSERT(dataBlock && blockCount > 0);
 
+	// Snapshots copy blocks while holding the mutex, don't move blocks array under them.
+	pthread_mutex_lock(&dataBlock->mutex);
 	uint prevBlockCount = dataBlock->blockCount;
 	dataBlock->blockCount += blockCount;
 	if(!dataBlock->blocks)
@@ -46,6 +45,7 @@ static void _DataBlock_AddBlocks(DataBlock *dataBlock, uint blockCount) {
 	dataBlock->blocks[i - 1]->next = NULL;
 
 	dataBlock->itemCap = dataBlock->blockCount * DATABLOCK_BLOCK_CAP;
+	pthread_mutex_unlock(&dataBlock->mutex);
 }
 
 // Checks to see if idx is within global array bounds
@@ -58,11 +58,45 @@ static inline bool _DataBlock_IndexOutOfBounds(const DataBlock *dataBlock, uint6
 
 static inline DataBlockItemHeader *DataBlock_GetItemHeader(const DataBlock *dataBlock,
 														   uint64_t idx) {
-	Block *block = GET_ITEM_BLOCK(dataBlock, idx);
+	Block *block = DataBlock_GetBlock(dataBlock, ITEM_INDEX_TO_BLOCK_INDEX(idx));
 	idx = ITEM_POSITION_WITHIN_BLOCK(idx);
 	return (DataBlockItemHeader *)block->data + (idx * block->itemSize);
 }
 
+// Returns a copy of block to be held by snapshot, deleted items aside
+// the resources of each item are copied as well.
+static Block *_DataBlock_CopyBlock(const DataBlock *snapshot, const Block *block) {
+	size_t size = sizeof(Block) + (DATABLOCK_BLOCK_CAP * block->itemSize);
+	Block *copy = rm_malloc(size);
+	memcpy(copy, block, size);
+	copy->next = NULL;
+	copy->modified = 0;
+	copy->refcount = 0;
+
+	if(snapshot->copy) {
+		for(uint i = 0; i < DATABLOCK_BLOCK_CAP; i++) {
+			DataBlockItemHeader *item_header = (DataBlockItemHeader *)copy->data + (i * copy->itemSize);
+			if(!IS_ITEM_DELETED(item_header)) snapshot->copy(ITEM_DATA(item_header));
+		}
+	}
+
+	return copy;
+}
+
+// Drops a snapshot's reference to a copied block,
+// the last snapshot holding the block frees it.
+static void _DataBlock_ReleaseBlock(const DataBlock *snapshot, Block *block) {
+	if(block == NULL || --block->refcount > 0) return;
+
+	if(snapshot->destructor) {
+		for(uint i = 0; i < DATABLOCK_BLOCK_CAP; i++) {
+			DataBlockItemHeader *item_header = (DataBlockItemHeader *)block->data + (i * block->itemSize);
+			if(!IS_ITEM_DELETED(item_header)) snapshot->destructor(ITEM_DATA(item_header));
+		}
+	}
+	Block_Free(block);
+}
+
 /* --------- DataBlock API implementation --------*/
 
 DataBlock *DataBlock_New(uint64_t itemCap, uint itemSize, fpDestructor fp) {
@@ -73,6 +107,10 @@ DataBlock *DataBlock_New(uint64_t itemCap, uint itemSize, fpDestructor fp) {
 	dataBlock->blocks = NULL;
 	dataBlock->deletedIdx = array_new(uint64_t, 128);
 	dataBlock->destructor = fp;
+	dataBlock->copy = NULL;
+	dataBlock->version = 0;
+	dataBlock->source = NULL;
+	dataBlock->snapshots = NULL;
 	int res = pthread_mutex_init(&dataBlock->mutex, NULL);
 	UNUSED(res);
 	ASSERT(res == 0);
@@ -82,12 +120,23 @@ DataBlock *DataBlock_New(uint64_t itemCap, uint itemSize, fpDestructor fp) {
 
 DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock) {
 	ASSERT(dataBlock != NULL);
-	Block *startBlock = dataBlock->blocks[0];
 
 	// Deleted items are skipped, we're about to perform
 	// array_len(dataBlock->deletedIdx) skips during out scan.
 	int64_t endPos = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
-	return DataBlockIterator_New(startBlock, 0, endPos, 1);
+	return DataBlockIterator_New(dataBlock, 0, endPos, 1);
+}
+
+DataBlockIterator *DataBlock_ScanRange(const DataBlock *dataBlock, uint64_t start, uint64_t end) {
+	ASSERT(dataBlock != NULL && start <= end);
+
+	// Clamp range to the last used position.
+	uint64_t endPos = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+	end = MIN(end, endPos);
+	// Empty range, iterator is depleted from the start.
+	if(start >= end) return DataBlockIterator_New(dataBlock, end, end, 1);
+
+	return DataBlockIterator_New(dataBlock, start, end, 1);
 }
 
 // Make sure datablock can accommodate at least k items.
@@ -115,6 +164,59 @@ void *DataBlock_GetItem(const DataBlock *dataBlock, uint64_t idx) {
 	return ITEM_DATA(item_header);
 }
 
+Block *DataBlock_GetBlock(const DataBlock *dataBlock, uint blockIdx) {
+	ASSERT(dataBlock != NULL && blockIdx < dataBlock->blockCount);
+	if(dataBlock->source == NULL) return dataBlock->blocks[blockIdx];
+
+	Block *block = __atomic_load_n(dataBlock->blocks + blockIdx, __ATOMIC_ACQUIRE);
+	if(block != NULL) return block;
+
+	// Source block wasn't modified since snapshot was taken, copy it.
+	DataBlock *source = dataBlock->source;
+	pthread_mutex_lock(&source->mutex);
+	{
+		block = dataBlock->blocks[blockIdx];
+		if(block == NULL) {
+			block = _DataBlock_CopyBlock(dataBlock, source->blocks[blockIdx]);
+			block->refcount = 1;
+			__atomic_store_n(dataBlock->blocks + blockIdx, block, __ATOMIC_RELEASE);
+		}
+	}
+	pthread_mutex_unlock(&source->mutex);
+
+	return block;
+}
+
+void DataBlock_PrepareWrite(DataBlock *dataBlock, uint64_t idx) {
+	ASSERT(dataBlock != NULL && dataBlock->source == NULL);
+	if(dataBlock->snapshots == NULL) return;
+
+	// Block was already preserved since the last snapshot was taken.
+	uint blockIdx = ITEM_INDEX_TO_BLOCK_INDEX(idx);
+	Block *block = dataBlock->blocks[blockIdx];
+	uint64_t version = dataBlock->version + 1;
+	if(__atomic_load_n(&block->modified, __ATOMIC_ACQUIRE) == version) return;
+
+	/* Items are deleted from concurrent GraphBLAS operations,
+	 * snapshots lacking the block share a single copy. */
+	pthread_mutex_lock(&dataBlock->mutex);
+	{
+		if(block->modified != version) {
+			Block *copy = NULL;
+			uint snapshot_count = array_len(dataBlock->snapshots);
+			for(uint i = 0; i < snapshot_count; i++) {
+				DataBlock *snapshot = dataBlock->snapshots[i];
+				if(blockIdx >= snapshot->blockCount || snapshot->blocks[blockIdx] != NULL) continue;
+				if(copy == NULL) copy = _DataBlock_CopyBlock(snapshot, block);
+				copy->refcount++;
+				__atomic_store_n(snapshot->blocks + blockIdx, copy, __ATOMIC_RELEASE);
+			}
+			__atomic_store_n(&block->modified, version, __ATOMIC_RELEASE);
+		}
+	}
+	pthread_mutex_unlock(&dataBlock->mutex);
+}
+
 void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx) {
 	// Make sure we've got room for items.
 	if(dataBlock->itemCount >= dataBlock->itemCap) {
@@ -128,8 +230,10 @@ void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx) {
 	// prefer reusing free indicies.
 	uint pos = dataBlock->itemCount;
 	if(array_len(dataBlock->deletedIdx) > 0) {
-		pos = array_pop(dataBlock->deletedIdx);
+		pos = array_tail(dataBlock->deletedIdx);
 	}
+	DataBlock_PrepareWrite(dataBlock, pos);
+	if(array_len(dataBlock->deletedIdx) > 0) array_pop(dataBlock->deletedIdx);
 	dataBlock->itemCount++;
 
 	if(idx) *idx = pos;
@@ -140,6 +244,44 @@ void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx) {
 	return ITEM_DATA(item_header);
 }
 
+void *DataBlock_AllocateItemAt(DataBlock *dataBlock, uint64_t idx) {
+	ASSERT(dataBlock != NULL);
+
+	// Positions preceding the first unused one either hold an item or are free.
+	uint64_t free_count = array_len(dataBlock->deletedIdx);
+	uint64_t unused = dataBlock->itemCount + free_count;
+	if(idx >= unused) {
+		// Make sure we've got room for idx.
+		if(idx >= dataBlock->itemCap) {
+			uint requiredAdditionalBlocks = ITEM_COUNT_TO_BLOCK_COUNT(idx + 1) - dataBlock->blockCount;
+			_DataBlock_AddBlocks(dataBlock, requiredAdditionalBlocks);
+		}
+		// Free skipped positions, lowest position is reused first.
+		for(uint64_t pos = idx; pos > unused; pos--) {
+			DataBlock_PrepareWrite(dataBlock, pos - 1);
+			MARK_HEADER_AS_DELETED(DataBlock_GetItemHeader(dataBlock, pos - 1));
+			dataBlock->deletedIdx = array_append(dataBlock->deletedIdx, pos - 1);
+		}
+	} else {
+		/* Claim idx from the free list, preserving the order of the remaining positions.
+		 * Replaying another datablock's allocations, idx is its tail. */
+		int64_t i = free_count - 1;
+		while(i >= 0 && dataBlock->deletedIdx[i] != idx) i--;
+		ASSERT(i >= 0);
+		memmove(dataBlock->deletedIdx + i, dataBlock->deletedIdx + i + 1,
+				(free_count - i - 1) * sizeof(uint64_t));
+		array_pop(dataBlock->deletedIdx);
+	}
+
+	DataBlock_PrepareWrite(dataBlock, idx);
+	dataBlock->itemCount++;
+
+	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
+	MARK_HEADER_AS_NOT_DELETED(item_header);
+
+	return ITEM_DATA(item_header);
+}
+
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
 	ASSERT(dataBlock != NULL);
 	ASSERT(!_DataBlock_IndexOutOfBounds(dataBlock, idx));
@@ -148,6 +290,8 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
 	DataBlockItemHeader *item_header = DataBlock_GetItemHeader(dataBlock, idx);
 	if(IS_ITEM_DELETED(item_header)) return;
 
+	DataBlock_PrepareWrite(dataBlock, idx);
+
 	// Call item destructor.
 	if(dataBlock->destructor) {
 		unsigned char *item = ITEM_DATA(item_header);
@@ -179,8 +323,77 @@ inline bool DataBlock_ItemIsDeleted(void *item) {
 	return IS_ITEM_DELETED(header);
 }
 
+DataBlock *DataBlock_Snapshot(DataBlock *dataBlock, const DataBlock *prev, fpCopy copy) {
+	ASSERT(dataBlock != NULL && dataBlock->source == NULL);
+	ASSERT(prev == NULL || prev->source == dataBlock);
+
+	DataBlock *snapshot = rm_malloc(sizeof(DataBlock));
+	snapshot->itemSize = dataBlock->itemSize;
+	snapshot->destructor = dataBlock->destructor;
+	snapshot->copy = copy;
+	snapshot->source = dataBlock;
+	snapshot->snapshots = NULL;
+	int res = pthread_mutex_init(&snapshot->mutex, NULL);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	pthread_mutex_lock(&dataBlock->mutex);
+	{
+		snapshot->itemCount = dataBlock->itemCount;
+		snapshot->itemCap = dataBlock->itemCap;
+		snapshot->blockCount = dataBlock->blockCount;
+		array_clone(snapshot->deletedIdx, dataBlock->deletedIdx);
+		snapshot->blocks = rm_calloc(snapshot->blockCount, sizeof(Block *));
+
+		// Share prev's copies of blocks which were not modified since.
+		uint blockCount = (prev) ? prev->blockCount : 0;
+		for(uint i = 0; i < blockCount; i++) {
+			Block *block = prev->blocks[i];
+			if(block == NULL || dataBlock->blocks[i]->modified > prev->version) continue;
+			block->refcount++;
+			snapshot->blocks[i] = block;
+		}
+
+		snapshot->version = ++dataBlock->version;
+		if(dataBlock->snapshots == NULL) dataBlock->snapshots = array_new(DataBlock *, 1);
+		dataBlock->snapshots = array_append(dataBlock->snapshots, snapshot);
+	}
+	pthread_mutex_unlock(&dataBlock->mutex);
+
+	return snapshot;
+}
+
+void DataBlock_DetachSnapshot(DataBlock *snapshot) {
+	ASSERT(snapshot != NULL && snapshot->source != NULL);
+	DataBlock *source = snapshot->source;
+
+	pthread_mutex_lock(&source->mutex);
+	{
+		uint snapshot_count = array_len(source->snapshots);
+		for(uint i = 0; i < snapshot_count; i++) {
+			if(source->snapshots[i] == snapshot) {
+				array_del_fast(source->snapshots, i);
+				break;
+			}
+		}
+	}
+	pthread_mutex_unlock(&source->mutex);
+}
+
 void DataBlock_Free(DataBlock *dataBlock) {
-	for(uint i = 0; i < dataBlock->blockCount; i++) Block_Free(dataBlock->blocks[i]);
+	if(dataBlock->source) {
+		// Blocks are shared among snapshots, guarded by the source's mutex.
+		DataBlock_DetachSnapshot(dataBlock);
+		pthread_mutex_lock(&dataBlock->source->mutex);
+		for(uint i = 0; i < dataBlock->blockCount; i++) {
+			_DataBlock_ReleaseBlock(dataBlock, dataBlock->blocks[i]);
+		}
+		pthread_mutex_unlock(&dataBlock->source->mutex);
+	} else {
+		ASSERT(array_len(dataBlock->snapshots) == 0);
+		for(uint i = 0; i < dataBlock->blockCount; i++) Block_Free(dataBlock->blocks[i]);
+		if(dataBlock->snapshots) array_free(dataBlock->snapshots);
+	}
 
 	rm_free(dataBlock->blocks);
 	array_free(dataBlock->deletedIdx);
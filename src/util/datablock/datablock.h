@@ -13,6 +13,8 @@
 #include "./datablock_iterator.h"
 
 typedef void (*fpDestructor)(void *);
+// Replaces the resources held by a copied item with copies of their own.
+typedef void (*fpCopy)(void *);
 
 // Number of items in a block. Should always be a power of 2.
 #define DATABLOCK_BLOCK_CAP 16384
@@ -39,16 +41,23 @@ typedef void (*fpDestructor)(void *);
 /* The DataBlock is a container structure for holding arbitrary items of a uniform type
  * in order to reduce the number of alloc/free calls and improve locality of reference.
  * Item deletions are thread-safe, and a DataBlockIterator can be used to traverse a
- * range within the block. */
-typedef struct {
-	uint64_t itemCount;         // Number of items stored in datablock.
-	uint64_t itemCap;           // Number of items datablock can hold.
-	uint blockCount;            // Number of blocks in datablock.
-	uint itemSize;              // Size of a single item in bytes.
-	Block **blocks;             // Array of blocks.
-	uint64_t *deletedIdx;       // Array of free indicies.
-	pthread_mutex_t mutex;      // Mutex guarding from concurent updates.
-	fpDestructor destructor;    // Function pointer to a clean-up function of an item.
+ * range within the block.
+ * A snapshot is a read-only DataBlock holding the items of its source as of the time
+ * it was taken, its blocks are copied from the source once first accessed, or by
+ * DataBlock_PrepareWrite before the source's block is modified. */
+typedef struct DataBlock {
+	uint64_t itemCount;           // Number of items stored in datablock.
+	uint64_t itemCap;             // Number of items datablock can hold.
+	uint blockCount;              // Number of blocks in datablock.
+	uint itemSize;                // Size of a single item in bytes.
+	Block **blocks;               // Array of blocks, NULL entries of a snapshot are yet to be copied.
+	uint64_t *deletedIdx;         // Array of free indicies.
+	pthread_mutex_t mutex;        // Mutex guarding from concurent updates.
+	fpDestructor destructor;      // Function pointer to a clean-up function of an item.
+	fpCopy copy;                  // Copies the resources of items copied into a snapshot.
+	uint64_t version;             // Number of snapshots taken, or the snapshot's own version.
+	struct DataBlock *source;     // DataBlock a snapshot was taken of, NULL if not a snapshot.
+	struct DataBlock **snapshots; // Snapshots to preserve blocks for before they are modified.
 } DataBlock;
 
 // This struct is for data block item header data.
@@ -69,23 +78,45 @@ void DataBlock_Accommodate(DataBlock *dataBlock, int64_t k);
 // Returns an iterator which scans entire datablock.
 DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock);
 
+// Returns an iterator which scans positions [start, end) of datablock.
+DataBlockIterator *DataBlock_ScanRange(const DataBlock *dataBlock, uint64_t start, uint64_t end);
+
 // Get item at position idx
 void *DataBlock_GetItem(const DataBlock *dataBlock, uint64_t idx);
 
+// Returns block at position blockIdx, a snapshot copies it from its source on first access.
+Block *DataBlock_GetBlock(const DataBlock *dataBlock, uint blockIdx);
+
 // Allocate a new item within given dataBlock,
 // if idx is not NULL, idx will contain item position
 // return a pointer to the newly allocated item.
 void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx);
 
+// Allocate a new item at position idx, which must not hold an item,
+// positions skipped over are added to the free list.
+// return a pointer to the newly allocated item.
+void *DataBlock_AllocateItemAt(DataBlock *dataBlock, uint64_t idx);
+
 // Removes item at position idx.
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx);
 
+// Must be called before the item at position idx is modified in place,
+// copies its block into every snapshot lacking it.
+void DataBlock_PrepareWrite(DataBlock *dataBlock, uint64_t idx);
+
+// Takes a snapshot of dataBlock, the snapshot shares prev's blocks which were
+// not modified since prev was taken, copy is called on every item copied into it.
+DataBlock *DataBlock_Snapshot(DataBlock *dataBlock, const DataBlock *prev, fpCopy copy);
+
+// Stops preserving snapshot's blocks, its items may no longer be accessed.
+void DataBlock_DetachSnapshot(DataBlock *snapshot);
+
 // Returns the number of deleted items.
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
 
 // Returns true if the given item has been deleted.
 bool DataBlock_ItemIsDeleted(void *item);
 
-// Free block.
+// Free block, a snapshot frees the items of blocks no other snapshot shares.
 void DataBlock_Free(DataBlock *block);
 
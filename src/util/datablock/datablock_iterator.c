@@ -11,22 +11,30 @@
 #include <stdio.h>
 #include <stdbool.h>
 
-DataBlockIterator *DataBlockIterator_New(Block *block, uint64_t start_pos, uint64_t end_pos, uint step) {
-	ASSERT(block && end_pos >= start_pos && step >= 1);
+// Returns the block holding position pos, NULL if iteration ends before pos.
+static inline Block *_DataBlockIterator_Block(const DataBlockIterator *iter, uint64_t pos) {
+	if(pos >= iter->_end_pos) return NULL;
+	// Snapshot blocks are copied on first access, which is why blocks aren't followed by next.
+	return DataBlock_GetBlock(iter->_datablock, pos / DATABLOCK_BLOCK_CAP);
+}
+
+DataBlockIterator *DataBlockIterator_New(const DataBlock *datablock, uint64_t start_pos,
+										 uint64_t end_pos, uint step) {
+	ASSERT(datablock && end_pos >= start_pos && step >= 1);
 
 	DataBlockIterator *iter = rm_malloc(sizeof(DataBlockIterator));
-	iter->_start_block = block;
-	iter->_current_block = block;
+	iter->_datablock = datablock;
 	iter->_block_pos = start_pos % DATABLOCK_BLOCK_CAP;
 	iter->_start_pos = start_pos;
 	iter->_current_pos = iter->_start_pos;
 	iter->_end_pos = end_pos;
 	iter->_step = step;
+	iter->_current_block = _DataBlockIterator_Block(iter, start_pos);
 	return iter;
 }
 
 DataBlockIterator *DataBlockIterator_Clone(const DataBlockIterator *it) {
-	return DataBlockIterator_New(it->_start_block, it->_start_pos, it->_end_pos, it->_step);
+	return DataBlockIterator_New(it->_datablock, it->_start_pos, it->_end_pos, it->_step);
 }
 
 void *DataBlockIterator_Next(DataBlockIterator *iter, uint64_t *id) {
@@ -49,7 +57,7 @@ void *DataBlockIterator_Next(DataBlockIterator *iter, uint64_t *id) {
 		// Advance to next block if current block consumed.
 		if(iter->_block_pos >= DATABLOCK_BLOCK_CAP) {
 			iter->_block_pos -= DATABLOCK_BLOCK_CAP;
-			iter->_current_block = iter->_current_block->next;
+			iter->_current_block = _DataBlockIterator_Block(iter, iter->_current_pos);
 		}
 
 		if(!IS_ITEM_DELETED(item_header)) {
@@ -65,7 +73,7 @@ void *DataBlockIterator_Next(DataBlockIterator *iter, uint64_t *id) {
 void DataBlockIterator_Reset(DataBlockIterator *iter) {
 	ASSERT(iter != NULL);
 	iter->_block_pos = iter->_start_pos % DATABLOCK_BLOCK_CAP;
-	iter->_current_block = iter->_start_block;
+	iter->_current_block = _DataBlockIterator_Block(iter, iter->_start_pos);
 	iter->_current_pos = iter->_start_pos;
 }
 
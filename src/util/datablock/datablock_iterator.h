@@ -11,8 +11,10 @@
 
 /* Datablock iterator iterates over items within a datablock. */
 
+struct DataBlock;
+
 typedef struct {
-	Block *_start_block;			// First block accessed by iterator.
+	const struct DataBlock *_datablock;	// Iterated datablock.
 	Block *_current_block;			// Current block.
 	uint _block_pos;				// Position within a block.
 	uint64_t _start_pos;			// Iterator initial position.
@@ -23,7 +25,7 @@ typedef struct {
 
 // Creates a new datablock iterator.
 DataBlockIterator *DataBlockIterator_New(
-	Block *block,       // Block from which iteration begins.
+	const struct DataBlock *datablock,  // Iterated datablock.
 	uint64_t start_pos,	// Iteration starts here.
 	uint64_t end_pos,	// Iteration stops here.
 	uint step           // To scan entire range, set step to 1.
@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <time.h>
 #include <assert.h>
+#include <stdbool.h>
 #if defined(__linux__)
 #include <sys/prctl.h>
 #endif
@@ -35,6 +36,9 @@
 #define err(str)
 #endif
 
+/* Maximal number of consecutive jobs pulled from a higher priority while jobs of a lower priority wait */
+#define THPOOL_MAX_PRIORITY_STREAK 16
+
 static volatile int threads_keepalive;
 static volatile int threads_on_hold;
 
@@ -52,13 +56,16 @@ typedef struct job {
 	struct job *prev;            /* pointer to previous job   */
 	void (*function)(void *arg); /* function pointer          */
 	void *arg;                   /* function's argument       */
+	thpool_priority priority;    /* job's priority            */
 } job;
 
 /* Job queue */
 typedef struct jobqueue {
 	pthread_mutex_t rwmutex; /* used for queue r/w access */
-	job *front;              /* pointer to front of queue */
-	job *rear;               /* pointer to rear  of queue */
+	job *front[THPOOL_PRIORITY_COUNT]; /* front of queue, per priority */
+	job *rear[THPOOL_PRIORITY_COUNT];  /* rear  of queue, per priority */
+	int lens[THPOOL_PRIORITY_COUNT];   /* number of jobs, per priority */
+	int streak;              /* consecutive jobs pulled while lower priority jobs wait */
 	bsem *has_jobs;          /* flag as binary semaphore  */
 	int len;                 /* number of jobs in queue   */
 } jobqueue;
@@ -158,6 +165,12 @@ struct thpool_ *thpool_init(int num_threads) {
 
 /* Add work to the thread pool */
 int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p) {
+	return thpool_add_work_priority(thpool_p, function_p, arg_p, THPOOL_PRIORITY_NORMAL);
+}
+
+/* Add work of a given priority to the thread pool */
+int thpool_add_work_priority(thpool_* thpool_p, void (*function_p)(void *), void *arg_p,
+		thpool_priority priority) {
 	job *newjob;
 
 	newjob = (struct job *)malloc(sizeof(struct job));
@@ -169,6 +182,7 @@ int thpool_add_work(thpool_* thpool_p, void (*function_p)(void *), void *arg_p)
 	/* add function and argument */
 	newjob->function = function_p;
 	newjob->arg = arg_p;
+	newjob->priority = priority;
 
 	/* add job to queue */
 	jobqueue_push(&thpool_p->jobqueue, newjob);
@@ -383,8 +397,12 @@ static void thread_destroy(thread *thread_p) {
 /* Initialize queue */
 static int jobqueue_init(jobqueue *jobqueue_p) {
 	jobqueue_p->len = 0;
-	jobqueue_p->front = NULL;
-	jobqueue_p->rear = NULL;
+	jobqueue_p->streak = 0;
+	for(int i = 0; i < THPOOL_PRIORITY_COUNT; i++) {
+		jobqueue_p->front[i] = NULL;
+		jobqueue_p->rear[i] = NULL;
+		jobqueue_p->lens[i] = 0;
+	}
 
 	jobqueue_p->has_jobs = (struct bsem *)malloc(sizeof(struct bsem));
 	if(jobqueue_p->has_jobs == NULL) {
@@ -404,8 +422,12 @@ static void jobqueue_clear(jobqueue *jobqueue_p) {
 		free(jobqueue_pull(jobqueue_p));
 	}
 
-	jobqueue_p->front = NULL;
-	jobqueue_p->rear = NULL;
+	for(int i = 0; i < THPOOL_PRIORITY_COUNT; i++) {
+		jobqueue_p->front[i] = NULL;
+		jobqueue_p->rear[i] = NULL;
+		jobqueue_p->lens[i] = 0;
+	}
+	jobqueue_p->streak = 0;
 	bsem_reset(jobqueue_p->has_jobs);
 	jobqueue_p->len = 0;
 }
@@ -416,24 +438,47 @@ static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob) {
 
 	pthread_mutex_lock(&jobqueue_p->rwmutex);
 	newjob->prev = NULL;
+	int p = newjob->priority;
 
-	switch(jobqueue_p->len) {
+	switch(jobqueue_p->lens[p]) {
 
-	case 0: /* if no jobs in queue */
-		jobqueue_p->front = newjob;
-		jobqueue_p->rear = newjob;
+	case 0: /* if no jobs of priority in queue */
+		jobqueue_p->front[p] = newjob;
+		jobqueue_p->rear[p] = newjob;
 		break;
 
-	default: /* if jobs in queue */
-		jobqueue_p->rear->prev = newjob;
-		jobqueue_p->rear = newjob;
+	default: /* if jobs of priority in queue */
+		jobqueue_p->rear[p]->prev = newjob;
+		jobqueue_p->rear[p] = newjob;
 	}
+	jobqueue_p->lens[p]++;
 	jobqueue_p->len++;
 
 	bsem_post(jobqueue_p->has_jobs);
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
 }
 
+/* Determine the priority of the next job to pull, -1 if queue is empty
+ *
+ * Notice: Caller MUST hold the queue mutex
+ */
+static int jobqueue_next_priority(jobqueue *jobqueue_p) {
+	int p = -1;
+	for(int i = 0; i < THPOOL_PRIORITY_COUNT; i++) {
+		if(jobqueue_p->lens[i] == 0) continue;
+		if(p == -1) {
+			p = i;
+		} else {
+			/* lower priority jobs are waiting
+			 * prefer them once the streak limit is reached */
+			if(jobqueue_p->streak >= THPOOL_MAX_PRIORITY_STREAK) p = i;
+			break;
+		}
+	}
+
+	return p;
+}
+
 /* Get first job from queue(removes it from queue)
  *
  * Notice: Caller MUST hold a mutex
@@ -441,24 +486,32 @@ static void jobqueue_push(jobqueue *jobqueue_p, struct job *newjob) {
 static struct job *jobqueue_pull(jobqueue *jobqueue_p) {
 
 	pthread_mutex_lock(&jobqueue_p->rwmutex);
-	job *job_p = jobqueue_p->front;
+	job *job_p = NULL;
+	int p = jobqueue_next_priority(jobqueue_p);
 
-	switch(jobqueue_p->len) {
+	if(p != -1) {
+		job_p = jobqueue_p->front[p];
 
-	case 0: /* if no jobs in queue */
-		break;
+		/* track streak of jobs pulled while lower priority jobs wait */
+		bool waiting = false;
+		for(int i = p + 1; i < THPOOL_PRIORITY_COUNT; i++) waiting |= (jobqueue_p->lens[i] > 0);
+		jobqueue_p->streak = (waiting) ? jobqueue_p->streak + 1 : 0;
 
-	case 1: /* if one job in queue */
-		jobqueue_p->front = NULL;
-		jobqueue_p->rear = NULL;
-		jobqueue_p->len = 0;
-		break;
+		switch(jobqueue_p->lens[p]) {
+
+		case 1: /* if one job of priority in queue */
+			jobqueue_p->front[p] = NULL;
+			jobqueue_p->rear[p] = NULL;
+			break;
 
-	default: /* if >1 jobs in queue */
-		jobqueue_p->front = job_p->prev;
+		default: /* if >1 jobs of priority in queue */
+			jobqueue_p->front[p] = job_p->prev;
+		}
+		jobqueue_p->lens[p]--;
 		jobqueue_p->len--;
-		/* more than one job in queue -> post it */
-		bsem_post(jobqueue_p->has_jobs);
+
+		/* more jobs in queue -> post it */
+		if(jobqueue_p->len > 0) bsem_post(jobqueue_p->has_jobs);
 	}
 
 	pthread_mutex_unlock(&jobqueue_p->rwmutex);
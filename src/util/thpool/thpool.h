@@ -16,6 +16,13 @@ extern "C" {
 
 typedef struct thpool_* threadpool;
 
+/* Job priorities, jobs of a higher priority are pulled before queued jobs of a lower priority */
+typedef enum {
+	THPOOL_PRIORITY_HIGH = 0,
+	THPOOL_PRIORITY_NORMAL = 1,
+	THPOOL_PRIORITY_COUNT
+} thpool_priority;
+
 
 /**
  * @brief  Initialize threadpool
@@ -67,6 +74,23 @@ threadpool thpool_init(int num_threads);
 int thpool_add_work(threadpool, void (*function_p)(void*), void* arg_p);
 
 
+/**
+ * @brief Add work of a given priority to the job queue
+ *
+ * Same as thpool_add_work, however queued jobs of a higher priority are
+ * executed first. To avoid starvation, a job of a lower priority is executed
+ * after THPOOL_MAX_PRIORITY_STREAK consecutive jobs of a higher priority
+ * whenever one is queued. thpool_add_work queues jobs of normal priority.
+ *
+ * @param  threadpool    threadpool to which the work will be added
+ * @param  function_p    pointer to function to add as work
+ * @param  arg_p         pointer to an argument
+ * @param  priority      job priority
+ * @return 0 on successs, -1 otherwise.
+ */
+int thpool_add_work_priority(threadpool, void (*function_p)(void*), void* arg_p, thpool_priority priority);
+
+
 /**
  * @brief Wait for all queued jobs to finish
  *
@@ -88,3 +88,30 @@ class testAlgebraicExpressionOrder(FlowTestsBase):
         self.env.assertIn("Node By Label Scan | (b:B)", plan)
         result = graph.query(query)
         self.env.assertEquals(result.result_set, expected_result)
+
+    # Test that traversals start from the smaller of the labeled nodes.
+    def test02_start_from_smaller_label(self):
+        redis_con = self.env.getConnection()
+        g = Graph("AlgebraicExpressionOrderStats", redis_con)
+        g.query("UNWIND range(1, 100) AS x CREATE (:Big {v: x})")
+        g.query("CREATE (:Small {v: 1})")
+        g.query("MATCH (b:Big), (s:Small) WHERE b.v <= 10 CREATE (b)-[:R]->(s)")
+
+        # Without statistics both labels look alike and the source node would be scanned.
+        query = """MATCH (b:Big)-[:R]->(s:Small) RETURN count(b)"""
+        plan = g.execution_plan(query)
+        self.env.assertIn("Node By Label Scan | (s:Small)", plan)
+        self.env.assertEquals(g.query(query).result_set, [[10]])
+
+        # A filter on the larger label doesn't outweigh the difference in size.
+        query = """MATCH (b:Big)-[:R]->(s:Small) WHERE b.v > 5 RETURN count(b)"""
+        plan = g.execution_plan(query)
+        self.env.assertIn("Node By Label Scan | (s:Small)", plan)
+        self.env.assertEquals(g.query(query).result_set, [[5]])
+
+        # Longer patterns are ordered starting at the smallest label as well.
+        query = """MATCH (a:Big)-[:R]->(s:Small)<-[:R]-(b:Big) WHERE a.v < 3 AND b.v < 3 AND a.v <> b.v
+                   RETURN a.v, b.v ORDER BY a.v"""
+        plan = g.execution_plan(query)
+        self.env.assertIn("Node By Label Scan | (s:Small)", plan)
+        self.env.assertEquals(g.query(query).result_set, [[1, 2], [2, 1]])
@@ -346,6 +346,54 @@ class testGraphBulkInsertFlow(FlowTestsBase):
         # The graph should have the correct types for all properties
         self.env.assertEquals(query_result.result_set, expected_result)
 
+    # Verify that multiple edges connecting the same pair of nodes are all formed,
+    # both within a single relation file and across bulk insert queries
+    def test10_multi_edges(self):
+        graphname = "tmpgraph6"
+        # Write temporary files
+        with open('/tmp/nodes.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["id"])
+            for i in range(3):
+                out.writerow([i])
+        with open('/tmp/relations.tmp', mode='w') as csv_file:
+            out = csv.writer(csv_file)
+            out.writerow(["src", "dest", "weight"])
+            out.writerow([0, 1, 1])
+            out.writerow([1, 2, 2])
+            out.writerow([0, 1, 3])
+            out.writerow([2, 0, 4])
+            out.writerow([0, 1, 5])
+
+        runner = CliRunner()
+        res = runner.invoke(bulk_insert, ['--port', port,
+                                          '--nodes', '/tmp/nodes.tmp',
+                                          '--relations', '/tmp/relations.tmp',
+                                          '--relations', '/tmp/relations.tmp',
+                                          '--max-token-count', 1,
+                                          graphname])
+
+        self.env.assertEquals(res.exit_code, 0)
+        self.env.assertIn('10 relations created', res.output)
+
+        graph = Graph(graphname, redis_con)
+        query_result = graph.query('MATCH (a)-[e]->(b) RETURN a.id, b.id, e.weight ORDER BY e.weight, a.id')
+        expected_result = [[0, 1, 1], [0, 1, 1],
+                           [1, 2, 2], [1, 2, 2],
+                           [0, 1, 3], [0, 1, 3],
+                           [2, 0, 4], [2, 0, 4],
+                           [0, 1, 5], [0, 1, 5]]
+        self.env.assertEquals(query_result.result_set, expected_result)
+
+        # Traversing in the opposite direction must yield the same edges
+        query_result = graph.query('MATCH (b)<-[e]-(a) RETURN a.id, b.id, e.weight ORDER BY e.weight, a.id')
+        self.env.assertEquals(query_result.result_set, expected_result)
+
+        # Deleting a multi-edge leaves the remaining edges intact
+        graph.query('MATCH ()-[e {weight: 3}]->() DELETE e')
+        query_result = graph.query('MATCH (a {id: 0})-[e]->(b {id: 1}) RETURN count(e)')
+        self.env.assertEquals(query_result.result_set, [[4]])
+
     # Verify that numeric, boolean, and null types are properly handled
     # def test09_utf8(self):
     #     graphname = "tmpgraph5"
@@ -223,3 +223,30 @@ class testCache(FlowTestsBase):
         cached_result = graph.query(query, params)
         self.env.assertEqual(expected_result, cached_result.result_set)
         self.env.assertTrue(cached_result.cached_execution)
+
+    def plan_cache_stats(self):
+        # Module INFO fields are prefixed by the module name.
+        info = redis_con.execute_command("INFO", "graph_plan_cache")
+        if isinstance(info, bytes):
+            info = info.decode()
+        if isinstance(info, str):
+            info = dict(line.split(':', 1) for line in info.splitlines() if ':' in line)
+        stats = {}
+        for field in ["hits", "misses", "evictions"]:
+            stats[field] = next(int(v) for k, v in info.items() if k.endswith(field))
+        return stats
+
+    def test12_cache_stats_info(self):
+        graph = Graph('Cache_Stats', redis_con)
+        graph.query("CREATE ()")
+        before = self.plan_cache_stats()
+
+        query = "MATCH (n) WHERE n.v = $v RETURN n"
+        self.env.assertFalse(graph.query(query, {'v': 1}).cached_execution)
+        self.env.assertTrue(graph.query(query, {'v': 2}).cached_execution)
+        self.env.assertTrue(graph.query(query, {'v': 3}).cached_execution)
+
+        after = self.plan_cache_stats()
+        self.env.assertEqual(after["misses"] - before["misses"], 1)
+        self.env.assertEqual(after["hits"] - before["hits"], 2)
+        self.env.assertEqual(after["evictions"], before["evictions"])
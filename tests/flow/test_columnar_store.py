@@ -0,0 +1,85 @@
+from RLTest import Env
+from redisgraph import Graph, Node
+
+from base import FlowTestsBase
+
+GRAPH_ID = "columnar_store"
+redis_graph = None
+
+# Each filter is compared against an equivalent filter
+# which can't be evaluated over a column.
+FILTERS = [
+    ("n.v = 3", "n.v + 0 = 3"),
+    ("n.v <> 3", "n.v + 0 <> 3"),
+    ("n.v > 3", "n.v + 0 > 3"),
+    ("n.v >= 3.5", "n.v + 0 >= 3.5"),
+    ("3 < n.v", "3 < n.v + 0"),
+    ("n.d < 4.5", "n.d + 0 < 4.5"),
+    ("n.d = 2", "n.d + 0 = 2"),
+    ("n.b = true", "n.b OR false = true"),
+    ("n.s = 'x3'", "n.s + '' = 'x3'"),
+    ("n.s <> 'x3'", "n.s + '' <> 'x3'"),
+    ("n.s > 'x5'", "n.s + '' > 'x5'"),
+    ("n.s = 'absent'", "n.s + '' = 'absent'"),
+    ("n.v = 'x'", "n.v + '' = 'x'"),
+    ("n.v <> 'x'", "n.v + '' <> 'x'"),
+    ("n.v = NULL", "n.v + 0 = NULL"),
+    ("n.missing = 1", "n.missing + 0 = 1"),
+]
+
+class testColumnarStore(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(moduleArgs='COLUMNAR_STORE yes')
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Attributes hold values of several types, some nodes miss attributes.
+        redis_graph.query("""UNWIND range(0, 2999) AS x CREATE (:N {v: x % 10, d: toFloat(x % 7),
+                             b: x % 3 = 0, s: 'x' + toString(x % 10), w: x})""")
+        redis_graph.query("UNWIND range(0, 99) AS x CREATE (:N {w: x, v: toFloat(x % 10)})")
+        redis_graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: 'x', w: x}), (:N {w: x}), (:N {v: [x]})")
+
+    def _assert_filters_match(self):
+        for f, expected_f in FILTERS:
+            query = "MATCH (n:N) WHERE %s RETURN count(n), sum(n.w)"
+            actual = redis_graph.query(query % f).result_set
+            expected = redis_graph.query(query % expected_f).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test01_filters(self):
+        self._assert_filters_match()
+
+    def test02_plan(self):
+        # Filter is evaluated by the scan.
+        plan = redis_graph.execution_plan("MATCH (n:N) WHERE n.v > 3 RETURN n")
+        self.env.assertNotIn("Filter", plan)
+        plan = redis_graph.execution_plan("MATCH (n:N) WHERE n.v + 0 > 3 RETURN n")
+        self.env.assertIn("Filter", plan)
+
+    def test03_parameters(self):
+        query = "MATCH (n:N) WHERE %s RETURN count(n)"
+        for v, expected_f in [(3, "n.v + 0 = $v"), (3.0, "n.v + 0 = $v"), ('x', "n.v + '' = $v"), (None, "n.v + 0 = $v")]:
+            actual = redis_graph.query(query % "n.v = $v", {'v': v}).result_set
+            expected = redis_graph.query(query % expected_f, {'v': v}).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test04_writes(self):
+        # Columns built by previous tests follow subsequent writes.
+        redis_graph.query("MATCH (n:N) WHERE n.w < 100 SET n.v = 100, n.s = 'new'")
+        redis_graph.query("MATCH (n:N) WHERE n.w >= 2900 SET n.v = NULL")
+        redis_graph.query("MATCH (n:N) WHERE n.w >= 1000 AND n.w < 1100 DELETE n")
+        redis_graph.query("UNWIND range(0, 99) AS x CREATE (:N {v: 3, s: 'x3', d: 2.0, b: true, w: x})")
+        redis_graph.query("MERGE (:N {v: 3, w: 5000})")
+        self._assert_filters_match()
+
+        query = "MATCH (n:N) WHERE n.v = 100 RETURN count(n)"
+        self.env.assertEquals(redis_graph.query(query).result_set, redis_graph.query(query.replace("n.v", "n.v + 0")).result_set)
+
+    def test05_ordered_scan(self):
+        # Filtered scan results are sorted and limited.
+        query = "MATCH (n:N) WHERE n.v = 5 RETURN n.w ORDER BY n.w LIMIT 5"
+        expected_query = "MATCH (n:N) WHERE n.v + 0 = 5 RETURN n.w ORDER BY n.w LIMIT 5"
+        self.env.assertEquals(redis_graph.query(query).result_set, redis_graph.query(expected_query).result_set)
@@ -0,0 +1,80 @@
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "compiled_filters"
+redis_graph = None
+
+# Each filter is compared against an equivalent filter
+# which isn't compiled into an attribute comparison.
+FILTERS = [
+    ("n.v = 3", "n.v + 0 = 3"),
+    ("n.v <> 3", "n.v + 0 <> 3"),
+    ("n.v > 3", "n.v + 0 > 3"),
+    ("n.v >= 3.5", "n.v + 0 >= 3.5"),
+    ("3 < n.v", "3 < n.v + 0"),
+    ("3 >= n.v", "3 >= n.v + 0"),
+    ("n.v = 'x'", "n.v + '' = 'x'"),
+    ("n.v <> 'x'", "n.v + '' <> 'x'"),
+    ("n.v = NULL", "n.v + 0 = NULL"),
+    ("n.missing = 1", "n.missing + 0 = 1"),
+    ("n.v > 2 AND n.w < 50 AND n.v <> 7", "n.v + 0 > 2 AND n.w + 0 < 50 AND n.v + 0 <> 7"),
+    ("n.v = 1 OR n.w = 2 OR (n.v > 8 AND n.w > 900)", "n.v + 0 = 1 OR n.w + 0 = 2 OR (n.v + 0 > 8 AND n.w + 0 > 900)"),
+    ("NOT n.v = 3 AND n.w % 2 = 0", "NOT n.v + 0 = 3 AND n.w % 2 = 0"),
+]
+
+class testCompiledFilters(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Enough nodes for filter operands to get reordered,
+        # properties are set in varying orders.
+        redis_graph.query("UNWIND range(0, 2999) AS x CREATE (:N {v: x % 10, w: x})")
+        redis_graph.query("UNWIND range(0, 99) AS x CREATE (:N {w: x, v: toFloat(x % 10)})")
+        redis_graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: 'x', w: x}), (:N {w: x})")
+
+    def test01_filters(self):
+        for f, expected_f in FILTERS:
+            query = "MATCH (n:N) WHERE %s RETURN count(n), sum(n.w)"
+            actual = redis_graph.query(query % f).result_set
+            expected = redis_graph.query(query % expected_f).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test02_parameters(self):
+        query = "MATCH (n:N) WHERE %s RETURN count(n)"
+        for v, expected_f in [(3, "n.v + 0 = $v"), (3.0, "n.v + 0 = $v"), ('x', "n.v + '' = $v"), (None, "n.v + 0 = $v")]:
+            actual = redis_graph.query(query % "n.v = $v", {'v': v}).result_set
+            expected = redis_graph.query(query % expected_f, {'v': v}).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test03_non_entity_values(self):
+        # Filtered alias may be bound to NULL.
+        query = """UNWIND [1, 2, 20000] AS x OPTIONAL MATCH (n:N {w: x}) WHERE n.v = x
+                   WITH n WHERE n.v = 1 RETURN count(n)"""
+        actual = redis_graph.query(query).result_set
+        self.env.assertEquals(actual, [[2]])
+
+    def test04_guarded_operands(self):
+        # Operands which may raise an error are never evaluated ahead of their guards,
+        # even once the guard rarely resolves the conjunction.
+        redis_graph.query("UNWIND range(0, 2999) AS x CREATE (:G {t: 's', s: toString(x)})")
+        # toUpper raises a type mismatch error on an integer.
+        redis_graph.query("CREATE (:G {t: 'i', s: 1})")
+        query = "MATCH (n:G) WHERE n.t = 's' AND toUpper(n.s) <> '' RETURN count(n)"
+        actual = redis_graph.query(query).result_set
+        self.env.assertEquals(actual, [[3000]])
+
+    def test05_guarded_non_entity_attributes(self):
+        # x isn't bound to a graph entity by the query graph, accessing its attribute
+        # raises an error once x is an integer, x <> 1 must remain ahead of x.w > 0.
+        query = """MATCH (n:N) WITH CASE WHEN n.w = 1 THEN 1 ELSE n END AS x
+                   WHERE x <> 1 AND x.w > 0 RETURN count(x)"""
+        actual = redis_graph.query(query).result_set
+        expected = redis_graph.query("MATCH (n:N) WHERE n.w > 1 RETURN count(n)").result_set
+        self.env.assertEquals(actual, expected)
@@ -0,0 +1,103 @@
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "cursor"
+NODE_COUNT = 2500
+redis_con = None
+redis_graph = None
+
+class testCursor(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        redis_graph.query("UNWIND range(0, {}) AS x CREATE (:N {{v: x}})".format(NODE_COUNT - 1))
+
+    def cursor_id(self, stats):
+        for stat in stats:
+            stat = stat.decode() if isinstance(stat, bytes) else stat
+            if stat.startswith("Cursor: "):
+                return stat[len("Cursor: "):]
+        return None
+
+    def read_all(self, query, count):
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, query, "CURSOR", count)
+        records = res[1]
+        self.env.assertLessEqual(len(records), count)
+        cursor = self.cursor_id(res[2])
+        while cursor is not None:
+            res = redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+            self.env.assertLessEqual(len(res[1]), count)
+            records += res[1]
+            cursor = self.cursor_id(res[2])
+        return records
+
+    def test01_read_through_cursor(self):
+        query = "MATCH (n:N) RETURN n.v ORDER BY n.v"
+        expected = redis_graph.query(query).result_set
+        for count in [1, 7, 1000, NODE_COUNT, NODE_COUNT + 1]:
+            records = self.read_all(query, count)
+            self.env.assertEquals(records, expected)
+
+    def test02_aggregation_through_cursor(self):
+        records = self.read_all("MATCH (n:N) RETURN count(n)", 10)
+        self.env.assertEquals(records, [[NODE_COUNT]])
+
+    def test03_cursor_invalidated_by_write(self):
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, "MATCH (n:N) RETURN n.v", "CURSOR", 10)
+        cursor = self.cursor_id(res[2])
+        self.env.assertIsNotNone(cursor)
+
+        redis_graph.query("CREATE (:N {v: -1})")
+        try:
+            redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+            self.env.assertTrue(False)
+        except Exception as e:
+            self.env.assertIn("Cursor invalidated", str(e))
+
+        # Invalidated cursors are discarded.
+        try:
+            redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+            self.env.assertTrue(False)
+        except Exception as e:
+            self.env.assertIn("Unknown cursor", str(e))
+
+        redis_graph.query("MATCH (n:N {v: -1}) DELETE n")
+
+    def test04_invalid_cursor_usage(self):
+        # Cursors are restricted to read-only queries.
+        try:
+            redis_con.execute_command("GRAPH.QUERY", GRAPH_ID, "CREATE (:M) RETURN 1", "CURSOR", 10)
+            self.env.assertTrue(False)
+        except Exception as e:
+            self.env.assertIn("read-only", str(e))
+
+        for count in [0, -1, "a"]:
+            try:
+                redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, "MATCH (n) RETURN n", "CURSOR", count)
+                self.env.assertTrue(False)
+            except Exception as e:
+                self.env.assertIn("Failed to parse cursor count value", str(e))
+
+        for cursor in ["999999", "a", ""]:
+            try:
+                redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+                self.env.assertTrue(False)
+            except Exception as e:
+                self.env.assertIn("Unknown cursor", str(e))
+
+        # A cursor can only be read through its own graph.
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, "MATCH (n:N) RETURN n.v", "CURSOR", 10)
+        cursor = self.cursor_id(res[2])
+        Graph("other", redis_con).query("CREATE ()")
+        try:
+            redis_con.execute_command("GRAPH.CURSOR", "other", cursor)
+            self.env.assertTrue(False)
+        except Exception as e:
+            self.env.assertIn("Unknown cursor", str(e))
+        res = redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+        self.env.assertEquals(len(res[1]), 10)
@@ -335,3 +335,24 @@ class testFunctionCallsFlow(FlowTestsBase):
             self.env.assertEquals(row[0], row[1])
             self.env.assertEquals(row[2], row[3])
 
+
+    # Aggregations should form a single group per distinct key.
+    def test17_aggregation_grouping(self):
+        # Many groups, interleaved input.
+        query = """UNWIND range(0, 9999) AS x RETURN x % 1000 AS k, count(x) ORDER BY k"""
+        actual_result = graph.query(query)
+        expected_result = [[k, 10] for k in range(1000)]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # NULL keys form a group of their own.
+        query = """UNWIND [1, NULL, 'a', NULL, 1, 'a', [1, 2], [1, 2]] AS x RETURN x, count(1)"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(len(actual_result.result_set), 4)
+        for row in actual_result.result_set:
+            self.env.assertEquals(row[1], 2)
+
+        # Composite keys.
+        query = """UNWIND range(0, 99) AS x RETURN x % 2 AS a, toString(x % 5) AS b, count(x) ORDER BY a, b"""
+        actual_result = graph.query(query)
+        expected_result = [[a, str(b), 10] for a in range(2) for b in range(5)]
+        self.env.assertEquals(actual_result.result_set, expected_result)
@@ -575,3 +575,37 @@ class testGraphMergeFlow(FlowTestsBase):
         except redis.exceptions.ResponseError as e:
             # Expecting an error.
             self.env.assertIn("undefined property", e.message)
+
+    def test28_merge_batched_bound_records(self):
+        redis_con = self.env.getConnection()
+        graph = Graph("batched_merge", redis_con)
+        graph.query("UNWIND range(0, 9) AS x CREATE (:L {id: x, v: 'a' + toString(x)})")
+        # Unlabeled nodes and nodes with a different label are never matched.
+        graph.query("CREATE ({id: 10}), (:M {id: 11})")
+
+        # Half of the rows match existing nodes, duplicated rows create a single node.
+        query = """UNWIND range(5, 14) + [12, 12.0] AS x
+                   MERGE (n:L {id: x})
+                   ON MATCH SET n.matched = true
+                   ON CREATE SET n.created = true
+                   RETURN n.id, n.matched, n.created ORDER BY n.id"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 5)
+        expected_result = [[5, True, None], [6, True, None], [7, True, None],
+                           [8, True, None], [9, True, None], [10, None, True],
+                           [11, None, True], [12, None, True], [12, None, True],
+                           [12, None, True], [13, None, True], [14, None, True]]
+        self.env.assertEquals(result.result_set, expected_result)
+
+        # Multiple properties, a matched row is returned once per matching node.
+        query = """UNWIND [[1, 'a1'], [2, 'a1'], [3, 'a3'], [3, 'a3']] AS row
+                   MERGE (n:L {id: row[0], v: row[1]})
+                   RETURN row[0], n.v ORDER BY row[0], n.v"""
+        result = graph.query(query)
+        self.env.assertEquals(result.nodes_created, 1)
+        expected_result = [[1, 'a1'], [2, 'a1'], [3, 'a3'], [3, 'a3']]
+        self.env.assertEquals(result.result_set, expected_result)
+
+        query = """MATCH (n:L) RETURN count(n)"""
+        result = graph.query(query)
+        self.env.assertEquals(result.result_set, [[16]])
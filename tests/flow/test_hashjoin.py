@@ -36,3 +36,62 @@ class testHashJoin(FlowTestsBase):
 
         self.env.assertEquals(actual_result.result_set, expected_result)
 
+
+    def test_join_values(self):
+        # Join on mixed numeric types, duplicated values and NULLs.
+        graph = Graph("hashjoin_values", self.env.getConnection())
+        graph.query("UNWIND range(0, 19) AS x CREATE (:L {v: x % 4}), (:R {v: toFloat(x % 6)})")
+        graph.query("CREATE (:L), (:R), (:L {v: 'a'}), (:R {v: 'a'}), (:R {v: [1]}), (:L {v: [1]})")
+
+        q = "MATCH (l:L), (r:R) WHERE l.v = r.v RETURN l.v, r.v, count(1) ORDER BY l.v, r.v"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+        actual_result = graph.query(q)
+
+        # Compute expected result without a join.
+        q = "MATCH (l:L) MATCH (r:R) WITH l, r WHERE l.v = r.v RETURN l.v, r.v, count(1) ORDER BY l.v, r.v"
+        expected_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+        self.env.assertEquals(len(actual_result.result_set), 6)
+
+    def test_cartesian_product_streams(self):
+        # Cartesian product holds its first stream in blocks.
+        graph = Graph("cartesian_product", self.env.getConnection())
+        graph.query("UNWIND range(0, 2) AS x CREATE (:A {v: x}), (:B {v: x}), (:C {v: x})")
+
+        q = "MATCH (a:A), (b:B), (c:C) RETURN a.v, b.v, c.v ORDER BY a.v, b.v, c.v"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Cartesian Product", plan)
+        actual_result = graph.query(q)
+        expected_result = [[a, b, c] for a in range(3) for b in range(3) for c in range(3)]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # Blocks are filled lazily, LIMIT stops the scans early.
+        q = "MATCH (a:A), (b:B) RETURN a, b LIMIT 1"
+        profile = self.env.getConnection().execute_command("GRAPH.PROFILE", "cartesian_product", q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Node By Label Scan | (a:A) | Records produced: 1", profile)
+        self.env.assertIn("Node By Label Scan | (b:B) | Records produced: 1", profile)
+
+        # An empty stream produces no records.
+        q = "MATCH (a:A), (b:B), (z:Z) RETURN count(1)"
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [[0]])
+
+        # Cartesian product is re-evaluated for every outer record.
+        q = "MATCH (a:A) OPTIONAL MATCH (b:B), (c:C) WHERE b.v < a.v AND c.v < a.v RETURN a.v, count(b) ORDER BY a.v"
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [[0, 0], [1, 1], [2, 4]])
+
+        # Join on node identity and multiple columns.
+        q = "MATCH (a:A), (b:A) WHERE a = b RETURN a.v, b.v ORDER BY a.v"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [[0, 0], [1, 1], [2, 2]])
+
+        q = "MATCH (a:A), (b:B) WHERE a.v = b.v AND a.v + 1 = b.v + 1 RETURN a.v, b.v ORDER BY a.v"
+        plan = graph.execution_plan(q)
+        self.env.assertIn("Value Hash Join", plan)
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [[0, 0], [1, 1], [2, 2]])
@@ -0,0 +1,119 @@
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "intersect"
+redis_graph = None
+
+class testIntersect(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        redis_graph.query("UNWIND range(0, 29) AS x CREATE (:N {v: x})")
+        redis_graph.query("""MATCH (a:N), (b:N) WHERE a.v <> b.v AND (a.v * 7 + b.v * 3) % 5 = 0
+                             CREATE (a)-[:R]->(b)""")
+        redis_graph.query("""MATCH (a:N), (b:N) WHERE a.v < b.v AND (a.v + b.v) % 4 = 1
+                             CREATE (a)-[:S]->(b)""")
+        redis_graph.query("MATCH (a:N) WHERE a.v % 3 = 0 SET a:M")
+
+    # Validates the cyclic query is resolved by an intersection, and that its results
+    # match those of the reference query, whose closing edge is referenced.
+    def compare(self, query, reference):
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Intersect", plan)
+        plan = redis_graph.execution_plan(reference)
+        self.env.assertNotIn("Intersect", plan)
+
+        actual_result = redis_graph.query(query)
+        expected_result = redis_graph.query(reference)
+        self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+        return actual_result
+
+    def test01_triangles(self):
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c)
+                   RETURN count(*)"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R]->(c), (a)-[e3:R]->(c)
+                       WITH a, b, c, e1, e2, e3
+                       RETURN count(*)"""
+        result = self.compare(query, reference)
+        self.env.assertGreater(result.result_set[0][0], 0)
+
+        # Report the triangles themselves.
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c)
+                   RETURN a.v, b.v, c.v ORDER BY a.v, b.v, c.v"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R]->(c), (a)-[e3:R]->(c)
+                       WITH a, b, c, e1, e2, e3
+                       RETURN a.v, b.v, c.v ORDER BY a.v, b.v, c.v"""
+        self.compare(query, reference)
+
+    def test02_directions_and_types(self):
+        # Closing edge pointing into the bound node.
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c), (c)-[:S]->(a)
+                   RETURN count(*)"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R]->(c), (c)-[e3:S]->(a)
+                       WITH a, b, c, e1, e2, e3
+                       RETURN count(*)"""
+        self.compare(query, reference)
+
+        # Undirected and multiple relationship types.
+        query = """MATCH (a)-[:R]->(b)-[:R|S]-(c), (a)-[:S]-(c)
+                   RETURN a.v, count(*) ORDER BY a.v"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R|S]-(c), (a)-[e3:S]-(c)
+                       WITH a, b, c, e1, e2, e3
+                       WITH DISTINCT a, b, c
+                       RETURN a.v, count(*) ORDER BY a.v"""
+        self.compare(query, reference)
+
+    def test03_labels(self):
+        query = """MATCH (a:N)-[:R]->(b:M)-[:R]->(c:M), (a)-[:R]->(c)
+                   RETURN count(*)"""
+        reference = """MATCH (a:N)-[e1:R]->(b:M)-[e2:R]->(c:M), (a)-[e3:R]->(c)
+                       WITH a, b, c, e1, e2, e3
+                       RETURN count(*)"""
+        self.compare(query, reference)
+
+        # Unknown label and relationship type.
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c:Z), (a)-[:R]->(c)
+                   RETURN count(*)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[0]])
+
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:Z]->(c)
+                   RETURN count(*)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[0]])
+
+    def test04_cliques(self):
+        # Node closing multiple cycles is constrained by all of its bound neighbors.
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c)-[:R]->(d), (a)-[:R]->(c), (a)-[:R]->(d), (b)-[:R]->(d)
+                   RETURN count(*)"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R]->(c)-[e3:R]->(d), (a)-[e4:R]->(c), (a)-[e5:R]->(d), (b)-[e6:R]->(d)
+                       WITH a, b, c, d, e1, e2, e3, e4, e5, e6
+                       RETURN count(*)"""
+        self.compare(query, reference)
+
+    def test05_acyclic_pattern(self):
+        query = """MATCH (a)-[:R]->(b)-[:R]->(c)
+                   RETURN count(*)"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertNotIn("Intersect", plan)
+
+    def test06_partially_consumed(self):
+        # Rows are merged lazily, consumption may stop mid row.
+        query = """MATCH (a)-[:R]->(b)-[:R|S]-(c), (a)-[:R|S]-(c)
+                   WITH a, b, c ORDER BY a.v, b.v, c.v SKIP 3 LIMIT 5
+                   RETURN a.v, b.v, c.v"""
+        reference = """MATCH (a)-[e1:R]->(b)-[e2:R|S]-(c), (a)-[e3:R|S]-(c)
+                       WITH DISTINCT a, b, c
+                       WITH a, b, c ORDER BY a.v, b.v, c.v SKIP 3 LIMIT 5
+                       RETURN a.v, b.v, c.v"""
+        self.compare(query, reference)
+
+        query = "MATCH (a)-[:R]->(b)-[:R]->(c), (a)-[:R]->(c) RETURN c.v LIMIT 1"
+        self.env.assertEquals(len(redis_graph.query(query).result_set), 1)
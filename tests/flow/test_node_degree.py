@@ -0,0 +1,66 @@
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "node_degree"
+redis_con = None
+redis_graph = None
+
+class testNodeDegree(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Hub connected to each leaf with R, twice to leaf 0 and once to itself with S.
+        redis_graph.query("CREATE (:Hub)")
+        redis_graph.query("MATCH (h:Hub) UNWIND range(0, 9) AS x CREATE (h)-[:R]->(:Leaf {v: x})")
+        redis_graph.query("MATCH (h:Hub), (l:Leaf {v: 0}) CREATE (h)-[:R]->(l), (l)-[:S]->(h), (h)-[:S]->(h)")
+
+    def degrees(self):
+        q = """MATCH (h:Hub), (l:Leaf {v: 0})
+               RETURN outdegree(h), indegree(h), outdegree(h, 'R'), outdegree(h, 'S'),
+                      indegree(h, 'S'), indegree(l), indegree(l, 'R', 'S'), outdegree(l, 'none')"""
+        return redis_graph.query(q).result_set[0]
+
+    def edge_counts(self):
+        q = "MATCH ()-[e:R]->() RETURN count(e)"
+        r_count = redis_graph.query(q).result_set[0][0]
+        q = "MATCH ()-[e:S]->() RETURN count(e)"
+        s_count = redis_graph.query(q).result_set[0][0]
+        return [r_count, s_count]
+
+    def test01_degree(self):
+        self.env.assertEquals(self.degrees(), [12, 2, 11, 1, 2, 2, 2, 0])
+        self.env.assertEquals(self.edge_counts(), [11, 2])
+
+    def test02_degree_after_reload(self):
+        redis_con.execute_command("DEBUG", "RELOAD")
+        self.env.assertEquals(self.degrees(), [12, 2, 11, 1, 2, 2, 2, 0])
+        self.env.assertEquals(self.edge_counts(), [11, 2])
+
+    def test03_degree_after_edge_deletion(self):
+        # Remove one of the multiple edges connecting the hub to leaf 0.
+        redis_graph.query("MATCH (:Hub)-[e:R]->(:Leaf {v: 0}) WITH e LIMIT 1 DELETE e")
+        self.env.assertEquals(self.degrees(), [11, 2, 10, 1, 2, 1, 1, 0])
+        self.env.assertEquals(self.edge_counts(), [10, 2])
+
+    def test04_degree_after_node_deletion(self):
+        # Deleting leaf 0 implicitly removes its incoming and outgoing edges.
+        redis_graph.query("MATCH (l:Leaf {v: 0}) DELETE l")
+        q = "MATCH (h:Hub) RETURN outdegree(h), indegree(h), outdegree(h, 'R'), indegree(h, 'S')"
+        self.env.assertEquals(redis_graph.query(q).result_set, [[10, 1, 9, 1]])
+        self.env.assertEquals(self.edge_counts(), [9, 1])
+
+    def test05_memory_usage(self):
+        # Memory usage accounts for the graph's entities.
+        before = redis_con.execute_command("MEMORY", "USAGE", GRAPH_ID)
+        redis_graph.query("MATCH (h:Hub) UNWIND range(0, 999) AS x CREATE (h)-[:R]->(:Leaf {v: x})")
+        self.env.assertEquals(self.degrees()[2], 1009)
+        after = redis_con.execute_command("MEMORY", "USAGE", GRAPH_ID)
+        self.env.assertGreater(after, before)
@@ -0,0 +1,66 @@
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+
+from base import FlowTestsBase
+
+GRAPH_ID = "parallel_aggregation"
+NODE_COUNT = 100000
+redis_graph = None
+
+class testParallelAggregation(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(moduleArgs='PARALLEL_THREAD_COUNT 4')
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Construct NODE_COUNT (:A)-[:R]->(:B) pairs, enough to span multiple morsels.
+        q = """UNWIND range(0, {}) AS x CREATE (:A {{v: x}})-[:R]->(:B {{v: x % 10}})""".format(NODE_COUNT - 1)
+        redis_graph.query(q)
+
+    def test01_plan(self):
+        plan = redis_graph.execution_plan("MATCH (a:A)-[:R]->(b) RETURN count(b)")
+        self.env.assertIn("Parallel Aggregate", plan)
+
+        # Grouped aggregations are not parallelized.
+        plan = redis_graph.execution_plan("MATCH (a:A)-[:R]->(b) RETURN b.v, count(b)")
+        self.env.assertNotIn("Parallel Aggregate", plan)
+
+        # Non-combinable aggregations are not parallelized.
+        plan = redis_graph.execution_plan("MATCH (a:A)-[:R]->(b) RETURN avg(b.v)")
+        self.env.assertNotIn("Parallel Aggregate", plan)
+
+    def test02_combined_aggregates(self):
+        q = """MATCH (a:A)-[:R]->(b:B) WHERE b.v < 5 RETURN count(b), sum(a.v), min(a.v), max(b.v)"""
+        actual_result = redis_graph.query(q)
+        half = NODE_COUNT // 2
+        # a.v % 10 < 5 for half of the nodes.
+        expected_sum = sum(x for x in range(NODE_COUNT) if x % 10 < 5)
+        expected_result = [[half, float(expected_sum), 0, 4]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        q = """MATCH (n) RETURN count(n.v), max(n.v)"""
+        actual_result = redis_graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [[2 * NODE_COUNT, NODE_COUNT - 1]])
+
+    def test03_empty_input(self):
+        # No records produce no aggregation, as with serial execution.
+        q = """MATCH (a:A) WHERE a.v < 0 RETURN count(a)"""
+        actual_result = redis_graph.query(q)
+        self.env.assertEquals(actual_result.result_set, [])
+
+    def test04_runtime_error(self):
+        # Errors raised by worker threads are reported.
+        try:
+            redis_graph.query("""MATCH (a:A) WHERE a.v / 0 > 1 RETURN count(a)""")
+        except Exception:
+            pass
+        # Server remains available.
+        actual_result = redis_graph.query("""MATCH (a:A) RETURN count(a)""")
+        self.env.assertEquals(actual_result.result_set, [[NODE_COUNT]])
@@ -0,0 +1,49 @@
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+
+from base import FlowTestsBase
+
+GRAPH_ID = "parallel_index_construction"
+NODE_COUNT = 100000
+redis_con = None
+redis_graph = None
+
+class testParallelIndexConstruction(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(moduleArgs='PARALLEL_THREAD_COUNT 4')
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Interleave labels so that indexed nodes span many node ID ranges.
+        q = """UNWIND range(0, {}) AS x CREATE (:A {{v: x, s: 'str' + toString(x % 100)}}), (:B {{v: x}})""".format(NODE_COUNT - 1)
+        redis_graph.query(q)
+
+    def validate_index(self):
+        q = "MATCH (a:A) WHERE a.v >= 0 RETURN count(a)"
+        plan = redis_graph.execution_plan(q)
+        self.env.assertIn("Index Scan", plan)
+        self.env.assertEquals(redis_graph.query(q).result_set, [[NODE_COUNT]])
+
+        q = "MATCH (a:A) WHERE a.v = {} RETURN a.v".format(NODE_COUNT - 1)
+        self.env.assertEquals(redis_graph.query(q).result_set, [[NODE_COUNT - 1]])
+
+        q = "CALL db.idx.fulltext.queryNodes('A', 'str42') YIELD node RETURN count(node)"
+        self.env.assertEquals(redis_graph.query(q).result_set, [[NODE_COUNT // 100]])
+
+    def test01_create_index(self):
+        redis_graph.query("CREATE INDEX ON :A(v)")
+        redis_graph.query("CALL db.idx.fulltext.createNodeIndex('A', 's')")
+        self.validate_index()
+
+    def test02_index_after_reload(self):
+        # Indices are reconstructed once the graph is decoded.
+        redis_con.execute_command("DEBUG", "RELOAD")
+        self.validate_index()
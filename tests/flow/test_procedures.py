@@ -327,6 +327,7 @@ class testProcedures(FlowTestsBase):
         expected_result = [["db.labels", "READ"], ["db.idx.fulltext.createNodeIndex", "WRITE"],
                            ["db.propertyKeys", "READ"], ["dbms.procedures", "READ"], ["db.relationshipTypes", "READ"],
                            ["algo.BFS", "READ"], ["algo.pageRank", "READ"], ["db.idx.fulltext.queryNodes", "READ"],
-                           ["db.idx.fulltext.drop", "WRITE"]]
+                           ["db.idx.fulltext.drop", "WRITE"], ["db.idx.range.createNodeIndex", "WRITE"],
+                           ["db.idx.range.drop", "WRITE"]]
         for res in expected_result:
             self.env.assertContains(res, actual_resultset)
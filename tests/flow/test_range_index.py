@@ -0,0 +1,117 @@
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "range_index"
+redis_con = None
+redis_graph = None
+
+# Filters evaluated against both an indexed and an unindexed label.
+FILTERS = [
+    "n.a = 2",
+    "n.a = 2 AND n.b > 50",
+    "n.a = 2 AND n.b >= 52 AND n.b < 87",
+    "n.a = 3 AND n.b <= 18",
+    "n.a > 1 AND n.a < 4",
+    "n.a >= 1.5",
+    "n.a = 2 AND n.b = 57",
+    "n.a = 2 AND n.b = 58",
+    "n.a = 2 AND n.b > 10 AND n.b < 5",
+    "n.a = 2 AND n.b = 'x'",
+    "n.a = 2 AND n.b > 50 AND n.s <> 'v72'",
+    "n.a = 1 AND n.s > 'v5'",
+    "n.s >= 'v3' AND n.s < 'v4'",
+    "n.s > 'v3'",
+    "n.s = 'v42'",
+    "n.a < 0",
+    "2 = n.a AND 20 < n.b",
+]
+
+class testRangeIndex(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        for label in ["N", "M"]:
+            redis_graph.query("UNWIND range(0, 99) AS x CREATE (:%s {a: x %% 5, b: x, s: 'v' + toString(x)})" % label)
+            # Nodes missing some of the indexed properties.
+            redis_graph.query("CREATE (:%s {b: 7}), (:%s {a: 2}), (:%s {a: 'two', b: 3})" % (label, label, label))
+        redis_graph.query("CALL db.idx.range.createNodeIndex('N', 'a', 'b', 's')")
+
+    def validate_filters(self):
+        for f in FILTERS:
+            query = "MATCH (n:N) WHERE %s RETURN n.a, n.b, n.s ORDER BY n.a, n.b, n.s" % f
+            plan = redis_graph.execution_plan(query)
+            self.env.assertIn("Index Scan", plan)
+            actual = redis_graph.query(query).result_set
+            expected = redis_graph.query(query.replace(":N", ":M")).result_set
+            self.env.assertEquals(actual, expected)
+
+    def test01_range_scans(self):
+        self.validate_filters()
+
+    def test02_index_not_utilized(self):
+        # Index can't resolve filters which don't constrain its first field.
+        for f in ["n.b = 5", "n.s = 'v5'", "n.a <> 2", "n.a = 2 OR n.b = 5"]:
+            plan = redis_graph.execution_plan("MATCH (n:N) WHERE %s RETURN n" % f)
+            self.env.assertNotIn("Index Scan", plan)
+
+    def test03_index_updates(self):
+        for label in ["N", "M"]:
+            redis_graph.query("MATCH (n:%s) WHERE n.b >= 90 SET n.a = 2, n.b = n.b + 1000" % label)
+            redis_graph.query("MATCH (n:%s) WHERE n.b < 10 DELETE n" % label)
+            redis_graph.query("MATCH (n:%s {b: 60}) SET n.a = NULL" % label)
+            redis_graph.query("CREATE (:%s {a: 2, b: 51, s: 'new'})" % label)
+        self.validate_filters()
+
+    def test04_modify_while_scanning(self):
+        # Nodes deleted by the scanning query are removed from the index.
+        query = "MATCH (n:N) WHERE n.a = 4 AND n.b > 0 DELETE n"
+        result = redis_graph.query(query)
+        expected = redis_graph.query(query.replace(":N", ":M"))
+        self.env.assertEquals(result.nodes_deleted, expected.nodes_deleted)
+        self.validate_filters()
+
+    def test05_persistency(self):
+        redis_con.execute_command("DEBUG", "RELOAD")
+        self.validate_filters()
+
+    def test06_drop_index(self):
+        redis_graph.query("CALL db.idx.range.drop('N')")
+        plan = redis_graph.execution_plan("MATCH (n:N) WHERE n.a = 2 RETURN n")
+        self.env.assertNotIn("Index Scan", plan)
+
+        # Recreate index with a single field.
+        redis_graph.query("CALL db.idx.range.createNodeIndex('N', 's')")
+        query = "MATCH (n:N) WHERE n.s >= 'v3' AND n.s < 'v4' RETURN n.s ORDER BY n.s"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Index Scan", plan)
+        actual = redis_graph.query(query).result_set
+        expected = redis_graph.query(query.replace(":N", ":M")).result_set
+        self.env.assertEquals(actual, expected)
+
+    def test07_value_types(self):
+        # Booleans are distinct from numbers, integers beyond 2^53 are distinct from one another.
+        for label in ["T", "U"]:
+            redis_graph.query("""UNWIND [true, false, 1, 0, 1.0, 9007199254740992, 9007199254740993,
+                                 9007199254740994, 9007199254740992.0, -9007199254740993] AS v
+                                 CREATE (:%s {v: v})""" % label)
+        redis_graph.query("CALL db.idx.range.createNodeIndex('T', 'v')")
+
+        filters = ["n.v = true", "n.v = false", "n.v = 1", "n.v = 0", "n.v >= 1",
+                   "n.v = 9007199254740993", "n.v > 9007199254740992", "n.v >= 9007199254740993",
+                   "n.v < 9007199254740994", "n.v <= 9007199254740992", "n.v = 9007199254740992.0",
+                   "n.v > 9007199254740993 AND n.v < 9007199254740995", "n.v < -9007199254740992"]
+        for f in filters:
+            query = "MATCH (n:T) WHERE %s RETURN n.v ORDER BY n.v, toString(n.v)" % f
+            plan = redis_graph.execution_plan(query)
+            self.env.assertIn("Index Scan", plan)
+            actual = redis_graph.query(query).result_set
+            expected = redis_graph.query(query.replace(":T", ":U")).result_set
+            self.env.assertEquals(actual, expected)
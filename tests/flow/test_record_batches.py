@@ -0,0 +1,55 @@
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+
+from base import FlowTestsBase
+
+GRAPH_ID = "record_batches"
+NODE_COUNT = 1000
+redis_graph = None
+
+class testRecordBatches(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Construct NODE_COUNT (:A)-[:R]->(:B) pairs, spanning multiple record batches.
+        q = """UNWIND range(0, {}) AS x CREATE (:A {{v: x}})-[:R]->(:B {{v: x}})""".format(NODE_COUNT - 1)
+        redis_graph.query(q)
+
+    def test01_filter_project(self):
+        # Half of the records pass the filter.
+        q = """MATCH (a:A) WHERE a.v % 2 = 0 RETURN a.v ORDER BY a.v"""
+        actual_result = redis_graph.query(q)
+        expected_result = [[x] for x in range(0, NODE_COUNT, 2)]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        q = """MATCH (a:A)-[:R]->(b:B) WHERE b.v >= 10 RETURN b.v + 1"""
+        actual_result = redis_graph.query(q)
+        self.env.assertEquals(len(actual_result.result_set), NODE_COUNT - 10)
+
+    def test02_aggregate(self):
+        q = """MATCH (a:A)-[:R]->(b:B) WHERE a.v < 500 RETURN count(b), sum(b.v)"""
+        actual_result = redis_graph.query(q)
+        expected_result = [[500, float(sum(range(500)))]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+    def test03_limit(self):
+        q = """MATCH (a:A)-[:R]->(b:B) RETURN b.v LIMIT 300"""
+        actual_result = redis_graph.query(q)
+        self.env.assertEquals(len(actual_result.result_set), 300)
+
+    def test04_batched_scalars(self):
+        # Scalars introduced before a traversal must remain valid
+        # once batched records outlive the traversal's source records.
+        q = """MATCH (a:A) WITH a, toString(a.v) AS s MATCH (a)-[:R]->(b:B) RETURN s, b.v"""
+        actual_result = redis_graph.query(q)
+        expected_result = [[str(x), x] for x in range(NODE_COUNT)]
+        self.env.assertEquals(sorted(actual_result.result_set, key=lambda row: row[1]), expected_result)
@@ -268,3 +268,33 @@ class testRelationPattern(FlowTestsBase):
         actual_result = redis_graph.query(query)
         expected_result = [['v1']]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    def test09_traversal_batches(self):
+        # Traverse enough sources to span multiple, growing batches.
+        g = Graph("batches", self.env.getConnection())
+        g.query("""UNWIND range(0, 9999) AS x CREATE (:A {v: x})-[:R]->(:B {v: x})""")
+
+        query = """MATCH (a:A)-[:R]->(b:B) WHERE a.v = b.v RETURN count(b)"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[10000]])
+
+        # Limited traversals only consume as many records as required.
+        query = """MATCH (a:A)-[:R]->(b:B) RETURN a.v, b.v ORDER BY a.v LIMIT 3"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[0, 0], [1, 1], [2, 2]])
+
+        # A single source node is traversed by scanning its row directly.
+        query = """MATCH (a:A {v: 42})-[:R]->(b) RETURN b.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[42]])
+
+        profile = self.env.getConnection().execute_command("GRAPH.PROFILE", "batches", query)
+        profile = [x.decode() if isinstance(x, bytes) else x for x in profile]
+        traverse = [x for x in profile if x.strip().startswith("Conditional Traverse")]
+        self.env.assertEquals(len(traverse), 1)
+        self.env.assertIn("Row scans: 1", traverse[0])
+        self.env.assertIn("Records produced: 1", traverse[0])
+
+        query = """MATCH (a:A {v: 42}) OPTIONAL MATCH (a)<-[:R]-(b) RETURN a.v, b"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[42, None]])
@@ -72,3 +72,85 @@ class testReplication(FlowTestsBase):
         replica_result = replica.query(q).result_set
         self.env.assertEquals(replica_result, result)
 
+
+    def test_effects_replication(self):
+        env = self.env
+        source_con = env.getConnection()
+        replica_con = env.getSlaveConnection()
+        replica_con.config_set("slave-read-only", "no")
+
+        # replicate write queries by their effects
+        source_con.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_REPLICATION", "yes")
+
+        graph = Graph("effects_replication", source_con)
+        replica = Graph("effects_replication", replica_con)
+
+        # non-deterministic values would differ if queries were re-executed
+        queries = [
+            "UNWIND range(0, 9) AS x CREATE (:L {id: x, v: rand(), list: [x, 'a', 1.5, true]})",
+            "CREATE INDEX ON :L(id)",
+            "MATCH (a:L), (b:L) WHERE b.id = a.id + 1 CREATE (a)-[:R {w: rand()}]->(b)",
+            "MATCH (n:L) WHERE n.id % 2 = 0 SET n.v = rand(), n.list = NULL, n.new = 'x'",
+            "MATCH ()-[e:R]->() WHERE e.w > 0.5 SET e.w = -1",
+            "UNWIND range(8, 12) AS x MERGE (n:L {id: x}) ON MATCH SET n.matched = rand() ON CREATE SET n.created = rand()",
+            "MATCH (n:L) WHERE n.id = 3 DELETE n",
+            "MATCH (:L {id: 6})-[e:R]->() DELETE e",
+            "CREATE (:L {id: 3, v: rand()})-[:R]->(:M {v: rand()})",
+        ]
+        for q in queries:
+            graph.query(q)
+
+        # give replica some time to catch up
+        time.sleep(1)
+
+        for q in ["MATCH (n) RETURN n ORDER BY id(n)",
+                  "MATCH (a)-[e]->(b) RETURN e ORDER BY id(e)",
+                  "MATCH (n:L) WHERE n.id = 3 RETURN id(n), n.v"]:
+            result = graph.query(q).result_set
+            replica_result = replica.query(q).result_set
+            env.assertEquals(replica_result, result)
+
+        # index updates are applied on replica
+        q = "MATCH (n:L {id: 3}) RETURN n.v"
+        env.assertIn("Index Scan", replica.execution_plan(q))
+        env.assertEquals(replica.query(q).result_set, graph.query(q).result_set)
+
+        # effects are only accepted from a primary
+        try:
+            source_con.execute_command("GRAPH.EFFECT", "effects_replication", "x")
+            env.assertTrue(False)
+        except Exception as e:
+            env.assertIn("only accepted from a primary", str(e))
+
+        source_con.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_REPLICATION", "no")
+
+    def test_effects_delete_and_create(self):
+        env = self.env
+        source_con = env.getConnection()
+        replica_con = env.getSlaveConnection()
+        replica_con.config_set("slave-read-only", "no")
+        source_con.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_REPLICATION", "yes")
+
+        graph = Graph("effects_delete_and_create", source_con)
+        replica = Graph("effects_delete_and_create", replica_con)
+
+        # created entities reuse IDs freed earlier by the same query
+        queries = [
+            "UNWIND range(0, 9) AS x CREATE (:L {id: x})-[:R {id: x}]->(:L {id: x + 10})",
+            "MATCH (n:L) WHERE n.id < 5 DETACH DELETE n WITH count(*) AS c UNWIND range(1, 3) AS x CREATE (:L {id: 100 + x, v: rand()})-[:R {w: rand()}]->(:M {v: rand()})",
+            "MATCH (a:L {id: 5})-[e:R]->(b) DELETE e, a CREATE (:L {id: 200, v: rand()})-[:R {w: rand()}]->(:M {v: rand()})",
+            "CREATE (:L {id: 300, v: rand()})-[:R {w: rand()}]->(:M {v: rand()})",
+        ]
+        for q in queries:
+            graph.query(q)
+
+        # give replica some time to catch up
+        time.sleep(1)
+
+        for q in ["MATCH (n) RETURN id(n), n ORDER BY id(n)",
+                  "MATCH (a)-[e]->(b) RETURN id(a), id(e), e, id(b) ORDER BY id(e)"]:
+            result = graph.query(q).result_set
+            replica_result = replica.query(q).result_set
+            env.assertEquals(replica_result, result)
+
+        source_con.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_REPLICATION", "no")
@@ -0,0 +1,143 @@
+import redis
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "shortest_path"
+redis_graph = None
+
+class testShortestPath(FlowTestsBase):
+    def __init__(self):
+        self.env = Env()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # Two shortest R paths from A to E: A->B->D->E and A->C->D->E,
+        # a longer R path A->F->G->H->E and a direct X edge A->E.
+        query = """CREATE (a:N {name: 'A'}), (b:N {name: 'B'}), (c:N {name: 'C'}), (d:N {name: 'D'}),
+                          (e:N {name: 'E'}), (f:N {name: 'F'}), (g:N {name: 'G'}), (h:N {name: 'H'}),
+                          (a)-[:R]->(b), (a)-[:R]->(c), (b)-[:R]->(d), (c)-[:R]->(d), (d)-[:R]->(e),
+                          (a)-[:R]->(f), (f)-[:R]->(g), (g)-[:R]->(h), (h)-[:R]->(e),
+                          (a)-[:X]->(e)"""
+        redis_graph.query(query)
+
+    def test01_shortest_path(self):
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = shortestPath((a)-[:R*]->(e))
+                   RETURN length(p)"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Shortest Path", plan)
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[3]])
+
+    def test02_all_shortest_paths(self):
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = allShortestPaths((a)-[:R*]->(e))
+                   RETURN [n IN nodes(p) | n.name] AS names ORDER BY names"""
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("All Shortest Paths", plan)
+        actual_result = redis_graph.query(query)
+        expected_result = [[['A', 'B', 'D', 'E']],
+                           [['A', 'C', 'D', 'E']]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+    def test03_relationship_types(self):
+        # Any relationship type.
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = allShortestPaths((a)-[*]->(e))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[1]])
+
+        # Non-existent relationship type.
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = shortestPath((a)-[:Z*]->(e))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+    def test04_direction(self):
+        # Path is reported from left to right.
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = allShortestPaths((e)<-[:R*]-(a))
+                   RETURN [n IN nodes(p) | n.name] AS names ORDER BY names"""
+        actual_result = redis_graph.query(query)
+        expected_result = [[['E', 'D', 'B', 'A']],
+                           [['E', 'D', 'C', 'A']]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # E can't reach A following outgoing edges.
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = shortestPath((e)-[:R*]->(a))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+        # Undirected.
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = allShortestPaths((e)-[:R*]-(a))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[3], [3]])
+
+    def test05_length_bounds(self):
+        query = """MATCH (a:N {name: 'A'}), (e:N {name: 'E'})
+                   MATCH p = shortestPath((a)-[:R*..2]->(e))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+        query = """MATCH (a:N {name: 'A'})
+                   MATCH p = shortestPath((a)-[:R*0..]->(a))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[0]])
+
+        query = """MATCH (a:N {name: 'A'})
+                   MATCH p = shortestPath((a)-[:R*]->(a))
+                   RETURN length(p)"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+    def test06_compare_to_variable_length_traversal(self):
+        # The shortest path length between every pair of nodes
+        # must match the minimal variable-length path.
+        query = """MATCH (a:N), (b:N) WHERE a <> b
+                   MATCH p = shortestPath((a)-[*]-(b))
+                   RETURN a.name, b.name, length(p) ORDER BY a.name, b.name"""
+        actual_result = redis_graph.query(query)
+
+        query = """MATCH p = (a:N)-[*]-(b:N) WHERE a <> b
+                   RETURN a.name, b.name, min(length(p)) ORDER BY a.name, b.name"""
+        expected_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+
+        query = """MATCH (a:N), (b:N) WHERE a <> b
+                   MATCH p = allShortestPaths((a)-[:R*]->(b))
+                   RETURN a.name, b.name, count(p) ORDER BY a.name, b.name"""
+        actual_result = redis_graph.query(query)
+
+        query = """MATCH p = (a:N)-[:R*]->(b:N) WHERE a <> b
+                   WITH a, b, length(p) AS len
+                   WITH a, b, collect(len) AS lens, min(len) AS shortest
+                   RETURN a.name, b.name, size([l IN lens WHERE l = shortest]) ORDER BY a.name, b.name"""
+        expected_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+
+    def test07_invalid_usage(self):
+        queries = {
+            "MATCH (a), (b) RETURN shortestPath((a)-[*]->(b))": "only supported within MATCH patterns",
+            "MATCH p = shortestPath((a)-[*]->(b)-[*]->(c)) RETURN p": "single relationship",
+            "MATCH p = shortestPath((a)-[]->(b)) RETURN p": "variable-length relationship",
+            "MATCH p = shortestPath((a)-[*2..]->(b)) RETURN p": "minimal length",
+        }
+        for query, error in queries.items():
+            try:
+                redis_graph.query(query)
+                assert(False)
+            except redis.exceptions.ResponseError as e:
+                self.env.assertIn(error, str(e))
@@ -0,0 +1,203 @@
+import threading
+from RLTest import Env
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+GRAPH_ID = "snapshot_reads"
+CONCURRENT_GRAPH_ID = "snapshot_reads_concurrent"
+NODE_COUNT = 500
+READER_COUNT = 4
+WRITER_ITERATIONS = 20
+redis_con = None
+redis_graph = None
+verdicts = [None] * (READER_COUNT + 1)  # Each reader places its first violation at position threadID.
+
+def cursor_id(stats):
+    for stat in stats:
+        stat = stat.decode() if isinstance(stat, bytes) else stat
+        if stat.startswith("Cursor: "):
+            return stat[len("Cursor: "):]
+    return None
+
+def ro_query(con, query, *args):
+    return con.execute_command("GRAPH.RO_QUERY", CONCURRENT_GRAPH_ID, query, *args)
+
+def write_graph(con):
+    for i in range(WRITER_ITERATIONS):
+        con.execute_command("GRAPH.QUERY", CONCURRENT_GRAPH_ID, "MATCH (n:N) SET n.v = n.v + 1")
+        con.execute_command("GRAPH.QUERY", CONCURRENT_GRAPH_ID, "UNWIND range(1, 10) AS x CREATE (:M {v: x})")
+        con.execute_command("GRAPH.QUERY", CONCURRENT_GRAPH_ID, "MATCH (m:M) DELETE m")
+        # Each new label replaces the schema array readers may be using.
+        con.execute_command("GRAPH.QUERY", CONCURRENT_GRAPH_ID, "CREATE (:L%d)" % i)
+
+# Every read must observe the graph as of a single commit.
+def read_graph(con, threadID, done):
+    global verdicts
+    try:
+        while not done.is_set():
+            count, low, high, total = ro_query(con, "MATCH (n:N) RETURN count(n), min(n.v), max(n.v), sum(n.v)")[1][0]
+            # Sums are replied as doubles.
+            total = int(float(total))
+            if count != NODE_COUNT or high - low != NODE_COUNT - 1 or total != count * low + NODE_COUNT * (NODE_COUNT - 1) // 2:
+                verdicts[threadID] = "nodes: %s" % [count, low, high, total]
+                return
+
+            edges, gaps = ro_query(con, "MATCH (a:N)-[e:R]->(b:N) RETURN count(e), sum(b.v - a.v)")[1][0]
+            gaps = int(float(gaps))
+            if edges != NODE_COUNT - 1 or gaps != NODE_COUNT - 1:
+                verdicts[threadID] = "edges: %s" % [edges, gaps]
+                return
+
+            count, total = ro_query(con, "MATCH (m:M) RETURN count(m), sum(m.v)")[1][0]
+            total = int(float(total))
+            if count not in (0, 10) or total != count // 10 * 55:
+                verdicts[threadID] = "created nodes: %s" % [count, total]
+                return
+    except Exception as e:
+        verdicts[threadID] = str(e)
+
+# Cursors read their snapshot across commits.
+def read_cursors(con, threadID, done):
+    global verdicts
+    try:
+        while not done.is_set():
+            res = ro_query(con, "MATCH (n:N) RETURN n.v", "CURSOR", 50)
+            records = res[1]
+            cursor = cursor_id(res[2])
+            while cursor is not None:
+                res = con.execute_command("GRAPH.CURSOR", CONCURRENT_GRAPH_ID, cursor)
+                records += res[1]
+                cursor = cursor_id(res[2])
+
+            values = sorted(record[0] for record in records)
+            if values != list(range(values[0], values[0] + NODE_COUNT)):
+                verdicts[threadID] = "cursor: %d records from %d" % (len(values), values[0])
+                return
+    except Exception as e:
+        verdicts[threadID] = str(e)
+
+class testSnapshotReads(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(moduleArgs='SNAPSHOT_READS yes')
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        redis_graph.query("UNWIND range(0, {}) AS x CREATE (:N {{v: x}})".format(NODE_COUNT - 1))
+        redis_graph.query("MATCH (a:N), (b:N) WHERE b.v = a.v + 1 CREATE (a)-[:R {v: a.v}]->(b)")
+
+    def read_remaining(self, records, cursor):
+        while cursor is not None:
+            res = redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+            records += res[1]
+            cursor = cursor_id(res[2])
+        return records
+
+    def test01_reads_follow_writes(self):
+        query = "MATCH (a:N)-[e:R]->(b:N) RETURN count(e), sum(a.v), sum(b.v), sum(e.v)"
+        self.env.assertEquals(redis_graph.query(query).result_set, [[NODE_COUNT - 1, 124251, 124750, 124251]])
+
+        # Each write is visible to the following reads.
+        redis_graph.query("MATCH (n:N) WHERE n.v < 10 SET n.v = n.v + 1000")
+        res = redis_graph.query("MATCH (n:N) WHERE n.v >= 1000 RETURN count(n), min(n.v)").result_set
+        self.env.assertEquals(res, [[10, 1000]])
+
+        redis_graph.query("MATCH (n:N) WHERE n.v >= 1000 DETACH DELETE n")
+        res = redis_graph.query("MATCH (n:N) RETURN count(n), min(n.v)").result_set
+        self.env.assertEquals(res, [[NODE_COUNT - 10, 10]])
+        res = redis_graph.query("MATCH ()-[e:R]->() RETURN count(e)").result_set
+        self.env.assertEquals(res, [[NODE_COUNT - 11]])
+
+        # Labels and relationship types introduced after the first reads.
+        redis_graph.query("MATCH (n:N) WHERE n.v < 20 CREATE (n)-[:S]->(:M {v: n.v})")
+        res = redis_graph.query("MATCH (:N)-[:S]->(m:M) RETURN count(m), sum(m.v)").result_set
+        self.env.assertEquals(res, [[10, 145]])
+        res = redis_graph.query("MATCH (n) RETURN count(n)").result_set
+        self.env.assertEquals(res, [[NODE_COUNT]])
+
+    def test02_cursor_reads_its_snapshot(self):
+        query = "MATCH (n:N) RETURN n.v"
+        expected = sorted(redis_graph.query(query).result_set)
+
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, query, "CURSOR", 10)
+        records = res[1]
+        cursor = cursor_id(res[2])
+        self.env.assertIsNotNone(cursor)
+
+        # Writes committed while the cursor is open don't affect it.
+        redis_graph.query("MATCH (n:N) SET n.v = n.v + 10000")
+        redis_graph.query("MATCH (n:N) WHERE n.v % 2 = 0 DETACH DELETE n")
+        redis_graph.query("UNWIND range(0, 99) AS x CREATE (:N {v: -x})")
+
+        records = self.read_remaining(records, cursor)
+        self.env.assertEquals(sorted(records), expected)
+
+        # Following reads observe the writes.
+        res = redis_graph.query("MATCH (n:N) WHERE n.v < 10000 RETURN count(n)").result_set
+        self.env.assertEquals(res, [[100]])
+
+    def test03_cursor_traversal_across_new_types(self):
+        query = "MATCH (a)-[e]->(b) RETURN a.v, type(e), b.v"
+        expected = sorted(redis_graph.query(query).result_set)
+
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, query, "CURSOR", 2)
+        records = res[1]
+        cursor = cursor_id(res[2])
+        self.env.assertIsNotNone(cursor)
+
+        redis_graph.query("MATCH (a:N {v: -1}), (b:N {v: -2}) CREATE (a)-[:T]->(b), (:L)-[:R]->(:L)")
+        redis_graph.query("MATCH ()-[e:R]->() DELETE e")
+
+        records = self.read_remaining(records, cursor)
+        self.env.assertEquals(sorted(records), expected)
+
+    def test04_index_reads_hold_read_lock(self):
+        # Index scans read the live graph, their cursors are invalidated by writes.
+        redis_graph.query("CREATE INDEX ON :N(v)")
+        query = "MATCH (n:N) WHERE n.v < 0 RETURN n.v"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Index Scan", plan)
+
+        res = redis_con.execute_command("GRAPH.RO_QUERY", GRAPH_ID, query, "CURSOR", 10)
+        cursor = cursor_id(res[2])
+        self.env.assertIsNotNone(cursor)
+
+        redis_graph.query("CREATE (:N {v: -1000})")
+        try:
+            redis_con.execute_command("GRAPH.CURSOR", GRAPH_ID, cursor)
+            self.env.assertTrue(False)
+        except Exception as e:
+            self.env.assertIn("Cursor invalidated", str(e))
+
+        res = redis_graph.query("MATCH (n:N) WHERE n.v < 0 RETURN count(n)").result_set
+        self.env.assertEquals(res, [[100]])
+
+    def test05_concurrent_writer_and_readers(self):
+        graph = Graph(CONCURRENT_GRAPH_ID, redis_con)
+        graph.query("UNWIND range(0, {}) AS x CREATE (:N {{v: x}})".format(NODE_COUNT - 1))
+        graph.query("MATCH (a:N), (b:N) WHERE b.v = a.v + 1 CREATE (a)-[:R]->(b)")
+
+        done = threading.Event()
+        readers = []
+        for i in range(READER_COUNT + 1):
+            target = read_cursors if i == READER_COUNT else read_graph
+            t = threading.Thread(target=target, args=(self.env.getConnection(), i, done))
+            t.setDaemon(True)
+            readers.append(t)
+            t.start()
+
+        write_graph(self.env.getConnection())
+        done.set()
+        for t in readers:
+            t.join()
+
+        for verdict in verdicts:
+            self.env.assertIsNone(verdict)
+
+        # Readers observed the writer's last commit once it was done.
+        res = graph.query("MATCH (n:N) RETURN min(n.v), count(n)").result_set
+        self.env.assertEquals(res, [[WRITER_ITERATIONS, NODE_COUNT]])
@@ -0,0 +1,74 @@
+from base import FlowTestsBase
+import os
+import sys
+from RLTest import Env
+from redisgraph import Graph, Node, Edge
+
+redis_con = None
+
+class test_v9_encode_decode(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(moduleArgs='VKEY_MAX_ENTITY_COUNT 10')
+        global redis_con
+        redis_con = self.env.getConnection()
+
+    def test01_labels_and_relations(self):
+        graph_name = "labels_and_relations"
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("UNWIND range(0,20) as i CREATE (:L1 {val:i})-[:R1 {val:i}]->(:L2 {val:i})")
+        redis_graph.query("MATCH (a:L1), (b:L2) WHERE a.val = b.val + 1 CREATE (b)-[:R2 {val:a.val}]->(a)")
+        queries = ["MATCH (a:L1) RETURN a.val ORDER BY a.val",
+                   "MATCH (a:L2) RETURN a.val ORDER BY a.val",
+                   "MATCH (a:L1)-[e:R1]->(b:L2) RETURN a.val, e.val, b.val ORDER BY e.val",
+                   "MATCH (a:L1)<-[e:R2]-(b:L2) RETURN a.val, e.val, b.val ORDER BY e.val",
+                   "MATCH (a)-[e]->(b) RETURN a.val, type(e), b.val ORDER BY a.val, b.val, type(e)",
+                   "MATCH (a)<-[e]-(b) RETURN a.val, type(e), b.val ORDER BY a.val, b.val, type(e)"]
+        expected = [redis_graph.query(q).result_set for q in queries]
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+        for q, e in zip(queries, expected):
+            actual = redis_graph.query(q)
+            self.env.assertEquals(e, actual.result_set)
+
+    def test02_multiple_edges(self):
+        graph_name = "multiple_edges"
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("CREATE (:Src {val:0}), (:Dest {val:0})")
+        redis_graph.query("MATCH (a:Src), (b:Dest) UNWIND range(0,20) as i CREATE (a)-[:R {val:i}]->(b)")
+        redis_graph.query("CREATE (:Src {val:1})-[:R {val:21}]->(:Dest {val:1})")
+        query = "MATCH (a:Src)-[e:R]->(b:Dest) RETURN a.val, e.val, b.val ORDER BY e.val"
+        expected = redis_graph.query(query)
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+        actual = redis_graph.query(query)
+        self.env.assertEquals(expected.result_set, actual.result_set)
+
+        # Traverse the transposed relation matrix.
+        actual = redis_graph.query("MATCH (b:Dest)<-[e:R]-(a:Src) RETURN a.val, e.val, b.val ORDER BY e.val")
+        self.env.assertEquals(expected.result_set, actual.result_set)
+
+        # Delete some of the multiple edges, the remaining ones should be intact.
+        redis_graph.query("MATCH ()-[e:R]->() WHERE e.val < 10 DELETE e")
+        actual = redis_graph.query("MATCH (:Src {val:0})-[e:R]->(:Dest {val:0}) RETURN count(e)")
+        self.env.assertEquals(actual.result_set, [[11]])
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+        actual = redis_graph.query("MATCH (:Src)-[e:R]->(:Dest) RETURN e.val ORDER BY e.val")
+        self.env.assertEquals(actual.result_set, [[i] for i in range(10, 22)])
+
+    def test03_deleted_entities(self):
+        graph_name = "deleted_entities"
+        redis_graph = Graph(graph_name, redis_con)
+        redis_graph.query("UNWIND range(0,20) as i CREATE (:Src {val:i})-[:R {val:i}]->(:Dest {val:i})")
+        redis_graph.query("MATCH (n:Src) WHERE n.val IN [3,7,15] DELETE n")
+        query = "MATCH (a)-[e]->(b) RETURN a.val, e.val, b.val, id(a), id(e), id(b) ORDER BY e.val"
+        expected = redis_graph.query(query)
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+        actual = redis_graph.query(query)
+        self.env.assertEquals(expected.result_set, actual.result_set)
+
+        # Deleted IDs are reused and new connections are formed on top of the loaded matrices.
+        redis_graph.query("UNWIND range(0,2) as i CREATE (:Src {val:100+i})-[:R {val:100+i}]->(:Dest {val:100+i})")
+        actual = redis_graph.query("MATCH (a:Src)-[e:R]->(b:Dest) RETURN count(e)")
+        self.env.assertEquals(actual.result_set, [[21]])
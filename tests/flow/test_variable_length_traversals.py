@@ -105,3 +105,40 @@ class testVariableLengthTraversals(FlowTestsBase):
         actual_result = redis_graph.query(query)
         expected_result = [['A', 'B']]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # Traversals whose paths are irrelevant report each reachable node once.
+    def test09_pruned_traversal(self):
+        g = Graph("pruned", redis_con)
+        # Diamonds and a cycle, yielding multiple paths between pairs of nodes.
+        g.query("""CREATE (a:L {v: 1})-[:R]->(b:L {v: 2})-[:R]->(d:L {v: 4}),
+                          (a)-[:R]->(c:L {v: 3})-[:R]->(d),
+                          (d)-[:R]->(e:L {v: 5})-[:R]->(a),
+                          (e)-[:R]->(e)""")
+
+        patterns = ["(a)-[*]->(b)", "(a)-[:R*1..2]->(b)", "(a)<-[*0..3]-(b)",
+                    "(a)-[*0..]-(b)", "(a)-[*..1]->(b)"]
+        for pattern in patterns:
+            query = "MATCH %s RETURN DISTINCT a.v, b.v ORDER BY a.v, b.v" % pattern
+            plan = g.execution_plan(query)
+            self.env.assertIn("Pruned", plan)
+            actual_result = g.query(query)
+            # Aggregation depends on the number of paths, preventing pruning.
+            query = "MATCH %s WITH a, b, count(*) AS paths RETURN a.v, b.v ORDER BY a.v, b.v" % pattern
+            plan = g.execution_plan(query)
+            self.env.assertNotIn("Pruned", plan)
+            expected_result = g.query(query)
+            self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+
+        # Existence checks by pattern predicates.
+        query = "MATCH (a:L), (b:L) WHERE (a)-[*2..]->(b) OR (a)-[*..1]->(b) RETURN a.v, b.v ORDER BY a.v, b.v"
+        expected_result = g.query(query)
+        query = "MATCH (a:L), (b:L) WHERE (a)-[*]->(b) RETURN a.v, b.v ORDER BY a.v, b.v"
+        plan = g.execution_plan(query)
+        self.env.assertIn("Pruned", plan)
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, expected_result.result_set)
+
+        # Minimal length greater than 1 and undirected paths of length 1 or more are not pruned.
+        for pattern in ["(a)-[*2..3]->(b)", "(a)-[*]-(b)"]:
+            plan = g.execution_plan("MATCH %s RETURN DISTINCT a, b" % pattern)
+            self.env.assertNotIn("Pruned", plan)
@@ -663,6 +663,147 @@ TEST_F(AlgebraicExpressionTest, Exp_OP_MUL) {
 	AlgebraicExpression_Free(exp);
 }
 
+TEST_F(AlgebraicExpressionTest, Exp_OP_MUL_Masked) {
+	// Exp = A * B, restricted to the entries of M
+	GrB_Matrix A;
+	GrB_Matrix B;
+	GrB_Matrix M;
+	GrB_Matrix C;
+	GrB_Matrix res;
+
+	// A
+	// 1 1
+	// 0 1
+	GrB_Matrix_new(&A, GrB_BOOL, 2, 2);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 0);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 1);
+	GrB_Matrix_setElement_BOOL(A, true, 1, 1);
+
+	// B
+	// 1 1
+	// 1 0
+	GrB_Matrix_new(&B, GrB_BOOL, 2, 2);
+	GrB_Matrix_setElement_BOOL(B, true, 0, 0);
+	GrB_Matrix_setElement_BOOL(B, true, 0, 1);
+	GrB_Matrix_setElement_BOOL(B, true, 1, 0);
+
+	// M
+	// 0 1
+	// 0 1
+	GrB_Matrix_new(&M, GrB_BOOL, 2, 2);
+	GrB_Matrix_setElement_BOOL(M, true, 0, 1);
+	GrB_Matrix_setElement_BOOL(M, true, 1, 1);
+
+	// C
+	// 0 1
+	// 0 0
+	GrB_Matrix_new(&C, GrB_BOOL, 2, 2);
+	GrB_Matrix_setElement_BOOL(C, true, 0, 1);
+
+	rax *matrices = raxNew();
+	raxInsert(matrices, (unsigned char *)"A", strlen("A"), A, NULL);
+	raxInsert(matrices, (unsigned char *)"B", strlen("B"), B, NULL);
+	AlgebraicExpression *exp = AlgebraicExpression_FromString("A*B", matrices);
+
+	// Populate res with entries outside of the mask, which should be discarded.
+	GrB_Matrix_new(&res, GrB_BOOL, 2, 2);
+	GrB_Matrix_setElement_BOOL(res, true, 1, 0);
+
+	// Evaluate twice, as intermediate matrices are reused across evaluations.
+	for(int i = 0; i < 2; i++) {
+		AlgebraicExpression_EvalMasked(exp, M, res);
+		// A * B = [[1 1] [1 0]], masked by M.
+		ASSERT_TRUE(_compare_matrices(res, C));
+	}
+
+	raxFree(matrices);
+	GrB_Matrix_free(&A);
+	GrB_Matrix_free(&B);
+	GrB_Matrix_free(&M);
+	GrB_Matrix_free(&C);
+	GrB_Matrix_free(&res);
+	AlgebraicExpression_Free(exp);
+}
+
+TEST_F(AlgebraicExpressionTest, Exp_OP_MUL_LabelMask) {
+	// Exp = A * R * L, where R is a dense relation and L labels a single node,
+	// the product is computed by pulling L's column from R's transpose.
+	GraphContext *prev_gc = QueryCtx_GetGraphCtx();
+	GraphContext *gc = (GraphContext *)malloc(sizeof(GraphContext));
+	gc->g = Graph_New(16, 16);
+	gc->index_count = 0;
+	gc->graph_name = strdup("masked");
+	gc->attributes = raxNew();
+	pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
+	gc->string_mapping = (char **)array_new(char *, 64);
+	gc->node_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
+	gc->relation_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	QueryCtx_SetGraphCtx(gc);
+
+	int label_id = GraphContext_AddSchema(gc, "L", SCHEMA_NODE)->id;
+	int relation_id = GraphContext_AddSchema(gc, "R", SCHEMA_EDGE)->id;
+
+	// Transposed relation matrices are maintained.
+	bool maintain_transpose;
+	Config_Option_get(Config_MAINTAIN_TRANSPOSE, &maintain_transpose);
+	ASSERT_TRUE(maintain_transpose);
+
+	Node n;
+	Edge e;
+	Graph *g = gc->g;
+	size_t node_count = 8;
+	Graph_AcquireWriteLock(g);
+	Graph_AllocateNodes(g, node_count);
+	for(int i = 0; i < node_count - 1; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+	Graph_CreateNode(g, label_id, &n);
+	// Connect every pair of nodes.
+	for(NodeID src = 0; src < node_count; src++) {
+		for(NodeID dest = 0; dest < node_count; dest++) {
+			Graph_ConnectNodes(g, src, dest, relation_id, &e);
+		}
+	}
+	Graph_ReleaseLock(g);
+
+	GrB_Matrix R = Graph_GetRelationMatrix(g, relation_id);
+	GrB_Matrix L = Graph_GetLabelMatrix(g, label_id);
+
+	// A
+	// 1 1 0 0 0 0 0 0
+	GrB_Matrix A;
+	GrB_Matrix_new(&A, GrB_BOOL, 1, node_count);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 0);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 1);
+
+	// C
+	// 0 0 0 0 0 0 0 1
+	GrB_Matrix C;
+	GrB_Matrix_new(&C, GrB_BOOL, 1, node_count);
+	GrB_Matrix_setElement_BOOL(C, true, 0, node_count - 1);
+
+	AlgebraicExpression *exp = AlgebraicExpression_NewOperation(AL_EXP_MUL);
+	AlgebraicExpression_AddChild(exp, AlgebraicExpression_NewOperand(A, false, "a", "a", NULL, NULL));
+	AlgebraicExpression_AddChild(exp, AlgebraicExpression_NewOperand(R, false, "a", "b", "r", "R"));
+	AlgebraicExpression_AddChild(exp, AlgebraicExpression_NewOperand(L, true, "b", "b", NULL, "L"));
+
+	GrB_Matrix res;
+	GrB_Matrix_new(&res, GrB_BOOL, 1, node_count);
+
+	// Evaluate twice, as the mask is reused across evaluations.
+	for(int i = 0; i < 2; i++) {
+		AlgebraicExpression_Eval(exp, res);
+		ASSERT_TRUE(_compare_matrices(res, C));
+		// The label was applied as a mask, built into the operation's scratch matrix.
+		ASSERT_TRUE(exp->operation.scratch != GrB_NULL);
+	}
+
+	AlgebraicExpression_Free(exp);
+	GrB_Matrix_free(&A);
+	GrB_Matrix_free(&C);
+	GrB_Matrix_free(&res);
+	Graph_Free(g);
+	QueryCtx_SetGraphCtx(prev_gc);
+}
+
 TEST_F(AlgebraicExpressionTest, Exp_OP_ADD_Transpose) {
 	// Exp = A + Transpose(A)
 	GrB_Matrix B;
@@ -102,3 +102,64 @@ TEST_F(CacheTest, ExecutionPlanCache) {
 	ASSERT_EQ(free_count, 9);
 }
 
+
+TEST_F(CacheTest, CacheStats) {
+	Cache *cache = Cache_New(2, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+	const char *key3 = "MATCH (c) RETURN c";
+
+	// Miss.
+	ASSERT_TRUE(Cache_GetValue(cache, key1) == NULL);
+
+	Cache_SetValue(cache, key1, CacheObj_New("1"));
+	Cache_SetValue(cache, key2, CacheObj_New("2"));
+
+	// Hits.
+	CacheObj *from_cache = (CacheObj *)Cache_GetValue(cache, key1);
+	ASSERT_TRUE(from_cache != NULL);
+	CacheObj_Free(from_cache);
+	from_cache = (CacheObj *)Cache_GetValue(cache, key2);
+	ASSERT_TRUE(from_cache != NULL);
+	CacheObj_Free(from_cache);
+
+	// Cache is full, evicts key1.
+	Cache_SetValue(cache, key3, CacheObj_New("3"));
+	ASSERT_TRUE(Cache_GetValue(cache, key1) == NULL);
+
+	CacheStats stats = Cache_GetStats(cache);
+	ASSERT_EQ(stats.hits, 2);
+	ASSERT_EQ(stats.misses, 2);
+	ASSERT_EQ(stats.evictions, 1);
+
+	Cache_Free(cache);
+}
+
+TEST_F(CacheTest, LRUOrderedByHits) {
+	Cache *cache = Cache_New(2, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+	const char *key3 = "MATCH (c) RETURN c";
+
+	Cache_SetValue(cache, key1, CacheObj_New("1"));
+	Cache_SetValue(cache, key2, CacheObj_New("2"));
+
+	// No insertions between hits, key2 is used before key1.
+	CacheObj *from_cache = (CacheObj *)Cache_GetValue(cache, key2);
+	CacheObj_Free(from_cache);
+	from_cache = (CacheObj *)Cache_GetValue(cache, key1);
+	CacheObj_Free(from_cache);
+
+	// Cache is full, evicts key2 which is the least recently used.
+	Cache_SetValue(cache, key3, CacheObj_New("3"));
+	ASSERT_TRUE(Cache_GetValue(cache, key2) == NULL);
+	from_cache = (CacheObj *)Cache_GetValue(cache, key1);
+	ASSERT_TRUE(from_cache != NULL);
+	CacheObj_Free(from_cache);
+
+	Cache_Free(cache);
+}
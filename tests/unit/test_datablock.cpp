@@ -239,3 +239,42 @@ TEST_F(DataBlockTest, OutOfOrderBuilding) {
 	DataBlock_Free(dataBlock);
 }
 
+
+TEST_F(DataBlockTest, AllocateItemAt) {
+	DataBlock *dataBlock = DataBlock_New(4, sizeof(int), NULL);
+	for(int i = 0; i < 4; i++) {
+		int *item = (int *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+	// Free list: 1, 3, 2.
+	DataBlock_DeleteItem(dataBlock, 1);
+	DataBlock_DeleteItem(dataBlock, 3);
+	DataBlock_DeleteItem(dataBlock, 2);
+
+	// Claim a position from the middle of the free list.
+	int *item = (int *)DataBlock_AllocateItemAt(dataBlock, 3);
+	*item = 3;
+	ASSERT_EQ(2, dataBlock->itemCount);
+	ASSERT_EQ(2, array_len(dataBlock->deletedIdx));
+	ASSERT_EQ(1, dataBlock->deletedIdx[0]);
+	ASSERT_EQ(2, dataBlock->deletedIdx[1]);
+
+	// Skipped positions are freed, lowest is reused first.
+	item = (int *)DataBlock_AllocateItemAt(dataBlock, 6);
+	*item = 6;
+	ASSERT_EQ(3, dataBlock->itemCount);
+	ASSERT_EQ(4, array_len(dataBlock->deletedIdx));
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, 6) != NULL);
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, 4) == NULL);
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, 5) == NULL);
+
+	uint64_t idx;
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(4, idx);
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(5, idx);
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(2, idx);
+
+	DataBlock_Free(dataBlock);
+}
@@ -882,7 +882,63 @@ TEST_F(GraphTest, BulkDelete) {
 	ASSERT_EQ(Graph_NodeCount(g), 3);
 	ASSERT_EQ(Graph_EdgeCount(g), 3);
 
+	// Label and relation counters follow deletions.
+	ASSERT_EQ(Graph_LabeledNodeCount(g, l), 3);
+	ASSERT_EQ(Graph_RelationEdgeCount(g, r0), 1);
+	ASSERT_EQ(Graph_RelationEdgeCount(g, r1), 2);
+
 	// Clean up.
 	Graph_Free(g);
 }
 
+
+// Make sure writes are flushed once a writer synchronizes the graph.
+TEST_F(GraphTest, SynchronizeWrites) {
+	Node n;
+	Edge e;
+	bool pending;
+	GrB_Index nrows;
+	size_t node_count = 16;
+	Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+
+	Graph_AcquireWriteLock(g);
+	int l = Graph_AddLabel(g);
+	int r = Graph_AddRelationType(g);
+	for(uint i = 0; i < node_count; i++) Graph_CreateNode(g, l, &n);
+	for(uint i = 1; i < node_count; i++) Graph_ConnectNodes(g, i - 1, i, r, &e);
+	Graph_ReleaseLock(g);
+
+	// Releasing the write lock publishes a new epoch.
+	ASSERT_EQ(Graph_GetEpoch(g), 1);
+
+	Graph_SynchronizeWrites(g);
+
+	// Matrices should be in sync, without any pending changes.
+	RG_Matrix matrices[4] = {g->adjacency_matrix, g->_t_adjacency_matrix,
+							 g->labels[l], g->relations[r]};
+	for(int i = 0; i < 4; i++) {
+		GrB_Matrix M = matrices[i]->grb_matrix;
+		ASSERT_EQ(GxB_Matrix_Pending(M, &pending), GrB_SUCCESS);
+		ASSERT_FALSE(pending);
+		ASSERT_EQ(GrB_Matrix_nrows(&nrows, M), GrB_SUCCESS);
+		ASSERT_EQ(nrows, Graph_RequiredMatrixDim(g));
+		ASSERT_EQ(matrices[i]->synced_dim, Graph_RequiredMatrixDim(g));
+	}
+
+	// Readers do not advance the epoch.
+	Graph_AcquireReadLock(g);
+	Graph_ReleaseLock(g);
+	ASSERT_EQ(Graph_GetEpoch(g), 1);
+
+	// Introducing a new node requires matrices to be resized.
+	Graph_AcquireWriteLock(g);
+	Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+	Graph_ReleaseLock(g);
+	ASSERT_EQ(Graph_GetEpoch(g), 2);
+
+	GrB_Matrix L = Graph_GetLabelMatrix(g, l);
+	ASSERT_EQ(GrB_Matrix_nrows(&nrows, L), GrB_SUCCESS);
+	ASSERT_EQ(nrows, Graph_RequiredMatrixDim(g));
+
+	Graph_Free(g);
+}
@@ -0,0 +1,95 @@
+/*
+* Copyright 2018-2020 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/util/arr.h"
+#include "../../src/query_ctx.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/arithmetic/funcs.h"
+#include "../../src/procedures/procedure.h"
+#include "../../src/commands/execution_ctx.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class QueryCostTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+		// Init query context.
+		ASSERT_TRUE(QueryCtx_Init());
+		// Initialize GraphBLAS.
+		GrB_init(GrB_NONBLOCKING);
+		GxB_Global_Option_set(GxB_FORMAT, GxB_BY_COL); // all matrices in CSC format
+		GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+		Proc_Register();         // Register procedures.
+		AR_RegisterFuncs();      // Register arithmetic functions.
+
+		// Create a graphcontext
+		_fake_graph_context();
+	}
+
+	static void _fake_graph_context() {
+		GraphContext *gc = (GraphContext *)malloc(sizeof(GraphContext));
+
+		gc->g = Graph_New(16, 16);
+		gc->index_count = 0;
+		gc->graph_name = strdup("G");
+		gc->attributes = raxNew();
+		pthread_rwlock_init(&gc->_attribute_rwlock, NULL);
+		gc->string_mapping = (char **)array_new(char *, 64);
+		gc->node_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
+		gc->relation_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+		gc->query_costs = (uint64_t *)calloc(QUERY_COST_TABLE_SIZE, sizeof(uint64_t));
+		QueryCtx_SetGraphCtx(gc);
+	}
+
+	// Builds an execution context for query, which mustn't hold parameters.
+	static ExecutionCtx build_execution_ctx(const char *query) {
+		cypher_parse_result_t *parse_result = cypher_parse(query, NULL, NULL, CYPHER_PARSE_ONLY_STATEMENTS);
+		ExecutionCtx ctx;
+		ctx.ast = AST_Build(parse_result);
+		ctx.plan = NewExecutionPlan();
+		ctx.cached = false;
+		ctx.exec_type = EXECUTION_TYPE_QUERY;
+		return ctx;
+	}
+};
+
+TEST_F(QueryCostTest, ParametersShareCost) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	ExecutionCtx ctx = build_execution_ctx("MATCH (n) WHERE n.v = $v RETURN n");
+
+	// Classified once, under the query stripped of its parameters.
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "CYPHER v=1 MATCH (n) WHERE n.v = $v RETURN n"),
+			  QUERY_COST_UNKNOWN);
+	ExecutionCtx_SetCachedCost(&ctx, gc, "CYPHER v=1 MATCH (n) WHERE n.v = $v RETURN n");
+
+	// All parameter values share the same cost entry.
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "CYPHER v=1 MATCH (n) WHERE n.v = $v RETURN n"),
+			  QUERY_COST_HIGH);
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "CYPHER v=2 MATCH (n) WHERE n.v = $v RETURN n"),
+			  QUERY_COST_HIGH);
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "CYPHER v='a' MATCH (n) WHERE n.v = $v RETURN n"),
+			  QUERY_COST_HIGH);
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "MATCH (n) WHERE n.v = $v RETURN n"), QUERY_COST_HIGH);
+
+	// Other queries aren't classified.
+	ASSERT_EQ(ExecutionCtx_GetCachedCost(gc, "CYPHER v=1 MATCH (n) WHERE n.v > $v RETURN n"),
+			  QUERY_COST_UNKNOWN);
+
+	AST_Free(ctx.ast);
+	ExecutionPlan_Free(ctx.plan);
+}
@@ -346,6 +346,41 @@ TEST_F(QueryGraphTest, QueryGraphConnectedComponents) {
 	array_free(connected_components);
 }
 
+TEST_F(QueryGraphTest, QueryGraphContainsCycle) {
+	QueryGraph *g;
+
+	g = SingleNodeGraph();
+	ASSERT_FALSE(QueryGraph_ContainsCycle(g));
+	QueryGraph_Free(g);
+
+	g = TriangleGraph();
+	ASSERT_TRUE(QueryGraph_ContainsCycle(g));
+	QueryGraph_Free(g);
+
+	g = DisjointGraph();
+	ASSERT_FALSE(QueryGraph_ContainsCycle(g));
+	QueryGraph_Free(g);
+
+	g = SingleNodeCycleGraph();
+	ASSERT_TRUE(QueryGraph_ContainsCycle(g));
+	QueryGraph_Free(g);
+
+	// Disjoint graph containing a cycle
+	// (A)->(B) (C)->(D)->(E)->(C)
+	g = DisjointGraph();
+	QGNode *C = QueryGraph_GetNodeByAlias(g, "C");
+	QGNode *D = QGNode_New("D");
+	QGNode *E = QGNode_New("E");
+	QueryGraph_AddNode(g, D);
+	QueryGraph_AddNode(g, E);
+	QueryGraph_ConnectNodes(g, C, D, QGEdge_New(C, D, "R", "CD"));
+	QueryGraph_ConnectNodes(g, D, E, QGEdge_New(D, E, "R", "DE"));
+	ASSERT_FALSE(QueryGraph_ContainsCycle(g));
+	QueryGraph_ConnectNodes(g, E, C, QGEdge_New(E, C, "R", "EC"));
+	ASSERT_TRUE(QueryGraph_ContainsCycle(g));
+	QueryGraph_Free(g);
+}
+
 TEST_F(QueryGraphTest, QueryGraphExtractSubGraph) {
 	//--------------------------------------------------------------------------
 	// Construct graph
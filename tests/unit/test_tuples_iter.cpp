@@ -526,3 +526,65 @@ TEST_F(TuplesTest, IteratorRange) {
 	ASSERT_TRUE(depleted);
 }
 
+
+TEST_F(TuplesTest, IteratorSeekCol) {
+	bool depleted;
+	GrB_Info info;
+	GrB_Index row;
+	GrB_Index col;
+
+	// Row 3 holds every even column, row 4 holds column 1.
+	GrB_Index n = 64;
+	GrB_Matrix A = CreateSquareNByNEmptyMatrix(n);
+	for(GrB_Index j = 0; j < n; j += 2) GrB_Matrix_setElement_BOOL(A, true, 3, j);
+	GrB_Matrix_setElement_BOOL(A, true, 4, 1);
+
+	GxB_MatrixTupleIter *iter;
+	GxB_MatrixTupleIter_new(&iter, A);
+
+	info = GxB_MatrixTupleIter_iterate_range(iter, 3, 3);
+	ASSERT_EQ(GrB_SUCCESS, info);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(0, col);
+
+	// Seek to a missing column stops at the following entry.
+	info = GxB_MatrixTupleIter_seek_col(iter, 31);
+	ASSERT_EQ(GrB_SUCCESS, info);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(3, row);
+	ASSERT_EQ(32, col);
+
+	// Entries already consumed aren't revisited.
+	GxB_MatrixTupleIter_seek_col(iter, 32);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(34, col);
+
+	// Seek to an existing column.
+	GxB_MatrixTupleIter_seek_col(iter, 60);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(60, col);
+
+	// Seek past the row's last entry depletes the iterator.
+	GxB_MatrixTupleIter_seek_col(iter, 63);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_TRUE(depleted);
+
+	// Seek is confined to the current row.
+	GxB_MatrixTupleIter_iterate_range(iter, 3, 4);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_EQ(0, col);
+	GxB_MatrixTupleIter_seek_col(iter, n);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(4, row);
+	ASSERT_EQ(1, col);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_TRUE(depleted);
+
+	GxB_MatrixTupleIter_free(iter);
+	GrB_Matrix_free(&A);
+}